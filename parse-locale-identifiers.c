@@ -8,7 +8,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <stdint.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#ifdef LOCALE_PTHREADS
+#include <pthread.h>
+#endif
 
 #ifndef __USE_GNU
 char *strndup (const char *s, size_t n)
@@ -167,6 +173,39 @@ const char* GettextModifierToUnicodeScriptDictionary[][2] = {
 	{NULL, NULL},
 };
 
+/*
+ * ASCII character classes and case-insensitive comparison.
+ * Unlike the ctype.h functions and strncasecmp, they don't depend on the current C locale (for instance, in Turkish locales "I" is not the uppercase of "i").
+ */
+static int IsLocaleAlpha(char c)
+{
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+static int IsLocaleDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+static int IsLocaleAlnum(char c)
+{
+	return IsLocaleAlpha(c) || IsLocaleDigit(c);
+}
+/* Compares at most n characters, like strncasecmp */
+static int CompareLocaleStringsIgnoringCase(const char* a, const char* b, size_t n)
+{
+	char ca, cb;
+	for (; n; n--, a++, b++) {
+		ca = *a >= 'A' && *a <= 'Z' ? (char)(*a + ('a' - 'A')) : *a;
+		cb = *b >= 'A' && *b <= 'Z' ? (char)(*b + ('a' - 'A')) : *b;
+		if (ca != cb) {
+			return (unsigned char)ca - (unsigned char)cb;
+		}
+		if (!ca) {
+			break;
+		}
+	}
+	return 0;
+}
+
 /*
  * Convert a Gettext modifier identifier to the corresponding Unicode script identifier.
  * Returns NULL if gettextModifier is empty or if no correspondance has been found.
@@ -177,7 +216,7 @@ const char* GettextModifierToUnicodeScript(const char *gettextModifier) {
 	result = NULL;
 	if (gettextModifier && gettextModifier[0]) {
 		for (p = 0; GettextModifierToUnicodeScriptDictionary[p][0]; p++) {
-			if (!strcasecmp(GettextModifierToUnicodeScriptDictionary[p][0], gettextModifier)) {
+			if (!CompareLocaleStringsIgnoringCase(GettextModifierToUnicodeScriptDictionary[p][0], gettextModifier, (size_t)-1)) {
 				result = GettextModifierToUnicodeScriptDictionary[p][1];
 				break;
 			}
@@ -196,7 +235,7 @@ const char* UnicodeScriptToGettextModifier(const char *unicodeScript) {
 	result = NULL;
 	if (unicodeScript && unicodeScript[0]) {
 		for (p = 0; GettextModifierToUnicodeScriptDictionary[p][0]; p++) {
-			if (!strcasecmp(GettextModifierToUnicodeScriptDictionary[p][1], unicodeScript)) {
+			if (!CompareLocaleStringsIgnoringCase(GettextModifierToUnicodeScriptDictionary[p][1], unicodeScript, (size_t)-1)) {
 				result = GettextModifierToUnicodeScriptDictionary[p][0];
 				break;
 			}
@@ -205,6 +244,185 @@ const char* UnicodeScriptToGettextModifier(const char *unicodeScript) {
 	return result;
 }
 
+/*
+ * Dense script identifiers: the index of the row of GettextModifierToUnicodeScriptDictionary plus one.
+ */
+/* The script has not been looked up yet */
+#define LOCALE_SCRIPT_ID_UNRESOLVED 0
+/* There's no script, or it's not in the dictionary */
+#define LOCALE_SCRIPT_ID_NONE -1
+
+/*
+ * Memory allocation hooks.
+ * They let callers provide the memory used by the parsers and by the serializers (for instance from a LocaleArena).
+ */
+typedef struct _LocaleAllocator {
+	/* Allocates size bytes, suitably aligned for any type; returns NULL in case of out-of-memory problems */
+	void* (*allocate)(void* userData, size_t size);
+	/* Releases a memory block returned by allocate (ptr is never NULL) */
+	void (*release)(void* userData, void* ptr);
+	/* Custom data passed to allocate and release */
+	void* userData;
+} LocaleAllocator;
+
+/*
+ * Allocates memory with the specified hooks (or with malloc if allocator is NULL).
+ */
+static void* LocaleAllocate(const LocaleAllocator* allocator, size_t size)
+{
+	return allocator ? allocator->allocate(allocator->userData, size) : malloc(size);
+}
+
+/*
+ * Releases memory with the specified hooks (or with free if allocator is NULL).
+ * ptr may be NULL (in that case nothing happens).
+ */
+static void LocaleRelease(const LocaleAllocator* allocator, void* ptr)
+{
+	if (ptr) {
+		if (allocator) {
+			allocator->release(allocator->userData, ptr);
+		} else {
+			free(ptr);
+		}
+	}
+}
+
+static void* LocaleMallocAllocate(void* userData, size_t size)
+{
+	(void)userData;
+	return malloc(size);
+}
+
+static void LocaleMallocRelease(void* userData, void* ptr)
+{
+	(void)userData;
+	free(ptr);
+}
+
+/*
+ * Memory allocation hooks that use malloc and free.
+ */
+const LocaleAllocator LocaleMallocAllocator = {LocaleMallocAllocate, LocaleMallocRelease, NULL};
+
+/*
+ * A block of memory allocated by a LocaleArena from its upstream allocator.
+ */
+typedef struct _LocaleArenaBlock {
+	struct _LocaleArenaBlock* previous;
+	size_t size;
+} LocaleArenaBlock;
+
+/*
+ * A monotonic memory arena: memory is carved out of a buffer and it's released all at once by ReleaseLocaleArena.
+ */
+typedef struct _LocaleArena {
+	/* The memory we are currently carving */
+	char* buffer;
+	size_t size;
+	size_t used;
+	/* Where new blocks come from once the buffer is exhausted (NULL to fail with out-of-memory instead) */
+	const LocaleAllocator* upstream;
+	/* The blocks allocated from upstream (NULL if none) */
+	LocaleArenaBlock* blocks;
+	/* The hooks that allocate from this arena */
+	LocaleAllocator allocator;
+} LocaleArena;
+
+/*
+ * All the memory returned by a LocaleArena is aligned to this number of bytes.
+ */
+#define LOCALE_ARENA_ALIGNMENT (2 * sizeof(void*))
+
+/*
+ * The minimum size of the blocks that a LocaleArena allocates from its upstream allocator.
+ */
+#define LOCALE_ARENA_MIN_BLOCK_SIZE 4096
+
+/*
+ * LocaleAllocator hook that allocates from a LocaleArena.
+ */
+static void* LocaleArenaAllocate(void* userData, size_t size)
+{
+	LocaleArena* arena;
+	LocaleArenaBlock* block;
+	size_t offset, blockSize;
+	void* result;
+	arena = (LocaleArena*)userData;
+	offset = (((uintptr_t)arena->buffer + arena->used + LOCALE_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(LOCALE_ARENA_ALIGNMENT - 1)) - (uintptr_t)arena->buffer;
+	if (!arena->buffer || offset > arena->size || size > arena->size - offset) {
+		if (!arena->upstream) {
+			return NULL;
+		}
+		/* Grow geometrically, so that the number of upstream allocations stays logarithmic */
+		blockSize = arena->size * 2;
+		if (blockSize < LOCALE_ARENA_MIN_BLOCK_SIZE) {
+			blockSize = LOCALE_ARENA_MIN_BLOCK_SIZE;
+		}
+		if (blockSize < size + LOCALE_ARENA_ALIGNMENT) {
+			blockSize = size + LOCALE_ARENA_ALIGNMENT;
+		}
+		block = (LocaleArenaBlock*)LocaleAllocate(arena->upstream, sizeof(LocaleArenaBlock) + LOCALE_ARENA_ALIGNMENT + blockSize);
+		if (!block) {
+			return NULL;
+		}
+		block->previous = arena->blocks;
+		block->size = blockSize;
+		arena->blocks = block;
+		arena->buffer = (char*)(block + 1);
+		arena->size = blockSize + LOCALE_ARENA_ALIGNMENT;
+		arena->used = 0;
+		offset = (((uintptr_t)arena->buffer + LOCALE_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(LOCALE_ARENA_ALIGNMENT - 1)) - (uintptr_t)arena->buffer;
+	}
+	result = arena->buffer + offset;
+	arena->used = offset + size;
+	return result;
+}
+
+/*
+ * LocaleAllocator hook for a LocaleArena: memory is only released by ReleaseLocaleArena.
+ */
+static void LocaleArenaRelease(void* userData, void* ptr)
+{
+	(void)userData;
+	(void)ptr;
+}
+
+/*
+ * Initializes a LocaleArena.
+ * buffer (of size bytes) is the initial memory to be used (it may be NULL if size is 0).
+ * upstream are the hooks to be used to allocate more memory when buffer is exhausted:
+ * if it's NULL, the arena will never allocate memory by itself.
+ */
+void InitLocaleArena(LocaleArena* arena, void* buffer, size_t size, const LocaleAllocator* upstream)
+{
+	arena->buffer = (char*)buffer;
+	arena->size = buffer ? size : 0;
+	arena->used = 0;
+	arena->upstream = upstream;
+	arena->blocks = NULL;
+	arena->allocator.allocate = LocaleArenaAllocate;
+	arena->allocator.release = LocaleArenaRelease;
+	arena->allocator.userData = arena;
+}
+
+/*
+ * Releases all the memory allocated by a LocaleArena.
+ * The arena can't be used anymore, unless it's initialized again.
+ */
+void ReleaseLocaleArena(LocaleArena* arena)
+{
+	LocaleArenaBlock* block;
+	while (arena->blocks) {
+		block = arena->blocks;
+		arena->blocks = block->previous;
+		LocaleRelease(arena->upstream, block);
+	}
+	arena->buffer = NULL;
+	arena->size = 0;
+	arena->used = 0;
+}
+
 /*
  * Contain all the possible chunck of the locale identifiers.
  */
@@ -225,8 +443,68 @@ typedef struct _LocaleChunks {
 	size_t variantCount;
 	/* List of null-terminated variant tags (NULL if empty) */
 	char** variants;
+	/* Extensions, in BCP 47 format without the leading separator, for example "u-ca-japanese" (NULL or not empty) */
+	char* extensions;
+	/* Lazily computed canonical identifiers (see GetCachedGettextLocaleID and GetCachedUnicodeLocaleID): NULL if not computed yet */
+	char* cachedGettextID;
+	char* cachedUnicodeID;
+	/* Lazily resolved dense script identifier (see GetLocaleChunksScriptID): LOCALE_SCRIPT_ID_UNRESOLVED if not resolved yet */
+	int scriptID;
+	/*
+	 * Size of the memory block that holds both this structure and the chunks stored inline after it
+	 * (0 if every chunk has been allocated separately, as it happens with ConstructLocaleChunks).
+	 */
+	size_t allocationSize;
+	/* The hooks used to allocate this structure and its chunks (NULL for malloc) */
+	const LocaleAllocator* allocator;
 } LocaleChunks;
 
+/*
+ * Size of the buffers used to store the extensions that can't point directly into a scanned string (like the ones built from ICU keywords).
+ */
+#define LOCALE_EXTENSIONS_BUFFER_SIZE 128
+
+/*
+ * A portion of a locale identifier (not null-terminated).
+ */
+typedef struct _LocaleSlice {
+	const char* start;
+	size_t length;
+} LocaleSlice;
+
+/*
+ * The chunks of a locale identifier, pointing directly into the scanned string (so that nothing gets allocated).
+ * Empty slices have a zero length.
+ */
+typedef struct _LocaleChunkSlices {
+	/* Is this the "root" for Unicode? */
+	int isRoot;
+	LocaleSlice language;
+	LocaleSlice territory;
+	LocaleSlice codeset;
+	LocaleSlice modifier;
+	LocaleSlice script;
+	/* Number of variant tags */
+	size_t variantCount;
+	/* All the variant tags, including the separators between them */
+	LocaleSlice variants;
+	/* Extensions, in BCP 47 format without the leading separator (the separators may also be underscores or plus signs) */
+	LocaleSlice extensions;
+} LocaleChunkSlices;
+
+/*
+ * Checks if a character separates the variants or the extension tags in the scanned strings ("+" is used by Android).
+ */
+static int IsLocaleIDTagSeparator(char c)
+{
+	return c == '-' || c == '_' || c == '+';
+}
+
+/*
+ * A buffer of this size is enough to hold the typical locale identifiers (up to 23 characters) without using the heap.
+ */
+#define LOCALE_ID_INLINE_SIZE 24
+
 /*
  * Initializes a new LocaleChunks structure and returns its pointer.
  * Returns NULL in case of out-of-memory problems.
@@ -236,6 +514,152 @@ LocaleChunks* ConstructLocaleChunks()
 	return (LocaleChunks*)calloc(1, sizeof(LocaleChunks));
 }
 
+/*
+ * Checks if a pointer refers to the memory block allocated together with a LocaleChunks structure.
+ */
+static int IsLocaleChunksInlineData(const LocaleChunks* lc, const void* p)
+{
+	return lc->allocationSize
+		&& (uintptr_t)p >= (uintptr_t)lc
+		&& (uintptr_t)p < (uintptr_t)lc + lc->allocationSize
+	;
+}
+
+/*
+ * Frees a LocaleChunks chunk, unless it's stored inline.
+ */
+static void FreeLocaleChunksData(const LocaleChunks* lc, void* p)
+{
+	if (p && !IsLocaleChunksInlineData(lc, p)) {
+		LocaleRelease(lc->allocator, p);
+	}
+}
+
+/*
+ * Atomic access to the cached identifiers of LocaleChunks.
+ * Without the GCC/Clang atomic builtins they are plain memory accesses (and the caches are not thread-safe).
+ */
+static char* LoadLocaleIDCache(char** cache)
+{
+#if defined(__GNUC__)
+	return __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+#else
+	return *cache;
+#endif
+}
+static int CompareAndSwapLocaleIDCache(char** cache, char* expected, char* desired)
+{
+#if defined(__GNUC__)
+	return __atomic_compare_exchange_n(cache, &expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#else
+	if (*cache != expected) {
+		return 0;
+	}
+	*cache = desired;
+	return 1;
+#endif
+}
+static char* ExchangeLocaleIDCache(char** cache, char* desired)
+{
+#if defined(__GNUC__)
+	return __atomic_exchange_n(cache, desired, __ATOMIC_ACQ_REL);
+#else
+	char* result;
+	result = *cache;
+	*cache = desired;
+	return result;
+#endif
+}
+
+/*
+ * Cached value of the identifiers that can't be represented in their format.
+ */
+static char LocaleIDCacheUnrepresentable[1] = "";
+
+/*
+ * Discards the cached identifiers and the derived script of a LocaleChunks: it must be called after changing its chunks.
+ * Like any other change, it must not happen while other threads are using lc.
+ */
+void InvalidateLocaleChunksCache(LocaleChunks* lc)
+{
+	char* cached;
+	if (lc) {
+		cached = ExchangeLocaleIDCache(&lc->cachedGettextID, NULL);
+		if (cached != LocaleIDCacheUnrepresentable) {
+			FreeLocaleChunksData(lc, cached);
+		}
+		cached = ExchangeLocaleIDCache(&lc->cachedUnicodeID, NULL);
+		if (cached != LocaleIDCacheUnrepresentable) {
+			FreeLocaleChunksData(lc, cached);
+		}
+		lc->scriptID = LOCALE_SCRIPT_ID_UNRESOLVED;
+	}
+}
+
+/*
+ * Gets the dense script identifier of a LocaleChunks (see LOCALE_SCRIPT_ID_...), from its script or else from its Gettext modifier.
+ * The dictionary is looked up only the first time: later calls just read lc->scriptID. It can be called by more threads at the same time.
+ * Returns LOCALE_SCRIPT_ID_NONE if lc is NULL or if the script is not in the dictionary.
+ */
+int GetLocaleChunksScriptID(const LocaleChunks* lc)
+{
+	int scriptID;
+	size_t p;
+	if (!lc) {
+		return LOCALE_SCRIPT_ID_NONE;
+	}
+#if defined(__GNUC__)
+	scriptID = __atomic_load_n(&lc->scriptID, __ATOMIC_RELAXED);
+#else
+	scriptID = lc->scriptID;
+#endif
+	if (scriptID != LOCALE_SCRIPT_ID_UNRESOLVED) {
+		return scriptID;
+	}
+	scriptID = LOCALE_SCRIPT_ID_NONE;
+	for (p = 0; GettextModifierToUnicodeScriptDictionary[p][0]; p++) {
+		if (lc->script ? !CompareLocaleStringsIgnoringCase(GettextModifierToUnicodeScriptDictionary[p][1], lc->script, (size_t)-1) : lc->modifier && !CompareLocaleStringsIgnoringCase(GettextModifierToUnicodeScriptDictionary[p][0], lc->modifier, (size_t)-1)) {
+			scriptID = (int)p + 1;
+			break;
+		}
+	}
+	/* Every thread computes the same value: the derived field is not part of the logical value of lc */
+#if defined(__GNUC__)
+	__atomic_store_n(&((LocaleChunks*)lc)->scriptID, scriptID, __ATOMIC_RELAXED);
+#else
+	((LocaleChunks*)lc)->scriptID = scriptID;
+#endif
+	return scriptID;
+}
+
+/*
+ * Gets the Unicode script of a LocaleChunks: its script, or else the one derived from its Gettext modifier (for example "Latn" for "latin").
+ * Returns NULL if lc is NULL or if it has no script.
+ */
+const char* GetLocaleChunksUnicodeScript(const LocaleChunks* lc)
+{
+	int scriptID;
+	if (lc && lc->script) {
+		return lc->script;
+	}
+	scriptID = GetLocaleChunksScriptID(lc);
+	return scriptID > 0 ? GettextModifierToUnicodeScriptDictionary[scriptID - 1][1] : NULL;
+}
+
+/*
+ * Gets the Gettext modifier of a LocaleChunks: its modifier, or else the one derived from its Unicode script (for example "latin" for "Latn").
+ * Returns NULL if lc is NULL or if it has no modifier.
+ */
+const char* GetLocaleChunksGettextModifier(const LocaleChunks* lc)
+{
+	int scriptID;
+	if (lc && lc->modifier) {
+		return lc->modifier;
+	}
+	scriptID = GetLocaleChunksScriptID(lc);
+	return scriptID > 0 ? GettextModifierToUnicodeScriptDictionary[scriptID - 1][0] : NULL;
+}
+
 /*
  * Frees a LocaleChunks structure and all its members.
  * lc may be NULL (in that case nothing happens).
@@ -244,147 +668,84 @@ void FreeLocaleChunks(LocaleChunks* lc)
 {
 	size_t i;
 	if (lc) {
-		if (lc->language) {
-			free(lc->language);
-		}
-		if (lc->territory) {
-			free(lc->territory);
-		}
-		if (lc->codeset) {
-			free(lc->codeset);
-		}
-		if (lc->modifier) {
-			free(lc->modifier);
-		}
-		if (lc->script) {
-			free(lc->script);
-		}
+		InvalidateLocaleChunksCache(lc);
+		FreeLocaleChunksData(lc, lc->language);
+		FreeLocaleChunksData(lc, lc->territory);
+		FreeLocaleChunksData(lc, lc->codeset);
+		FreeLocaleChunksData(lc, lc->modifier);
+		FreeLocaleChunksData(lc, lc->script);
 		if (lc->variants) {
 			for (i = 0; i < lc->variantCount; i++) {
-				if (lc->variants[i]) {
-					free(lc->variants[i]);
-				}
+				FreeLocaleChunksData(lc, lc->variants[i]);
 			}
-			free(lc->variants);
+			FreeLocaleChunksData(lc, lc->variants);
 		}
-		free(lc);
+		FreeLocaleChunksData(lc, lc->extensions);
+		LocaleRelease(lc->allocator, lc);
 	}
 }
 
 /*
- * Parse a locale identifier in Gettext format (language[_territory][.codeset][@modifier]).
- * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ * Copies a slice to the inline data of a LocaleChunks, null-terminating it.
+ * Returns the pointer to the next free inline byte.
  */
-LocaleChunks* GettextLocaleIDToLocaleChunks(const char* locale)
+static char* CopyLocaleSliceInline(char** field, const LocaleSlice* slice, char* data)
 {
-	LocaleChunks* result;
-	char *p, *separator;
-	if (!locale) {
-		return NULL;
-	}
-	separator = NULL;
-	result = NULL;
-	for (p = (char*) locale; !separator || *separator != '\0'; p++) {
-		switch (*p) {
-			case '_':
-			case '.':
-			case '@':
-			case '\0':
-				if (!result) {
-					/* First chunk: language */
-					if (p == locale) {
-						/* Empty language -> error */
-						return NULL;
-					}
-					result = ConstructLocaleChunks();
-					if (result == NULL) {
-						return NULL;
-					}
-					result->language = strndup(locale, p - locale);
-				} else {
-					if (p == separator + 1) {
-						/* Empty chunk -> error */
-						FreeLocaleChunks(result);
-						return NULL;
-
-					}
-					switch (*separator) {
-						case '_':
-							if (result->territory || result->codeset || result->modifier) {
-								/* Duplicated or misplaced territory -> error */
-								FreeLocaleChunks(result);
-								return NULL;
-							}
-							result->territory = strndup(separator + 1, p - separator - 1);
-							break;
-						case '.':
-							if (result->codeset || result->modifier) {
-								/* Duplicated or misplaced codeset -> error */
-								FreeLocaleChunks(result);
-								return NULL;
-							}
-							result->codeset = strndup(separator + 1, p - separator - 1);
-							break;
-						case '@':
-							if (result->modifier) {
-								/* Duplicated modifier -> error */
-								FreeLocaleChunks(result);
-								return NULL;
-							}
-							result->modifier = strndup(separator + 1, p - separator - 1);
-							break;
-					}
-				}
-				separator = p;
-				break;
-			default:
-				if (!isalnum(*p)) {
-					/* Invalid character */
-					FreeLocaleChunks(result);
-					return NULL;
-				}
-				break;
-		}
+	if (slice->length) {
+		memcpy(data, slice->start, slice->length);
+		data[slice->length] = '\0';
+		*field = data;
+		data += slice->length + 1;
 	}
-	return result;
+	return data;
 }
 
 /*
- * Convert a LocaleChunks to the Gettext locale ID format (language[_territory][.codeset][@modifier]).
- * Returns NULL if LocaleChunks is NULL or invalid, or in case of out-of-memory problems.
+ * Builds a LocaleChunks structure from the result of a scan, allocating it with the specified hooks (NULL for malloc).
+ * The structure and all its chunks are stored in one memory block, so that FreeLocaleChunks only needs to release it once.
+ * Returns NULL in case of out-of-memory problems.
  */
-char * LocaleChunksToGettextLocaleID(const LocaleChunks* lc)
+LocaleChunks* LocaleChunkSlicesToLocaleChunksWithAllocator(const LocaleChunkSlices* slices, const LocaleAllocator* allocator)
 {
-	char* result;
-	const char* modifier;
-	size_t length;
-	result = NULL;
-	if (lc && lc->language) {
-		length = strlen(lc->language) + 1;
-		if (lc->territory) {
-			length += 1 + strlen(lc->territory);
-		}
-		if (lc->codeset) {
-			length += 1 + strlen(lc->codeset);
-		}
-		modifier = lc->modifier ? lc->modifier : UnicodeScriptToGettextModifier(lc->script);
-		if (modifier) {
-			length += 1 + strlen(modifier);
+	LocaleChunks* result;
+	size_t size, i;
+	char* data;
+	size = sizeof(LocaleChunks) + slices->variantCount * sizeof(char*);
+	size += slices->language.length ? slices->language.length + 1 : 0;
+	size += slices->territory.length ? slices->territory.length + 1 : 0;
+	size += slices->codeset.length ? slices->codeset.length + 1 : 0;
+	size += slices->modifier.length ? slices->modifier.length + 1 : 0;
+	size += slices->script.length ? slices->script.length + 1 : 0;
+	size += slices->variantCount ? slices->variants.length + 1 : 0;
+	size += slices->extensions.length ? slices->extensions.length + 1 : 0;
+	result = (LocaleChunks*)LocaleAllocate(allocator, size);
+	if (result) {
+		memset(result, 0, size);
+		result->allocationSize = size;
+		result->allocator = allocator;
+		result->isRoot = slices->isRoot;
+		data = (char*)result + sizeof(LocaleChunks);
+		if (slices->variantCount) {
+			result->variants = (char**)data;
+			data += slices->variantCount * sizeof(char*);
 		}
-		result = (char*)malloc(length * sizeof(char));
-		if(result) {
-			strcpy(result, lc->language);
-			if (lc->territory) {
-				strcat(result, "_");
-				strcat(result, lc->territory);
-			}
-			if (lc->codeset) {
-				strcat(result, ".");
-				strcat(result, lc->codeset);
-			}
-			if (modifier) {
-				strcat(result, "@");
-				strcat(result, modifier);
+		data = CopyLocaleSliceInline(&result->language, &slices->language, data);
+		data = CopyLocaleSliceInline(&result->territory, &slices->territory, data);
+		data = CopyLocaleSliceInline(&result->codeset, &slices->codeset, data);
+		data = CopyLocaleSliceInline(&result->modifier, &slices->modifier, data);
+		data = CopyLocaleSliceInline(&result->script, &slices->script, data);
+		data = CopyLocaleSliceInline(&result->extensions, &slices->extensions, data);
+		if (slices->variantCount) {
+			/* Variants only contain alphanumeric characters: we can split them at the separators */
+			memcpy(data, slices->variants.start, slices->variants.length);
+			data[slices->variants.length] = '\0';
+			result->variantCount = slices->variantCount;
+			result->variants[0] = data;
+			for (i = 1; *data; data++) {
+				if (IsLocaleIDTagSeparator(*data)) {
+					*data = '\0';
+					result->variants[i++] = data + 1;
+				}
 			}
 		}
 	}
@@ -392,349 +753,9541 @@ char * LocaleChunksToGettextLocaleID(const LocaleChunks* lc)
 }
 
 /*
- * Parse a locale identifier in Gettext format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ).
- * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ * Builds a LocaleChunks structure from the result of a scan.
+ * The structure and all its chunks are stored in one memory block, so that FreeLocaleChunks only needs to call free() once.
+ * Returns NULL in case of out-of-memory problems.
  */
-LocaleChunks* UnicodeLocaleIDToLocaleChunks(const char* locale)
+LocaleChunks* LocaleChunkSlicesToLocaleChunks(const LocaleChunkSlices* slices)
 {
-	LocaleChunks* result;
-	size_t numChunks;
-	size_t nextChunk;
-	size_t initialVariantChunk;
-	char** chunks;
-	size_t *chunkLengths;
-	size_t maxNumChunks;
-	char *p, *chunkStart;
-	int badData;
-	if (!(locale && locale[0])) {
-		return NULL;
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(slices, NULL);
+}
+
+/*
+ * Scan a locale identifier in Gettext format (language[_territory][.codeset][@modifier]).
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise.
+ */
+int ScanGettextLocaleID(const char* locale, size_t length, LocaleChunkSlices* slices)
+{
+	const char *p, *end, *chunkStart;
+	char separator;
+	LocaleSlice* chunk;
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale) {
+		return 0;
 	}
-	result = NULL;
-	maxNumChunks = 1 + (strlen(locale) >> 1);
-	chunks = (char**)malloc(maxNumChunks * sizeof(char*));
-	if (chunks) {
-		chunkLengths = (size_t*)malloc(maxNumChunks * sizeof(size_t));
-		if (chunkLengths) {
-			numChunks = 0;
-			for (badData = 0, chunkStart = p = (char*) locale; !badData; p++) {
-				switch (*p) {
-					case '-':
-					case '_':
-					case '\0':
-						if (p == chunkStart) {
-							/* Empty chunk */
-							badData = 1;
-						} else {
-							chunks[numChunks] = chunkStart;
-							chunkLengths[numChunks] = p - chunkStart;
-							numChunks++;
-							chunkStart = p + 1;
-						}
-						break;
-					default:
-						if (!isalnum(*p)) {
-							/* Invalid character */
-							badData = 1;
-						}
-						break;
-				}
-				if (*p == '\0') {
-					break;
-				}
-			}
-			if (!badData) {
-				result = ConstructLocaleChunks();
-				if (result == NULL) {
-					badData = 1;
-				}
+	end = locale + length;
+	/* '\0' stands for the first chunk (the language) */
+	separator = '\0';
+	for (chunkStart = p = locale; ; p++) {
+		if (p == end || *p == '_' || *p == '.' || *p == '@') {
+			if (p == chunkStart) {
+				/* Empty chunk -> error */
+				return 0;
 			}
-			if (!badData) {
-				if (chunkLengths[0] == 4 && !strncmp("root", chunks[0], 4)) {
-					/* First chunk: "root" */
-					result->isRoot = 1;
-					nextChunk = 1;
-				} else {
-					/* First chunks: language and/or script */
-					if (chunkLengths[0] >= 2 && chunkLengths[0] <= 3) {
-						/* language - alpha{2,3} */
-						if (
-							isalpha(chunks[0][0])
-							&& isalpha(chunks[0][1])
-							&& (
-								chunkLengths[0] == 2
-								|| isalpha(chunks[0][2])
-							)
-						) {
-							result->language = strndup(chunks[0], chunkLengths[0]);
-						}
-						if (!result->language) {
-							badData = 1;
-						}
-						nextChunk = 1;
-					} else {
-						nextChunk = 0;
-					}
-					if (
-						nextChunk < numChunks
-						&& chunkLengths[nextChunk] == 4
-						&& isalpha(chunks[nextChunk][0])
-						&& isalpha(chunks[nextChunk][1])
-						&& isalpha(chunks[nextChunk][2])
-						&& isalpha(chunks[nextChunk][3])
-					) {
-						result->script = strndup(chunks[nextChunk], chunkLengths[nextChunk]);
-						if (!result->script) {
-							badData = 1;
-						}
-						nextChunk++;
-					} else if(nextChunk == 0) {
-						badData = 1;
-					}
-				}
-				if (!badData && nextChunk < numChunks) {
-					/* Next we may optionally have the region tag */
-					if (chunkLengths[nextChunk] == 2) {
-						/* Region - alpha{2} */
-						if (
-							isalpha(chunks[nextChunk][0])
-							&& isalpha(chunks[nextChunk][1])
-						) {
-							result->territory = strndup(chunks[nextChunk], chunkLengths[nextChunk]);
-						}
-						if (!result->territory) {
-							badData = 1;
-						}
-						nextChunk++;
-					} else if(chunkLengths[nextChunk] == 3) {
-						/* Region - digit{2} */
-						if (
-							isdigit(chunks[nextChunk][0])
-							&& isdigit(chunks[nextChunk][1])
-							&& isdigit(chunks[nextChunk][3])
-						) {
-							result->territory = strndup(chunks[nextChunk], chunkLengths[nextChunk]);
-						}
-						if (!result->territory) {
-							badData = 1;
-						}
-						nextChunk++;
+			switch (separator) {
+				case '\0':
+					chunk = &slices->language;
+					break;
+				case '_':
+					if (slices->territory.length || slices->codeset.length || slices->modifier.length) {
+						/* Duplicated or misplaced territory -> error */
+						return 0;
 					}
-				}
-				if (!badData) {
-					/* Finally we have a variable number of variant tags (alphanum{5,8} or digit+alphanum{3}) ) */
-					initialVariantChunk = nextChunk;
-					while (!badData && nextChunk < numChunks) {
-						switch (chunkLengths[nextChunk]) {
-							case 8:
-								if (!isalnum(chunks[nextChunk][7])) {
-									badData = 1;
-								}
-								/* no break */
-							case 7:
-								if (!isalnum(chunks[nextChunk][6])) {
-									badData = 1;
-								}
-								/* no break */
-							case 6:
-								if (!isalnum(chunks[nextChunk][5])) {
-									badData = 1;
-								}
-								/* no break */
-							case 5:
-								if (!isalnum(chunks[nextChunk][4])) {
-									badData = 1;
-								}
-								if (!badData) {
-
-								}
-								break;
-							case 4:
-								/* digit+alphanum{3} */
-								if (!(
-									isdigit(chunks[nextChunk][0])
-									&& isalnum(chunks[nextChunk][1])
-									&& isalnum(chunks[nextChunk][2])
-									&& isalnum(chunks[nextChunk][3])
-								)) {
-									badData = 1;
-								}
-								break;
-						}
-						nextChunk++;
+					chunk = &slices->territory;
+					break;
+				case '.':
+					if (slices->codeset.length || slices->modifier.length) {
+						/* Duplicated or misplaced codeset -> error */
+						return 0;
 					}
-					if (!badData) {
-						result->variantCount = numChunks - initialVariantChunk;
-						if (result->variantCount) {
-							result->variants = (char**)calloc(result->variantCount, sizeof(char*));
-							if (!result->variants) {
-								badData = 1;
-							} else {
-								for (nextChunk = initialVariantChunk; nextChunk < numChunks; nextChunk++) {
-									result->variants[nextChunk - initialVariantChunk] = strndup(chunks[nextChunk], chunkLengths[nextChunk]);
-									if (!result->variants[nextChunk - initialVariantChunk]) {
-										badData = 1;
-										break;
-									}
-								}
-							}
-						}
-
+					chunk = &slices->codeset;
+					break;
+				default:
+					if (slices->modifier.length) {
+						/* Duplicated modifier -> error */
+						return 0;
 					}
-				}
+					chunk = &slices->modifier;
+					break;
 			}
-			if (badData) {
-				FreeLocaleChunks(result);
-				result = NULL;
+			chunk->start = chunkStart;
+			chunk->length = p - chunkStart;
+			if (p == end) {
+				return 1;
 			}
-			free(chunkLengths);
+			separator = *p;
+			chunkStart = p + 1;
+		} else if (!IsLocaleAlnum(*p)) {
+			/* Invalid character */
+			return 0;
 		}
-		free(chunks);
 	}
+}
 
-	return result;
+/*
+ * Parse a locale identifier in Gettext format (language[_territory][.codeset][@modifier]), allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* GettextLocaleIDToLocaleChunksWithAllocator(const char* locale, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	if (!locale || !ScanGettextLocaleID(locale, strlen(locale), &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
 }
 
 /*
- * Convert a LocaleChunks to the Unicode locale ID format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ).
- * Returns NULL if LocaleChunks is NULL or invalid, or in case of out-of-memory problems.
+ * Parse a locale identifier in Gettext format (language[_territory][.codeset][@modifier]).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
  */
-char* LocaleChunksToUnicodeLocaleID(const LocaleChunks* lc)
+LocaleChunks* GettextLocaleIDToLocaleChunks(const char* locale)
 {
-	char* result;
-	const char* script;
-	size_t length, i;
+	return GettextLocaleIDToLocaleChunksWithAllocator(locale, NULL);
+}
+
+/*
+ * Appends a string to a buffer, truncating it if the buffer is too small.
+ * length is incremented by n in any case.
+ */
+static void AppendToLocaleIDBuffer(char* buffer, size_t size, size_t* length, const char* s, size_t n)
+{
+	size_t available;
+	if (*length + 1 < size) {
+		available = size - 1 - *length;
+		memcpy(buffer + *length, s, n < available ? n : available);
+	}
+	*length += n;
+}
+
+/*
+ * Null-terminates a buffer written with AppendToLocaleIDBuffer.
+ */
+static void TerminateLocaleIDBuffer(char* buffer, size_t size, size_t length)
+{
+	if (size) {
+		buffer[length < size ? length : size - 1] = '\0';
+	}
+}
+
+/*
+ * Sets a slice to a null-terminated string (NULL for an empty slice).
+ */
+static void SetLocaleSlice(LocaleSlice* slice, const char* s)
+{
+	slice->start = s;
+	slice->length = s ? strlen(s) : 0;
+}
+
+/*
+ * Changes the case of a character, if it's a letter.
+ */
+static char ToLowerLocaleChar(char c)
+{
+	return c >= 'A' && c <= 'Z' ? (char)(c + ('a' - 'A')) : c;
+}
+static char ToUpperLocaleChar(char c)
+{
+	return c >= 'a' && c <= 'z' ? (char)(c - ('a' - 'A')) : c;
+}
+
+/*
+ * Reads a chunk of a locale identifier, moving p after the separator that follows it.
+ * The chunks are separated by hyphens or underscores, or only by plus signs if plusSeparated is non-zero.
+ * Returns 0 if the chunk is empty or if it contains invalid characters.
+ */
+static int ReadLocaleIDChunk(const char** p, const char* end, LocaleSlice* chunk, int* isLast, int plusSeparated)
+{
+	const char* q;
+	for (q = *p; q < end && (plusSeparated ? *q != '+' : *q != '-' && *q != '_'); q++) {
+		if (!IsLocaleAlnum(*q)) {
+			/* Invalid character */
+			return 0;
+		}
+	}
+	if (q == *p) {
+		/* Empty chunk */
+		return 0;
+	}
+	chunk->start = *p;
+	chunk->length = q - *p;
+	*isLast = q == end;
+	*p = q == end ? q : q + 1;
+	return 1;
+}
+
+/*
+ * Reads a chunk of a Unicode locale identifier, moving p after the separator that follows it.
+ * Returns 0 if the chunk is empty or if it contains invalid characters.
+ */
+static int ReadUnicodeLocaleIDChunk(const char** p, const char* end, LocaleSlice* chunk, int* isLast)
+{
+	return ReadLocaleIDChunk(p, end, chunk, isLast, 0);
+}
+
+/*
+ * Checks if a slice is equal to a null-terminated string (case-insensitive).
+ */
+static int IsLocaleSliceEqual(const LocaleSlice* slice, const char* s)
+{
+	return strlen(s) == slice->length && !CompareLocaleStringsIgnoringCase(slice->start, s, slice->length);
+}
+
+/*
+ * Map from ICU keyword names to the keys of the BCP 47 Unicode locale extension.
+ * Source: https://github.com/unicode-org/cldr/tree/main/common/bcp47
+ */
+static const char* ICUKeywordDictionary[][2] = {
+	{"calendar", "ca"},
+	{"colalternate", "ka"},
+	{"colbackwards", "kb"},
+	{"colcasefirst", "kf"},
+	{"colcaselevel", "kc"},
+	{"collation", "co"},
+	{"colnormalization", "kk"},
+	{"colnumeric", "kn"},
+	{"colreorder", "kr"},
+	{"colstrength", "ks"},
+	{"currency", "cu"},
+	{"em", "em"},
+	{"fw", "fw"},
+	{"hours", "hc"},
+	{"lb", "lb"},
+	{"lw", "lw"},
+	{"measure", "ms"},
+	{"numbers", "nu"},
+	{"ss", "ss"},
+	{"timezone", "tz"},
+	{NULL, NULL}
+};
+
+/*
+ * Map from ICU keyword values to the values of the BCP 47 Unicode locale extension, for the keys where they differ.
+ * Every row is: BCP 47 key, ICU value, BCP 47 value.
+ */
+static const char* ICUKeywordValueDictionary[][3] = {
+	{"ca", "ethiopic-amete-alem", "ethioaa"},
+	{"ca", "gregorian", "gregory"},
+	{"co", "dictionary", "dict"},
+	{"co", "gb2312han", "gb2312"},
+	{"co", "phonebook", "phonebk"},
+	{"co", "traditional", "trad"},
+	{"kb", "no", "false"},
+	{"kb", "yes", "true"},
+	{"kc", "no", "false"},
+	{"kc", "yes", "true"},
+	{"kk", "no", "false"},
+	{"kk", "yes", "true"},
+	{"kn", "no", "false"},
+	{"kn", "yes", "true"},
+	{"ks", "identical", "identic"},
+	{"ks", "primary", "level1"},
+	{"ks", "quaternary", "level4"},
+	{"ks", "secondary", "level2"},
+	{"ks", "tertiary", "level3"},
+	{"ms", "imperial", "uksystem"},
+	{NULL, NULL, NULL}
+};
+
+/*
+ * Looks for a row of ICUKeywordValueDictionary.
+ * If fromICU is non-zero, value is an ICU value and the BCP 47 value is returned, otherwise the ICU value is returned.
+ * Returns NULL if no correspondance has been found (the value is the same in both formats).
+ */
+static const char* TranslateICUKeywordValue(const LocaleSlice* key, const LocaleSlice* value, int fromICU)
+{
+	size_t p;
+	for (p = 0; ICUKeywordValueDictionary[p][0]; p++) {
+		if (IsLocaleSliceEqual(key, ICUKeywordValueDictionary[p][0]) && IsLocaleSliceEqual(value, ICUKeywordValueDictionary[p][fromICU ? 1 : 2])) {
+			return ICUKeywordValueDictionary[p][fromICU ? 2 : 1];
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Output formats of WriteLocaleChunks and FormatLocaleChunks.
+ */
+/* Gettext format: language[_territory][.codeset][@modifier] */
+#define LOCALE_FORMAT_GETTEXT 0
+/* Unicode format, with underscores: language[_Script][_TERRITORY][_VARIANT]... */
+#define LOCALE_FORMAT_UNICODE 1
+/* BCP 47 format, with hyphens: language[-Script][-TERRITORY][-variant]... ("und" for the Unicode root) */
+#define LOCALE_FORMAT_BCP47 2
+/* Java format (see java.util.Locale.toString()): language[_TERRITORY][_variant]...[_#Script][_extensions], for example "sr_RS_#Latn" */
+#define LOCALE_FORMAT_JAVA 3
+/* ICU format: language[_Script][_TERRITORY][_VARIANT]...[@keyword=value;...], for example "de_DE@collation=phonebook" */
+#define LOCALE_FORMAT_ICU 4
+/* Android resource qualifier: language[-rTERRITORY], or b+language[+Script][+TERRITORY][+variant]... when needed (for example "zh-rTW" or "b+sr+Latn") */
+#define LOCALE_FORMAT_ANDROID 5
+/* Apple localization directory name (without ".lproj"): language[-Script][-TERRITORY][-variant]..., for example "zh-Hans" or "pt-BR" */
+#define LOCALE_FORMAT_APPLE 6
+/* Mask of the above format identifiers */
+#define LOCALE_FORMAT_MASK 0x0f
+/* Flag: use the canonical case instead of the original one (for example "sr_Latn_RS" for "SR-latn-rs") */
+#define LOCALE_FORMAT_CANONICAL_CASE 0x10
+
+/*
+ * Receives the pieces of a locale identifier written by WriteLocaleChunks (s is not null-terminated).
+ */
+typedef void (*LocaleIDWriter)(void* userData, const char* s, size_t length);
+
+/*
+ * Case conversions of the pieces of a locale identifier.
+ */
+#define LOCALE_CASE_VERBATIM 0
+#define LOCALE_CASE_LOWER 1
+#define LOCALE_CASE_TITLE 2
+#define LOCALE_CASE_UPPER 3
+
+/*
+ * Writes a piece of a locale identifier, converting its case if needed.
+ * Returns the number of written characters.
+ */
+static size_t WriteLocaleIDPiece(LocaleIDWriter writer, void* userData, const char* s, size_t length, int caseMode)
+{
+	char converted[32];
+	size_t done, n, i;
+	if (!length) {
+		/* Empty pieces may have a NULL pointer */
+		return 0;
+	}
+	if (caseMode == LOCALE_CASE_VERBATIM) {
+		writer(userData, s, length);
+		return length;
+	}
+	/* Convert the case in small blocks on the stack */
+	for (done = 0; done < length; done += n) {
+		n = length - done < sizeof(converted) ? length - done : sizeof(converted);
+		for (i = 0; i < n; i++) {
+			if (caseMode == LOCALE_CASE_UPPER || (caseMode == LOCALE_CASE_TITLE && done + i == 0)) {
+				converted[i] = ToUpperLocaleChar(s[done + i]);
+			} else {
+				converted[i] = ToLowerLocaleChar(s[done + i]);
+			}
+		}
+		writer(userData, converted, n);
+	}
+	return length;
+}
+
+/*
+ * Looks for a script or for a modifier in the dictionary, given a not null-terminated slice.
+ * Returns NULL if the slice is empty or if no correspondance has been found.
+ */
+static const char* TranslateLocaleSlice(const LocaleSlice* slice, int toScript)
+{
+	char s[32];
+	if (!slice->length || slice->length >= sizeof(s)) {
+		return NULL;
+	}
+	memcpy(s, slice->start, slice->length);
+	s[slice->length] = '\0';
+	return toScript ? GettextModifierToUnicodeScript(s) : UnicodeScriptToGettextModifier(s);
+}
+
+/*
+ * Writes the variants of a locale identifier, each one preceded by a separator.
+ * If variants is NULL, the variants are taken from the variants slice.
+ * Returns the number of written characters.
+ */
+static size_t WriteLocaleIDVariants(const LocaleChunkSlices* slices, char* const* variants, const char* separator, int caseMode, LocaleIDWriter writer, void* userData)
+{
+	LocaleSlice variant;
+	const char *p, *end;
+	size_t length, i;
+	length = 0;
+	p = slices->variants.start;
+	end = p + slices->variants.length;
+	for (i = 0; i < slices->variantCount; i++) {
+		if (variants) {
+			SetLocaleSlice(&variant, variants[i]);
+		} else {
+			for (variant.start = p; p < end && !IsLocaleIDTagSeparator(*p); p++);
+			variant.length = p - variant.start;
+			p++;
+		}
+		length += WriteLocaleIDPiece(writer, userData, separator, 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, variant.start, variant.length, caseMode);
+	}
+	return length;
+}
+
+/*
+ * Writes the tags of a slice (separated by hyphens or underscores), using a specific separator between them.
+ * Returns the number of written characters.
+ */
+static size_t WriteLocaleIDTags(const LocaleSlice* tags, const char* separator, int caseMode, LocaleIDWriter writer, void* userData)
+{
+	const char *p, *end, *start;
+	size_t length;
+	length = 0;
+	end = tags->start + tags->length;
+	for (p = tags->start; p < end; p++) {
+		for (start = p; p < end && !IsLocaleIDTagSeparator(*p); p++);
+		if (start != tags->start) {
+			length += WriteLocaleIDPiece(writer, userData, separator, 1, LOCALE_CASE_VERBATIM);
+		}
+		length += WriteLocaleIDPiece(writer, userData, start, p - start, caseMode);
+	}
+	return length;
+}
+
+/*
+ * Maximum number of keywords written in ICU locale IDs (the other ones are ignored).
+ */
+#define ICU_LOCALE_MAX_KEYWORDS 16
+
+/*
+ * Compares the names of two ICU keywords (case-insensitive).
+ */
+static int CompareICUKeywordNames(const LocaleSlice* a, const LocaleSlice* b)
+{
+	size_t i;
+	char ca, cb;
+	for (i = 0; i < a->length && i < b->length; i++) {
+		ca = ToLowerLocaleChar(a->start[i]);
+		cb = ToLowerLocaleChar(b->start[i]);
+		if (ca != cb) {
+			return ca < cb ? -1 : 1;
+		}
+	}
+	return a->length == b->length ? 0 : (a->length < b->length ? -1 : 1);
+}
+
+/*
+ * Writes the extensions of a locale identifier as ICU keywords (for example "@calendar=japanese;x=foo").
+ * The keys of the Unicode locale extension are mapped to the ICU keyword names, the other extensions use their singleton as the name.
+ * Returns the number of written characters.
+ */
+static size_t WriteICULocaleKeywords(const LocaleSlice* extensions, LocaleIDWriter writer, void* userData)
+{
+	struct {
+		LocaleSlice key;
+		LocaleSlice name;
+		LocaleSlice value;
+	} keywords[ICU_LOCALE_MAX_KEYWORDS], keyword;
+	const char *p, *end;
+	const char* translated;
+	LocaleSlice chunk;
+	size_t count, length, i, j;
+	int isLast, inKeyword, plusSeparated;
+	char singleton;
+	plusSeparated = memchr(extensions->start, '+', extensions->length) != NULL;
+	count = 0;
+	singleton = '\0';
+	inKeyword = 0;
+	p = extensions->start;
+	end = p + extensions->length;
+	while (p < end && ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated)) {
+		if (chunk.length == 1 && singleton != 'x') {
+			singleton = ToLowerLocaleChar(*chunk.start);
+			/* Every extension but the Unicode one becomes a keyword named after its singleton */
+			inKeyword = singleton != 'u';
+		} else if (singleton == 'u' && chunk.length == 2) {
+			/* A key of the Unicode locale extension */
+			inKeyword = 1;
+		} else if (inKeyword && count) {
+			/* A value: it spans all the tags up to the next key or singleton */
+			if (!keywords[count - 1].value.length) {
+				keywords[count - 1].value.start = chunk.start;
+			}
+			keywords[count - 1].value.length = chunk.start + chunk.length - keywords[count - 1].value.start;
+			continue;
+		} else {
+			/* An attribute of the Unicode locale extension: ICU doesn't support them */
+			continue;
+		}
+		if (inKeyword && count < ICU_LOCALE_MAX_KEYWORDS) {
+			keywords[count].key = chunk;
+			keywords[count].name = chunk;
+			keywords[count].value.start = NULL;
+			keywords[count].value.length = 0;
+			if (singleton == 'u') {
+				for (i = 0; ICUKeywordDictionary[i][0]; i++) {
+					if (IsLocaleSliceEqual(&chunk, ICUKeywordDictionary[i][1])) {
+						SetLocaleSlice(&keywords[count].name, ICUKeywordDictionary[i][0]);
+						break;
+					}
+				}
+			}
+			count++;
+		} else {
+			inKeyword = 0;
+		}
+	}
+	/* ICU keywords are sorted by name */
+	for (i = 1; i < count; i++) {
+		keyword = keywords[i];
+		for (j = i; j > 0 && CompareICUKeywordNames(&keywords[j - 1].name, &keyword.name) > 0; j--) {
+			keywords[j] = keywords[j - 1];
+		}
+		keywords[j] = keyword;
+	}
+	length = 0;
+	for (i = 0; i < count; i++) {
+		length += WriteLocaleIDPiece(writer, userData, i ? ";" : "@", 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, keywords[i].name.start, keywords[i].name.length, LOCALE_CASE_LOWER);
+		length += WriteLocaleIDPiece(writer, userData, "=", 1, LOCALE_CASE_VERBATIM);
+		if (!keywords[i].value.length) {
+			/* A key of the Unicode locale extension without value means "true" */
+			SetLocaleSlice(&keywords[i].value, "true");
+		}
+		translated = keywords[i].key.length == 2 ? TranslateICUKeywordValue(&keywords[i].key, &keywords[i].value, 0) : NULL;
+		if (translated) {
+			length += WriteLocaleIDPiece(writer, userData, translated, strlen(translated), LOCALE_CASE_VERBATIM);
+		} else {
+			length += WriteLocaleIDTags(&keywords[i].value, "-", LOCALE_CASE_LOWER, writer, userData);
+		}
+	}
+	return length;
+}
+
+/*
+ * Writes the chunks of a locale identifier in the Java format (see java.util.Locale.toString()).
+ * Returns the length of the whole locale ID, or 0 if the chunks can't be represented in the Java format.
+ */
+static size_t WriteJavaLocaleIDChunks(const LocaleChunkSlices* slices, const LocaleSlice* script, char* const* variants, int canonical, LocaleIDWriter writer, void* userData)
+{
+	size_t length;
+	/* Java doesn't write anything if both the language and the country are missing */
+	if (!slices->language.length && !slices->territory.length) {
+		return 0;
+	}
+	length = WriteLocaleIDPiece(writer, userData, slices->language.start, slices->language.length, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM);
+	if (slices->territory.length || (slices->language.length && (slices->variantCount || script->length || slices->extensions.length))) {
+		length += WriteLocaleIDPiece(writer, userData, "_", 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, slices->territory.start, slices->territory.length, canonical ? LOCALE_CASE_UPPER : LOCALE_CASE_VERBATIM);
+	}
+	length += WriteLocaleIDVariants(slices, variants, "_", LOCALE_CASE_VERBATIM, writer, userData);
+	if (script->length) {
+		length += WriteLocaleIDPiece(writer, userData, "_#", 2, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, script->start, script->length, canonical ? LOCALE_CASE_TITLE : LOCALE_CASE_VERBATIM);
+	}
+	if (slices->extensions.length) {
+		length += WriteLocaleIDPiece(writer, userData, script->length ? "_" : "_#", script->length ? 1 : 2, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDTags(&slices->extensions, "-", canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM, writer, userData);
+	}
+	return length;
+}
+
+/*
+ * Writes the chunks of a locale identifier as an Android resource qualifier.
+ * The legacy form (for example "zh-rTW") is used when possible, the BCP 47 form (for example "b+sr+Latn") otherwise.
+ * Returns the length of the whole locale ID, or 0 if the chunks can't be represented as an Android resource qualifier.
+ */
+static size_t WriteAndroidLocaleIDChunks(const LocaleChunkSlices* slices, const LocaleSlice* script, char* const* variants, int canonical, LocaleIDWriter writer, void* userData)
+{
+	size_t length;
+	if (!slices->language.length) {
+		return 0;
+	}
+	if (!script->length && !slices->variantCount && !slices->extensions.length && slices->territory.length != 3) {
+		length = WriteLocaleIDPiece(writer, userData, slices->language.start, slices->language.length, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM);
+		if (slices->territory.length) {
+			length += WriteLocaleIDPiece(writer, userData, "-r", 2, LOCALE_CASE_VERBATIM);
+			length += WriteLocaleIDPiece(writer, userData, slices->territory.start, slices->territory.length, canonical ? LOCALE_CASE_UPPER : LOCALE_CASE_VERBATIM);
+		}
+		return length;
+	}
+	length = WriteLocaleIDPiece(writer, userData, "b+", 2, LOCALE_CASE_VERBATIM);
+	length += WriteLocaleIDPiece(writer, userData, slices->language.start, slices->language.length, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM);
+	if (script->length) {
+		length += WriteLocaleIDPiece(writer, userData, "+", 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, script->start, script->length, canonical ? LOCALE_CASE_TITLE : LOCALE_CASE_VERBATIM);
+	}
+	if (slices->territory.length) {
+		length += WriteLocaleIDPiece(writer, userData, "+", 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, slices->territory.start, slices->territory.length, canonical ? LOCALE_CASE_UPPER : LOCALE_CASE_VERBATIM);
+	}
+	length += WriteLocaleIDVariants(slices, variants, "+", canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM, writer, userData);
+	if (slices->extensions.length) {
+		length += WriteLocaleIDPiece(writer, userData, "+", 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDTags(&slices->extensions, "+", canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM, writer, userData);
+	}
+	return length;
+}
+
+/*
+ * Writes the chunks of a locale identifier.
+ * If variants is NULL, the variants are taken from the variants slice.
+ * Returns the length of the whole locale ID, or 0 if the chunks can't be represented in the requested format.
+ */
+static size_t WriteLocaleIDChunks(const LocaleChunkSlices* slices, char* const* variants, unsigned int format, LocaleIDWriter writer, void* userData)
+{
+	LocaleSlice script, modifier;
+	const char* separator;
+	size_t length;
+	int canonical, isICU;
+	canonical = (format & LOCALE_FORMAT_CANONICAL_CASE) != 0;
+	format &= LOCALE_FORMAT_MASK;
+	length = 0;
+	if (format == LOCALE_FORMAT_GETTEXT) {
+		if (!slices->language.length) {
+			return 0;
+		}
+		modifier = slices->modifier;
+		if (!modifier.length) {
+			SetLocaleSlice(&modifier, TranslateLocaleSlice(&slices->script, 0));
+		}
+		length += WriteLocaleIDPiece(writer, userData, slices->language.start, slices->language.length, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM);
+		if (slices->territory.length) {
+			length += WriteLocaleIDPiece(writer, userData, "_", 1, LOCALE_CASE_VERBATIM);
+			length += WriteLocaleIDPiece(writer, userData, slices->territory.start, slices->territory.length, canonical ? LOCALE_CASE_UPPER : LOCALE_CASE_VERBATIM);
+		}
+		if (slices->codeset.length) {
+			length += WriteLocaleIDPiece(writer, userData, ".", 1, LOCALE_CASE_VERBATIM);
+			length += WriteLocaleIDPiece(writer, userData, slices->codeset.start, slices->codeset.length, LOCALE_CASE_VERBATIM);
+		}
+		if (modifier.length) {
+			length += WriteLocaleIDPiece(writer, userData, "@", 1, LOCALE_CASE_VERBATIM);
+			length += WriteLocaleIDPiece(writer, userData, modifier.start, modifier.length, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM);
+		}
+		return length;
+	}
+	script = slices->script;
+	if (!script.length) {
+		SetLocaleSlice(&script, TranslateLocaleSlice(&slices->modifier, 1));
+	}
+	if (format == LOCALE_FORMAT_JAVA) {
+		return WriteJavaLocaleIDChunks(slices, &script, variants, canonical, writer, userData);
+	}
+	if (format == LOCALE_FORMAT_ANDROID) {
+		return WriteAndroidLocaleIDChunks(slices, &script, variants, canonical, writer, userData);
+	}
+	if (format == LOCALE_FORMAT_APPLE) {
+		/* Apple uses BCP 47 tags, but it requires a language and it doesn't support the extensions */
+		if (!slices->language.length) {
+			return 0;
+		}
+	}
+	if (!(slices->isRoot || slices->language.length || script.length)) {
+		return 0;
+	}
+	isICU = format == LOCALE_FORMAT_ICU;
+	separator = format == LOCALE_FORMAT_BCP47 || format == LOCALE_FORMAT_APPLE ? "-" : "_";
+	if (slices->isRoot) {
+		length += WriteLocaleIDPiece(writer, userData, *separator == '-' ? "und" : "root", *separator == '-' ? 3 : 4, LOCALE_CASE_VERBATIM);
+	} else {
+		if (slices->language.length) {
+			length += WriteLocaleIDPiece(writer, userData, slices->language.start, slices->language.length, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM);
+		}
+		if (script.length) {
+			if (length || isICU) {
+				length += WriteLocaleIDPiece(writer, userData, separator, 1, LOCALE_CASE_VERBATIM);
+			}
+			length += WriteLocaleIDPiece(writer, userData, script.start, script.length, canonical ? LOCALE_CASE_TITLE : LOCALE_CASE_VERBATIM);
+		}
+	}
+	if (slices->territory.length || (isICU && slices->variantCount)) {
+		/* ICU keeps an empty territory before the variants (for example "en__POSIX") */
+		length += WriteLocaleIDPiece(writer, userData, separator, 1, LOCALE_CASE_VERBATIM);
+		length += WriteLocaleIDPiece(writer, userData, slices->territory.start, slices->territory.length, canonical ? LOCALE_CASE_UPPER : LOCALE_CASE_VERBATIM);
+	}
+	/* Variants are uppercase in Unicode IDs, lowercase in BCP 47 */
+	length += WriteLocaleIDVariants(slices, variants, separator, canonical ? (*separator == '-' ? LOCALE_CASE_LOWER : LOCALE_CASE_UPPER) : LOCALE_CASE_VERBATIM, writer, userData);
+	if (slices->extensions.length && format != LOCALE_FORMAT_APPLE) {
+		if (isICU) {
+			length += WriteICULocaleKeywords(&slices->extensions, writer, userData);
+		} else {
+			length += WriteLocaleIDPiece(writer, userData, separator, 1, LOCALE_CASE_VERBATIM);
+			length += WriteLocaleIDTags(&slices->extensions, separator, canonical ? LOCALE_CASE_LOWER : LOCALE_CASE_VERBATIM, writer, userData);
+		}
+	}
+	return length;
+}
+
+/*
+ * Writes the result of a scan in a specific format (LOCALE_FORMAT_... constants), piece by piece, without allocating anything.
+ * Returns the length of the whole locale ID, or 0 if the chunks can't be represented in the requested format.
+ */
+size_t WriteLocaleChunkSlices(const LocaleChunkSlices* slices, unsigned int format, LocaleIDWriter writer, void* userData)
+{
+	return WriteLocaleIDChunks(slices, NULL, format, writer, userData);
+}
+
+/*
+ * Writes a LocaleChunks in a specific format (LOCALE_FORMAT_... constants), piece by piece, without allocating anything.
+ * Returns the length of the whole locale ID, or 0 if lc is NULL or if it can't be represented in the requested format.
+ */
+size_t WriteLocaleChunks(const LocaleChunks* lc, unsigned int format, LocaleIDWriter writer, void* userData)
+{
+	LocaleChunkSlices slices;
+	if (!lc) {
+		return 0;
+	}
+	memset(&slices, 0, sizeof(slices));
+	slices.isRoot = lc->isRoot;
+	SetLocaleSlice(&slices.language, lc->language);
+	SetLocaleSlice(&slices.territory, lc->territory);
+	SetLocaleSlice(&slices.codeset, lc->codeset);
+	/* The derived script and modifier avoid looking up the dictionary every time */
+	SetLocaleSlice(&slices.modifier, GetLocaleChunksGettextModifier(lc));
+	SetLocaleSlice(&slices.script, GetLocaleChunksUnicodeScript(lc));
+	SetLocaleSlice(&slices.extensions, lc->extensions);
+	slices.variantCount = lc->variantCount;
+	return WriteLocaleIDChunks(&slices, lc->variants, format, writer, userData);
+}
+
+/*
+ * The destination of a LocaleIDWriter that writes to a buffer.
+ */
+typedef struct _LocaleIDBufferWriter {
+	char* buffer;
+	size_t size;
+	size_t length;
+} LocaleIDBufferWriter;
+
+static void WriteLocaleIDToBuffer(void* userData, const char* s, size_t length)
+{
+	LocaleIDBufferWriter* destination;
+	destination = (LocaleIDBufferWriter*)userData;
+	AppendToLocaleIDBuffer(destination->buffer, destination->size, &destination->length, s, length);
+}
+
+/*
+ * Write the result of a scan in a specific format (LOCALE_FORMAT_... constants) to a buffer.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if the chunks can't be represented in the requested format.
+ */
+size_t FormatLocaleChunkSlices(const LocaleChunkSlices* slices, unsigned int format, char* buffer, size_t size)
+{
+	LocaleIDBufferWriter destination;
+	destination.buffer = buffer;
+	destination.size = size;
+	destination.length = 0;
+	WriteLocaleChunkSlices(slices, format, WriteLocaleIDToBuffer, &destination);
+	TerminateLocaleIDBuffer(buffer, size, destination.length);
+	return destination.length;
+}
+
+/*
+ * Write a LocaleChunks in a specific format (LOCALE_FORMAT_... constants) to a buffer.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if lc is NULL or if it can't be represented in the requested format.
+ */
+size_t FormatLocaleChunks(const LocaleChunks* lc, unsigned int format, char* buffer, size_t size)
+{
+	LocaleIDBufferWriter destination;
+	destination.buffer = buffer;
+	destination.size = size;
+	destination.length = 0;
+	WriteLocaleChunks(lc, format, WriteLocaleIDToBuffer, &destination);
+	TerminateLocaleIDBuffer(buffer, size, destination.length);
+	return destination.length;
+}
+
+static void WriteLocaleIDToStream(void* userData, const char* s, size_t length)
+{
+	fwrite(s, 1, length, (FILE*)userData);
+}
+
+/*
+ * Print a LocaleChunks in a specific format (LOCALE_FORMAT_... constants) to a stream, without allocating anything.
+ * Returns the number of written characters.
+ */
+size_t FPrintLocaleChunks(FILE* stream, const LocaleChunks* lc, unsigned int format)
+{
+	return WriteLocaleChunks(lc, format, WriteLocaleIDToStream, stream);
+}
+
+/*
+ * Write a LocaleChunks in the Gettext locale ID format (language[_territory][.codeset][@modifier]) to a buffer.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if LocaleChunks is NULL or invalid.
+ */
+size_t LocaleChunksToGettextLocaleIDBuffer(const LocaleChunks* lc, char* buffer, size_t size)
+{
+	return FormatLocaleChunks(lc, LOCALE_FORMAT_GETTEXT, buffer, size);
+}
+
+/*
+ * Convert a LocaleChunks to the Gettext locale ID format (language[_territory][.codeset][@modifier]), allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if LocaleChunks is NULL or invalid, or in case of out-of-memory problems.
+ */
+char* LocaleChunksToGettextLocaleIDWithAllocator(const LocaleChunks* lc, const LocaleAllocator* allocator)
+{
+	char* result;
+	size_t length;
 	result = NULL;
-	script = lc ? (lc->script ? lc->script : GettextModifierToUnicodeScript(lc->modifier)) : NULL;
-	if (lc && (lc->isRoot || lc->language || script)) {
-		length = 1;
-		if (lc->isRoot) {
-			length += 4; /* strlen("root"); */
-		} else if (lc->language && script) {
-			length += strlen(lc->language) + 1 + strlen(script);
+	length = LocaleChunksToGettextLocaleIDBuffer(lc, NULL, 0);
+	if (length) {
+		result = (char*)LocaleAllocate(allocator, (length + 1) * sizeof(char));
+		if (result) {
+			LocaleChunksToGettextLocaleIDBuffer(lc, result, length + 1);
+		}
+	}
+	return result;
+}
+
+/*
+ * Convert a LocaleChunks to the Gettext locale ID format (language[_territory][.codeset][@modifier]).
+ * Returns NULL if LocaleChunks is NULL or invalid, or in case of out-of-memory problems.
+ */
+char * LocaleChunksToGettextLocaleID(const LocaleChunks* lc)
+{
+	return LocaleChunksToGettextLocaleIDWithAllocator(lc, NULL);
+}
+
+/*
+ * Checks if all the characters of a slice are letters.
+ */
+static int IsAlphaLocaleSlice(const LocaleSlice* slice)
+{
+	size_t i;
+	for (i = 0; i < slice->length; i++) {
+		if (!IsLocaleAlpha(slice->start[i])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Checks if all the characters of a slice are digits.
+ */
+static int IsDigitLocaleSlice(const LocaleSlice* slice)
+{
+	size_t i;
+	for (i = 0; i < slice->length; i++) {
+		if (!IsLocaleDigit(slice->start[i])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Checks if all the characters of a slice are letters or digits.
+ */
+static int IsAlphanumericLocaleSlice(const LocaleSlice* slice)
+{
+	size_t i;
+	for (i = 0; i < slice->length; i++) {
+		if (!IsLocaleAlnum(slice->start[i])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Checks if a slice is a valid variant: alphanumeric, 5 to 8 characters, or 4 characters starting with a digit (like "POSIX" or "1901").
+ */
+static int IsLocaleVariantSlice(const LocaleSlice* slice)
+{
+	if (slice->length < 4 || slice->length > 8 || !IsAlphanumericLocaleSlice(slice)) {
+		return 0;
+	}
+	return slice->length != 4 || IsLocaleDigit(slice->start[0]);
+}
+
+/*
+ * Checks a sequence of BCP 47 extensions (for example "u-ca-japanese-x-foo"), storing it in a slice.
+ * Every extension starts with a singleton and has at least one tag (alphanum{2,8}, or alphanum{1,8} for private use).
+ * Returns 1 if the extensions are valid, 0 otherwise.
+ */
+static int ScanLocaleIDExtensions(const char* extensions, size_t length, int plusSeparated, LocaleSlice* slice)
+{
+	const char *p, *end;
+	LocaleSlice chunk;
+	int isLast, tags, isPrivate;
+	p = extensions;
+	end = extensions + length;
+	tags = -1;
+	isPrivate = 0;
+	do {
+		if (!ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated) || chunk.length > 8) {
+			return 0;
+		}
+		if (chunk.length == 1 && !isPrivate) {
+			/* A new singleton: the previous extension (if any) must have at least one tag */
+			if (tags == 0) {
+				return 0;
+			}
+			isPrivate = *chunk.start == 'x' || *chunk.start == 'X';
+			tags = 0;
+		} else if (tags < 0 || (chunk.length == 1 && !isPrivate)) {
+			return 0;
+		} else {
+			tags++;
+		}
+	} while (!isLast);
+	if (tags <= 0) {
+		return 0;
+	}
+	slice->start = extensions;
+	slice->length = length;
+	return 1;
+}
+
+/*
+ * Scan the tags of a locale identifier in Unicode format, separated by hyphens or underscores, or only by plus signs if plusSeparated is non-zero.
+ */
+static int ScanLocaleIDTags(const char* locale, size_t length, int plusSeparated, LocaleChunkSlices* slices)
+{
+	const char *p, *end;
+	LocaleSlice chunk;
+	int isLast, pending;
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale) {
+		return 0;
+	}
+	pending = 0;
+	p = locale;
+	end = locale + length;
+	if (!ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated)) {
+		return 0;
+	}
+	if (chunk.length == 4 && !strncmp("root", chunk.start, 4)) {
+		/* First chunk: "root" */
+		slices->isRoot = 1;
+	} else {
+		/* First chunks: language and/or script */
+		if (chunk.length >= 2 && chunk.length <= 3) {
+			/* language - alpha{2,3} */
+			if (!IsAlphaLocaleSlice(&chunk)) {
+				return 0;
+			}
+			slices->language = chunk;
+			if (isLast) {
+				return 1;
+			}
+			if (!ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated)) {
+				return 0;
+			}
+		}
+		if (chunk.length == 4 && IsAlphaLocaleSlice(&chunk)) {
+			/* script - alpha{4} */
+			slices->script = chunk;
+		} else if (!slices->language.length) {
+			return 0;
+		} else {
+			/* This chunk is not a script: let's check it as a region */
+			pending = 1;
+		}
+	}
+	if (!pending) {
+		if (isLast) {
+			return 1;
+		}
+		if (!ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated)) {
+			return 0;
+		}
+	}
+	/* Next we may optionally have the region tag */
+	if (chunk.length == 2 || chunk.length == 3) {
+		/* Region - alpha{2} or digit{3} */
+		if (!(chunk.length == 2 ? IsAlphaLocaleSlice(&chunk) : IsDigitLocaleSlice(&chunk))) {
+			return 0;
+		}
+		slices->territory = chunk;
+		if (isLast) {
+			return 1;
+		}
+		if (!ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated)) {
+			return 0;
+		}
+	}
+	/* Then we have a variable number of variant tags (alphanum{5,8} or digit+alphanum{3}) ) */
+	slices->variants.start = chunk.start;
+	while (chunk.length != 1) {
+		if (!IsLocaleVariantSlice(&chunk)) {
+			return 0;
+		}
+		slices->variantCount++;
+		slices->variants.length = chunk.start + chunk.length - slices->variants.start;
+		if (isLast) {
+			return 1;
+		}
+		if (!ReadLocaleIDChunk(&p, end, &chunk, &isLast, plusSeparated)) {
+			return 0;
+		}
+	}
+	/* Finally we may have extensions, each one starting with a singleton followed by alphanum{2,8} tags */
+	return ScanLocaleIDExtensions(chunk.start, end - chunk.start, plusSeparated, &slices->extensions);
+}
+
+/*
+ * Scan a locale identifier in Unicode format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ).
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise.
+ */
+int ScanUnicodeLocaleID(const char* locale, size_t length, LocaleChunkSlices* slices)
+{
+	return ScanLocaleIDTags(locale, length, 0, slices);
+}
+
+/*
+ * Parse a locale identifier in Unicode format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ), allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* UnicodeLocaleIDToLocaleChunksWithAllocator(const char* locale, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	if (!locale || !ScanUnicodeLocaleID(locale, strlen(locale), &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Parse a locale identifier in Gettext format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* UnicodeLocaleIDToLocaleChunks(const char* locale)
+{
+	return UnicodeLocaleIDToLocaleChunksWithAllocator(locale, NULL);
+}
+
+/*
+ * Write a LocaleChunks in the Unicode locale ID format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ) to a buffer.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if LocaleChunks is NULL or invalid.
+ */
+size_t LocaleChunksToUnicodeLocaleIDBuffer(const LocaleChunks* lc, char* buffer, size_t size)
+{
+	return FormatLocaleChunks(lc, LOCALE_FORMAT_UNICODE, buffer, size);
+}
+
+/*
+ * Convert a LocaleChunks to the Unicode locale ID format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ), allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if LocaleChunks is NULL or invalid, or in case of out-of-memory problems.
+ */
+char* LocaleChunksToUnicodeLocaleIDWithAllocator(const LocaleChunks* lc, const LocaleAllocator* allocator)
+{
+	char* result;
+	size_t length;
+	result = NULL;
+	length = LocaleChunksToUnicodeLocaleIDBuffer(lc, NULL, 0);
+	if (length) {
+		result = (char*)LocaleAllocate(allocator, (length + 1) * sizeof(char));
+		if (result) {
+			LocaleChunksToUnicodeLocaleIDBuffer(lc, result, length + 1);
+		}
+	}
+	return result;
+}
+
+/*
+ * Convert a LocaleChunks to the Unicode locale ID format ( http://unicode.org/reports/tr35/#Unicode_language_identifier ).
+ * Returns NULL if LocaleChunks is NULL or invalid, or in case of out-of-memory problems.
+ */
+char* LocaleChunksToUnicodeLocaleID(const LocaleChunks* lc)
+{
+	return LocaleChunksToUnicodeLocaleIDWithAllocator(lc, NULL);
+}
+
+/*
+ * Gets a cached identifier of a LocaleChunks, computing it if it's not cached yet.
+ * When more threads compute it at the same time, only the first one is stored (the others are released).
+ */
+static const char* GetCachedLocaleID(const LocaleChunks* lc, char** cache, unsigned int format)
+{
+	char *cached, *formatted;
+	size_t length;
+	cached = LoadLocaleIDCache(cache);
+	if (!cached) {
+		length = FormatLocaleChunks(lc, format, NULL, 0);
+		if (!length) {
+			formatted = LocaleIDCacheUnrepresentable;
+		} else {
+			formatted = (char*)LocaleAllocate(lc->allocator, length + 1);
+			if (!formatted) {
+				return NULL;
+			}
+			FormatLocaleChunks(lc, format, formatted, length + 1);
+		}
+		if (CompareAndSwapLocaleIDCache(cache, NULL, formatted)) {
+			cached = formatted;
+		} else {
+			if (formatted != LocaleIDCacheUnrepresentable) {
+				LocaleRelease(lc->allocator, formatted);
+			}
+			cached = LoadLocaleIDCache(cache);
+		}
+	}
+	return cached == LocaleIDCacheUnrepresentable ? NULL : cached;
+}
+
+/*
+ * Gets the canonical Gettext locale ID of a LocaleChunks (for example "sr_RS@latin"), computing it only the first time.
+ * The result is owned by lc: it's valid until lc is freed or InvalidateLocaleChunksCache is called. It can be called by more threads at the same time.
+ * Returns NULL if lc is NULL, if it can't be represented in the Gettext format, or in case of out-of-memory problems.
+ */
+const char* GetCachedGettextLocaleID(const LocaleChunks* lc)
+{
+	if (!lc) {
+		return NULL;
+	}
+	/* The cache is not part of the logical value of lc */
+	return GetCachedLocaleID(lc, &((LocaleChunks*)lc)->cachedGettextID, LOCALE_FORMAT_GETTEXT | LOCALE_FORMAT_CANONICAL_CASE);
+}
+
+/*
+ * Gets the canonical Unicode locale ID of a LocaleChunks (for example "sr_Latn_RS"), computing it only the first time.
+ * The result is owned by lc: it's valid until lc is freed or InvalidateLocaleChunksCache is called. It can be called by more threads at the same time.
+ * Returns NULL if lc is NULL, if it can't be represented in the Unicode format, or in case of out-of-memory problems.
+ */
+const char* GetCachedUnicodeLocaleID(const LocaleChunks* lc)
+{
+	if (!lc) {
+		return NULL;
+	}
+	/* The cache is not part of the logical value of lc */
+	return GetCachedLocaleID(lc, &((LocaleChunks*)lc)->cachedUnicodeID, LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE);
+}
+
+/*
+ * Creates an empty LocaleChunks, allocated with the specified hooks (NULL for malloc), to be filled with the SetLocaleChunks... functions.
+ * Returns NULL in case of out-of-memory problems.
+ */
+LocaleChunks* ConstructLocaleChunksWithAllocator(const LocaleAllocator* allocator)
+{
+	LocaleChunks* result;
+	result = (LocaleChunks*)LocaleAllocate(allocator, sizeof(LocaleChunks));
+	if (result) {
+		memset(result, 0, sizeof(LocaleChunks));
+		result->allocator = allocator;
+	}
+	return result;
+}
+
+/*
+ * Replaces a chunk of a LocaleChunks (value may be empty to clear it).
+ * The current storage of the chunk is reused if the new value fits in it, otherwise the new value is allocated separately.
+ * Returns 0 in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+static int SetLocaleChunksData(LocaleChunks* lc, char** chunk, const LocaleSlice* value)
+{
+	char* data;
+	InvalidateLocaleChunksCache(lc);
+	if (!value->length) {
+		FreeLocaleChunksData(lc, *chunk);
+		*chunk = NULL;
+		return 1;
+	}
+	if (*chunk && strlen(*chunk) >= value->length) {
+		memmove(*chunk, value->start, value->length);
+		(*chunk)[value->length] = '\0';
+		return 1;
+	}
+	data = (char*)LocaleAllocate(lc->allocator, value->length + 1);
+	if (!data) {
+		return 0;
+	}
+	memcpy(data, value->start, value->length);
+	data[value->length] = '\0';
+	FreeLocaleChunksData(lc, *chunk);
+	*chunk = data;
+	return 1;
+}
+
+/*
+ * Set the language of a LocaleChunks (alphanumeric, up to 8 characters, like "it" or "POSIX"), or clear it if language is NULL or empty.
+ * Setting a language turns off the Unicode root flag.
+ * Returns 0 if lc is NULL, if language is not valid or in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+int SetLocaleChunksLanguage(LocaleChunks* lc, const char* language)
+{
+	LocaleSlice value;
+	SetLocaleSlice(&value, language);
+	if (!lc || value.length > 8 || !IsAlphanumericLocaleSlice(&value) || !SetLocaleChunksData(lc, &lc->language, &value)) {
+		return 0;
+	}
+	if (value.length) {
+		lc->isRoot = 0;
+	}
+	return 1;
+}
+
+/*
+ * Set the territory of a LocaleChunks (2 letters or 3 digits), or clear it if territory is NULL or empty.
+ * Returns 0 if lc is NULL, if territory is not valid or in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+int SetLocaleChunksTerritory(LocaleChunks* lc, const char* territory)
+{
+	LocaleSlice value;
+	SetLocaleSlice(&value, territory);
+	if (!lc || (value.length && !(value.length == 2 ? IsAlphaLocaleSlice(&value) : value.length == 3 && IsDigitLocaleSlice(&value)))) {
+		return 0;
+	}
+	return SetLocaleChunksData(lc, &lc->territory, &value);
+}
+
+/*
+ * Set the Gettext codeset of a LocaleChunks (alphanumeric, like "utf8"), or clear it if codeset is NULL or empty.
+ * Returns 0 if lc is NULL, if codeset is not valid or in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+int SetLocaleChunksCodeset(LocaleChunks* lc, const char* codeset)
+{
+	LocaleSlice value;
+	SetLocaleSlice(&value, codeset);
+	if (!lc || !IsAlphanumericLocaleSlice(&value)) {
+		return 0;
+	}
+	return SetLocaleChunksData(lc, &lc->codeset, &value);
+}
+
+/*
+ * Set the Gettext modifier of a LocaleChunks (alphanumeric, like "euro" or "latin"), or clear it if modifier is NULL or empty.
+ * Returns 0 if lc is NULL, if modifier is not valid or in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+int SetLocaleChunksModifier(LocaleChunks* lc, const char* modifier)
+{
+	LocaleSlice value;
+	SetLocaleSlice(&value, modifier);
+	if (!lc || !IsAlphanumericLocaleSlice(&value)) {
+		return 0;
+	}
+	return SetLocaleChunksData(lc, &lc->modifier, &value);
+}
+
+/*
+ * Set the Unicode script of a LocaleChunks (4 letters, like "Latn"), or clear it if script is NULL or empty.
+ * Returns 0 if lc is NULL, if script is not valid or in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+int SetLocaleChunksScript(LocaleChunks* lc, const char* script)
+{
+	LocaleSlice value;
+	SetLocaleSlice(&value, script);
+	if (!lc || (value.length && (value.length != 4 || !IsAlphaLocaleSlice(&value)))) {
+		return 0;
+	}
+	return SetLocaleChunksData(lc, &lc->script, &value);
+}
+
+/*
+ * Append a variant to a LocaleChunks (alphanumeric, 5 to 8 characters, or 4 characters starting with a digit, like "POSIX" or "1901").
+ * Returns 0 if lc is NULL, if variant is not valid or in case of out-of-memory problems (lc is not changed), 1 otherwise.
+ */
+int AddLocaleChunksVariant(LocaleChunks* lc, const char* variant)
+{
+	LocaleSlice value;
+	char** variants;
+	char* data;
+	SetLocaleSlice(&value, variant);
+	if (!lc || !IsLocaleVariantSlice(&value)) {
+		return 0;
+	}
+	variants = (char**)LocaleAllocate(lc->allocator, (lc->variantCount + 1) * sizeof(char*));
+	data = (char*)LocaleAllocate(lc->allocator, value.length + 1);
+	if (!variants || !data) {
+		LocaleRelease(lc->allocator, variants);
+		LocaleRelease(lc->allocator, data);
+		return 0;
+	}
+	InvalidateLocaleChunksCache(lc);
+	memcpy(data, value.start, value.length + 1);
+	if (lc->variantCount) {
+		memcpy(variants, lc->variants, lc->variantCount * sizeof(char*));
+	}
+	variants[lc->variantCount++] = data;
+	FreeLocaleChunksData(lc, lc->variants);
+	lc->variants = variants;
+	return 1;
+}
+
+/*
+ * Remove a variant from a LocaleChunks, given its index.
+ * Returns 0 if lc is NULL or if there's no variant with the specified index, 1 otherwise.
+ */
+int RemoveLocaleChunksVariant(LocaleChunks* lc, size_t index)
+{
+	if (!lc || index >= lc->variantCount) {
+		return 0;
+	}
+	InvalidateLocaleChunksCache(lc);
+	FreeLocaleChunksData(lc, lc->variants[index]);
+	memmove(lc->variants + index, lc->variants + index + 1, (lc->variantCount - index - 1) * sizeof(char*));
+	if (!--lc->variantCount) {
+		FreeLocaleChunksData(lc, lc->variants);
+		lc->variants = NULL;
+	}
+	return 1;
+}
+
+/*
+ * Checks if all the chunks of a LocaleChunks are still stored in its own memory block (that is, if it has not been changed after being parsed).
+ */
+static int IsLocaleChunksCompact(const LocaleChunks* lc)
+{
+	size_t i;
+	const char* chunks[6];
+	chunks[0] = lc->language;
+	chunks[1] = lc->territory;
+	chunks[2] = lc->codeset;
+	chunks[3] = lc->modifier;
+	chunks[4] = lc->script;
+	chunks[5] = lc->extensions;
+	if (!lc->allocationSize || (lc->variants && !IsLocaleChunksInlineData(lc, lc->variants))) {
+		return 0;
+	}
+	for (i = 0; i < 6; i++) {
+		if (chunks[i] && !IsLocaleChunksInlineData(lc, chunks[i])) {
+			return 0;
+		}
+	}
+	for (i = 0; i < lc->variantCount; i++) {
+		if (!IsLocaleChunksInlineData(lc, lc->variants[i])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Moves a pointer into the memory block of a LocaleChunks to the same position in the memory block of its copy.
+ */
+static void* RelocateLocaleChunksData(const LocaleChunks* from, const LocaleChunks* to, const void* p)
+{
+	return p ? (char*)to + ((const char*)p - (const char*)from) : NULL;
+}
+
+/*
+ * Copies a LocaleChunks, allocating the copy with the specified hooks (NULL for malloc).
+ * The copy is stored in one memory block: if lc is compact too (see LocaleChunkSlicesToLocaleChunks), it's copied with one memcpy.
+ * The cached identifiers are not copied.
+ * Returns NULL if lc is NULL, or in case of out-of-memory problems.
+ */
+LocaleChunks* CloneLocaleChunksWithAllocator(const LocaleChunks* lc, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	LocaleChunks* result;
+	char* variants;
+	size_t i, length;
+	if (!lc) {
+		return NULL;
+	}
+	if (!IsLocaleChunksCompact(lc)) {
+		memset(&slices, 0, sizeof(slices));
+		slices.isRoot = lc->isRoot;
+		SetLocaleSlice(&slices.language, lc->language);
+		SetLocaleSlice(&slices.territory, lc->territory);
+		SetLocaleSlice(&slices.codeset, lc->codeset);
+		SetLocaleSlice(&slices.modifier, lc->modifier);
+		SetLocaleSlice(&slices.script, lc->script);
+		SetLocaleSlice(&slices.extensions, lc->extensions);
+		variants = NULL;
+		if (lc->variantCount) {
+			/* The variants of a compact LocaleChunks are built from a single slice, with the variants separated by '_' */
+			for (i = 0, length = 0; i < lc->variantCount; i++) {
+				length += strlen(lc->variants[i]) + 1;
+			}
+			variants = (char*)LocaleAllocate(allocator, length);
+			if (!variants) {
+				return NULL;
+			}
+			for (i = 0, length = 0; i < lc->variantCount; i++) {
+				if (i) {
+					variants[length++] = '_';
+				}
+				strcpy(variants + length, lc->variants[i]);
+				length += strlen(lc->variants[i]);
+			}
+			slices.variants.start = variants;
+			slices.variants.length = length;
+			slices.variantCount = lc->variantCount;
+		}
+		result = LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+		LocaleRelease(allocator, variants);
+		return result;
+	}
+	result = (LocaleChunks*)LocaleAllocate(allocator, lc->allocationSize);
+	if (result) {
+		memcpy(result, lc, lc->allocationSize);
+		result->allocator = allocator;
+		result->cachedGettextID = NULL;
+		result->cachedUnicodeID = NULL;
+		result->language = (char*)RelocateLocaleChunksData(lc, result, lc->language);
+		result->territory = (char*)RelocateLocaleChunksData(lc, result, lc->territory);
+		result->codeset = (char*)RelocateLocaleChunksData(lc, result, lc->codeset);
+		result->modifier = (char*)RelocateLocaleChunksData(lc, result, lc->modifier);
+		result->script = (char*)RelocateLocaleChunksData(lc, result, lc->script);
+		result->extensions = (char*)RelocateLocaleChunksData(lc, result, lc->extensions);
+		result->variants = (char**)RelocateLocaleChunksData(lc, result, lc->variants);
+		for (i = 0; i < lc->variantCount; i++) {
+			result->variants[i] = (char*)RelocateLocaleChunksData(lc, result, lc->variants[i]);
+		}
+	}
+	return result;
+}
+
+/*
+ * Copies a LocaleChunks, using the same allocation hooks.
+ * Returns NULL if lc is NULL, or in case of out-of-memory problems.
+ */
+LocaleChunks* CloneLocaleChunks(const LocaleChunks* lc)
+{
+	return lc ? CloneLocaleChunksWithAllocator(lc, lc->allocator) : NULL;
+}
+
+/*
+ * Scan a locale string in the Java format (see java.util.Locale.toString()), for example "sr_RS_#Latn" or "ja_JP_#u-ca-japanese".
+ * The legacy Java locales are converted: "ja_JP_JP" (Japanese calendar), "th_TH_TH" (Thai digits), "no_NO_NY" (Nynorsk), and the old "iw", "in" and "ji" language codes.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise.
+ */
+int ScanJavaLocaleID(const char* locale, size_t length, LocaleChunkSlices* slices)
+{
+	const char *p, *end, *baseEnd;
+	LocaleSlice chunk, tail;
+	size_t index;
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale) {
+		return 0;
+	}
+	end = locale + length;
+	/* The script and the extensions follow "_#" */
+	for (baseEnd = locale; baseEnd < end && !(*baseEnd == '_' && baseEnd + 1 < end && baseEnd[1] == '#'); baseEnd++);
+	/* Language, country and variants are separated by underscores */
+	index = 0;
+	for (p = locale; p <= baseEnd; p++, index++) {
+		for (chunk.start = p; p < baseEnd && *p != '_'; p++) {
+			if (!IsLocaleAlnum(*p)) {
+				return 0;
+			}
+		}
+		chunk.length = p - chunk.start;
+		if (index == 0) {
+			/* Language - empty or alpha{2,3} */
+			if (chunk.length && (chunk.length < 2 || chunk.length > 3 || !IsAlphaLocaleSlice(&chunk))) {
+				return 0;
+			}
+			slices->language = chunk;
+		} else if (index == 1) {
+			/* Country - empty, alpha{2} or digit{3} */
+			if (chunk.length && !(chunk.length == 2 ? IsAlphaLocaleSlice(&chunk) : chunk.length == 3 && IsDigitLocaleSlice(&chunk))) {
+				return 0;
+			}
+			slices->territory = chunk;
+		} else {
+			/* Variants - alphanum{1,8} */
+			if (!chunk.length || chunk.length > 8) {
+				return 0;
+			}
+			if (!slices->variantCount) {
+				slices->variants.start = chunk.start;
+			}
+			slices->variantCount++;
+			slices->variants.length = chunk.start + chunk.length - slices->variants.start;
+		}
+	}
+	if (!slices->language.length && !slices->territory.length) {
+		return 0;
+	}
+	if (baseEnd < end) {
+		/* Script (alpha{4}) and/or extensions */
+		tail.start = baseEnd + 2;
+		tail.length = end - tail.start;
+		if (tail.length >= 4 && (tail.length == 4 || tail.start[4] == '_' || tail.start[4] == '-')) {
+			chunk.start = tail.start;
+			chunk.length = 4;
+			if (IsAlphaLocaleSlice(&chunk)) {
+				slices->script = chunk;
+				tail.start += tail.length == 4 ? 4 : 5;
+				tail.length -= tail.length == 4 ? 4 : 5;
+				if (!tail.length && chunk.start + 4 < end) {
+					return 0;
+				}
+			}
+		}
+		if ((tail.length || !slices->script.length) && !ScanLocaleIDExtensions(tail.start, tail.length, 0, &slices->extensions)) {
+			return 0;
+		}
+	}
+	/* Legacy Java locales */
+	if (slices->variantCount == 1) {
+		if (IsLocaleSliceEqual(&slices->language, "ja") && IsLocaleSliceEqual(&slices->territory, "JP") && IsLocaleSliceEqual(&slices->variants, "JP")) {
+			slices->variantCount = 0;
+			if (!slices->extensions.length) {
+				SetLocaleSlice(&slices->extensions, "u-ca-japanese");
+			}
+		} else if (IsLocaleSliceEqual(&slices->language, "th") && IsLocaleSliceEqual(&slices->territory, "TH") && IsLocaleSliceEqual(&slices->variants, "TH")) {
+			slices->variantCount = 0;
+			if (!slices->extensions.length) {
+				SetLocaleSlice(&slices->extensions, "u-nu-thai");
+			}
+		} else if (IsLocaleSliceEqual(&slices->language, "no") && IsLocaleSliceEqual(&slices->territory, "NO") && IsLocaleSliceEqual(&slices->variants, "NY")) {
+			slices->variantCount = 0;
+			SetLocaleSlice(&slices->language, "nn");
+		}
+		if (!slices->variantCount) {
+			slices->variants.length = 0;
+		}
+	}
+	if (IsLocaleSliceEqual(&slices->language, "iw")) {
+		SetLocaleSlice(&slices->language, "he");
+	} else if (IsLocaleSliceEqual(&slices->language, "in")) {
+		SetLocaleSlice(&slices->language, "id");
+	} else if (IsLocaleSliceEqual(&slices->language, "ji")) {
+		SetLocaleSlice(&slices->language, "yi");
+	}
+	return 1;
+}
+
+/*
+ * Parse a locale string in the Java format (see java.util.Locale.toString()), allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* JavaLocaleIDToLocaleChunksWithAllocator(const char* locale, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	if (!locale || !ScanJavaLocaleID(locale, strlen(locale), &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Parse a locale string in the Java format (see java.util.Locale.toString()).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* JavaLocaleIDToLocaleChunks(const char* locale)
+{
+	return JavaLocaleIDToLocaleChunksWithAllocator(locale, NULL);
+}
+
+/*
+ * The order of the extensions built from ICU keywords: the private use one ("x") is always the last one.
+ */
+static int GetICUKeywordExtensionOrder(const LocaleSlice* key)
+{
+	char singleton;
+	singleton = key->length == 1 ? ToLowerLocaleChar(*key->start) : 'u';
+	return singleton == 'x' ? 'z' + 1 : singleton;
+}
+
+/*
+ * Scan a locale identifier in the ICU format, for example "de_DE@collation=phonebook" or "en__POSIX".
+ * The ICU keywords are converted to BCP 47 extensions, written to extensionsBuffer (usually LOCALE_EXTENSIONS_BUFFER_SIZE bytes):
+ * the extensions of slices point into it, so it must outlive slices.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid (and its extensions fit in extensionsBuffer), 0 otherwise.
+ */
+int ScanICULocaleID(const char* locale, size_t length, LocaleChunkSlices* slices, char* extensionsBuffer, size_t extensionsSize)
+{
+	struct {
+		LocaleSlice key;
+		LocaleSlice value;
+	} keywords[ICU_LOCALE_MAX_KEYWORDS], keyword;
+	const char *p, *end, *baseEnd, *variants;
+	const char* translated;
+	LocaleSlice name, chunk;
+	size_t count, bufferLength, i, j;
+	int isLast, order, previousOrder;
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale || !length) {
+		return 0;
+	}
+	end = locale + length;
+	for (baseEnd = locale; baseEnd < end && *baseEnd != '@'; baseEnd++);
+	/* The variants may follow an empty territory (for example "en__POSIX") */
+	for (variants = locale; variants + 1 < baseEnd && !(variants[0] == '_' && variants[1] == '_'); variants++);
+	if (variants + 1 >= baseEnd) {
+		variants = baseEnd;
+	}
+	if (*locale == '_') {
+		/* No language (for example "_Latn_RS") */
+		if (!ScanUnicodeLocaleID(locale + 1, variants - locale - 1, slices) || slices->language.length || !slices->script.length) {
+			return 0;
+		}
+	} else if (!ScanUnicodeLocaleID(locale, variants - locale, slices)) {
+		return 0;
+	}
+	if (slices->extensions.length) {
+		return 0;
+	}
+	if (variants < baseEnd) {
+		if (slices->territory.length || slices->variantCount) {
+			return 0;
+		}
+		p = variants + 2;
+		slices->variants.start = p;
+		do {
+			if (!ReadUnicodeLocaleIDChunk(&p, baseEnd, &chunk, &isLast) || chunk.length > 8) {
+				return 0;
+			}
+			slices->variantCount++;
+		} while (!isLast);
+		slices->variants.length = baseEnd - slices->variants.start;
+	}
+	if (baseEnd == end) {
+		return 1;
+	}
+	/* Keywords: name=value pairs separated by semicolons */
+	count = 0;
+	for (p = baseEnd + 1; p < end; p++) {
+		for (name.start = p; p < end && *p != '='; p++);
+		name.length = p - name.start;
+		if (p == end || count == ICU_LOCALE_MAX_KEYWORDS) {
+			return 0;
+		}
+		for (chunk.start = ++p; p < end && *p != ';'; p++);
+		chunk.length = p - chunk.start;
+		if (!name.length || !chunk.length) {
+			return 0;
+		}
+		keywords[count].key.length = 0;
+		for (i = 0; ICUKeywordDictionary[i][0]; i++) {
+			if (IsLocaleSliceEqual(&name, ICUKeywordDictionary[i][0])) {
+				SetLocaleSlice(&keywords[count].key, ICUKeywordDictionary[i][1]);
+				break;
+			}
+		}
+		if (!keywords[count].key.length) {
+			/* Unknown keywords are accepted only if they are BCP 47 keys or singletons */
+			if (name.length > 2 || !IsLocaleAlnum(name.start[0]) || (name.length == 1 && ToLowerLocaleChar(*name.start) == 'u')) {
+				return 0;
+			}
+			keywords[count].key = name;
+		}
+		translated = TranslateICUKeywordValue(&keywords[count].key, &chunk, 1);
+		if (translated) {
+			SetLocaleSlice(&keywords[count].value, translated);
+		} else {
+			keywords[count].value = chunk;
+		}
+		count++;
+	}
+	/* BCP 47 extensions are sorted by singleton, and the keys of the Unicode extension are sorted too */
+	for (i = 1; i < count; i++) {
+		keyword = keywords[i];
+		order = GetICUKeywordExtensionOrder(&keyword.key);
+		for (j = i; j > 0; j--) {
+			previousOrder = GetICUKeywordExtensionOrder(&keywords[j - 1].key);
+			if (previousOrder < order || (previousOrder == order && CompareICUKeywordNames(&keywords[j - 1].key, &keyword.key) <= 0)) {
+				break;
+			}
+			keywords[j] = keywords[j - 1];
+		}
+		keywords[j] = keyword;
+	}
+	bufferLength = 0;
+	previousOrder = 0;
+	for (i = 0; i < count; i++) {
+		order = GetICUKeywordExtensionOrder(&keywords[i].key);
+		if (bufferLength) {
+			AppendToLocaleIDBuffer(extensionsBuffer, extensionsSize, &bufferLength, "-", 1);
+		}
+		if (order == 'u' && previousOrder != 'u') {
+			AppendToLocaleIDBuffer(extensionsBuffer, extensionsSize, &bufferLength, "u-", 2);
+		}
+		previousOrder = order;
+		j = bufferLength;
+		AppendToLocaleIDBuffer(extensionsBuffer, extensionsSize, &bufferLength, keywords[i].key.start, keywords[i].key.length);
+		AppendToLocaleIDBuffer(extensionsBuffer, extensionsSize, &bufferLength, "-", 1);
+		AppendToLocaleIDBuffer(extensionsBuffer, extensionsSize, &bufferLength, keywords[i].value.start, keywords[i].value.length);
+		/* BCP 47 extensions are lowercase, and ICU values may use underscores */
+		for (; j < bufferLength && j < extensionsSize; j++) {
+			extensionsBuffer[j] = extensionsBuffer[j] == '_' ? '-' : ToLowerLocaleChar(extensionsBuffer[j]);
+		}
+	}
+	if (bufferLength >= extensionsSize) {
+		return 0;
+	}
+	return !count || ScanLocaleIDExtensions(extensionsBuffer, bufferLength, 0, &slices->extensions);
+}
+
+/*
+ * Parse a locale identifier in the ICU format, allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* ICULocaleIDToLocaleChunksWithAllocator(const char* locale, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	char extensions[LOCALE_EXTENSIONS_BUFFER_SIZE];
+	if (!locale || !ScanICULocaleID(locale, strlen(locale), &slices, extensions, sizeof(extensions))) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Parse a locale identifier in the ICU format.
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* ICULocaleIDToLocaleChunks(const char* locale)
+{
+	return ICULocaleIDToLocaleChunksWithAllocator(locale, NULL);
+}
+
+/*
+ * The resource types of the Android resource directories (for example "values" in "values-zh-rTW").
+ */
+static const char* AndroidResourceTypes[] = {
+	"anim", "animator", "color", "drawable", "font", "interpolator", "layout", "menu", "mipmap", "navigation", "raw", "transition", "values", "xml", NULL
+};
+
+/*
+ * Scan an Android locale resource qualifier (for example "zh-rTW" or "b+sr+Latn"), or a resource directory name (for example "values-zh-rTW-land").
+ * In directory names, the resource type and the mobile country/network codes before the locale are skipped, and the qualifiers after the locale are ignored.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise.
+ */
+int ScanAndroidLocaleID(const char* locale, size_t length, LocaleChunkSlices* slices)
+{
+	const char *p, *end;
+	LocaleSlice chunk;
+	size_t i;
+	int isFirst;
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale) {
+		return 0;
+	}
+	end = locale + length;
+	p = locale;
+	for (isFirst = 1; ; isFirst = 0) {
+		for (chunk.start = p; p < end && *p != '-'; p++);
+		chunk.length = p - chunk.start;
+		if (chunk.length > 2 && chunk.start[0] == 'b' && chunk.start[1] == '+') {
+			/* BCP 47 form */
+			return ScanLocaleIDTags(chunk.start + 2, chunk.length - 2, 1, slices) && slices->language.length;
+		}
+		for (i = 0; isFirst && AndroidResourceTypes[i] && !IsLocaleSliceEqual(&chunk, AndroidResourceTypes[i]); i++);
+		if (!(isFirst && AndroidResourceTypes[i]) && !(chunk.length > 3 && (!strncmp(chunk.start, "mcc", 3) || !strncmp(chunk.start, "mnc", 3)))) {
+			break;
+		}
+		/* Skip the resource type and the mobile country/network codes */
+		if (p == end) {
+			return 0;
+		}
+		p++;
+	}
+	/* Legacy form: language - alpha{2,3}; like aapt, "car" is the UI mode qualifier (Carib needs "b+car") */
+	if (chunk.length < 2 || chunk.length > 3 || !IsAlphaLocaleSlice(&chunk) || IsLocaleSliceEqual(&chunk, "car")) {
+		return 0;
+	}
+	slices->language = chunk;
+	/* The next qualifiers (for example "rTW", "land" or "sw600dp") start with a lowercase letter */
+	for (isFirst = 1; p < end; isFirst = 0) {
+		for (chunk.start = ++p; p < end && *p != '-'; p++) {
+			if (!IsLocaleAlnum(*p)) {
+				return 0;
+			}
+		}
+		chunk.length = p - chunk.start;
+		if (!chunk.length || *chunk.start < 'a' || *chunk.start > 'z') {
+			return 0;
+		}
+		if (isFirst && *chunk.start == 'r') {
+			/* Territory - r followed by alpha{2} or digit{3} */
+			chunk.start++;
+			chunk.length--;
+			if (chunk.length == 2 ? IsAlphaLocaleSlice(&chunk) : chunk.length == 3 && IsDigitLocaleSlice(&chunk)) {
+				slices->territory = chunk;
+			}
+		}
+	}
+	return 1;
+}
+
+/*
+ * Parse an Android locale resource qualifier or resource directory name, allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* AndroidLocaleIDToLocaleChunksWithAllocator(const char* locale, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	if (!locale || !ScanAndroidLocaleID(locale, strlen(locale), &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Parse an Android locale resource qualifier or resource directory name.
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* AndroidLocaleIDToLocaleChunks(const char* locale)
+{
+	return AndroidLocaleIDToLocaleChunksWithAllocator(locale, NULL);
+}
+
+/*
+ * Map from the legacy Apple localization directory names to language identifiers.
+ */
+static const char* AppleLegacyLanguageDictionary[][2] = {
+	{"Dutch", "nl"},
+	{"English", "en"},
+	{"French", "fr"},
+	{"German", "de"},
+	{"Italian", "it"},
+	{"Japanese", "ja"},
+	{"Spanish", "es"},
+	{NULL, NULL}
+};
+
+/*
+ * Scan an Apple localization directory name, with or without the ".lproj" extension (for example "zh-Hans.lproj", "pt_BR" or "English.lproj").
+ * "Base.lproj" is not a locale, so it's not valid.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise.
+ */
+int ScanAppleLocaleID(const char* locale, size_t length, LocaleChunkSlices* slices)
+{
+	LocaleSlice name;
+	size_t i;
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale) {
+		return 0;
+	}
+	name.start = locale;
+	name.length = length;
+	if (length > 6 && !CompareLocaleStringsIgnoringCase(locale + length - 6, ".lproj", 6)) {
+		name.length -= 6;
+	}
+	for (i = 0; AppleLegacyLanguageDictionary[i][0]; i++) {
+		if (IsLocaleSliceEqual(&name, AppleLegacyLanguageDictionary[i][0])) {
+			SetLocaleSlice(&slices->language, AppleLegacyLanguageDictionary[i][1]);
+			return 1;
+		}
+	}
+	return ScanUnicodeLocaleID(name.start, name.length, slices) && slices->language.length;
+}
+
+/*
+ * Parse an Apple localization directory name, allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* AppleLocaleIDToLocaleChunksWithAllocator(const char* locale, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	if (!locale || !ScanAppleLocaleID(locale, strlen(locale), &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Parse an Apple localization directory name.
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* AppleLocaleIDToLocaleChunks(const char* locale)
+{
+	return AppleLocaleIDToLocaleChunksWithAllocator(locale, NULL);
+}
+
+
+/*
+ * A locale identifier (language, script and territory only) packed in a 64-bit integer.
+ * Keys are canonical: "sr@latin", "sr-Latn" and "SR_latn" have the same key (codesets are ignored).
+ * Identifiers with anything else (variants, extensions, Gettext modifiers like "@valencia") don't have a key.
+ * The numeric order of the keys is the same as the order of their canonical Unicode IDs (see LocaleKeyToUnicodeLocaleIDBuffer).
+ * 0 is never a valid key.
+ */
+typedef uint64_t LocaleKey;
+
+/*
+ * Characters that may be found at a specific position of a LocaleKey.
+ */
+#define LOCALE_KEY_DIGIT 1
+#define LOCALE_KEY_UPPER 2
+#define LOCALE_KEY_LOWER 4
+
+/*
+ * Number of positions in a LocaleKey.
+ */
+#define LOCALE_KEY_POSITIONS 11
+
+/*
+ * A LocaleKey contains the characters of the canonical Unicode ID:
+ * - first segment (language, script or "root"): 4 positions
+ * - second segment (script or territory): 4 positions
+ * - third segment (territory following a script): 3 positions
+ * Every position is stored in the minimum number of bits, with 0 meaning "no more characters":
+ * digits come before uppercase letters, which come before lowercase letters (like in ASCII),
+ * so that comparing keys is the same as comparing strings.
+ */
+static const unsigned char LocaleKeyPositionCharacters[LOCALE_KEY_POSITIONS] = {
+	LOCALE_KEY_UPPER | LOCALE_KEY_LOWER, LOCALE_KEY_LOWER, LOCALE_KEY_LOWER, LOCALE_KEY_LOWER,
+	LOCALE_KEY_DIGIT | LOCALE_KEY_UPPER, LOCALE_KEY_DIGIT | LOCALE_KEY_UPPER | LOCALE_KEY_LOWER, LOCALE_KEY_DIGIT | LOCALE_KEY_LOWER, LOCALE_KEY_LOWER,
+	LOCALE_KEY_DIGIT | LOCALE_KEY_UPPER, LOCALE_KEY_DIGIT | LOCALE_KEY_UPPER, LOCALE_KEY_DIGIT,
+};
+static const unsigned char LocaleKeyPositionBits[LOCALE_KEY_POSITIONS] = {
+	6, 5, 5, 5,
+	6, 6, 6, 5,
+	6, 6, 4,
+};
+
+/*
+ * Encodes a character at a specific LocaleKey position.
+ * Returns 0 if the character can't be stored there.
+ */
+static unsigned int EncodeLocaleKeyCharacter(char c, unsigned char characters)
+{
+	unsigned int code;
+	code = 1;
+	if (characters & LOCALE_KEY_DIGIT) {
+		if (c >= '0' && c <= '9') {
+			return code + (c - '0');
+		}
+		code += 10;
+	}
+	if (characters & LOCALE_KEY_UPPER) {
+		if (c >= 'A' && c <= 'Z') {
+			return code + (c - 'A');
+		}
+		code += 26;
+	}
+	if ((characters & LOCALE_KEY_LOWER) && c >= 'a' && c <= 'z') {
+		return code + (c - 'a');
+	}
+	return 0;
+}
+
+/*
+ * Decodes a character stored at a specific LocaleKey position ('\0' if there's no character there).
+ */
+static char DecodeLocaleKeyCharacter(unsigned int code, unsigned char characters)
+{
+	if (code == 0) {
+		return '\0';
+	}
+	code--;
+	if (characters & LOCALE_KEY_DIGIT) {
+		if (code < 10) {
+			return (char)('0' + code);
+		}
+		code -= 10;
+	}
+	if (characters & LOCALE_KEY_UPPER) {
+		if (code < 26) {
+			return (char)('A' + code);
+		}
+		code -= 26;
+	}
+	return (char)('a' + code);
+}
+
+/*
+ * Copies a chunk to the characters of a LocaleKey, changing its case:
+ * languages are lowercase, scripts are titlecase and territories are uppercase.
+ */
+#define LOCALE_KEY_CASE_LANGUAGE 0
+#define LOCALE_KEY_CASE_SCRIPT 1
+#define LOCALE_KEY_CASE_TERRITORY 2
+static void SetLocaleKeyChunk(char* characters, const char* chunk, size_t length, int caseMode)
+{
+	size_t i;
+	for (i = 0; i < length; i++) {
+		if (caseMode == LOCALE_KEY_CASE_TERRITORY || (caseMode == LOCALE_KEY_CASE_SCRIPT && i == 0)) {
+			characters[i] = ToUpperLocaleChar(chunk[i]);
+		} else {
+			characters[i] = ToLowerLocaleChar(chunk[i]);
+		}
+	}
+}
+
+/*
+ * Builds the LocaleKey of the result of a scan (in Gettext or Unicode format).
+ * Returns 0 if the identifier can't be represented as a LocaleKey: for instance, Gettext languages like "POSIX",
+ * or identifiers with variants, extensions or Gettext modifiers that don't identify a script (like "ca_ES@valencia"),
+ * since their key would be the same as the one of a different locale.
+ */
+LocaleKey LocaleChunkSlicesToLocaleKey(const LocaleChunkSlices* slices)
+{
+	char characters[LOCALE_KEY_POSITIONS];
+	char modifier[32];
+	const char* script;
+	size_t scriptLength, territoryPosition, i;
+	LocaleKey result;
+	unsigned int code;
+	if (slices->variantCount || slices->extensions.length) {
+		return 0;
+	}
+	memset(characters, 0, sizeof(characters));
+	script = slices->script.start;
+	scriptLength = slices->script.length;
+	if (slices->modifier.length) {
+		/* Gettext modifiers may identify a script: the other ones can't be stored in a key */
+		if (slices->modifier.length >= sizeof(modifier)) {
+			return 0;
+		}
+		memcpy(modifier, slices->modifier.start, slices->modifier.length);
+		modifier[slices->modifier.length] = '\0';
+		script = GettextModifierToUnicodeScript(modifier);
+		if (!script || (scriptLength && (scriptLength != strlen(script) || CompareLocaleStringsIgnoringCase(script, slices->script.start, scriptLength)))) {
+			return 0;
+		}
+		scriptLength = strlen(script);
+	}
+	territoryPosition = 4;
+	if (slices->isRoot) {
+		SetLocaleKeyChunk(characters, "root", 4, LOCALE_KEY_CASE_LANGUAGE);
+	} else if (slices->language.length) {
+		if (slices->language.length < 2 || slices->language.length > 3 || !IsAlphaLocaleSlice(&slices->language)) {
+			return 0;
+		}
+		SetLocaleKeyChunk(characters, slices->language.start, slices->language.length, LOCALE_KEY_CASE_LANGUAGE);
+		if (scriptLength) {
+			if (scriptLength != 4) {
+				return 0;
+			}
+			SetLocaleKeyChunk(characters + 4, script, scriptLength, LOCALE_KEY_CASE_SCRIPT);
+			territoryPosition = 8;
+		}
+	} else if (scriptLength == 4) {
+		SetLocaleKeyChunk(characters, script, scriptLength, LOCALE_KEY_CASE_SCRIPT);
+	} else {
+		return 0;
+	}
+	if (slices->territory.length) {
+		if (!(slices->territory.length == 2 ? IsAlphaLocaleSlice(&slices->territory) : slices->territory.length == 3 && IsDigitLocaleSlice(&slices->territory))) {
+			return 0;
+		}
+		SetLocaleKeyChunk(characters + territoryPosition, slices->territory.start, slices->territory.length, LOCALE_KEY_CASE_TERRITORY);
+	}
+	result = 0;
+	for (i = 0; i < LOCALE_KEY_POSITIONS; i++) {
+		code = 0;
+		if (characters[i]) {
+			code = EncodeLocaleKeyCharacter(characters[i], LocaleKeyPositionCharacters[i]);
+			if (!code) {
+				return 0;
+			}
+		}
+		result = (result << LocaleKeyPositionBits[i]) | code;
+	}
+	return result;
+}
+
+/*
+ * Points the slices to the language, the Unicode script and the territory of a LocaleChunks (the other slices are left empty).
+ */
+static void SetLocaleKeySlices(LocaleChunkSlices* slices, const LocaleChunks* lc)
+{
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	slices->isRoot = lc->isRoot;
+	SetLocaleSlice(&slices->language, lc->language);
+	SetLocaleSlice(&slices->territory, lc->territory);
+	SetLocaleSlice(&slices->script, GetLocaleChunksUnicodeScript(lc));
+}
+
+/*
+ * Builds the LocaleKey of a LocaleChunks.
+ * Returns 0 if lc is NULL or if it can't be represented as a LocaleKey.
+ */
+LocaleKey LocaleChunksToLocaleKey(const LocaleChunks* lc)
+{
+	LocaleChunkSlices slices;
+	if (!lc) {
+		return 0;
+	}
+	SetLocaleKeySlices(&slices, lc);
+	SetLocaleSlice(&slices.modifier, lc->modifier);
+	SetLocaleSlice(&slices.extensions, lc->extensions);
+	slices.variantCount = lc->variantCount;
+	return LocaleChunkSlicesToLocaleKey(&slices);
+}
+
+/*
+ * Builds the LocaleKey of a locale identifier, in Unicode or in Gettext format.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 0 if locale is invalid or if it can't be represented as a LocaleKey.
+ */
+LocaleKey LocaleIDToLocaleKey(const char* locale, size_t length)
+{
+	LocaleChunkSlices slices;
+	LocaleKey result;
+	result = 0;
+	if (ScanUnicodeLocaleID(locale, length, &slices)) {
+		result = LocaleChunkSlicesToLocaleKey(&slices);
+	}
+	if (!result && ScanGettextLocaleID(locale, length, &slices)) {
+		result = LocaleChunkSlicesToLocaleKey(&slices);
+	}
+	return result;
+}
+
+/*
+ * Write the canonical Unicode ID of a LocaleKey to a buffer (for example "sr_Latn_RS").
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if key is 0.
+ */
+size_t LocaleKeyToUnicodeLocaleIDBuffer(LocaleKey key, char* buffer, size_t size)
+{
+	char characters[LOCALE_KEY_POSITIONS];
+	size_t length, i, shift;
+	length = 0;
+	if (key) {
+		shift = 0;
+		for (i = LOCALE_KEY_POSITIONS; i-- > 0; ) {
+			characters[i] = DecodeLocaleKeyCharacter((unsigned int)(key >> shift) & ((1u << LocaleKeyPositionBits[i]) - 1), LocaleKeyPositionCharacters[i]);
+			shift += LocaleKeyPositionBits[i];
+		}
+		for (i = 0; i < LOCALE_KEY_POSITIONS; i++) {
+			if (characters[i]) {
+				if (i == 4 || i == 8) {
+					AppendToLocaleIDBuffer(buffer, size, &length, "_", 1);
+				}
+				AppendToLocaleIDBuffer(buffer, size, &length, characters + i, 1);
+			}
+		}
+	}
+	TerminateLocaleIDBuffer(buffer, size, length);
+	return length;
+}
+
+/*
+ * Write the locale identifier of a LocaleKey in a specific format (LOCALE_FORMAT_... constants) to a buffer.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if key is 0 or if it can't be represented in the requested format.
+ */
+size_t FormatLocaleKey(LocaleKey key, unsigned int format, char* buffer, size_t size)
+{
+	char canonical[LOCALE_ID_INLINE_SIZE];
+	LocaleChunkSlices slices;
+	size_t length;
+	length = LocaleKeyToUnicodeLocaleIDBuffer(key, canonical, sizeof(canonical));
+	if (!ScanUnicodeLocaleID(canonical, length, &slices)) {
+		memset(&slices, 0, sizeof(slices));
+	}
+	return FormatLocaleChunkSlices(&slices, format, buffer, size);
+}
+
+/*
+ * Calculates the hash of a LocaleKey (the bits of the result are well distributed, so they can be masked).
+ */
+uint64_t HashLocaleKey(LocaleKey key)
+{
+	/* MurmurHash3 finalizer */
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return key;
+}
+
+/*
+ * Compares two LocaleKeys.
+ * Returns a negative number if a comes before b, a positive number if a comes after b, 0 if they are the same.
+ */
+int CompareLocaleKeys(LocaleKey a, LocaleKey b)
+{
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/*
+ * Calculates the hash of a locale identifier, in Unicode or in Gettext format, without allocating anything.
+ * The result is the same as HashLocaleKey of its LocaleKey, so it can be used to look for a locale identifier in a LocaleKey hash table.
+ * Identifiers without a LocaleKey all have the hash of 0, so check LocaleIDToLocaleKey before using it as a map key.
+ */
+uint64_t HashLocaleID(const char* locale, size_t length)
+{
+	return HashLocaleKey(LocaleIDToLocaleKey(locale, length));
+}
+
+/*
+ * Compares a LocaleKey with a locale identifier, in Unicode or in Gettext format, without allocating anything.
+ * Invalid identifiers (and the ones without a LocaleKey) come before any LocaleKey.
+ * Returns a negative number if key comes before locale, a positive number if key comes after locale, 0 if they are the same.
+ */
+int CompareLocaleKeyToLocaleID(LocaleKey key, const char* locale, size_t length)
+{
+	return CompareLocaleKeys(key, LocaleIDToLocaleKey(locale, length));
+}
+
+/*
+ * A LocaleKey with the index of the row it comes from, to sort records by locale.
+ */
+typedef struct _LocaleKeyRow {
+	LocaleKey key;
+	size_t row;
+} LocaleKeyRow;
+
+/*
+ * The radix sort of LocaleKeys sorts them one byte at a time.
+ */
+#define LOCALE_KEY_RADIX_PASSES ((unsigned int)sizeof(LocaleKey))
+
+/*
+ * Counts the occurrences of every byte value at every byte position of a list of keys.
+ * Returns a bitmask of the positions where the keys don't all have the same byte (the other positions, like the highest byte that is almost always 0, don't need to be sorted).
+ */
+static unsigned int CountLocaleKeyRadixBytes(const LocaleKey* keys, const LocaleKeyRow* rows, size_t count, size_t histograms[LOCALE_KEY_RADIX_PASSES][256])
+{
+	LocaleKey key;
+	unsigned int passes, pass;
+	size_t i;
+	memset(histograms, 0, LOCALE_KEY_RADIX_PASSES * 256 * sizeof(size_t));
+	key = 0;
+	for (i = 0; i < count; i++) {
+		key = keys ? keys[i] : rows[i].key;
+		for (pass = 0; pass < LOCALE_KEY_RADIX_PASSES; pass++) {
+			histograms[pass][(key >> (pass * 8)) & 0xff]++;
+		}
+	}
+	passes = 0;
+	for (pass = 0; pass < LOCALE_KEY_RADIX_PASSES; pass++) {
+		if (count && histograms[pass][(key >> (pass * 8)) & 0xff] != count) {
+			passes |= 1u << pass;
+		}
+	}
+	return passes;
+}
+
+/*
+ * Turns the byte counts of a radix pass into the positions where every byte value starts.
+ */
+static void AccumulateLocaleKeyRadixBytes(size_t histogram[256])
+{
+	size_t i, total, n;
+	for (i = 0, total = 0; i < 256; i++) {
+		n = histogram[i];
+		histogram[i] = total;
+		total += n;
+	}
+}
+
+/*
+ * Sorts a list of LocaleKeys in ascending order (that is, in the order of their canonical Unicode IDs), with a LSD radix sort.
+ * scratch must have room for count keys: its content is overwritten.
+ */
+void SortLocaleKeys(LocaleKey* keys, size_t count, LocaleKey* scratch)
+{
+	size_t histograms[LOCALE_KEY_RADIX_PASSES][256];
+	LocaleKey *from, *to, *swap;
+	unsigned int passes, pass, shift;
+	size_t i;
+	passes = CountLocaleKeyRadixBytes(keys, NULL, count, histograms);
+	from = keys;
+	to = scratch;
+	for (pass = 0; pass < LOCALE_KEY_RADIX_PASSES; pass++) {
+		if (!(passes & (1u << pass))) {
+			continue;
+		}
+		AccumulateLocaleKeyRadixBytes(histograms[pass]);
+		shift = pass * 8;
+		for (i = 0; i < count; i++) {
+			to[histograms[pass][(from[i] >> shift) & 0xff]++] = from[i];
+		}
+		swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != keys) {
+		memcpy(keys, from, count * sizeof(LocaleKey));
+	}
+}
+
+/*
+ * Sorts a list of LocaleKeyRows by key (that is, in the order of their canonical Unicode IDs), with a LSD radix sort.
+ * The sort is stable: the rows with the same key keep their order.
+ * scratch must have room for count rows: its content is overwritten.
+ */
+void SortLocaleKeyRows(LocaleKeyRow* rows, size_t count, LocaleKeyRow* scratch)
+{
+	size_t histograms[LOCALE_KEY_RADIX_PASSES][256];
+	LocaleKeyRow *from, *to, *swap;
+	unsigned int passes, pass, shift;
+	size_t i;
+	passes = CountLocaleKeyRadixBytes(NULL, rows, count, histograms);
+	from = rows;
+	to = scratch;
+	for (pass = 0; pass < LOCALE_KEY_RADIX_PASSES; pass++) {
+		if (!(passes & (1u << pass))) {
+			continue;
+		}
+		AccumulateLocaleKeyRadixBytes(histograms[pass]);
+		shift = pass * 8;
+		for (i = 0; i < count; i++) {
+			to[histograms[pass][(from[i].key >> shift) & 0xff]++] = from[i];
+		}
+		swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != rows) {
+		memcpy(rows, from, count * sizeof(LocaleKeyRow));
+	}
+}
+
+/*
+ * A list of LocaleChunks, allocated (together with its items) with a LocaleAllocator.
+ */
+typedef struct _LocaleList {
+	/* The LocaleChunks owned by this list */
+	LocaleChunks** items;
+	/* Number of items */
+	size_t count;
+	/* Number of items that can be stored without growing the list */
+	size_t capacity;
+	/* The hooks used to allocate the list and its items (NULL for malloc) */
+	const LocaleAllocator* allocator;
+} LocaleList;
+
+/*
+ * Initializes an empty LocaleList that allocates memory with the specified hooks (NULL for malloc).
+ */
+void InitLocaleList(LocaleList* list, const LocaleAllocator* allocator)
+{
+	list->items = NULL;
+	list->count = 0;
+	list->capacity = 0;
+	list->allocator = allocator;
+}
+
+/*
+ * Frees all the items of a LocaleList, and the memory used by the list itself.
+ * The list is left empty, so it can be reused.
+ */
+void FreeLocaleList(LocaleList* list)
+{
+	size_t i;
+	for (i = 0; i < list->count; i++) {
+		FreeLocaleChunks(list->items[i]);
+	}
+	LocaleRelease(list->allocator, list->items);
+	list->items = NULL;
+	list->count = 0;
+	list->capacity = 0;
+}
+
+/*
+ * Makes sure that a LocaleList can hold at least capacity items.
+ * Returns 0 in case of out-of-memory problems, 1 otherwise.
+ */
+int ReserveLocaleList(LocaleList* list, size_t capacity)
+{
+	LocaleChunks** items;
+	if (capacity <= list->capacity) {
+		return 1;
+	}
+	/* We don't use realloc, since allocators like LocaleArena can't resize memory blocks */
+	items = (LocaleChunks**)LocaleAllocate(list->allocator, capacity * sizeof(LocaleChunks*));
+	if (!items) {
+		return 0;
+	}
+	if (list->count) {
+		memcpy(items, list->items, list->count * sizeof(LocaleChunks*));
+	}
+	LocaleRelease(list->allocator, list->items);
+	list->items = items;
+	list->capacity = capacity;
+	return 1;
+}
+
+/*
+ * Appends a LocaleChunks to a LocaleList, which takes its ownership.
+ * lc should have been allocated with the same hooks as the list.
+ * Returns 0 in case of out-of-memory problems (lc is not freed), 1 otherwise.
+ */
+int AppendLocaleList(LocaleList* list, LocaleChunks* lc)
+{
+	if (list->count == list->capacity && !ReserveLocaleList(list, list->capacity ? list->capacity * 2 : 8)) {
+		return 0;
+	}
+	list->items[list->count++] = lc;
+	return 1;
+}
+
+/*
+ * Parse a locale identifier in Gettext format and append it to a LocaleList.
+ * Returns the appended LocaleChunks, or NULL if locale is NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* AppendGettextLocaleIDToLocaleList(LocaleList* list, const char* locale)
+{
+	LocaleChunks* result;
+	result = GettextLocaleIDToLocaleChunksWithAllocator(locale, list->allocator);
+	if (result && !AppendLocaleList(list, result)) {
+		FreeLocaleChunks(result);
+		result = NULL;
+	}
+	return result;
+}
+
+/*
+ * Parse a locale identifier in Unicode format and append it to a LocaleList.
+ * Returns the appended LocaleChunks, or NULL if locale is NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* AppendUnicodeLocaleIDToLocaleList(LocaleList* list, const char* locale)
+{
+	LocaleChunks* result;
+	result = UnicodeLocaleIDToLocaleChunksWithAllocator(locale, list->allocator);
+	if (result && !AppendLocaleList(list, result)) {
+		FreeLocaleChunks(result);
+		result = NULL;
+	}
+	return result;
+}
+
+
+/*
+ * Input formats accepted by a LocaleIDStream.
+ */
+#define LOCALE_STREAM_INPUT_GETTEXT 1
+#define LOCALE_STREAM_INPUT_UNICODE 2
+#define LOCALE_STREAM_INPUT_ANDROID 4
+#define LOCALE_STREAM_INPUT_APPLE 8
+
+/*
+ * Size of the output buffer of a LocaleIDStream.
+ */
+#define LOCALE_STREAM_OUTPUT_SIZE 256
+
+/*
+ * Output format of a LocaleIDStream that only parses the identifiers, without converting them.
+ */
+#define LOCALE_STREAM_OUTPUT_NONE ((unsigned int)-1)
+
+/*
+ * Provides the next locale identifier to a LocaleIDStream (it doesn't need to be null-terminated).
+ * Returns 0 when there are no more identifiers.
+ */
+typedef int (*LocaleIDSource)(void* userData, const char** locale, size_t* length);
+
+/*
+ * Lazily parses and converts a sequence of locale identifiers, one at a time.
+ * The parsed chunks point into the input, and the converted identifier is written to a buffer that's reused for every item,
+ * so nothing is allocated while streaming.
+ */
+typedef struct _LocaleIDStream {
+	/* Where the identifiers come from */
+	LocaleIDSource source;
+	void* userData;
+	/* Accepted input formats (LOCALE_STREAM_INPUT_... flags): Unicode is tried first, then Android, Apple and Gettext */
+	unsigned int inputFormats;
+	/* Output format (LOCALE_FORMAT_... constants, or LOCALE_STREAM_OUTPUT_NONE) */
+	unsigned int outputFormat;
+	/* Index of the current item (starting from 0) */
+	size_t index;
+	/* The current input identifier (not null-terminated) */
+	const char* input;
+	size_t inputLength;
+	/* Is the current input valid? If not, slices and output are empty */
+	int isValid;
+	/* The chunks of the current input */
+	LocaleChunkSlices slices;
+	/* The converted identifier (truncated if it's longer than LOCALE_STREAM_OUTPUT_SIZE - 1 characters) */
+	char output[LOCALE_STREAM_OUTPUT_SIZE];
+	/* The length of the whole converted identifier (0 if it can't be represented in the output format) */
+	size_t outputLength;
+	/* State of the built-in sources */
+	const char* const* sourceItems;
+	const char* sourceText;
+	size_t sourceSize;
+	size_t sourcePosition;
+} LocaleIDStream;
+
+/*
+ * Initializes a LocaleIDStream that reads the identifiers from a custom source.
+ */
+void InitLocaleIDStream(LocaleIDStream* stream, LocaleIDSource source, void* userData, unsigned int inputFormats, unsigned int outputFormat)
+{
+	memset(stream, 0, sizeof(LocaleIDStream));
+	stream->source = source;
+	stream->userData = userData;
+	stream->inputFormats = inputFormats;
+	stream->outputFormat = outputFormat;
+	stream->index = (size_t)-1;
+}
+
+static int ReadLocaleIDStreamArray(void* userData, const char** locale, size_t* length)
+{
+	LocaleIDStream* stream;
+	stream = (LocaleIDStream*)userData;
+	if (stream->sourcePosition >= stream->sourceSize) {
+		return 0;
+	}
+	*locale = stream->sourceItems[stream->sourcePosition++];
+	*length = *locale ? strlen(*locale) : 0;
+	return 1;
+}
+
+/*
+ * Initializes a LocaleIDStream that reads the identifiers from an array of null-terminated strings.
+ */
+void InitLocaleIDStreamFromArray(LocaleIDStream* stream, const char* const* locales, size_t count, unsigned int inputFormats, unsigned int outputFormat)
+{
+	InitLocaleIDStream(stream, ReadLocaleIDStreamArray, stream, inputFormats, outputFormat);
+	stream->sourceItems = locales;
+	stream->sourceSize = count;
+}
+
+static int ReadLocaleIDStreamLines(void* userData, const char** locale, size_t* length)
+{
+	LocaleIDStream* stream;
+	const char *start, *end, *p;
+	stream = (LocaleIDStream*)userData;
+	if (stream->sourcePosition >= stream->sourceSize) {
+		return 0;
+	}
+	start = stream->sourceText + stream->sourcePosition;
+	end = stream->sourceText + stream->sourceSize;
+	p = (const char*)memchr(start, '\n', end - start);
+	if (!p) {
+		p = end;
+	}
+	stream->sourcePosition = p - stream->sourceText + 1;
+	if (p > start && p[-1] == '\r') {
+		p--;
+	}
+	*locale = start;
+	*length = p - start;
+	return 1;
+}
+
+/*
+ * Initializes a LocaleIDStream that reads the identifiers from a text, one per line (the text is not copied).
+ */
+void InitLocaleIDStreamFromLines(LocaleIDStream* stream, const char* text, size_t length, unsigned int inputFormats, unsigned int outputFormat)
+{
+	InitLocaleIDStream(stream, ReadLocaleIDStreamLines, stream, inputFormats, outputFormat);
+	stream->sourceText = text;
+	stream->sourceSize = length;
+}
+
+/*
+ * Scan a locale identifier trying the formats specified by LOCALE_STREAM_INPUT_... flags: Unicode first, then Android, Apple and Gettext.
+ * Returns 1 if locale is valid in one of the formats, 0 otherwise.
+ */
+static int ScanLocaleIDInFormats(const char* locale, size_t length, unsigned int inputFormats, LocaleChunkSlices* slices)
+{
+	if ((inputFormats & LOCALE_STREAM_INPUT_UNICODE) && ScanUnicodeLocaleID(locale, length, slices)) {
+		return 1;
+	}
+	if ((inputFormats & LOCALE_STREAM_INPUT_ANDROID) && ScanAndroidLocaleID(locale, length, slices)) {
+		return 1;
+	}
+	if ((inputFormats & LOCALE_STREAM_INPUT_APPLE) && ScanAppleLocaleID(locale, length, slices)) {
+		return 1;
+	}
+	return (inputFormats & LOCALE_STREAM_INPUT_GETTEXT) && ScanGettextLocaleID(locale, length, slices);
+}
+
+/*
+ * Moves a LocaleIDStream to the next identifier, parsing and converting it.
+ * Returns 0 when there are no more identifiers, 1 otherwise (even if the new identifier is invalid: check isValid).
+ */
+int NextLocaleIDStream(LocaleIDStream* stream)
+{
+	if (!stream->source(stream->userData, &stream->input, &stream->inputLength)) {
+		return 0;
+	}
+	stream->index++;
+	stream->isValid = ScanLocaleIDInFormats(stream->input, stream->inputLength, stream->inputFormats, &stream->slices);
+	if (stream->isValid && stream->outputFormat == LOCALE_STREAM_OUTPUT_NONE) {
+		stream->output[0] = '\0';
+		stream->outputLength = 0;
+	} else if (stream->isValid) {
+		stream->outputLength = FormatLocaleChunkSlices(&stream->slices, stream->outputFormat, stream->output, sizeof(stream->output));
+	} else {
+		memset(&stream->slices, 0, sizeof(stream->slices));
+		stream->output[0] = '\0';
+		stream->outputLength = 0;
+	}
+	return 1;
+}
+
+/*
+ * Converts a whole listing of directory or file names (one per line), writing the converted names to a buffer, one per line.
+ * Names that are not valid in any of the input formats (LOCALE_STREAM_INPUT_... flags) or that can't be represented in the output format
+ * produce empty lines, so that the output lines match the input ones.
+ * prefix and suffix (they may be NULL) are added to every converted name: for example "values-" for Android, ".lproj" for Apple or ".po" for Gettext catalogs.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole output (without the null terminator); if convertedCount is not NULL it receives the number of converted names.
+ */
+size_t ConvertLocaleDirectoryListing(const char* listing, size_t length, unsigned int inputFormats, unsigned int outputFormat, const char* prefix, const char* suffix, char* buffer, size_t size, size_t* convertedCount)
+{
+	LocaleIDStream stream;
+	LocaleIDBufferWriter destination;
+	size_t start, count;
+	destination.buffer = buffer;
+	destination.size = size;
+	destination.length = 0;
+	count = 0;
+	/* The names are written directly to the destination, without using the stream buffer */
+	InitLocaleIDStreamFromLines(&stream, listing, listing ? length : 0, inputFormats, LOCALE_STREAM_OUTPUT_NONE);
+	while (NextLocaleIDStream(&stream)) {
+		if (stream.isValid) {
+			start = destination.length;
+			if (prefix) {
+				WriteLocaleIDToBuffer(&destination, prefix, strlen(prefix));
+			}
+			if (WriteLocaleChunkSlices(&stream.slices, outputFormat, WriteLocaleIDToBuffer, &destination)) {
+				if (suffix) {
+					WriteLocaleIDToBuffer(&destination, suffix, strlen(suffix));
+				}
+				count++;
+			} else {
+				destination.length = start;
+			}
+		}
+		WriteLocaleIDToBuffer(&destination, "\n", 1);
+	}
+	TerminateLocaleIDBuffer(buffer, size, destination.length);
+	if (convertedCount) {
+		*convertedCount = count;
+	}
+	return destination.length;
+}
+
+/*
+ * UTF-16 and wide character input.
+ * Locale identifiers only contain ASCII characters: the code units are validated and narrowed in one pass,
+ * directly into the buffer used by the scanners.
+ */
+
+/*
+ * Maximum length of the UTF-16 and wide locale identifiers parsed without a caller-provided buffer.
+ */
+#define LOCALE_ID_MAX_LENGTH 256
+
+/*
+ * Narrows UTF-16 code units to ASCII characters.
+ * Returns 0 as soon as a code unit is not ASCII, 1 otherwise.
+ */
+static int NarrowLocaleIDUTF16(const uint16_t* locale, size_t length, char* narrow)
+{
+	size_t i;
+	i = 0;
+#if defined(__SSE2__)
+	{
+		const __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+		const __m128i zero = _mm_setzero_si128();
+		__m128i low, high;
+		/* 16 code units at a time: check that no bit above the 7th is set, then pack them to bytes */
+		for (; i + 16 <= length; i += 16) {
+			low = _mm_loadu_si128((const __m128i*)(locale + i));
+			high = _mm_loadu_si128((const __m128i*)(locale + i + 8));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(low, high), nonASCII), zero)) != 0xffff) {
+				return 0;
+			}
+			_mm_storeu_si128((__m128i*)(narrow + i), _mm_packus_epi16(low, high));
+		}
+	}
+#endif
+	for (; i < length; i++) {
+		if (locale[i] > 0x7f) {
+			return 0;
+		}
+		narrow[i] = (char)locale[i];
+	}
+	return 1;
+}
+
+/*
+ * Scan a UTF-16 locale identifier trying the formats specified by LOCALE_STREAM_INPUT_... flags (Unicode first, then Android, Apple and Gettext).
+ * The identifier is narrowed to buffer (which must be at least length bytes long), and slices point into it.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise (for example if it contains non-ASCII characters, or if buffer is too small).
+ */
+int ScanLocaleIDUTF16(const uint16_t* locale, size_t length, unsigned int inputFormats, char* buffer, size_t size, LocaleChunkSlices* slices)
+{
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (!locale || length > size || !NarrowLocaleIDUTF16(locale, length, buffer)) {
+		return 0;
+	}
+	return ScanLocaleIDInFormats(buffer, length, inputFormats, slices);
+}
+
+/*
+ * Parse a UTF-16 locale identifier (up to LOCALE_ID_MAX_LENGTH code units) trying the formats specified by LOCALE_STREAM_INPUT_... flags,
+ * allocating the result with the specified hooks (NULL for malloc).
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* UTF16LocaleIDToLocaleChunksWithAllocator(const uint16_t* locale, size_t length, unsigned int inputFormats, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	char buffer[LOCALE_ID_MAX_LENGTH];
+	if (!ScanLocaleIDUTF16(locale, length, inputFormats, buffer, sizeof(buffer), &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Parse a UTF-16 locale identifier (up to LOCALE_ID_MAX_LENGTH code units) trying the formats specified by LOCALE_STREAM_INPUT_... flags.
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* UTF16LocaleIDToLocaleChunks(const uint16_t* locale, size_t length, unsigned int inputFormats)
+{
+	return UTF16LocaleIDToLocaleChunksWithAllocator(locale, length, inputFormats, NULL);
+}
+
+/*
+ * Parse a wide locale identifier (up to LOCALE_ID_MAX_LENGTH characters) trying the formats specified by LOCALE_STREAM_INPUT_... flags.
+ * wchar_t is UTF-16 on Windows (so the UTF-16 path is used), UTF-32 elsewhere.
+ * Returns NULL if locale NULL or invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* WideLocaleIDToLocaleChunks(const wchar_t* locale, size_t length, unsigned int inputFormats)
+{
+	LocaleChunkSlices slices;
+	char buffer[LOCALE_ID_MAX_LENGTH];
+	size_t i;
+	if (sizeof(wchar_t) == sizeof(uint16_t)) {
+		return UTF16LocaleIDToLocaleChunks((const uint16_t*)locale, length, inputFormats);
+	}
+	if (!locale || length > sizeof(buffer)) {
+		return NULL;
+	}
+	for (i = 0; i < length; i++) {
+		if ((uint32_t)locale[i] > 0x7f) {
+			return NULL;
+		}
+		buffer[i] = (char)locale[i];
+	}
+	if (!ScanLocaleIDInFormats(buffer, length, inputFormats, &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunks(&slices);
+}
+
+/*
+ * Registries of the valid subtags, used to strictly validate locale identifiers (see IsRegisteredLocaleChunkSlices).
+ * Sources: CLDR (through Babel 2.18: see tools/generate-locale-registry.py) for ISO 639 (including the ISO 639-3 languages with likely subtags and the deprecated codes), ISO 15924, ISO 3166 and UN M.49, and the IANA Language Subtag Registry for the variants.
+ * The private use subtags of BCP 47 are valid ("qaa" to "qtz", "Qaaa" to "Qabx", "AA", "QM" to "QZ", "XA" to "XZ" and "ZZ"),
+ * while "UK" is not, even if CLDR has it as an alias of "GB" (it's only exceptionally reserved by ISO 3166, and it's not in the IANA registry).
+ */
+
+/*
+ * Bitmap of the valid languages, indexed by (a * 27 + b) * 27 + c, where a, b and c are the letters of the code (1 for "a", 0 for a missing third letter).
+ */
+#define LOCALE_REGISTRY_LANGUAGE_BITS (27 * 27 * 27)
+static const uint64_t LocaleRegistryLanguages[(LOCALE_REGISTRY_LANGUAGE_BITS + 63) / 64] = {
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0xbff0000000000000ULL,
+	0xfd85dbfefdffdbffULL, 0xaea6382ff6fafedfULL, 0xf70dffffffa16e59ULL, 0x58a14139ffefe03bULL,
+	0xeff7ffefd3fe6ffeULL, 0x1fbfbfffffffffefULL, 0xc146898ffbfff947ULL, 0xd7ddf3feffd7ffdfULL,
+	0xc7d1beb7ffbaffffULL, 0xf2007148ff3aeb83ULL, 0x000208725ad3ffbbULL, 0xfffefefdffbde000ULL,
+	0xffffffffb7fffff3ULL, 0xf36ffbbf5feff7feULL, 0xdfff3ffbffffffffULL, 0xffbffffef7ffffdeULL,
+	0xfeeffbdffffff7fbULL, 0xdffefeebfffebbfeULL, 0xfb7fffffffbff7dbULL, 0xfffffdfff9ff9fffULL,
+	0x3bdfdfff7f6effefULL, 0xff7eb9afefd3bfffULL, 0xf7ff7fc0000007f7ULL, 0xb0007b5b85fdbd39ULL,
+	0x04124861221e0253ULL, 0xbfbfffb800088a00ULL, 0x00649bd644a1584bULL, 0x736a895c5f9d77efULL,
+	0x773fbdff33e371c0ULL, 0xfffe080004194614ULL, 0x1cf8dd6d9ad07fbdULL, 0xb60008102dc67c3fULL,
+	0x2801c00008001000ULL, 0x8000000020924000ULL, 0x010bcfdbdaf7fffdULL, 0x73dfc88cc6b20080ULL,
+	0x0b39b77c00000023ULL, 0xf9fbffefef1ecf29ULL, 0x0060802183104293ULL, 0xdcbd33ac9f65c7f0ULL,
+	0x000000100007bbb6ULL, 0x0059608afb4ea000ULL, 0x00fffffff23dab16ULL, 0x00000d5830040000ULL,
+	0x000342cd12714b00ULL, 0x4440000002000000ULL, 0x0000008100000124ULL, 0x0800011100000010ULL,
+	0x00000400000802c0ULL, 0x816ea88000001051ULL, 0xefda96aa62437042ULL, 0x104000400004e378ULL,
+	0x44e05c1000000000ULL, 0x011a79800a8e0ae8ULL, 0x0200800020900080ULL, 0x1000800202000000ULL,
+	0xffae000000000001ULL, 0x0000000001000e7bULL, 0x0100800000000000ULL, 0x0000002000000022ULL,
+	0x000000112aa8c600ULL, 0x0008114c08200400ULL, 0x6310880002840420ULL, 0xb010000000000800ULL,
+	0x000000000021fa83ULL, 0x0400004ece6f8000ULL, 0x0200000000000110ULL, 0x0000000000000000ULL,
+	0xfdffffdffffffc00ULL, 0xf789b7ffe8145058ULL, 0x4d8b62001001f3a7ULL, 0x1c7fc6f80e64150bULL,
+	0xfdf821c032048d00ULL, 0x6dff7fd91c658724ULL, 0x080020113fffffe9ULL, 0xd000ff4cf7c01100ULL,
+	0x7dffffc100101081ULL, 0x001b466fe41be8d7ULL, 0x08405813cbd88000ULL, 0xbffffdd800000000ULL,
+	0x00000002000a3001ULL, 0x0000000211cba004ULL, 0xba04020010040000ULL, 0x12440000800ca7feULL,
+	0x7ff22b0300016000ULL, 0x005ab6e7e0231ecbULL, 0x6a0ac00000000080ULL, 0x928820101080097dULL,
+	0x01410120a3febdfeULL, 0x0001180000000010ULL, 0x1000000000000044ULL, 0x04891279db004420ULL,
+	0x000001079047e010ULL, 0x08223c2951014330ULL, 0x2214000420110204ULL, 0x1c3754d7d66c8404ULL,
+	0x00408e2cba1cd200ULL, 0x0000000114002900ULL, 0xe0c3ec6d9025900aULL, 0x0020002001fb9746ULL,
+	0x002010022a004200ULL, 0x0202118010080020ULL, 0xee20efdfafe00000ULL, 0x04002080800000b4ULL,
+	0x120000000068b748ULL, 0x0617e00008000044ULL, 0x010500100400204eULL, 0x692318a43c000008ULL,
+	0x11000842004a0081ULL, 0x0034000600800000ULL, 0xf62c000000000000ULL, 0x000100800401156bULL,
+	0x0040000440000000ULL, 0xffe7c00000000000ULL, 0x6fbfffefffff7dfeULL, 0x7fdff3effbebbffdULL,
+	0xffeff3ffbd7ffdffULL, 0xfe7fff7fffff7fffULL, 0xfffffffffffffbffULL, 0xfffffbffffdfffffULL,
+	0xffffffffbfffffd6ULL, 0xffff5fffffdffafeULL, 0xfbfeffffffffffffULL, 0xfffebff3f6ffffffULL,
+	0x00000ffbfefdffbfULL, 0x1fdbf996ffffdf80ULL, 0xfff003ff9601662fULL, 0x6df70e001000bfffULL,
+	0x8bffffff83863028ULL, 0xfefe479ee7c60448ULL, 0x2a1de5df3ffff123ULL, 0x00100c022f7fff5fULL,
+	0x84465143ea280200ULL, 0xf7fff7fc28c38901ULL, 0x00012163440a0680ULL, 0x0144000020010002ULL,
+	0xf7fefffe00000010ULL, 0xdffdffffffbffffaULL, 0xfbffff6fffdbeffeULL, 0xfff7ffdfbfffffffULL,
+	0x7f9ffff3fde7b7ffULL, 0xff7e3febffbfdfffULL, 0xf7dfffffefffbfffULL, 0xfffeffefffeeffffULL,
+	0xe7fffffffefffbffULL, 0xfffbffecf977fbfbULL, 0xf53dffffffffd3ffULL, 0xfe0000002fbff997ULL,
+	0xffff3f7ff7fffff9ULL, 0xf6fdf7fffffffe9bULL, 0xbfbffbfdf8241012ULL, 0xcf716ffdefedfdfaULL,
+	0xdf9bbaeeff77ff73ULL, 0x7fffffffffbfffffULL, 0x25f100ca34e117ffULL, 0xc3fd74ff5217ae74ULL,
+	0xa101fffdff5cb6baULL, 0x49b4ac8c25156000ULL, 0x006242a167fffffeULL, 0x9740011000280000ULL,
+	0x0180401020820306ULL, 0x08c0500000000000ULL, 0x0100881800000208ULL, 0x956caabe190051a0ULL,
+	0x9d446d66a3c1a541ULL, 0x085401004401027bULL, 0x0bff9c5560000001ULL, 0x18893df3d1b13982ULL,
+	0x0001200000002000ULL, 0x0008008040000000ULL, 0xffdfe80000000004ULL, 0xa10adffc9f7cfb3fULL,
+	0x408ba7dd5b030c00ULL, 0xf4f990050b524000ULL, 0x0c0400003fefaef8ULL, 0x7fbf4fcdbbf04b83ULL,
+	0x5bff7d1b7ffefbdfULL, 0xfe800100101ffa22ULL, 0x5c303174c646efeaULL, 0xc0000003dfd37f07ULL,
+	0x0100002000109c10ULL, 0x0000000010481903ULL, 0xfbffffff7fffffe0ULL, 0xfffeffffffdfffffULL,
+	0xffffffbffffff7ffULL, 0xff7fffffeffffffdULL, 0xffffdffffffbffffULL, 0xbffffff7fffffeffULL,
+	0xffeffffffdffffffULL, 0xfffffbffffff7fffULL, 0x57cf7affffffffdfULL, 0xa214060842a44fb9ULL,
+	0x000000001000216fULL, 0x04f8bdfbc0000000ULL, 0x0001000002000118ULL, 0x0000000430ed4c00ULL,
+	0x0840040200162001ULL, 0x811830080280068eULL, 0x1f6ff7fe00000004ULL, 0x000052f8fe884509ULL,
+	0x10a2000000000041ULL, 0xda20084204004000ULL, 0x5c018000000c77d5ULL, 0x0400000200004002ULL,
+	0x7fc0000000000000ULL, 0xddbeffffff7dfffbULL, 0x1bff7ffc9766f79fULL, 0x7dfebd373f100404ULL,
+	0x6a616dfbdffdf7ffULL, 0xfff2ffccfffefff1ULL, 0xbabffdffdffeff77ULL, 0x0ca8c0d2ffd5f7ffULL,
+	0xf3ffaf5fdffff7feULL, 0x0405ff7bfabd6fffULL, 0x85620123ffafef01ULL, 0x000582a13c633e83ULL,
+	0xe7ffebfffeff8000ULL, 0xfb7effbef57d7fdfULL, 0xbffe0530803fffddULL, 0xfffffefff3b7bff7ULL,
+	0xdfbfe31ee2a75a09ULL, 0xfefff7bffff3ff7fULL, 0x7f57eeafdfffbaf7ULL, 0xfbffffdfbc58f802ULL,
+	0x77fff6ffff7dbebaULL, 0x276fe7ee6e3e8cbbULL, 0xd403beab91b3ae6aULL, 0x0420000000000403ULL,
+	0x4400000011209010ULL, 0x010000800000406dULL, 0x0008004002049c00ULL, 0xe0c0001000480080ULL,
+	0xde296540d4dcb9c2ULL, 0x0001200292b55902ULL, 0x5ff8000000080040ULL, 0x4a02440a42c0bfafULL,
+	0x0800089000420000ULL, 0x0002000000000000ULL, 0x0000000042002800ULL, 0x0000008044dbefc4ULL,
+	0xbc01200000000000ULL, 0x0020000000000000ULL, 0x8000a0a1f2000000ULL, 0x24000218fe010000ULL,
+	0x08012800f5e7ffc0ULL, 0x000000000000a080ULL, 0x0000000188002000ULL, 0x00020c0000020000ULL,
+	0x0000000000100000ULL, 0x0000000000000000ULL, 0xecdffddffc000000ULL, 0x8064800002021ae7ULL,
+	0x600001002f6ce611ULL, 0xffb01004412a0828ULL, 0x8400120000404bd1ULL, 0x786638cf8f671d12ULL,
+	0x000408cfaff543d5ULL, 0xbdb7708000000000ULL, 0x0584015a206c0a82ULL, 0x480060000000dd1cULL,
+	0x0811881040000008ULL, 0xf430000000000000ULL, 0x090200a159ad97e7ULL, 0x001e104820288020ULL,
+	0xa021140452800000ULL, 0x0400011062101040ULL, 0xef200001affeabfcULL, 0xbd5318d9b81bfbf2ULL,
+	0x80000005d6fff610ULL, 0x73e45eee4c2998adULL, 0x230880187a0a2fb7ULL, 0x3014280412938640ULL,
+	0x00000040401080e0ULL, 0x807b9b7fffffe000ULL, 0x2a00011640114001ULL, 0x4c80800000027c56ULL,
+	0x24c3793000002029ULL, 0x54c812ae08000000ULL, 0x50c49011f8a64482ULL, 0x00000000871ea141ULL,
+	0x0041445c13000000ULL, 0xb776fe5000000835ULL, 0x0429902080800015ULL, 0x0000024000044061ULL,
+	0xfff5ffe000000000ULL, 0x0000000810b0102aULL, 0x00000000c3040001ULL, 0x4603084c02308300ULL,
+	0x00b0000000908f00ULL, 0xfffffc089900a18cULL, 0xf807508400808a2fULL, 0xc0800000041fffffULL,
+	0xcedc280121001009ULL, 0x010000000400e202ULL, 0x2890840000000000ULL, 0x0000000000040200ULL,
+};
+
+/*
+ * Bitmap of the valid two-letter territories (ISO 3166), indexed by a * 26 + b, where a and b are the letters of the code (0 for "A").
+ */
+static const uint64_t LocaleRegistryAlphaTerritories[(26 * 26 + 63) / 64] = {
+	0xdeddfdefeedf797dULL, 0x1e00d5c015963fffULL, 0x0015fb9fb20d5c02ULL, 0x2340400f781c0e8dULL,
+	0xfd4f8141f42b1d00ULL, 0x0100086f27d7fffdULL, 0x43fff001d78f3d40ULL, 0xbfbb7be7fdf15102ULL,
+	0x004085770430419aULL, 0x0018ffffffc04042ULL, 0x0000000908400418ULL,
+};
+
+/*
+ * Bitmap of the valid numeric territories (UN M.49 and ISO 3166 numeric codes), indexed by their value.
+ */
+static const uint64_t LocaleRegistryNumericTerritories[(1000 + 63) / 64] = {
+	0x737d119df13fff3eULL, 0x1111111114501551ULL, 0x9114d4445dd3d110ULL, 0x4744c7c444511d11ULL,
+	0x1111111101585454ULL, 0x1111111111115111ULL, 0x4544544e45114111ULL, 0x111d101144444444ULL,
+	0x4444441011fd1111ULL, 0x44451111114087f4ULL, 0xc045444444d8504cULL, 0x1511111113111047ULL,
+	0xc404049159111111ULL, 0x4cc4100054440107ULL, 0xc000000000000000ULL, 0x000000fffffffffdULL,
+};
+
+/*
+ * Sorted list of the valid scripts (ISO 15924), packed in 5 bits per letter (1 for "a").
+ * 26^4 possible codes for about 250 scripts are too sparse for a bitmap.
+ */
+#define LOCALE_REGISTRY_SCRIPT_COUNT 258
+static const uint32_t LocaleRegistryScripts[LOCALE_REGISTRY_SCRIPT_COUNT] = {
+	0x0918d, 0x0982b, 0x09d02, 0x0a1ed, 0x0c822, 0x0c82e, 0x0c9a9, 0x0c9ae,
+	0x0da74, 0x10589, 0x105b5, 0x10673, 0x1068b, 0x115c7, 0x12173, 0x13133,
+	0x13e0f, 0x14828, 0x14829, 0x154e9, 0x15504, 0x1856d, 0x185d3, 0x18649,
+	0x1a02d, 0x1a0b2, 0x1a253, 0x1a654, 0x1be14, 0x1c1ae, 0x1c254, 0x1e64c,
+	0x1e653, 0x216c1, 0x2242b, 0x23cf2, 0x24e54, 0x2560c, 0x29f24, 0x29f28,
+	0x29f30, 0x2b041, 0x2b32d, 0x2d109, 0x38641, 0x395eb, 0x395f2, 0x3b027,
+	0x3bdc7, 0x3bdcd, 0x3be88, 0x3c82e, 0x3c8ab, 0x3d552, 0x3d568, 0x3d655,
+	0x405c2, 0x405c7, 0x405c9, 0x405cf, 0x405d3, 0x405d4, 0x40692, 0x41452,
+	0x42641, 0x432b7, 0x435c7, 0x435d0, 0x44974, 0x455c7, 0x4b893, 0x4d02c,
+	0x505af, 0x506c1, 0x5402e, 0x55643, 0x58589, 0x585c1, 0x586e9, 0x5a032,
+	0x5a1b2, 0x5a1ea, 0x5a693, 0x5b881, 0x5be45, 0x5c0ac, 0x5c829, 0x5d109,
+	0x605c1, 0x605ef, 0x60686, 0x60687, 0x6068e, 0x61603, 0x625a2, 0x625c1,
+	0x625c2, 0x62675, 0x63da1, 0x66469, 0x66489, 0x6850a, 0x68561, 0x685c4,
+	0x685c9, 0x68643, 0x68721, 0x69486, 0x695c4, 0x69643, 0x6964f, 0x6b32d,
+	0x6bc89, 0x6bdc7, 0x6bdee, 0x6c9ef, 0x6d0a9, 0x6d594, 0x6e5b2, 0x704ed,
+	0x705c4, 0x70642, 0x70834, 0x716e1, 0x72ce2, 0x72def, 0x74d15, 0x79c2d,
+	0x7b06b, 0x7b82f, 0x7c968, 0x7cb21, 0x7cce5, 0x7cda1, 0x7d4f2, 0x8058d,
+	0x806a3, 0x8164d, 0x82027, 0x82189, 0x82190, 0x82196, 0x821d8, 0x83244,
+	0x84a89, 0x88421, 0x88422, 0x88423, 0x88424, 0x88425, 0x88426, 0x88427,
+	0x88428, 0x88429, 0x8842a, 0x8842b, 0x8842c, 0x8842d, 0x8842e, 0x8842f,
+	0x88430, 0x88431, 0x88432, 0x88433, 0x88434, 0x88435, 0x88436, 0x88437,
+	0x88438, 0x88439, 0x8843a, 0x88441, 0x88442, 0x88443, 0x88444, 0x88445,
+	0x88446, 0x88447, 0x88448, 0x88449, 0x8844a, 0x8844b, 0x8844c, 0x8844d,
+	0x8844e, 0x8844f, 0x88450, 0x88451, 0x88452, 0x88453, 0x88454, 0x88455,
+	0x88456, 0x88457, 0x88458, 0x929c7, 0x93d07, 0x93e4f, 0x955d2, 0x985b2,
+	0x98641, 0x98642, 0x986b2, 0x99dd7, 0x9a037, 0x9a244, 0x9a484, 0x9a5c4,
+	0x9a5c8, 0x9bce4, 0x9bcef, 0x9be41, 0x9bf2f, 0x9d5c4, 0x9d5d5, 0x9e58f,
+	0x9e643, 0x9e645, 0x9e64a, 0x9e64e, 0xa04e2, 0xa0572, 0xa0585, 0xa0595,
+	0xa05ac, 0xa05c7, 0xa06d4, 0xa1595, 0xa15c7, 0xa19c7, 0xa1d87, 0xa2021,
+	0xa2029, 0xa2454, 0xa2648, 0xa3a61, 0xa3c92, 0xa3e8f, 0xa5687, 0xa9c32,
+	0xb0529, 0xb2670, 0xb2688, 0xb8641, 0xb8d0f, 0xbbd85, 0xc40af, 0xc4eb8,
+	0xc9749, 0xca529, 0xd05c2, 0xd25c8, 0xd3688, 0xd4f25, 0xd4f2d, 0xd6318,
+	0xd6739, 0xd6b5a,
+};
+
+/*
+ * Sorted list of the valid variants, packed in base 37 (1 to 10 for the digits, 11 to 36 for the letters).
+ * "POSIX" is not in the IANA registry, but it's used by CLDR and by Gettext.
+ */
+#define LOCALE_REGISTRY_VARIANT_COUNT 115
+static const uint64_t LocaleRegistryVariants[LOCALE_REGISTRY_VARIANT_COUNT] = {
+	0x0000001c15bULL, 0x0000001c2abULL, 0x0000001c2adULL, 0x000014c3c48ULL,
+	0x000016044c0ULL, 0x00001619ed7ULL, 0x000016678e0ULL, 0x000016b0728ULL,
+	0x0000187b025ULL, 0x00001ef216dULL, 0x00002451b61ULL, 0x00002691024ULL,
+	0x000026f3f0cULL, 0x000028460dfULL, 0x00002ba3c45ULL, 0x00002be3622ULL,
+	0x00002c6c4d5ULL, 0x00002e1e244ULL, 0x00002f35ed1ULL, 0x00002fb7905ULL,
+	0x000030020f2ULL, 0x000032fc780ULL, 0x0000334cf20ULL, 0x00003392dafULL,
+	0x00003461152ULL, 0x00003511d4fULL, 0x00003514807ULL, 0x0000380daa6ULL,
+	0x0003043d957ULL, 0x00030a0e4a2ULL, 0x00030bd7fb0ULL, 0x0003106bc51ULL,
+	0x000331c77f6ULL, 0x00037f16025ULL, 0x00038e81909ULL, 0x0003b2802bfULL,
+	0x00040614e25ULL, 0x00044ff92f9ULL, 0x00044ffd325ULL, 0x00047950dc3ULL,
+	0x0004973d403ULL, 0x0004c276adbULL, 0x00064de9738ULL, 0x000655c2901ULL,
+	0x0006cc350bfULL, 0x0006da95e3fULL, 0x0007964cafaULL, 0x0007a0eb926ULL,
+	0x0007d4f9a96ULL, 0x00081aaf172ULL, 0x00082ad713fULL, 0x00082de9f0fULL,
+	0x006c648d146ULL, 0x006ec846f16ULL, 0x006ee72d149ULL, 0x00707b99d1eULL,
+	0x00707b9c6beULL, 0x00708550ce2ULL, 0x0075b1bd934ULL, 0x0075c1f555bULL,
+	0x0079491d448ULL, 0x00957d6aa49ULL, 0x009f8f3cd4dULL, 0x00a9d0be101ULL,
+	0x00a9e27e93aULL, 0x00b01aad95eULL, 0x00bd7d4565dULL, 0x00d556fa16cULL,
+	0x00d651691e9ULL, 0x00da2585feaULL, 0x00da258f55aULL, 0x00dfec4c183ULL,
+	0x00e27761e2cULL, 0x00fb7abf018ULL, 0x00fb7abf019ULL, 0x00fb7abf01aULL,
+	0x00ff20e4947ULL, 0x00ffec7c29bULL, 0x010fba6934cULL, 0x011d64b43deULL,
+	0x011d68475c0ULL, 0x0134d5dd4efULL, 0x0135d3adc3aULL, 0x03068415d57ULL,
+	0x0308d30f049ULL, 0x03248012405ULL, 0x110290eff91ULL, 0x11048d1493cULL,
+	0x1150f93973eULL, 0x118a24488a1ULL, 0x12ea27588d7ULL, 0x170faed1d94ULL,
+	0x170fc6840b4ULL, 0x19d131bc9dfULL, 0x19f7faa1654ULL, 0x1b0283325d0ULL,
+	0x1b743284f0eULL, 0x1cf7bb32e1eULL, 0x1df512137a0ULL, 0x1ef9f7265e5ULL,
+	0x1f92d9dcf4fULL, 0x21bf956e566ULL, 0x23d23d633baULL, 0x24822f8751bULL,
+	0x2892bdf5f10ULL, 0x290b56718d1ULL, 0x293f8355695ULL, 0x2964b7dc890ULL,
+	0x2a66bdbdd91ULL, 0x2aa02f61857ULL, 0x2ca3b1663b7ULL, 0x2ca3bd48aebULL,
+	0x2cf2b6b211aULL, 0x2e03461c19aULL, 0x30125c1e724ULL,
+};
+
+/*
+ * Checks a bit of a registry bitmap.
+ */
+static int IsLocaleRegistryBitSet(const uint64_t* bitmap, size_t index)
+{
+	return (bitmap[index >> 6] >> (index & 63)) & 1;
+}
+
+/*
+ * Checks if a language (not null-terminated) is registered.
+ */
+static int IsRegisteredLanguage(const char* language, size_t length)
+{
+	size_t index, i;
+	if (length < 2 || length > 3) {
+		return 0;
+	}
+	index = 0;
+	for (i = 0; i < 3; i++) {
+		index *= 27;
+		if (i < length) {
+			if (!IsLocaleAlpha(language[i])) {
+				return 0;
+			}
+			index += (size_t)(ToLowerLocaleChar(language[i]) - 'a' + 1);
+		}
+	}
+	return IsLocaleRegistryBitSet(LocaleRegistryLanguages, index);
+}
+
+/*
+ * Checks if a territory (not null-terminated) is registered.
+ */
+static int IsRegisteredTerritory(const char* territory, size_t length)
+{
+	if (length == 2 && IsLocaleAlpha(territory[0]) && IsLocaleAlpha(territory[1])) {
+		return IsLocaleRegistryBitSet(LocaleRegistryAlphaTerritories, (size_t)(ToLowerLocaleChar(territory[0]) - 'a') * 26 + (size_t)(ToLowerLocaleChar(territory[1]) - 'a'));
+	}
+	if (length == 3 && IsLocaleDigit(territory[0]) && IsLocaleDigit(territory[1]) && IsLocaleDigit(territory[2])) {
+		return IsLocaleRegistryBitSet(LocaleRegistryNumericTerritories, (size_t)(territory[0] - '0') * 100 + (size_t)(territory[1] - '0') * 10 + (size_t)(territory[2] - '0'));
+	}
+	return 0;
+}
+
+/*
+ * Checks if a script (not null-terminated) is registered.
+ */
+static int IsRegisteredScript(const char* script, size_t length)
+{
+	uint32_t packed;
+	size_t i, low, high, middle;
+	if (length != 4) {
+		return 0;
+	}
+	packed = 0;
+	for (i = 0; i < 4; i++) {
+		if (!IsLocaleAlpha(script[i])) {
+			return 0;
+		}
+		packed = packed << 5 | (uint32_t)(ToLowerLocaleChar(script[i]) - 'a' + 1);
+	}
+	for (low = 0, high = LOCALE_REGISTRY_SCRIPT_COUNT; low < high;) {
+		middle = (low + high) / 2;
+		if (LocaleRegistryScripts[middle] < packed) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low < LOCALE_REGISTRY_SCRIPT_COUNT && LocaleRegistryScripts[low] == packed;
+}
+
+/*
+ * Checks if a variant (not null-terminated) is registered.
+ */
+static int IsRegisteredVariant(const char* variant, size_t length)
+{
+	uint64_t packed;
+	size_t i, low, high, middle;
+	if (length < 4 || length > 8) {
+		return 0;
+	}
+	packed = 0;
+	for (i = 0; i < length; i++) {
+		if (IsLocaleDigit(variant[i])) {
+			packed = packed * 37 + (uint64_t)(variant[i] - '0' + 1);
+		} else if (IsLocaleAlpha(variant[i])) {
+			packed = packed * 37 + (uint64_t)(ToLowerLocaleChar(variant[i]) - 'a' + 11);
+		} else {
+			return 0;
+		}
+	}
+	for (low = 0, high = LOCALE_REGISTRY_VARIANT_COUNT; low < high;) {
+		middle = (low + high) / 2;
+		if (LocaleRegistryVariants[middle] < packed) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low < LOCALE_REGISTRY_VARIANT_COUNT && LocaleRegistryVariants[low] == packed;
+}
+
+/*
+ * Checks if a language is one of the special Gettext locales ("C" and "POSIX"), that are valid even if they are not in the registries.
+ */
+static int IsGettextSpecialLanguage(const LocaleSlice* language)
+{
+	return IsLocaleSliceEqual(language, "C") || IsLocaleSliceEqual(language, "POSIX");
+}
+
+/*
+ * Checks if all the subtags of the result of a scan are registered: language, script, territory and variants (the codesets, the modifiers and the extensions are not checked).
+ * Returns 1 if the identifier is valid, 0 otherwise.
+ */
+int IsRegisteredLocaleChunkSlices(const LocaleChunkSlices* slices)
+{
+	const char *p, *end, *variant;
+	if (slices->language.length && !IsRegisteredLanguage(slices->language.start, slices->language.length) && !IsGettextSpecialLanguage(&slices->language)) {
+		return 0;
+	}
+	if (slices->script.length && !IsRegisteredScript(slices->script.start, slices->script.length)) {
+		return 0;
+	}
+	if (slices->territory.length && !IsRegisteredTerritory(slices->territory.start, slices->territory.length)) {
+		return 0;
+	}
+	if (slices->variantCount) {
+		end = slices->variants.start + slices->variants.length;
+		for (variant = p = slices->variants.start; p <= end; p++) {
+			if (p == end || IsLocaleIDTagSeparator(*p)) {
+				if (!IsRegisteredVariant(variant, (size_t)(p - variant))) {
+					return 0;
+				}
+				variant = p + 1;
+			}
+		}
+	}
+	return 1;
+}
+
+/*
+ * Checks if all the subtags of a LocaleChunks are registered (see IsRegisteredLocaleChunkSlices).
+ * Returns 1 if lc is valid, 0 if it's NULL or not valid.
+ */
+int IsRegisteredLocaleChunks(const LocaleChunks* lc)
+{
+	LocaleSlice language;
+	size_t i;
+	if (!lc) {
+		return 0;
+	}
+	SetLocaleSlice(&language, lc->language);
+	if (language.length && !IsRegisteredLanguage(language.start, language.length) && !IsGettextSpecialLanguage(&language)) {
+		return 0;
+	}
+	if (lc->script && !IsRegisteredScript(lc->script, strlen(lc->script))) {
+		return 0;
+	}
+	if (lc->territory && !IsRegisteredTerritory(lc->territory, strlen(lc->territory))) {
+		return 0;
+	}
+	for (i = 0; i < lc->variantCount; i++) {
+		if (!IsRegisteredVariant(lc->variants[i], strlen(lc->variants[i]))) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Contexts: the configuration and the state used by the ...InContext functions (allocator, limits, conversion cache and statistics).
+ * A LocaleContext is not thread-safe: every thread (or tenant) should use its own one, so that its cache and its statistics never need synchronization.
+ * The dictionaries are read-only static tables, and they are shared by every context.
+ * The ...InContext functions accept a NULL context, meaning the default one (malloc, default limits, no cache and no statistics), that can be shared by every thread.
+ * The bulk operations, the LocaleAggregator, the LocaleIDRegistry, the LocaleRouter, the JSON Lines export and the fallback chains take a context too:
+ * they allocate memory with its hooks, and they only accept the identifiers that are within its limits (counting them in its statistics).
+ */
+
+/*
+ * Number of entries of the conversion cache of a LocaleContext (a power of 2).
+ */
+#define LOCALE_CONTEXT_CACHE_SIZE 256
+
+/*
+ * The conversion cache only stores identifiers (and results) shorter than this.
+ */
+#define LOCALE_CONTEXT_CACHE_ID_SIZE 32
+
+/*
+ * Number of identifiers whose cache entries are prefetched together by ConvertLocaleIDsInContext.
+ */
+#define LOCALE_CONTEXT_PROBE_BATCH 16
+
+/*
+ * Flags of a LocaleContext.
+ */
+/* Don't use the conversion cache */
+#define LOCALE_CONTEXT_NO_CACHE 0x01
+/* Don't collect statistics */
+#define LOCALE_CONTEXT_NO_STATS 0x02
+/* Only accept the identifiers whose subtags are registered (see IsRegisteredLocaleChunkSlices) */
+#define LOCALE_CONTEXT_STRICT 0x04
+
+/*
+ * An entry of the conversion cache: invalid identifiers are cached too, with an empty result.
+ */
+typedef struct _LocaleContextCacheEntry {
+	/* Hash of the identifier and of the formats (0 for unused entries) */
+	uint64_t hash;
+	unsigned int inputFormats;
+	unsigned int outputFormat;
+	unsigned char localeLength;
+	unsigned char convertedLength;
+	char locale[LOCALE_CONTEXT_CACHE_ID_SIZE];
+	char converted[LOCALE_CONTEXT_CACHE_ID_SIZE];
+} LocaleContextCacheEntry;
+
+/*
+ * Counters of a LocaleContext.
+ */
+typedef struct _LocaleContextStats {
+	/* Identifiers scanned successfully */
+	size_t scanned;
+	/* Identifiers rejected because they are invalid or because they exceed the limits */
+	size_t rejected;
+	/* Conversions found in the cache */
+	size_t cacheHits;
+	/* Conversions not found in the cache */
+	size_t cacheMisses;
+} LocaleContextStats;
+
+typedef struct _LocaleContext {
+	/* The hooks used to allocate LocaleChunks and identifiers (NULL for malloc) */
+	const LocaleAllocator* allocator;
+	/* LOCALE_CONTEXT_... flags */
+	unsigned int flags;
+	/* Longest accepted identifier */
+	size_t maxLength;
+	/* Maximum number of variants of the accepted identifiers */
+	size_t maxVariants;
+	LocaleContextStats stats;
+	LocaleContextCacheEntry cache[LOCALE_CONTEXT_CACHE_SIZE];
+	/* A bigger conversion cache, used instead of cache if not NULL (see ResizeLocaleContextCache) */
+	LocaleContextCacheEntry* largeCache;
+	size_t largeCacheMask;
+} LocaleContext;
+
+/*
+ * The context used when the ...InContext functions receive NULL: it's never changed.
+ */
+static LocaleContext DefaultLocaleContext = {NULL, LOCALE_CONTEXT_NO_CACHE | LOCALE_CONTEXT_NO_STATS, LOCALE_ID_MAX_LENGTH, (size_t)-1, {0, 0, 0, 0}, {{0}}, NULL, 0};
+
+/*
+ * Initializes a LocaleContext, with the default limits (LOCALE_ID_MAX_LENGTH characters, any number of variants).
+ * allocator are the hooks to be used to allocate the results (NULL for malloc), flags are LOCALE_CONTEXT_... constants.
+ */
+void InitLocaleContext(LocaleContext* context, const LocaleAllocator* allocator, unsigned int flags)
+{
+	memset(context, 0, sizeof(LocaleContext));
+	context->allocator = allocator;
+	context->flags = flags;
+	context->maxLength = LOCALE_ID_MAX_LENGTH;
+	context->maxVariants = (size_t)-1;
+}
+
+/*
+ * Empties the conversion cache of a LocaleContext (for instance, after changing its limits).
+ */
+void ClearLocaleContextCache(LocaleContext* context)
+{
+	memset(context->cache, 0, sizeof(context->cache));
+	if (context->largeCache) {
+		memset(context->largeCache, 0, (context->largeCacheMask + 1) * sizeof(LocaleContextCacheEntry));
+	}
+}
+
+/*
+ * Changes the number of entries of the conversion cache of a LocaleContext (a power of 2), emptying it.
+ * Caches bigger than LOCALE_CONTEXT_CACHE_SIZE entries are allocated with the hooks of the context:
+ * call ResizeLocaleContextCache(context, 0) to release them before discarding the context.
+ * Returns 0 if size is not a power of 2 (or 0) or in case of out-of-memory problems (the cache is left unchanged), 1 otherwise.
+ */
+int ResizeLocaleContextCache(LocaleContext* context, size_t size)
+{
+	LocaleContextCacheEntry* largeCache;
+	if (size & (size - 1)) {
+		return 0;
+	}
+	largeCache = NULL;
+	if (size > LOCALE_CONTEXT_CACHE_SIZE) {
+		largeCache = (LocaleContextCacheEntry*)LocaleAllocate(context->allocator, size * sizeof(LocaleContextCacheEntry));
+		if (!largeCache) {
+			return 0;
+		}
+	}
+	LocaleRelease(context->allocator, context->largeCache);
+	context->largeCache = largeCache;
+	context->largeCacheMask = largeCache ? size - 1 : 0;
+	ClearLocaleContextCache(context);
+	return 1;
+}
+
+/*
+ * Scan a locale identifier trying the formats specified by LOCALE_STREAM_INPUT_... flags, checking the limits of a context (and the registries, in strict mode).
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 1 if locale is valid, 0 otherwise.
+ */
+int ScanLocaleIDInContext(LocaleContext* context, const char* locale, size_t length, unsigned int inputFormats, LocaleChunkSlices* slices)
+{
+	int result;
+	if (!context) {
+		context = &DefaultLocaleContext;
+	}
+	result = locale && length <= context->maxLength && ScanLocaleIDInFormats(locale, length, inputFormats, slices) && slices->variantCount <= context->maxVariants
+		&& (!(context->flags & LOCALE_CONTEXT_STRICT) || IsRegisteredLocaleChunkSlices(slices))
+	;
+	if (!(context->flags & LOCALE_CONTEXT_NO_STATS)) {
+		if (result) {
+			context->stats.scanned++;
+		} else {
+			context->stats.rejected++;
+		}
+	}
+	return result;
+}
+
+/*
+ * Parse a locale identifier trying the formats specified by LOCALE_STREAM_INPUT_... flags, allocating the result with the hooks of a context.
+ * Returns NULL if locale is NULL, invalid or exceeds the limits of the context, or in case of out-of-memory problems.
+ */
+LocaleChunks* LocaleIDToLocaleChunksInContext(LocaleContext* context, const char* locale, size_t length, unsigned int inputFormats)
+{
+	LocaleChunkSlices slices;
+	if (!ScanLocaleIDInContext(context, locale, length, inputFormats, &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, context ? context->allocator : NULL);
+}
+
+/*
+ * Builds the LocaleKey of a locale identifier, in Unicode or in Gettext format, checking the limits of a context (see ScanLocaleIDInContext).
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ * Returns 0 if locale is invalid, if it exceeds the limits of the context or if it can't be represented as a LocaleKey.
+ */
+LocaleKey LocaleIDToLocaleKeyInContext(LocaleContext* context, const char* locale, size_t length)
+{
+	LocaleChunkSlices slices;
+	if (!ScanLocaleIDInContext(context, locale, length, LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT, &slices)) {
+		return 0;
+	}
+	return LocaleChunkSlicesToLocaleKey(&slices);
+}
+
+/*
+ * Convert a LocaleChunks to a specific format (LOCALE_FORMAT_... constants), allocating the result with the hooks of a context.
+ * Returns NULL if lc is NULL or if it can't be represented in the requested format, or in case of out-of-memory problems.
+ */
+char* LocaleChunksToLocaleIDInContext(LocaleContext* context, const LocaleChunks* lc, unsigned int format)
+{
+	char* result;
+	size_t length;
+	result = NULL;
+	length = FormatLocaleChunks(lc, format, NULL, 0);
+	if (length) {
+		result = (char*)LocaleAllocate(context ? context->allocator : NULL, length + 1);
+		if (result) {
+			FormatLocaleChunks(lc, format, result, length + 1);
+		}
+	}
+	return result;
+}
+
+/*
+ * Hashes an identifier together with the formats of a conversion (FNV-1a), never returning 0.
+ */
+static uint64_t HashLocaleContextCacheKey(const char* locale, size_t length, unsigned int inputFormats, unsigned int outputFormat)
+{
+	uint64_t hash;
+	size_t i;
+	hash = 0xcbf29ce484222325ULL ^ ((uint64_t)inputFormats << 32 | outputFormat);
+	for (i = 0; i < length; i++) {
+		hash = (hash ^ (unsigned char)locale[i]) * 0x100000001b3ULL;
+	}
+	return hash ? hash : 1;
+}
+
+/*
+ * Gets the entry of the conversion cache of a context where an identifier with a specific hash is stored.
+ */
+static LocaleContextCacheEntry* GetLocaleContextCacheEntry(LocaleContext* context, uint64_t hash)
+{
+	if (context->largeCache) {
+		return &context->largeCache[hash & context->largeCacheMask];
+	}
+	return &context->cache[hash & (LOCALE_CONTEXT_CACHE_SIZE - 1)];
+}
+
+/*
+ * Checks if an entry of the conversion cache contains the conversion of an identifier: if so, appends the result to a buffer (see AppendToLocaleIDBuffer).
+ * Returns 1 if the conversion has been found, 0 otherwise.
+ */
+static int ProbeLocaleContextCacheEntry(LocaleContext* context, const LocaleContextCacheEntry* entry, uint64_t hash, const char* locale, size_t length, unsigned int inputFormats, unsigned int outputFormat, char* buffer, size_t size, size_t* written)
+{
+	if (entry->hash != hash || entry->inputFormats != inputFormats || entry->outputFormat != outputFormat || entry->localeLength != length || memcmp(entry->locale, locale, length)) {
+		if (!(context->flags & LOCALE_CONTEXT_NO_STATS)) {
+			context->stats.cacheMisses++;
+		}
+		return 0;
+	}
+	if (!(context->flags & LOCALE_CONTEXT_NO_STATS)) {
+		context->stats.cacheHits++;
+	}
+	AppendToLocaleIDBuffer(buffer, size, written, entry->converted, entry->convertedLength);
+	return 1;
+}
+
+/*
+ * Converts an identifier that has not been found in the conversion cache, storing the result in a cache entry (if entry is not NULL).
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the converted identifier (without the null terminator), or 0 if locale is invalid or if it can't be represented in the requested format.
+ */
+static size_t ConvertUncachedLocaleIDInContext(LocaleContext* context, LocaleContextCacheEntry* entry, uint64_t hash, const char* locale, size_t length, unsigned int inputFormats, unsigned int outputFormat, char* buffer, size_t size)
+{
+	LocaleChunkSlices slices;
+	char converted[LOCALE_CONTEXT_CACHE_ID_SIZE];
+	size_t convertedLength, written;
+	convertedLength = 0;
+	if (ScanLocaleIDInContext(context, locale, length, inputFormats, &slices)) {
+		convertedLength = FormatLocaleChunkSlices(&slices, outputFormat, converted, sizeof(converted));
+		if (convertedLength >= sizeof(converted)) {
+			/* Too long to be cached */
+			return FormatLocaleChunkSlices(&slices, outputFormat, buffer, size);
+		}
+	}
+	written = 0;
+	AppendToLocaleIDBuffer(buffer, size, &written, converted, convertedLength);
+	TerminateLocaleIDBuffer(buffer, size, written);
+	if (entry) {
+		entry->hash = hash;
+		entry->inputFormats = inputFormats;
+		entry->outputFormat = outputFormat;
+		entry->localeLength = (unsigned char)length;
+		entry->convertedLength = (unsigned char)convertedLength;
+		memcpy(entry->locale, locale, length);
+		memcpy(entry->converted, converted, convertedLength);
+	}
+	return convertedLength;
+}
+
+/*
+ * Convert a locale identifier (trying the formats specified by LOCALE_STREAM_INPUT_... flags) to a specific format (LOCALE_FORMAT_... constants), using the conversion cache of a context.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the converted identifier (without the null terminator), or 0 if locale is invalid or if it can't be represented in the requested format.
+ */
+size_t ConvertLocaleIDInContext(LocaleContext* context, const char* locale, size_t length, unsigned int inputFormats, unsigned int outputFormat, char* buffer, size_t size)
+{
+	LocaleContextCacheEntry* entry;
+	size_t written;
+	uint64_t hash;
+	if (!context) {
+		context = &DefaultLocaleContext;
+	}
+	entry = NULL;
+	hash = 0;
+	if (!(context->flags & LOCALE_CONTEXT_NO_CACHE) && locale && length < LOCALE_CONTEXT_CACHE_ID_SIZE) {
+		hash = HashLocaleContextCacheKey(locale, length, inputFormats, outputFormat);
+		entry = GetLocaleContextCacheEntry(context, hash);
+		written = 0;
+		if (ProbeLocaleContextCacheEntry(context, entry, hash, locale, length, inputFormats, outputFormat, buffer, size, &written)) {
+			TerminateLocaleIDBuffer(buffer, size, written);
+			return written;
+		}
+	}
+	return ConvertUncachedLocaleIDInContext(context, entry, hash, locale, length, inputFormats, outputFormat, buffer, size);
+}
+
+/*
+ * Converts a list of null-terminated locale identifiers (trying the formats specified by LOCALE_STREAM_INPUT_... flags) to a specific format (LOCALE_FORMAT_... constants),
+ * using the conversion cache of a context, and writing the results to a buffer, one per line (like ConvertLocaleDirectoryListing, invalid identifiers produce empty lines).
+ * The identifiers are processed in groups of LOCALE_CONTEXT_PROBE_BATCH: the cache entries of a whole group are prefetched before being checked,
+ * so that the memory latency of the probes overlaps when the cache is big (see ResizeLocaleContextCache).
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole output (without the null terminator); if convertedCount is not NULL it receives the number of converted identifiers.
+ */
+size_t ConvertLocaleIDsInContext(LocaleContext* context, const char* const* locales, size_t count, unsigned int inputFormats, unsigned int outputFormat, char* buffer, size_t size, size_t* convertedCount)
+{
+	LocaleContextCacheEntry* entries[LOCALE_CONTEXT_PROBE_BATCH];
+	uint64_t hashes[LOCALE_CONTEXT_PROBE_BATCH];
+	size_t lengths[LOCALE_CONTEXT_PROBE_BATCH];
+	size_t first, groupSize, written, start, converted, i;
+	if (!context) {
+		context = &DefaultLocaleContext;
+	}
+	written = 0;
+	converted = 0;
+	for (first = 0; first < count; first += groupSize) {
+		groupSize = count - first < LOCALE_CONTEXT_PROBE_BATCH ? count - first : LOCALE_CONTEXT_PROBE_BATCH;
+		/* First hash the whole group and prefetch its entries (they span two cache lines)... */
+		for (i = 0; i < groupSize; i++) {
+			lengths[i] = locales[first + i] ? strlen(locales[first + i]) : 0;
+			entries[i] = NULL;
+			hashes[i] = 0;
+			if (!(context->flags & LOCALE_CONTEXT_NO_CACHE) && locales[first + i] && lengths[i] < LOCALE_CONTEXT_CACHE_ID_SIZE) {
+				hashes[i] = HashLocaleContextCacheKey(locales[first + i], lengths[i], inputFormats, outputFormat);
+				entries[i] = GetLocaleContextCacheEntry(context, hashes[i]);
+#if defined(__GNUC__)
+				__builtin_prefetch(entries[i]);
+				__builtin_prefetch((const char*)entries[i] + sizeof(LocaleContextCacheEntry) - 1);
+#endif
+			}
+		}
+		/* ... then probe the entries, converting the identifiers not found */
+		for (i = 0; i < groupSize; i++) {
+			start = written;
+			if (!entries[i] || !ProbeLocaleContextCacheEntry(context, entries[i], hashes[i], locales[first + i], lengths[i], inputFormats, outputFormat, buffer, size, &written)) {
+				written += ConvertUncachedLocaleIDInContext(context, entries[i], hashes[i], locales[first + i], lengths[i], inputFormats, outputFormat, written < size ? buffer + written : NULL, written < size ? size - written : 0);
+			}
+			if (written != start) {
+				converted++;
+			}
+			AppendToLocaleIDBuffer(buffer, size, &written, "\n", 1);
+		}
+	}
+	TerminateLocaleIDBuffer(buffer, size, written);
+	if (convertedCount) {
+		*convertedCount = converted;
+	}
+	return written;
+}
+
+/*
+ * Bulk operations on lists of locale identifiers (each one in Unicode or in Gettext format):
+ * identifiers are compared by LocaleKey, so equivalent forms like "sr@latin" and "sr-Latn" are the same locale.
+ * The identifiers without a LocaleKey (like "ca_ES@valencia", "de-DE-1901" or "POSIX") are compared by their canonical ID (see WriteBulkLocaleID),
+ * and the ones that can't be scanned are reported separately.
+ * The results are indices in the lists, in the order of the input: the indices of a second list start after the ones of the first list.
+ */
+#define LOCALE_BULK_ERROR ((size_t)-1)
+
+/*
+ * Maximum length of the canonical IDs of the identifiers without a LocaleKey (the longer ones are reported as invalid).
+ */
+#define LOCALE_BULK_ID_SIZE 256
+
+/*
+ * Writes the canonical ID used to compare an identifier without a LocaleKey, from the result of its scan:
+ * the canonical Unicode ID (or the canonical Gettext ID, if there's no Unicode one) without the codeset,
+ * followed by "@" and the Gettext modifier (if it doesn't identify a script).
+ * Returns the length of the ID, or 0 if it doesn't fit in buffer.
+ */
+static size_t WriteBulkLocaleSlices(const LocaleChunkSlices* scanned, char* buffer, size_t size)
+{
+	LocaleChunkSlices slices;
+	char modifier[32];
+	size_t length, i;
+	slices = *scanned;
+	memset(&slices.codeset, 0, sizeof(LocaleSlice));
+	length = FormatLocaleChunkSlices(&slices, LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE, buffer, size);
+	if (!length) {
+		length = FormatLocaleChunkSlices(&slices, LOCALE_FORMAT_GETTEXT | LOCALE_FORMAT_CANONICAL_CASE, buffer, size);
+	} else if (slices.modifier.length) {
+		if (slices.modifier.length >= sizeof(modifier)) {
+			return 0;
+		}
+		memcpy(modifier, slices.modifier.start, slices.modifier.length);
+		modifier[slices.modifier.length] = '\0';
+		if (!GettextModifierToUnicodeScript(modifier)) {
+			AppendToLocaleIDBuffer(buffer, size, &length, "@", 1);
+			for (i = 0; i < slices.modifier.length; i++) {
+				modifier[i] = ToLowerLocaleChar(modifier[i]);
+			}
+			AppendToLocaleIDBuffer(buffer, size, &length, modifier, slices.modifier.length);
+			TerminateLocaleIDBuffer(buffer, size, length);
+		}
+	}
+	return length < size ? length : 0;
+}
+
+/*
+ * Writes the canonical ID used to compare an identifier without a LocaleKey (see WriteBulkLocaleSlices).
+ * locale doesn't need to be null-terminated.
+ * Returns the length of the ID, or 0 if locale can't be scanned or if its ID doesn't fit in buffer.
+ */
+static size_t WriteBulkLocaleID(const char* locale, size_t length, char* buffer, size_t size)
+{
+	LocaleChunkSlices slices;
+	if (!ScanLocaleIDInFormats(locale, length, LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT, &slices)) {
+		return 0;
+	}
+	return WriteBulkLocaleSlices(&slices, buffer, size);
+}
+
+/*
+ * Scans an identifier of a bulk operation (in Unicode or in Gettext format) checking the limits of a context:
+ * *key receives its LocaleKey, or 0 if it has none (in which case buffer receives its canonical ID: see WriteBulkLocaleSlices).
+ * locale doesn't need to be null-terminated.
+ * Returns the length of the canonical ID (0 if the identifier has a LocaleKey), or LOCALE_BULK_ERROR if the identifier can't be scanned, if it exceeds the limits or if its ID doesn't fit in buffer.
+ */
+static size_t ScanBulkLocaleID(LocaleContext* context, const char* locale, size_t length, LocaleKey* key, char* buffer, size_t size)
+{
+	LocaleChunkSlices slices;
+	if (!ScanLocaleIDInContext(context, locale, length, LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT, &slices)) {
+		return LOCALE_BULK_ERROR;
+	}
+	*key = LocaleChunkSlicesToLocaleKey(&slices);
+	if (*key) {
+		return 0;
+	}
+	length = WriteBulkLocaleSlices(&slices, buffer, size);
+	return length ? length : LOCALE_BULK_ERROR;
+}
+
+/*
+ * An open addressing hash set of locales, sized once for the whole operation (0 marks the empty slots).
+ * The locales with a LocaleKey are stored in keys; the other ones are stored in names, as the index (plus one) of their first identifier,
+ * with the hash of their canonical ID in nameHashes (so that the canonical IDs are only compared when their hashes are the same).
+ * LocaleKeys and the indices never use their highest bit, so a slot can also store a mark in it.
+ */
+#define LOCALE_KEY_HASH_SET_MARK ((LocaleKey)1 << 63)
+typedef struct _LocaleKeyHashSet {
+	LocaleKey* keys;
+	LocaleKey* names;
+	uint64_t* nameHashes;
+	size_t mask;
+	/* The lists of the identifiers (the indices of second start at firstCount) */
+	const char* const* first;
+	size_t firstCount;
+	const char* const* second;
+	/* The context used to scan the identifiers and to allocate the set (NULL for the default one) */
+	LocaleContext* context;
+} LocaleKeyHashSet;
+
+/*
+ * Allocates a LocaleKeyHashSet that can hold count locales, keeping its load factor at most 50%.
+ * Returns 0 in case of out-of-memory problems, 1 otherwise.
+ */
+static int InitLocaleKeyHashSet(LocaleKeyHashSet* set, const char* const* first, size_t firstCount, const char* const* second, size_t secondCount, LocaleContext* context)
+{
+	size_t size;
+	size = 16;
+	while (size < (firstCount + secondCount) * 2) {
+		size *= 2;
+	}
+	set->keys = (LocaleKey*)LocaleAllocate(context ? context->allocator : NULL, 3 * size * sizeof(LocaleKey));
+	if (!set->keys) {
+		return 0;
+	}
+	memset(set->keys, 0, 3 * size * sizeof(LocaleKey));
+	set->names = set->keys + size;
+	set->nameHashes = set->keys + 2 * size;
+	set->mask = size - 1;
+	set->first = first;
+	set->firstCount = firstCount;
+	set->second = second;
+	set->context = context;
+	return 1;
+}
+
+/*
+ * Finds the slot of a key in a LocaleKeyHashSet (the slot is empty if the key is not in the set).
+ */
+static LocaleKey* FindLocaleKeyHashSetSlot(const LocaleKeyHashSet* set, LocaleKey key)
+{
+	size_t slot;
+	slot = (size_t)HashLocaleKey(key) & set->mask;
+	while (set->keys[slot] && (set->keys[slot] & ~LOCALE_KEY_HASH_SET_MARK) != key) {
+		slot = (slot + 1) & set->mask;
+	}
+	return set->keys + slot;
+}
+
+/*
+ * Finds the slot of the index-th identifier of the lists of a LocaleKeyHashSet (the slot is empty if its locale is not in the set),
+ * and sets *value and *hash to what the slot should store (*hash is only used by the identifiers without a LocaleKey).
+ * Returns NULL if the identifier can't be scanned (or if it exceeds the limits of the context of the set).
+ */
+static LocaleKey* FindLocaleIDHashSetSlot(const LocaleKeyHashSet* set, size_t index, LocaleKey* value, uint64_t* nameHash)
+{
+	char name[LOCALE_BULK_ID_SIZE], other[LOCALE_BULK_ID_SIZE];
+	const char* locale;
+	size_t length, slot, i;
+	uint64_t hash;
+	locale = index < set->firstCount ? set->first[index] : set->second[index - set->firstCount];
+	length = ScanBulkLocaleID(set->context, locale, strlen(locale), value, name, sizeof(name));
+	if (length == LOCALE_BULK_ERROR) {
+		return NULL;
+	}
+	if (*value) {
+		return FindLocaleKeyHashSetSlot(set, *value);
+	}
+	*value = (LocaleKey)index + 1;
+	for (i = 0, hash = 0xcbf29ce484222325ULL; i < length; i++) {
+		hash = (hash ^ (unsigned char)name[i]) * 0x100000001b3ULL;
+	}
+	*nameHash = hash;
+	for (slot = (size_t)HashLocaleKey(hash) & set->mask; set->names[slot]; slot = (slot + 1) & set->mask) {
+		if (set->nameHashes[slot] != hash) {
+			continue;
+		}
+		index = (size_t)(set->names[slot] & ~LOCALE_KEY_HASH_SET_MARK) - 1;
+		locale = index < set->firstCount ? set->first[index] : set->second[index - set->firstCount];
+		if (WriteBulkLocaleID(locale, strlen(locale), other, sizeof(other)) == length && !memcmp(name, other, length)) {
+			break;
+		}
+	}
+	return set->names + slot;
+}
+
+/*
+ * Stores a value in an empty slot of a LocaleKeyHashSet, with the hash of the canonical ID if the slot is in names.
+ */
+static void SetLocaleIDHashSetSlot(LocaleKeyHashSet* set, LocaleKey* slot, LocaleKey value, uint64_t nameHash)
+{
+	*slot = value;
+	if (slot >= set->names && slot < set->nameHashes) {
+		set->nameHashes[slot - set->names] = nameHash;
+	}
+}
+
+/*
+ * Adds the locales of a range of the lists of a LocaleKeyHashSet to the set.
+ * If indices is not NULL, it receives the indices of the identifiers whose locale has been added, in the order of the input, and *count is incremented.
+ * If invalid and invalidCount are not NULL, invalid receives the indices of the identifiers that can't be scanned, and *invalidCount is incremented.
+ */
+static void AddLocaleIDsToLocaleKeyHashSet(LocaleKeyHashSet* set, size_t from, size_t to, size_t* indices, size_t* count, size_t* invalid, size_t* invalidCount)
+{
+	LocaleKey value, *slot;
+	uint64_t nameHash;
+	size_t i;
+	for (i = from; i < to; i++) {
+		slot = FindLocaleIDHashSetSlot(set, i, &value, &nameHash);
+		if (!slot) {
+			if (invalid && invalidCount) {
+				invalid[(*invalidCount)++] = i;
+			}
+		} else if (!*slot) {
+			SetLocaleIDHashSetSlot(set, slot, value, nameHash);
+			if (indices) {
+				indices[(*count)++] = i;
+			}
+		}
+	}
+}
+
+/*
+ * Finds the distinct locales of a list: indices receives the index of the first identifier of every locale (so it must have room for count items).
+ * If invalid and invalidCount are not NULL, invalid receives the indices of the identifiers that can't be scanned (so it must have room for count items), and *invalidCount their number.
+ * The identifiers are scanned within the limits of a context, whose hooks are used for the temporary memory (NULL for the default context).
+ * Returns the number of indices, or LOCALE_BULK_ERROR in case of out-of-memory problems.
+ */
+size_t DedupeLocaleIDs(const char* const* locales, size_t count, LocaleContext* context, size_t* indices, size_t* invalid, size_t* invalidCount)
+{
+	LocaleKeyHashSet set;
+	size_t result;
+	if (invalidCount) {
+		*invalidCount = 0;
+	}
+	if (!InitLocaleKeyHashSet(&set, locales, count, NULL, 0, context)) {
+		return LOCALE_BULK_ERROR;
+	}
+	result = 0;
+	AddLocaleIDsToLocaleKeyHashSet(&set, 0, count, indices, &result, invalid, invalidCount);
+	LocaleRelease(context ? context->allocator : NULL, set.keys);
+	return result;
+}
+
+/*
+ * Finds the distinct locales of two lists: indices receives the index of the first identifier of every locale,
+ * where the indices of b start after the ones of a (so b[0] is aCount, and indices must have room for aCount + bCount items).
+ * If invalid and invalidCount are not NULL, invalid receives the indices of the identifiers that can't be scanned (so it must have room for aCount + bCount items), and *invalidCount their number.
+ * The identifiers are scanned within the limits of a context, whose hooks are used for the temporary memory (NULL for the default context).
+ * Returns the number of indices, or LOCALE_BULK_ERROR in case of out-of-memory problems.
+ */
+size_t UniteLocaleIDs(const char* const* a, size_t aCount, const char* const* b, size_t bCount, LocaleContext* context, size_t* indices, size_t* invalid, size_t* invalidCount)
+{
+	LocaleKeyHashSet set;
+	size_t result;
+	if (invalidCount) {
+		*invalidCount = 0;
+	}
+	if (!InitLocaleKeyHashSet(&set, a, aCount, b, bCount, context)) {
+		return LOCALE_BULK_ERROR;
+	}
+	result = 0;
+	AddLocaleIDsToLocaleKeyHashSet(&set, 0, aCount + bCount, indices, &result, invalid, invalidCount);
+	LocaleRelease(context ? context->allocator : NULL, set.keys);
+	return result;
+}
+
+/*
+ * Finds the distinct locales of a that are (if keep is 1) or that are not (if keep is 0) in b.
+ * The locales of b are added to the set first: the locales of a that have already been returned are marked.
+ */
+static size_t FilterLocaleIDs(const char* const* a, size_t aCount, const char* const* b, size_t bCount, int keep, LocaleContext* context, size_t* indices, size_t* invalid, size_t* invalidCount)
+{
+	LocaleKeyHashSet set;
+	LocaleKey value, *slot;
+	uint64_t nameHash;
+	size_t result, i;
+	if (invalidCount) {
+		*invalidCount = 0;
+	}
+	if (!InitLocaleKeyHashSet(&set, a, aCount, b, bCount, context)) {
+		return LOCALE_BULK_ERROR;
+	}
+	result = 0;
+	AddLocaleIDsToLocaleKeyHashSet(&set, aCount, aCount + bCount, NULL, NULL, NULL, NULL);
+	for (i = 0; i < aCount; i++) {
+		slot = FindLocaleIDHashSetSlot(&set, i, &value, &nameHash);
+		if (!slot) {
+			if (invalid && invalidCount) {
+				invalid[(*invalidCount)++] = i;
+			}
+			continue;
+		}
+		if (!(*slot & LOCALE_KEY_HASH_SET_MARK) && (*slot != 0) == keep) {
+			if (*slot) {
+				*slot |= LOCALE_KEY_HASH_SET_MARK;
+			} else {
+				SetLocaleIDHashSetSlot(&set, slot, value | LOCALE_KEY_HASH_SET_MARK, nameHash);
+			}
+			indices[result++] = i;
+		}
+	}
+	LocaleRelease(context ? context->allocator : NULL, set.keys);
+	return result;
+}
+
+/*
+ * Finds the distinct locales of a that are also in b: indices receives the index in a of the first identifier of every locale (so it must have room for aCount items).
+ * If invalid and invalidCount are not NULL, invalid receives the indices in a of the identifiers that can't be scanned (so it must have room for aCount items), and *invalidCount their number.
+ * The identifiers are scanned within the limits of a context, whose hooks are used for the temporary memory (NULL for the default context).
+ * Returns the number of indices, or LOCALE_BULK_ERROR in case of out-of-memory problems.
+ */
+size_t IntersectLocaleIDs(const char* const* a, size_t aCount, const char* const* b, size_t bCount, LocaleContext* context, size_t* indices, size_t* invalid, size_t* invalidCount)
+{
+	return FilterLocaleIDs(a, aCount, b, bCount, 1, context, indices, invalid, invalidCount);
+}
+
+/*
+ * Finds the distinct locales of a that are not in b (for example, the catalogs that are missing from a configuration):
+ * indices receives the index in a of the first identifier of every locale (so it must have room for aCount items).
+ * If invalid and invalidCount are not NULL, invalid receives the indices in a of the identifiers that can't be scanned (so it must have room for aCount items), and *invalidCount their number:
+ * they are not in the result, since it's unknown whether b has them.
+ * The identifiers are scanned within the limits of a context, whose hooks are used for the temporary memory (NULL for the default context).
+ * Returns the number of indices, or LOCALE_BULK_ERROR in case of out-of-memory problems.
+ */
+size_t SubtractLocaleIDs(const char* const* a, size_t aCount, const char* const* b, size_t bCount, LocaleContext* context, size_t* indices, size_t* invalid, size_t* invalidCount)
+{
+	return FilterLocaleIDs(a, aCount, b, bCount, 0, context, indices, invalid, invalidCount);
+}
+
+/*
+ * Aggregation of streams of locale identifiers (for example, the locale distribution of log lines).
+ * Identifiers are counted by LocaleKey: counts can be exact, or approximated in bounded memory with the Space-Saving algorithm
+ * (Metwally, Agrawal, El Abbadi: "Efficient Computation of Frequent and Top-k Elements in Data Streams").
+ * An aggregator is not thread-safe: every thread should use its own one, and the aggregators can be merged at the end.
+ */
+
+/*
+ * Number of entries of the cache of the canonicalized identifiers of a LocaleAggregator (a power of 2).
+ */
+#define LOCALE_AGGREGATOR_CACHE_SIZE 256
+
+/*
+ * The cache only stores identifiers shorter than this.
+ */
+#define LOCALE_AGGREGATOR_CACHE_ID_SIZE 24
+
+typedef struct _LocaleAggregatorEntry {
+	LocaleKey key;
+	/* The number of occurrences (in Space-Saving mode it may be overestimated, by up to error) */
+	uint64_t count;
+	/* The maximum overestimation of count (always 0 for exact counts) */
+	uint64_t error;
+} LocaleAggregatorEntry;
+
+typedef struct _LocaleAggregatorCacheEntry {
+	LocaleKey key;
+	size_t length;
+	char locale[LOCALE_AGGREGATOR_CACHE_ID_SIZE];
+} LocaleAggregatorCacheEntry;
+
+typedef struct _LocaleAggregator {
+	/* The counted keys */
+	LocaleAggregatorEntry* entries;
+	/* Number of counted keys */
+	size_t count;
+	/* Number of keys that can be stored without growing the aggregator */
+	size_t capacity;
+	/* Maximum number of counted keys for the Space-Saving mode (0 for exact counts) */
+	size_t maxCount;
+	/* Open addressing hash table of the entry indices plus one (0 for empty slots) */
+	uint32_t* slots;
+	/* Number of slots (a power of 2, at least twice the capacity) */
+	size_t slotCount;
+	/* In Space-Saving mode, a binary min-heap of the entry indices by count (so that the smallest count is found in constant time), and the position of every entry in it */
+	uint32_t* heap;
+	uint32_t* heapPositions;
+	/* Number of aggregated identifiers, including the invalid ones */
+	uint64_t total;
+	/* Number of identifiers that can't be represented as a LocaleKey */
+	uint64_t invalid;
+	/* The last canonicalized identifiers */
+	LocaleAggregatorCacheEntry cache[LOCALE_AGGREGATOR_CACHE_SIZE];
+	/* The context used to scan the identifiers (NULL for the default one) */
+	LocaleContext* context;
+	/* The hooks used to allocate the memory of the aggregator (the ones of the context) */
+	const LocaleAllocator* allocator;
+} LocaleAggregator;
+
+/*
+ * Initializes an empty LocaleAggregator that scans the identifiers within the limits of a context, and allocates memory with its hooks
+ * (NULL for the default context; the context must outlive the aggregator).
+ * maxCount is the maximum number of keys counted with the Space-Saving algorithm (0 for exact counts of every key).
+ */
+void InitLocaleAggregator(LocaleAggregator* aggregator, size_t maxCount, LocaleContext* context)
+{
+	memset(aggregator, 0, sizeof(LocaleAggregator));
+	aggregator->maxCount = maxCount;
+	aggregator->context = context;
+	aggregator->allocator = context ? context->allocator : NULL;
+}
+
+/*
+ * Frees the memory used by a LocaleAggregator (that can then be used again, as if it has just been initialized).
+ */
+void FreeLocaleAggregator(LocaleAggregator* aggregator)
+{
+	LocaleRelease(aggregator->allocator, aggregator->entries);
+	LocaleRelease(aggregator->allocator, aggregator->slots);
+	LocaleRelease(aggregator->allocator, aggregator->heap);
+	InitLocaleAggregator(aggregator, aggregator->maxCount, aggregator->context);
+}
+
+/*
+ * Finds the slot of a key in the hash table of an aggregator (the slot is empty if the key is not counted).
+ */
+static size_t FindLocaleAggregatorSlot(const LocaleAggregator* aggregator, LocaleKey key)
+{
+	size_t slot;
+	slot = (size_t)HashLocaleKey(key) & (aggregator->slotCount - 1);
+	while (aggregator->slots[slot] && aggregator->entries[aggregator->slots[slot] - 1].key != key) {
+		slot = (slot + 1) & (aggregator->slotCount - 1);
+	}
+	return slot;
+}
+
+/*
+ * Removes a slot from the hash table of an aggregator, moving back the following slots of the same cluster (so that no tombstones are needed).
+ */
+static void RemoveLocaleAggregatorSlot(LocaleAggregator* aggregator, size_t slot)
+{
+	size_t next, home, mask;
+	mask = aggregator->slotCount - 1;
+	aggregator->slots[slot] = 0;
+	for (next = (slot + 1) & mask; aggregator->slots[next]; next = (next + 1) & mask) {
+		home = (size_t)HashLocaleKey(aggregator->entries[aggregator->slots[next] - 1].key) & mask;
+		/* Move the entry back if its home slot is not in the cyclic range (slot, next] */
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			aggregator->slots[slot] = aggregator->slots[next];
+			aggregator->slots[next] = 0;
+			slot = next;
+		}
+	}
+}
+
+/*
+ * Swaps two positions of the heap of an aggregator.
+ */
+static void SwapLocaleAggregatorHeap(LocaleAggregator* aggregator, size_t a, size_t b)
+{
+	uint32_t index;
+	index = aggregator->heap[a];
+	aggregator->heap[a] = aggregator->heap[b];
+	aggregator->heap[b] = index;
+	aggregator->heapPositions[aggregator->heap[a]] = (uint32_t)a;
+	aggregator->heapPositions[aggregator->heap[b]] = (uint32_t)b;
+}
+
+/*
+ * Moves an entry up the heap of an aggregator (after it has been appended).
+ */
+static void SiftUpLocaleAggregatorHeap(LocaleAggregator* aggregator, size_t position)
+{
+	size_t parent;
+	while (position > 0) {
+		parent = (position - 1) / 2;
+		if (aggregator->entries[aggregator->heap[parent]].count <= aggregator->entries[aggregator->heap[position]].count) {
+			break;
+		}
+		SwapLocaleAggregatorHeap(aggregator, parent, position);
+		position = parent;
+	}
+}
+
+/*
+ * Moves an entry down the heap of an aggregator (after its count has been increased).
+ */
+static void SiftDownLocaleAggregatorHeap(LocaleAggregator* aggregator, size_t position)
+{
+	size_t child;
+	for (;;) {
+		child = position * 2 + 1;
+		if (child >= aggregator->count) {
+			break;
+		}
+		if (child + 1 < aggregator->count && aggregator->entries[aggregator->heap[child + 1]].count < aggregator->entries[aggregator->heap[child]].count) {
+			child++;
+		}
+		if (aggregator->entries[aggregator->heap[position]].count <= aggregator->entries[aggregator->heap[child]].count) {
+			break;
+		}
+		SwapLocaleAggregatorHeap(aggregator, position, child);
+		position = child;
+	}
+}
+
+/*
+ * Grows the capacity of an aggregator, rebuilding its hash table.
+ * Returns 0 in case of out-of-memory problems (the aggregator is not changed), 1 otherwise.
+ */
+static int GrowLocaleAggregator(LocaleAggregator* aggregator)
+{
+	LocaleAggregatorEntry* entries;
+	uint32_t *slots, *heap;
+	size_t capacity, slotCount, i;
+	capacity = aggregator->capacity ? aggregator->capacity * 2 : 64;
+	if (aggregator->maxCount && capacity > aggregator->maxCount) {
+		capacity = aggregator->maxCount;
+	}
+	slotCount = 16;
+	while (slotCount < capacity * 2) {
+		slotCount *= 2;
+	}
+	entries = (LocaleAggregatorEntry*)LocaleAllocate(aggregator->allocator, capacity * sizeof(LocaleAggregatorEntry));
+	slots = (uint32_t*)LocaleAllocate(aggregator->allocator, slotCount * sizeof(uint32_t));
+	heap = aggregator->maxCount ? (uint32_t*)LocaleAllocate(aggregator->allocator, 2 * capacity * sizeof(uint32_t)) : NULL;
+	if (!entries || !slots || (aggregator->maxCount && !heap)) {
+		LocaleRelease(aggregator->allocator, entries);
+		LocaleRelease(aggregator->allocator, slots);
+		LocaleRelease(aggregator->allocator, heap);
+		return 0;
+	}
+	if (aggregator->count) {
+		memcpy(entries, aggregator->entries, aggregator->count * sizeof(LocaleAggregatorEntry));
+		if (heap) {
+			memcpy(heap, aggregator->heap, aggregator->count * sizeof(uint32_t));
+			memcpy(heap + capacity, aggregator->heapPositions, aggregator->count * sizeof(uint32_t));
+		}
+	}
+	memset(slots, 0, slotCount * sizeof(uint32_t));
+	LocaleRelease(aggregator->allocator, aggregator->entries);
+	LocaleRelease(aggregator->allocator, aggregator->slots);
+	LocaleRelease(aggregator->allocator, aggregator->heap);
+	aggregator->entries = entries;
+	aggregator->capacity = capacity;
+	aggregator->slots = slots;
+	aggregator->slotCount = slotCount;
+	aggregator->heap = heap;
+	aggregator->heapPositions = heap ? heap + capacity : NULL;
+	for (i = 0; i < aggregator->count; i++) {
+		aggregator->slots[FindLocaleAggregatorSlot(aggregator, entries[i].key)] = (uint32_t)(i + 1);
+	}
+	return 1;
+}
+
+/*
+ * Counts occurrences of a LocaleKey.
+ * In Space-Saving mode, when the aggregator is full a new key replaces the one with the smallest count (inheriting its count as error).
+ * Returns 0 if key is 0 or in case of out-of-memory problems, 1 otherwise.
+ */
+int AggregateLocaleKey(LocaleAggregator* aggregator, LocaleKey key, uint64_t count)
+{
+	LocaleAggregatorEntry* entry;
+	size_t slot, index;
+	if (!key) {
+		return 0;
+	}
+	if (aggregator->count) {
+		slot = FindLocaleAggregatorSlot(aggregator, key);
+		if (aggregator->slots[slot]) {
+			index = aggregator->slots[slot] - 1;
+			aggregator->entries[index].count += count;
+			if (aggregator->heap) {
+				SiftDownLocaleAggregatorHeap(aggregator, aggregator->heapPositions[index]);
+			}
+			return 1;
+		}
+	}
+	if (aggregator->count == aggregator->capacity && !(aggregator->maxCount && aggregator->count == aggregator->maxCount) && !GrowLocaleAggregator(aggregator)) {
+		return 0;
+	}
+	if (aggregator->count < aggregator->capacity) {
+		index = aggregator->count++;
+		entry = aggregator->entries + index;
+		entry->count = count;
+		entry->error = 0;
+		entry->key = key;
+		if (aggregator->heap) {
+			aggregator->heap[index] = (uint32_t)index;
+			aggregator->heapPositions[index] = (uint32_t)index;
+			SiftUpLocaleAggregatorHeap(aggregator, index);
+		}
+	} else {
+		/* Space-Saving: replace the key with the smallest count (the top of the heap) */
+		index = aggregator->heap[0];
+		entry = aggregator->entries + index;
+		RemoveLocaleAggregatorSlot(aggregator, FindLocaleAggregatorSlot(aggregator, entry->key));
+		entry->error = entry->count;
+		entry->count += count;
+		entry->key = key;
+		SiftDownLocaleAggregatorHeap(aggregator, 0);
+	}
+	aggregator->slots[FindLocaleAggregatorSlot(aggregator, key)] = (uint32_t)(index + 1);
+	return 1;
+}
+
+/*
+ * Counts an occurrence of a locale identifier (in Unicode or in Gettext format).
+ * The identifiers are canonicalized with a cache, so repeated identifiers are not parsed again (nor counted again in the statistics of the context).
+ * locale doesn't need to be null-terminated.
+ * Returns 0 if locale exceeds the limits of the context or can't be represented as a LocaleKey (it's counted as invalid) or in case of out-of-memory problems, 1 otherwise.
+ */
+int AggregateLocaleID(LocaleAggregator* aggregator, const char* locale, size_t length)
+{
+	LocaleAggregatorCacheEntry* cached;
+	LocaleKey key;
+	uint64_t hash;
+	size_t i;
+	aggregator->total++;
+	cached = NULL;
+	if (length < LOCALE_AGGREGATOR_CACHE_ID_SIZE) {
+		for (i = 0, hash = 0xcbf29ce484222325ULL; i < length; i++) {
+			hash = (hash ^ (unsigned char)locale[i]) * 0x100000001b3ULL;
+		}
+		cached = &aggregator->cache[hash & (LOCALE_AGGREGATOR_CACHE_SIZE - 1)];
+		if (cached->length == length && length && !memcmp(cached->locale, locale, length)) {
+			key = cached->key;
+		} else {
+			key = LocaleIDToLocaleKeyInContext(aggregator->context, locale, length);
+			cached->key = key;
+			cached->length = length;
+			memcpy(cached->locale, locale, length);
+		}
+	} else {
+		key = LocaleIDToLocaleKeyInContext(aggregator->context, locale, length);
+	}
+	if (!key) {
+		aggregator->invalid++;
+		return 0;
+	}
+	return AggregateLocaleKey(aggregator, key, 1);
+}
+
+static int CompareLocaleAggregatorEntries(const void* a, const void* b)
+{
+	const LocaleAggregatorEntry *ea, *eb;
+	ea = (const LocaleAggregatorEntry*)a;
+	eb = (const LocaleAggregatorEntry*)b;
+	if (ea->count != eb->count) {
+		return ea->count > eb->count ? -1 : 1;
+	}
+	return CompareLocaleKeys(ea->key, eb->key);
+}
+
+/*
+ * Gets the count that a full Space-Saving aggregator may have missed for the keys it doesn't hold (its smallest count), or 0 for exact counts.
+ */
+static uint64_t GetLocaleAggregatorMissedCount(const LocaleAggregator* aggregator)
+{
+	return aggregator->heap && aggregator->count == aggregator->maxCount ? aggregator->entries[aggregator->heap[0]].count : 0;
+}
+
+/*
+ * Adds the counts of an aggregator (for example, the one of another thread) to another one.
+ * Like in the mergeable summaries of Agarwal et al., the keys that are missing from a full Space-Saving aggregator
+ * get its smallest count (both as count and as error), and in Space-Saving mode only the keys with the highest counts are kept.
+ * Returns 0 in case of out-of-memory problems (the counts are not changed), 1 otherwise.
+ */
+int MergeLocaleAggregators(LocaleAggregator* aggregator, const LocaleAggregator* other)
+{
+	LocaleAggregatorEntry* merged;
+	uint64_t missed, otherMissed;
+	size_t count, slot, i;
+	if (other->count) {
+		merged = (LocaleAggregatorEntry*)LocaleAllocate(aggregator->allocator, (aggregator->count + other->count) * sizeof(LocaleAggregatorEntry));
+		if (!merged) {
+			return 0;
+		}
+		missed = GetLocaleAggregatorMissedCount(aggregator);
+		otherMissed = GetLocaleAggregatorMissedCount(other);
+		for (i = 0; i < aggregator->count; i++) {
+			merged[i] = aggregator->entries[i];
+			slot = FindLocaleAggregatorSlot(other, merged[i].key);
+			if (other->slots[slot]) {
+				merged[i].count += other->entries[other->slots[slot] - 1].count;
+				merged[i].error += other->entries[other->slots[slot] - 1].error;
+			} else {
+				merged[i].count += otherMissed;
+				merged[i].error += otherMissed;
+			}
+		}
+		count = aggregator->count;
+		for (i = 0; i < other->count; i++) {
+			if (!aggregator->count || !aggregator->slots[FindLocaleAggregatorSlot(aggregator, other->entries[i].key)]) {
+				merged[count] = other->entries[i];
+				merged[count].count += missed;
+				merged[count].error += missed;
+				count++;
+			}
+		}
+		if (aggregator->maxCount && count > aggregator->maxCount) {
+			qsort(merged, count, sizeof(LocaleAggregatorEntry), CompareLocaleAggregatorEntries);
+			count = aggregator->maxCount;
+		}
+		while (aggregator->capacity < count) {
+			if (!GrowLocaleAggregator(aggregator)) {
+				LocaleRelease(aggregator->allocator, merged);
+				return 0;
+			}
+		}
+		memcpy(aggregator->entries, merged, count * sizeof(LocaleAggregatorEntry));
+		LocaleRelease(aggregator->allocator, merged);
+		aggregator->count = count;
+		memset(aggregator->slots, 0, aggregator->slotCount * sizeof(uint32_t));
+		for (i = 0; i < count; i++) {
+			aggregator->slots[FindLocaleAggregatorSlot(aggregator, aggregator->entries[i].key)] = (uint32_t)(i + 1);
+			if (aggregator->heap) {
+				aggregator->heap[i] = (uint32_t)i;
+				aggregator->heapPositions[i] = (uint32_t)i;
+			}
+		}
+		for (i = count / 2; aggregator->heap && i-- > 0; ) {
+			SiftDownLocaleAggregatorHeap(aggregator, i);
+		}
+	}
+	aggregator->total += other->total;
+	aggregator->invalid += other->invalid;
+	return 1;
+}
+
+/*
+ * Get the count of a LocaleKey (in Space-Saving mode it may be overestimated).
+ */
+uint64_t GetLocaleAggregatorCount(const LocaleAggregator* aggregator, LocaleKey key)
+{
+	size_t slot;
+	if (!aggregator->count || !key) {
+		return 0;
+	}
+	slot = FindLocaleAggregatorSlot(aggregator, key);
+	return aggregator->slots[slot] ? aggregator->entries[aggregator->slots[slot] - 1].count : 0;
+}
+
+/*
+ * Get the most frequent keys of an aggregator (sorted by count, then by key).
+ * top must have room for size entries.
+ * Returns the number of entries written to top.
+ */
+size_t GetLocaleAggregatorTop(const LocaleAggregator* aggregator, LocaleAggregatorEntry* top, size_t size)
+{
+	LocaleAggregatorEntry entry;
+	size_t count, i, j;
+	count = 0;
+	/* Keep the best entries sorted in top, with an insertion sort (size is usually small) */
+	for (i = 0; i < aggregator->count; i++) {
+		entry = aggregator->entries[i];
+		if (count == size && (!size || CompareLocaleAggregatorEntries(&entry, &top[count - 1]) >= 0)) {
+			continue;
+		}
+		j = count < size ? count++ : count - 1;
+		for (; j > 0 && CompareLocaleAggregatorEntries(&entry, &top[j - 1]) < 0; j--) {
+			top[j] = top[j - 1];
+		}
+		top[j] = entry;
+	}
+	return count;
+}
+
+/*
+ * Windows locale identifiers (LCIDs).
+ * The lower 10 bits of an LCID are the primary language, the next 6 bits are the sublanguage, and bits 16-19 are the sort ID.
+ * Source: [MS-LCID] Windows Language Code Identifier (LCID) Reference (the tables are generated by tools/generate-lcid-tables.py).
+ */
+typedef uint32_t LCID;
+
+#define LCID_PRIMARY_LANGUAGE_COUNT 147
+#define LCID_SUBLANGUAGE_ENTRIES 457
+#define LCID_HASH_BUCKETS 128
+#define LCID_HASH_SLOTS 512
+
+/*
+ * LCID to LocaleKey, first level: for every primary language, the offset and the number of its entries in the second level.
+ */
+static const struct {
+	uint16_t offset;
+	uint8_t count;
+} LCIDPrimaryLanguages[LCID_PRIMARY_LANGUAGE_COUNT] = {
+	{0, 0}, {0, 17}, {17, 2}, {19, 2}, {21, 32}, {53, 2}, {55, 2}, {57, 6},
+	{63, 2}, {65, 20}, {85, 24}, {109, 2}, {111, 16}, {127, 2}, {129, 2}, {131, 2},
+	{133, 3}, {136, 2}, {138, 2}, {140, 3}, {143, 32}, {175, 2}, {177, 3}, {180, 2},
+	{182, 3}, {185, 3}, {188, 32}, {220, 2}, {222, 2}, {224, 3}, {227, 2}, {229, 2},
+	{231, 3}, {234, 2}, {236, 2}, {238, 2}, {240, 2}, {242, 2}, {244, 2}, {246, 2},
+	{248, 2}, {250, 2}, {252, 2}, {254, 2}, {256, 3}, {259, 2}, {261, 3}, {264, 2},
+	{266, 2}, {268, 2}, {270, 3}, {273, 2}, {275, 2}, {277, 2}, {279, 2}, {281, 2},
+	{283, 2}, {285, 2}, {287, 2}, {289, 10}, {299, 3}, {302, 2}, {304, 3}, {307, 2},
+	{309, 2}, {311, 2}, {313, 2}, {315, 3}, {318, 2}, {320, 3}, {323, 3}, {326, 2},
+	{328, 2}, {330, 3}, {333, 2}, {335, 2}, {337, 2}, {339, 2}, {341, 2}, {343, 2},
+	{345, 4}, {349, 2}, {351, 2}, {353, 2}, {355, 2}, {357, 2}, {359, 2}, {361, 2},
+	{0, 0}, {363, 3}, {366, 2}, {368, 2}, {370, 2}, {372, 3}, {375, 2}, {377, 3},
+	{380, 2}, {382, 3}, {385, 2}, {387, 2}, {389, 2}, {391, 2}, {0, 0}, {393, 3},
+	{396, 2}, {0, 0}, {398, 2}, {400, 4}, {404, 2}, {406, 2}, {408, 2}, {410, 2},
+	{412, 2}, {0, 0}, {414, 2}, {416, 3}, {419, 2}, {421, 2}, {0, 0}, {423, 2},
+	{425, 2}, {0, 0}, {427, 2}, {0, 0}, {429, 2}, {0, 0}, {431, 2}, {0, 0},
+	{433, 2}, {435, 2}, {437, 2}, {439, 2}, {441, 2}, {443, 2}, {445, 2}, {447, 2},
+	{449, 2}, {0, 0}, {0, 0}, {0, 0}, {451, 2}, {0, 0}, {0, 0}, {0, 0},
+	{0, 0}, {453, 2}, {455, 2}
+};
+
+/*
+ * LCID to LocaleKey, second level: indexed by the offset of the primary language plus the sublanguage (0 if there's no such LCID).
+ */
+static const LocaleKey LCIDSublanguages[LCID_SUBLANGUAGE_ENTRIES] = {
+	/* 0x01: ar ar_SA ar_IQ ar_EG ar_LY ar_DZ ar_MA ar_TN ar_OM ar_YE ar_SY ar_JO ar_LB ar_KW ar_AE ar_BH ar_QA */
+	0x06e4000000000000ULL, 0x06e4003a58000000ULL, 0x06e40026d8000000ULL, 0x06e4001e88000000ULL,
+	0x06e4002d18000000ULL, 0x06e4001d20000000ULL, 0x06e4002e58000000ULL, 0x06e4003cc0000000ULL,
+	0x06e40032b8000000ULL, 0x06e4004678000000ULL, 0x06e4003b18000000ULL, 0x06e40028c8000000ULL,
+	0x06e4002c60000000ULL, 0x06e4002b08000000ULL, 0x06e4001678000000ULL, 0x06e4001890000000ULL,
+	0x06e4003658000000ULL,
+	/* 0x02: bg bg_BG */
+	0x070e000000000000ULL, 0x070e001888000000ULL,
+	/* 0x03: ca ca_ES */
+	0x0742000000000000ULL, 0x0742001ee8000000ULL,
+	/* 0x04: zh_Hans zh_TW zh_CN zh_HK zh_SG zh_MO - - - - - - - - - - - - - - - - - - - - - - - - - zh_Hant */
+	0x0d1000252b130000ULL, 0x0d10003d08000000ULL, 0x0d10001ac0000000ULL, 0x0d100024a8000000ULL,
+	0x0d10003a88000000ULL, 0x0d10002ec8000000ULL, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0x0d1000252b140000ULL,
+	/* 0x05: cs cs_CZ */
+	0x0766000000000000ULL, 0x0766001b20000000ULL,
+	/* 0x06: da da_DK */
+	0x0782000000000000ULL, 0x0782001ca8000000ULL,
+	/* 0x07: de de_DE de_CH de_AT de_LU de_LI */
+	0x078a000000000000ULL, 0x078a001c78000000ULL, 0x078a001a90000000ULL, 0x078a0016f0000000ULL,
+	0x078a002cf8000000ULL, 0x078a002c98000000ULL,
+	/* 0x08: el el_GR */
+	0x07d8000000000000ULL, 0x07d80022e0000000ULL,
+	/* 0x09: en en_US en_GB en_AU en_CA en_NZ en_IE en_ZA en_JM en_029 en_BZ en_TT en_ZW en_PH en_ID en_HK en_IN en_MY en_SG en_AE */
+	0x07dc000000000000ULL, 0x07dc003ee8000000ULL, 0x07dc002260000000ULL, 0x07dc0016f8000000ULL,
+	0x07dc001a58000000ULL, 0x07dc003120000000ULL, 0x07dc002678000000ULL, 0x07dc004858000000ULL,
+	0x07dc0028b8000000ULL, 0x07dc000219400000ULL, 0x07dc001920000000ULL, 0x07dc003cf0000000ULL,
+	0x07dc004908000000ULL, 0x07dc003490000000ULL, 0x07dc002670000000ULL, 0x07dc0024a8000000ULL,
+	0x07dc0026c0000000ULL, 0x07dc002f18000000ULL, 0x07dc003a88000000ULL, 0x07dc001678000000ULL,
+	/* 0x0A: es es_ES es_MX es_ES es_GT es_CR es_PA es_DO es_VE es_CO es_PE es_AR es_EC es_CL es_UY es_PY es_BO es_SV es_HN es_NI es_PR es_US es_419 es_CU */
+	0x07e6000000000000ULL, 0x07e6001ee8000000ULL, 0x07e6002f10000000ULL, 0x07e6001ee8000000ULL,
+	0x07e60022f0000000ULL, 0x07e6001ae0000000ULL, 0x07e6003458000000ULL, 0x07e6001cc8000000ULL,
+	0x07e6004078000000ULL, 0x07e6001ac8000000ULL, 0x07e6003478000000ULL, 0x07e60016e0000000ULL,
+	0x07e6001e68000000ULL, 0x07e6001ab0000000ULL, 0x07e6003f18000000ULL, 0x07e6003518000000ULL,
+	0x07e60018c8000000ULL, 0x07e6003b00000000ULL, 0x07e60024c0000000ULL, 0x07e6003098000000ULL,
+	0x07e60034e0000000ULL, 0x07e6003ee8000000ULL, 0x07e6000a11400000ULL, 0x07e6001af8000000ULL,
+	/* 0x0B: fi fi_FI */
+	0x0812000000000000ULL, 0x0812002098000000ULL,
+	/* 0x0C: fr fr_FR fr_BE fr_CA fr_CH fr_LU fr_MC fr_029 fr_RE fr_CD fr_SN fr_CM fr_CI fr_ML fr_MA fr_HT */
+	0x0824000000000000ULL, 0x08240020e0000000ULL, 0x0824001878000000ULL, 0x0824001a58000000ULL,
+	0x0824001a90000000ULL, 0x0824002cf8000000ULL, 0x0824002e68000000ULL, 0x0824000219400000ULL,
+	0x0824003878000000ULL, 0x0824001a70000000ULL, 0x0824003ac0000000ULL, 0x0824001ab8000000ULL,
+	0x0824001a98000000ULL, 0x0824002eb0000000ULL, 0x0824002e58000000ULL, 0x08240024f0000000ULL,
+	/* 0x0D: he he_IL */
+	0x088a000000000000ULL, 0x088a0026b0000000ULL,
+	/* 0x0E: hu hu_HU */
+	0x08aa000000000000ULL, 0x08aa0024f8000000ULL,
+	/* 0x0F: is is_IS */
+	0x08e6000000000000ULL, 0x08e60026e8000000ULL,
+	/* 0x10: it it_IT it_CH */
+	0x08e8000000000000ULL, 0x08e80026f0000000ULL, 0x08e8001a90000000ULL,
+	/* 0x11: ja ja_JP */
+	0x0902000000000000ULL, 0x09020028d0000000ULL,
+	/* 0x12: ko ko_KR */
+	0x095e000000000000ULL, 0x095e002ae0000000ULL,
+	/* 0x13: nl nl_NL nl_BE */
+	0x0a18000000000000ULL, 0x0a180030b0000000ULL, 0x0a18001878000000ULL,
+	/* 0x14: no nb_NO nn_NO - - - - - - - - - - - - - - - - - - - - - - - - - - - nn nb */
+	0x0a1e000000000000ULL, 0x0a040030c8000000ULL, 0x0a1c0030c8000000ULL, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0x0a1c000000000000ULL, 0x0a04000000000000ULL,
+	/* 0x15: pl pl_PL */
+	0x0a98000000000000ULL, 0x0a980034b0000000ULL,
+	/* 0x16: pt pt_BR pt_PT */
+	0x0aa8000000000000ULL, 0x0aa80018e0000000ULL, 0x0aa80034f0000000ULL,
+	/* 0x17: rm rm_CH */
+	0x0b1a000000000000ULL, 0x0b1a001a90000000ULL,
+	/* 0x18: ro ro_RO ro_MD */
+	0x0b1e000000000000ULL, 0x0b1e0038c8000000ULL, 0x0b1e002e70000000ULL,
+	/* 0x19: ru ru_RU ru_MD */
+	0x0b2a000000000000ULL, 0x0b2a0038f8000000ULL, 0x0b2a002e70000000ULL,
+	/* 0x1A: hr hr_HR sr_Latn_CS sr_Cyrl_CS hr_BA bs_Latn_BA sr_Latn_BA sr_Cyrl_BA bs_Cyrl_BA sr_Latn_RS sr_Cyrl_RS sr_Latn_ME sr_Cyrl_ME - - - - - - - - - - - - - - - - - bs sr */
+	0x08a4000000000000ULL, 0x08a40024e0000000ULL, 0x0b64002d2bce35d0ULL, 0x0b64001beb8c35d0ULL,
+	0x08a4001858000000ULL, 0x0726002d2bce30b0ULL, 0x0b64002d2bce30b0ULL, 0x0b64001beb8c30b0ULL,
+	0x0726001beb8c30b0ULL, 0x0b64002d2bce71d0ULL, 0x0b64001beb8c71d0ULL, 0x0b64002d2bce5cf0ULL,
+	0x0b64001beb8c5cf0ULL, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0x0726000000000000ULL, 0x0b64000000000000ULL,
+	/* 0x1B: sk sk_SK */
+	0x0b56000000000000ULL, 0x0b56003aa8000000ULL,
+	/* 0x1C: sq sq_AL */
+	0x0b62000000000000ULL, 0x0b620016b0000000ULL,
+	/* 0x1D: sv sv_SE sv_FI */
+	0x0b6c000000000000ULL, 0x0b6c003a78000000ULL, 0x0b6c002098000000ULL,
+	/* 0x1E: th th_TH */
+	0x0b90000000000000ULL, 0x0b90003c90000000ULL,
+	/* 0x1F: tr tr_TR */
+	0x0ba4000000000000ULL, 0x0ba4003ce0000000ULL,
+	/* 0x20: ur ur_PK ur_IN */
+	0x0be4000000000000ULL, 0x0be40034a8000000ULL, 0x0be40026c0000000ULL,
+	/* 0x21: id id_ID */
+	0x08c8000000000000ULL, 0x08c8002670000000ULL,
+	/* 0x22: uk uk_UA */
+	0x0bd6000000000000ULL, 0x0bd6003e58000000ULL,
+	/* 0x23: be be_BY */
+	0x070a000000000000ULL, 0x070a001918000000ULL,
+	/* 0x24: sl sl_SI */
+	0x0b58000000000000ULL, 0x0b58003a98000000ULL,
+	/* 0x25: et et_EE */
+	0x07e8000000000000ULL, 0x07e8001e78000000ULL,
+	/* 0x26: lv lv_LV */
+	0x09ac000000000000ULL, 0x09ac002d00000000ULL,
+	/* 0x27: lt lt_LT */
+	0x09a8000000000000ULL, 0x09a8002cf0000000ULL,
+	/* 0x28: tg tg_Cyrl_TJ */
+	0x0b8e000000000000ULL, 0x0b8e001beb8c7940ULL,
+	/* 0x29: fa fa_IR */
+	0x0802000000000000ULL, 0x08020026e0000000ULL,
+	/* 0x2A: vi vi_VN */
+	0x0c12000000000000ULL, 0x0c120040c0000000ULL,
+	/* 0x2B: hy hy_AM */
+	0x08b2000000000000ULL, 0x08b20016b8000000ULL,
+	/* 0x2C: az az_Latn_AZ az_Cyrl_AZ */
+	0x06f4000000000000ULL, 0x06f4002d2bce2e40ULL, 0x06f4001beb8c2e40ULL,
+	/* 0x2D: eu eu_ES */
+	0x07ea000000000000ULL, 0x07ea001ee8000000ULL,
+	/* 0x2E: hsb hsb_DE dsb_DE */
+	0x08a6200000000000ULL, 0x08a6201c78000000ULL, 0x07a6201c78000000ULL,
+	/* 0x2F: mk mk_MK */
+	0x09d6000000000000ULL, 0x09d6002ea8000000ULL,
+	/* 0x30: st st_ZA */
+	0x0b68000000000000ULL, 0x0b68004858000000ULL,
+	/* 0x31: ts ts_ZA */
+	0x0ba6000000000000ULL, 0x0ba6004858000000ULL,
+	/* 0x32: tn tn_ZA tn_BW */
+	0x0b9c000000000000ULL, 0x0b9c004858000000ULL, 0x0b9c001908000000ULL,
+	/* 0x33: ve ve_ZA */
+	0x0c0a000000000000ULL, 0x0c0a004858000000ULL,
+	/* 0x34: xh xh_ZA */
+	0x0c90000000000000ULL, 0x0c90004858000000ULL,
+	/* 0x35: zu zu_ZA */
+	0x0d2a000000000000ULL, 0x0d2a004858000000ULL,
+	/* 0x36: af af_ZA */
+	0x06cc000000000000ULL, 0x06cc004858000000ULL,
+	/* 0x37: ka ka_GE */
+	0x0942000000000000ULL, 0x0942002278000000ULL,
+	/* 0x38: fo fo_FO */
+	0x081e000000000000ULL, 0x081e0020c8000000ULL,
+	/* 0x39: hi hi_IN */
+	0x0892000000000000ULL, 0x08920026c0000000ULL,
+	/* 0x3A: mt mt_MT */
+	0x09e8000000000000ULL, 0x09e8002ef0000000ULL,
+	/* 0x3B: se se_NO se_SE se_FI smj_NO smj_SE sma_NO sma_SE sms_FI smn_FI */
+	0x0b4a000000000000ULL, 0x0b4a0030c8000000ULL, 0x0b4a003a78000000ULL, 0x0b4a002098000000ULL,
+	0x0b5aa030c8000000ULL, 0x0b5aa03a78000000ULL, 0x0b5a1030c8000000ULL, 0x0b5a103a78000000ULL,
+	0x0b5b302098000000ULL, 0x0b5ae02098000000ULL,
+	/* 0x3C: ga - ga_IE */
+	0x0842000000000000ULL, 0, 0x0842002678000000ULL,
+	/* 0x3D: yi yi_001 */
+	0x0cd2000000000000ULL, 0x0cd2000208400000ULL,
+	/* 0x3E: ms ms_MY ms_BN */
+	0x09e6000000000000ULL, 0x09e6002f18000000ULL, 0x09e60018c0000000ULL,
+	/* 0x3F: kk kk_KZ */
+	0x0956000000000000ULL, 0x0956002b20000000ULL,
+	/* 0x40: ky ky_KG */
+	0x0972000000000000ULL, 0x0972002a88000000ULL,
+	/* 0x41: sw sw_KE */
+	0x0b6e000000000000ULL, 0x0b6e002a78000000ULL,
+	/* 0x42: tk tk_TM */
+	0x0b96000000000000ULL, 0x0b96003cb8000000ULL,
+	/* 0x43: uz uz_Latn_UZ uz_Cyrl_UZ */
+	0x0bf4000000000000ULL, 0x0bf4002d2bce7e40ULL, 0x0bf4001beb8c7e40ULL,
+	/* 0x44: tt tt_RU */
+	0x0ba8000000000000ULL, 0x0ba80038f8000000ULL,
+	/* 0x45: bn bn_IN bn_BD */
+	0x071c000000000000ULL, 0x071c0026c0000000ULL, 0x071c001870000000ULL,
+	/* 0x46: pa pa_IN pa_Arab_PK */
+	0x0a82000000000000ULL, 0x0a820026c0000000ULL, 0x0a820017b1626950ULL,
+	/* 0x47: gu gu_IN */
+	0x086a000000000000ULL, 0x086a0026c0000000ULL,
+	/* 0x48: or or_IN */
+	0x0a64000000000000ULL, 0x0a640026c0000000ULL,
+	/* 0x49: ta ta_IN ta_LK */
+	0x0b82000000000000ULL, 0x0b820026c0000000ULL, 0x0b82002ca8000000ULL,
+	/* 0x4A: te te_IN */
+	0x0b8a000000000000ULL, 0x0b8a0026c0000000ULL,
+	/* 0x4B: kn kn_IN */
+	0x095c000000000000ULL, 0x095c0026c0000000ULL,
+	/* 0x4C: ml ml_IN */
+	0x09d8000000000000ULL, 0x09d80026c0000000ULL,
+	/* 0x4D: as as_IN */
+	0x06e6000000000000ULL, 0x06e60026c0000000ULL,
+	/* 0x4E: mr mr_IN */
+	0x09e4000000000000ULL, 0x09e40026c0000000ULL,
+	/* 0x4F: sa sa_IN */
+	0x0b42000000000000ULL, 0x0b420026c0000000ULL,
+	/* 0x50: mn mn_MN mn_Mong_CN mn_Mong_MN */
+	0x09dc000000000000ULL, 0x09dc002ec0000000ULL, 0x09dc002f9b073580ULL, 0x09dc002f9b075d80ULL,
+	/* 0x51: bo bo_CN */
+	0x071e000000000000ULL, 0x071e001ac0000000ULL,
+	/* 0x52: cy cy_GB */
+	0x0772000000000000ULL, 0x0772002260000000ULL,
+	/* 0x53: km km_KH */
+	0x095a000000000000ULL, 0x095a002a90000000ULL,
+	/* 0x54: lo lo_LA */
+	0x099e000000000000ULL, 0x099e002c58000000ULL,
+	/* 0x55: my my_MM */
+	0x09f2000000000000ULL, 0x09f2002eb8000000ULL,
+	/* 0x56: gl gl_ES */
+	0x0858000000000000ULL, 0x0858001ee8000000ULL,
+	/* 0x57: kok kok_IN */
+	0x095eb00000000000ULL, 0x095eb026c0000000ULL,
+	/* 0x59: sd - sd_Arab_PK */
+	0x0b48000000000000ULL, 0, 0x0b480017b1626950ULL,
+	/* 0x5A: syr syr_SY */
+	0x0b73200000000000ULL, 0x0b73203b18000000ULL,
+	/* 0x5B: si si_LK */
+	0x0b52000000000000ULL, 0x0b52002ca8000000ULL,
+	/* 0x5C: chr chr_Cher_US */
+	0x0751200000000000ULL, 0x0751201b61f27dd0ULL,
+	/* 0x5D: iu iu_Cans_CA iu_Latn_CA */
+	0x08ea000000000000ULL, 0x08ea001b2b1334b0ULL, 0x08ea002d2bce34b0ULL,
+	/* 0x5E: am am_ET */
+	0x06da000000000000ULL, 0x06da001ef0000000ULL,
+	/* 0x5F: tzm - tzm_Latn_DZ */
+	0x0bb4d00000000000ULL, 0, 0x0bb4d02d2bce3a40ULL,
+	/* 0x60: ks ks_Arab */
+	0x0966000000000000ULL, 0x09660017b1620000ULL,
+	/* 0x61: ne ne_NP ne_IN */
+	0x0a0a000000000000ULL, 0x0a0a0030d0000000ULL, 0x0a0a0026c0000000ULL,
+	/* 0x62: fy fy_NL */
+	0x0832000000000000ULL, 0x08320030b0000000ULL,
+	/* 0x63: ps ps_AF */
+	0x0aa6000000000000ULL, 0x0aa6001680000000ULL,
+	/* 0x64: fil fil_PH */
+	0x0812c00000000000ULL, 0x0812c03490000000ULL,
+	/* 0x65: dv dv_MV */
+	0x07ac000000000000ULL, 0x07ac002f00000000ULL,
+	/* 0x67: ff - ff_Latn_SN */
+	0x080c000000000000ULL, 0, 0x080c002d2bce7580ULL,
+	/* 0x68: ha ha_Latn_NG */
+	0x0882000000000000ULL, 0x0882002d2bce6110ULL,
+	/* 0x6A: yo yo_NG */
+	0x0cde000000000000ULL, 0x0cde003088000000ULL,
+	/* 0x6B: quz quz_BO quz_EC quz_PE */
+	0x0aeba00000000000ULL, 0x0aeba018c8000000ULL, 0x0aeba01e68000000ULL, 0x0aeba03478000000ULL,
+	/* 0x6C: nso nso_ZA */
+	0x0a26f00000000000ULL, 0x0a26f04858000000ULL,
+	/* 0x6D: ba ba_RU */
+	0x0702000000000000ULL, 0x07020038f8000000ULL,
+	/* 0x6E: lb lb_LU */
+	0x0984000000000000ULL, 0x0984002cf8000000ULL,
+	/* 0x6F: kl kl_GL */
+	0x0958000000000000ULL, 0x09580022b0000000ULL,
+	/* 0x70: ig ig_NG */
+	0x08ce000000000000ULL, 0x08ce003088000000ULL,
+	/* 0x72: om om_ET */
+	0x0a5a000000000000ULL, 0x0a5a001ef0000000ULL,
+	/* 0x73: ti ti_ET ti_ER */
+	0x0b92000000000000ULL, 0x0b92001ef0000000ULL, 0x0b92001ee0000000ULL,
+	/* 0x74: gn gn_PY */
+	0x085c000000000000ULL, 0x085c003518000000ULL,
+	/* 0x75: haw haw_US */
+	0x0883700000000000ULL, 0x0883703ee8000000ULL,
+	/* 0x77: so so_SO */
+	0x0b5e000000000000ULL, 0x0b5e003ac8000000ULL,
+	/* 0x78: ii ii_CN */
+	0x08d2000000000000ULL, 0x08d2001ac0000000ULL,
+	/* 0x7A: arn arn_CL */
+	0x06e4e00000000000ULL, 0x06e4e01ab0000000ULL,
+	/* 0x7C: moh moh_CA */
+	0x09de800000000000ULL, 0x09de801a58000000ULL,
+	/* 0x7E: br br_FR */
+	0x0724000000000000ULL, 0x07240020e0000000ULL,
+	/* 0x80: ug ug_CN */
+	0x0bce000000000000ULL, 0x0bce001ac0000000ULL,
+	/* 0x81: mi mi_NZ */
+	0x09d2000000000000ULL, 0x09d2003120000000ULL,
+	/* 0x82: oc oc_FR */
+	0x0a46000000000000ULL, 0x0a460020e0000000ULL,
+	/* 0x83: co co_FR */
+	0x075e000000000000ULL, 0x075e0020e0000000ULL,
+	/* 0x84: gsw gsw_FR */
+	0x0867700000000000ULL, 0x08677020e0000000ULL,
+	/* 0x85: sah sah_RU */
+	0x0b42800000000000ULL, 0x0b428038f8000000ULL,
+	/* 0x86: quc quc_Latn_GT */
+	0x0aea300000000000ULL, 0x0aea302d2bce45e0ULL,
+	/* 0x87: rw rw_RW */
+	0x0b2e000000000000ULL, 0x0b2e003908000000ULL,
+	/* 0x88: wo wo_SN */
+	0x0c5e000000000000ULL, 0x0c5e003ac0000000ULL,
+	/* 0x8C: prs prs_AF */
+	0x0aa5300000000000ULL, 0x0aa5301680000000ULL,
+	/* 0x91: gd gd_GB */
+	0x0848000000000000ULL, 0x0848002260000000ULL,
+	/* 0x92: ku ku_Arab_IQ */
+	0x096a000000000000ULL, 0x096a0017b1624db0ULL
+};
+
+/*
+ * LocaleKey to LCID: a perfect hash table.
+ * The seed of the bucket of a key makes sure that no other key is hashed to the same slot.
+ */
+static const uint16_t LCIDHashSeeds[LCID_HASH_BUCKETS] = {
+	6, 2, 15, 1, 1, 6, 3, 8, 1, 2, 10, 2, 8, 2, 2, 11,
+	8, 2, 0, 17, 12, 6, 9, 1, 2, 3, 2, 1, 3, 2, 3, 2,
+	2, 2, 2, 51, 1, 2, 11, 8, 4, 6, 11, 3, 2, 3, 10, 0,
+	1, 6, 6, 2, 3, 2, 13, 6, 3, 26, 3, 1, 10, 8, 4, 4,
+	2, 2, 3, 11, 2, 1, 9, 12, 8, 12, 1, 3, 3, 49, 9, 11,
+	3, 1, 1, 2, 2, 9, 11, 1, 2, 4, 7, 2, 8, 1, 1, 5,
+	1, 1, 0, 6, 17, 3, 4, 24, 9, 32, 7, 21, 15, 1, 2, 17,
+	12, 9, 1, 6, 2, 16, 4, 1, 2, 3, 5, 8, 3, 2, 11, 2
+};
+static const struct {
+	LocaleKey key;
+	LCID lcid;
+} LCIDHashSlots[LCID_HASH_SLOTS] = {
+	{0, 0}, {0x0882003088000000ULL, 0x0468}, {0, 0}, {0x06e4003b18000000ULL, 0x2801},
+	{0x095c000000000000ULL, 0x004B}, {0x0b42000000000000ULL, 0x004F}, {0x0aa5301680000000ULL, 0x048C}, {0x0c5e003ac0000000ULL, 0x0488},
+	{0x080c003ac0000000ULL, 0x0867}, {0x0b64002e78000000ULL, 0x2C1A}, {0x0bb4d00000000000ULL, 0x005F}, {0, 0},
+	{0x0d1000252b133580ULL, 0x0804}, {0, 0}, {0x078a000000000000ULL, 0x0007}, {0x07e6003518000000ULL, 0x3C0A},
+	{0x0882002d2bce6110ULL, 0x0468}, {0x07dc002670000000ULL, 0x3809}, {0x086a000000000000ULL, 0x0047}, {0x0824003ac0000000ULL, 0x280C},
+	{0x0972002a88000000ULL, 0x0440}, {0x06e4e01ab0000000ULL, 0x047A}, {0x071c000000000000ULL, 0x0045}, {0x0d100024a8000000ULL, 0x0C04},
+	{0, 0}, {0x08ce003088000000ULL, 0x0470}, {0, 0}, {0x08a4000000000000ULL, 0x001A},
+	{0, 0}, {0x09e6002f18000000ULL, 0x043E}, {0x0b96000000000000ULL, 0x0042}, {0x0ba80038f8000000ULL, 0x0444},
+	{0, 0}, {0x09660026c0000000ULL, 0x0460}, {0x0726002d2bce30b0ULL, 0x141A}, {0x07dc0016f8000000ULL, 0x0C09},
+	{0x08ea002d2bce34b0ULL, 0x085D}, {0x07e6003b00000000ULL, 0x440A}, {0x08320030b0000000ULL, 0x0462}, {0x09ac002d00000000ULL, 0x0426},
+	{0, 0}, {0x0be40026c0000000ULL, 0x0820}, {0x0b820026c0000000ULL, 0x0449}, {0, 0},
+	{0x06f4001beb8c2e40ULL, 0x082C}, {0x07e6001cc8000000ULL, 0x1C0A}, {0x0a5a000000000000ULL, 0x0072}, {0, 0},
+	{0x0a1c000000000000ULL, 0x7814}, {0x0956002b20000000ULL, 0x043F}, {0x0d1000252b137510ULL, 0x1004}, {0x08e60026e8000000ULL, 0x040F},
+	{0, 0}, {0x0b8e001beb8c7940ULL, 0x0428}, {0, 0}, {0x0cd2000208400000ULL, 0x043D},
+	{0x07e6001ee8000000ULL, 0x0C0A}, {0, 0}, {0x0aa8000000000000ULL, 0x0016}, {0x0b2e000000000000ULL, 0x0087},
+	{0x0726001858000000ULL, 0x141A}, {0x0858000000000000ULL, 0x0056}, {0x0b4a002098000000ULL, 0x0C3B}, {0, 0},
+	{0x0b1a001a90000000ULL, 0x0417}, {0x0d1000252b144950ULL, 0x0C04}, {0x07e6001af8000000ULL, 0x5C0A}, {0x06e4001890000000ULL, 0x3C01},
+	{0x0b5aa030c8000000ULL, 0x103B}, {0, 0}, {0x0b8a000000000000ULL, 0x004A}, {0x0742000000000000ULL, 0x0003},
+	{0x0848000000000000ULL, 0x0091}, {0x080c000000000000ULL, 0x0067}, {0x0b92000000000000ULL, 0x0073}, {0, 0},
+	{0x09a8000000000000ULL, 0x0027}, {0x099e002c58000000ULL, 0x0454}, {0x0b4a000000000000ULL, 0x003B}, {0, 0},
+	{0x0867700000000000ULL, 0x0084}, {0, 0}, {0x0b96003cb8000000ULL, 0x0442}, {0x06f4001720000000ULL, 0x042C},
+	{0x0b1e000000000000ULL, 0x0018}, {0x08d2001ac0000000ULL, 0x0478}, {0x0b5aa03a78000000ULL, 0x143B}, {0x0a04000000000000ULL, 0x7C14},
+	{0x0b64001858000000ULL, 0x1C1A}, {0x0a180030b0000000ULL, 0x0413}, {0x0812c00000000000ULL, 0x0064}, {0x0aeba01e68000000ULL, 0x086B},
+	{0x09dc001ac0000000ULL, 0x0850}, {0x0972000000000000ULL, 0x0040}, {0, 0}, {0x0aea300000000000ULL, 0x0086},
+	{0x07e6001ac8000000ULL, 0x240A}, {0x0751201b61f27dd0ULL, 0x045C}, {0, 0}, {0x0b90003c90000000ULL, 0x041E},
+	{0x0a18001878000000ULL, 0x0813}, {0x07dc000000000000ULL, 0x0009}, {0x0824001878000000ULL, 0x080C}, {0x0751203ee8000000ULL, 0x045C},
+	{0, 0}, {0x06e4003a58000000ULL, 0x0401}, {0x07020038f8000000ULL, 0x046D}, {0x095a000000000000ULL, 0x0053},
+	{0x07dc004858000000ULL, 0x1C09}, {0x0b5ae02098000000ULL, 0x243B}, {0, 0}, {0, 0},
+	{0x0824000000000000ULL, 0x000C}, {0x0956000000000000ULL, 0x003F}, {0x0aeba00000000000ULL, 0x006B}, {0x0b1e0038c8000000ULL, 0x0418},
+	{0, 0}, {0x096a000000000000ULL, 0x0092}, {0x0b73203b18000000ULL, 0x045A}, {0x0aeba03478000000ULL, 0x0C6B},
+	{0x075e000000000000ULL, 0x0083}, {0x08c8000000000000ULL, 0x0021}, {0x096a0017b1624db0ULL, 0x0492}, {0x07dc003120000000ULL, 0x1409},
+	{0x09ac000000000000ULL, 0x0026}, {0x0c90004858000000ULL, 0x0434}, {0x0b42800000000000ULL, 0x0085}, {0x0b68004858000000ULL, 0x0430},
+	{0x0a040030c8000000ULL, 0x0414}, {0x0b8e003ca0000000ULL, 0x0428}, {0x0742001ee8000000ULL, 0x0403}, {0, 0},
+	{0x081e000000000000ULL, 0x0038}, {0x06cc000000000000ULL, 0x0036}, {0x0b82002ca8000000ULL, 0x0849}, {0x0b480034a8000000ULL, 0x0859},
+	{0x07dc0024a8000000ULL, 0x3C09}, {0x0902000000000000ULL, 0x0011}, {0x0a820026c0000000ULL, 0x0446}, {0x099e000000000000ULL, 0x0054},
+	{0x06e6000000000000ULL, 0x004D}, {0, 0}, {0x0b56000000000000ULL, 0x001B}, {0, 0},
+	{0x070e001888000000ULL, 0x0402}, {0x0782000000000000ULL, 0x0006}, {0, 0}, {0x09dc002f9b075d80ULL, 0x0C50},
+	{0x0b64001beb8c71d0ULL, 0x281A}, {0x071e001ac0000000ULL, 0x0451}, {0x07e8000000000000ULL, 0x0025}, {0x071c001870000000ULL, 0x0845},
+	{0, 0}, {0x09f2002eb8000000ULL, 0x0455}, {0x06e4e00000000000ULL, 0x007A}, {0x0724000000000000ULL, 0x007E},
+	{0x070e000000000000ULL, 0x0002}, {0, 0}, {0x07e6000a11400000ULL, 0x580A}, {0x06e4002b08000000ULL, 0x3401},
+	{0, 0}, {0x0b64001beb8c35d0ULL, 0x0C1A}, {0x0984000000000000ULL, 0x006E}, {0, 0},
+	{0x0b64001beb8c5cf0ULL, 0x301A}, {0, 0}, {0x0b64001beb8c30b0ULL, 0x1C1A}, {0x0984002cf8000000ULL, 0x046E},
+	{0, 0}, {0x0a82000000000000ULL, 0x0046}, {0x095eb026c0000000ULL, 0x0457}, {0x06cc004858000000ULL, 0x0436},
+	{0x0842000000000000ULL, 0x003C}, {0x0824002eb0000000ULL, 0x340C}, {0x08a4001858000000ULL, 0x101A}, {0, 0},
+	{0x0b52000000000000ULL, 0x005B}, {0x08e8001a90000000ULL, 0x0810}, {0x0ba4000000000000ULL, 0x001F}, {0x06e60026c0000000ULL, 0x044D},
+	{0x0a64000000000000ULL, 0x0048}, {0x0aa80034f0000000ULL, 0x0816}, {0x0812002098000000ULL, 0x040B}, {0x0b64002d2bce5cf0ULL, 0x2C1A},
+	{0x06e4004678000000ULL, 0x2401}, {0, 0}, {0, 0}, {0, 0},
+	{0x071c0026c0000000ULL, 0x0445}, {0, 0}, {0x0772002260000000ULL, 0x0452}, {0x07dc002260000000ULL, 0x0809},
+	{0, 0}, {0x0d1000252b147a10ULL, 0x0404}, {0x0b8e000000000000ULL, 0x0028}, {0, 0},
+	{0x096a0026d8000000ULL, 0x0492}, {0x07dc003ee8000000ULL, 0x0409}, {0x0b92001ee0000000ULL, 0x0873}, {0x0b9c004858000000ULL, 0x0432},
+	{0x06e4003658000000ULL, 0x4001}, {0x0d10003d08000000ULL, 0x0404}, {0x09580022b0000000ULL, 0x046F}, {0, 0},
+	{0x09660017b1620000ULL, 0x0460}, {0x0b5e000000000000ULL, 0x0077}, {0x08677020e0000000ULL, 0x0484}, {0x0b5a103a78000000ULL, 0x1C3B},
+	{0x0c12000000000000ULL, 0x002A}, {0x095a002a90000000ULL, 0x0453}, {0x07dc001920000000ULL, 0x2809}, {0x06da000000000000ULL, 0x005E},
+	{0, 0}, {0x0b9c000000000000ULL, 0x0032}, {0x09e40026c0000000ULL, 0x044E}, {0x06e4001e88000000ULL, 0x0C01},
+	{0x0a0a0026c0000000ULL, 0x0861}, {0x0824001a70000000ULL, 0x240C}, {0, 0}, {0, 0},
+	{0x08ea001a58000000ULL, 0x045D}, {0, 0}, {0x08a40024e0000000ULL, 0x041A}, {0x07e6001ae0000000ULL, 0x140A},
+	{0x078a001c78000000ULL, 0x0407}, {0x09dc002f9b073580ULL, 0x0850}, {0x0824002e58000000ULL, 0x380C}, {0, 0},
+	{0x0b4a003a78000000ULL, 0x083B}, {0x0b64002d2bce71d0ULL, 0x241A}, {0x0d1000252b140000ULL, 0x7C04}, {0x0b62000000000000ULL, 0x001C},
+	{0x0b2a002e70000000ULL, 0x0819}, {0, 0}, {0, 0}, {0x095eb00000000000ULL, 0x0057},
+	{0x08e6000000000000ULL, 0x000F}, {0, 0}, {0x0832000000000000ULL, 0x0062}, {0, 0},
+	{0x0b8a0026c0000000ULL, 0x044A}, {0x085c003518000000ULL, 0x0474}, {0x07e6001e68000000ULL, 0x300A}, {0x09e6000000000000ULL, 0x003E},
+	{0x0b480017b1626950ULL, 0x0859}, {0x095e002ae0000000ULL, 0x0412}, {0x0824002e68000000ULL, 0x180C}, {0x0883703ee8000000ULL, 0x0475},
+	{0x0bf4003f20000000ULL, 0x0443}, {0x08a6200000000000ULL, 0x002E}, {0x08240020e0000000ULL, 0x040C}, {0x07e60024c0000000ULL, 0x480A},
+	{0x0a460020e0000000ULL, 0x0482}, {0x0858001ee8000000ULL, 0x0456}, {0x07e6003458000000ULL, 0x180A}, {0x0c0a004858000000ULL, 0x0433},
+	{0x0766000000000000ULL, 0x0005}, {0x0b6c000000000000ULL, 0x001D}, {0, 0}, {0x095e000000000000ULL, 0x0012},
+	{0, 0}, {0x07dc003a88000000ULL, 0x4809}, {0x0824002cf8000000ULL, 0x140C}, {0, 0},
+	{0, 0}, {0x08e8000000000000ULL, 0x0010}, {0, 0}, {0x07dc001678000000ULL, 0x4C09},
+	{0x0b420026c0000000ULL, 0x044F}, {0x07d80022e0000000ULL, 0x0408}, {0, 0}, {0x08240024f0000000ULL, 0x3C0C},
+	{0x088a0026b0000000ULL, 0x040D}, {0x078a0016f0000000ULL, 0x0C07}, {0, 0}, {0x0bce000000000000ULL, 0x0080},
+	{0x0824001a98000000ULL, 0x300C}, {0x0ba4003ce0000000ULL, 0x041F}, {0x07240020e0000000ULL, 0x047E}, {0x0802000000000000ULL, 0x0029},
+	{0x09d2000000000000ULL, 0x0081}, {0x071e000000000000ULL, 0x0051}, {0x0842002678000000ULL, 0x083C}, {0x08ce000000000000ULL, 0x0070},
+	{0x0958000000000000ULL, 0x006F}, {0x09d6000000000000ULL, 0x002F}, {0x0aeba018c8000000ULL, 0x046B}, {0x0a46000000000000ULL, 0x0082},
+	{0x0824003878000000ULL, 0x200C}, {0, 0}, {0x0c0a000000000000ULL, 0x0033}, {0x0c120040c0000000ULL, 0x042A},
+	{0x0c5e000000000000ULL, 0x0088}, {0x07dc000219400000ULL, 0x2409}, {0x07dc0028b8000000ULL, 0x2009}, {0x07e6002f10000000ULL, 0x080A},
+	{0x07dc0026c0000000ULL, 0x4009}, {0, 0}, {0x07e60018c8000000ULL, 0x400A}, {0, 0},
+	{0x06da001ef0000000ULL, 0x045E}, {0x0bd6003e58000000ULL, 0x0422}, {0x0ba6004858000000ULL, 0x0431}, {0x0a980034b0000000ULL, 0x0415},
+	{0x0824001ab8000000ULL, 0x2C0C}, {0x09e60018c0000000ULL, 0x083E}, {0x06e4002d18000000ULL, 0x1001}, {0x06f4002d2bce2e40ULL, 0x042C},
+	{0, 0}, {0x0883700000000000ULL, 0x0075}, {0x0bb4d02d2bce3a40ULL, 0x085F}, {0, 0},
+	{0x0848002260000000ULL, 0x0491}, {0x07dc003cf0000000ULL, 0x2C09}, {0x09dc000000000000ULL, 0x0050}, {0x0b5a1030c8000000ULL, 0x183B},
+	{0x0a98000000000000ULL, 0x0015}, {0x07e6003478000000ULL, 0x280A}, {0x0882000000000000ULL, 0x0068}, {0x0b52002ca8000000ULL, 0x045B},
+	{0x0b64000000000000ULL, 0x7C1A}, {0x0aea302d2bce45e0ULL, 0x0486}, {0x0942002278000000ULL, 0x0437}, {0x0942000000000000ULL, 0x0037},
+	{0, 0}, {0x0966000000000000ULL, 0x0060}, {0x0b64002d2bce35d0ULL, 0x081A}, {0x0b620016b0000000ULL, 0x041C},
+	{0x0824000219400000ULL, 0x1C0C}, {0x0b5b302098000000ULL, 0x203B}, {0x0726001beb8c30b0ULL, 0x201A}, {0x0b428038f8000000ULL, 0x0485},
+	{0, 0}, {0x0bf4001beb8c7e40ULL, 0x0843}, {0x0a820017b1626950ULL, 0x0846}, {0, 0},
+	{0x0b5e003ac8000000ULL, 0x0477}, {0, 0}, {0x0b6c003a78000000ULL, 0x041D}, {0, 0},
+	{0x0726000000000000ULL, 0x781A}, {0, 0}, {0x0a0a0030d0000000ULL, 0x0461}, {0x07ea001ee8000000ULL, 0x042D},
+	{0x07e6003098000000ULL, 0x4C0A}, {0x0a640026c0000000ULL, 0x0448}, {0x0aa6001680000000ULL, 0x0463}, {0x07a6201c78000000ULL, 0x082E},
+	{0x09f2000000000000ULL, 0x0055}, {0x09e4000000000000ULL, 0x004E}, {0x07e60022f0000000ULL, 0x100A}, {0x0d1000252b145d90ULL, 0x1404},
+	{0x0b6e002a78000000ULL, 0x0441}, {0, 0}, {0x0a18000000000000ULL, 0x0013}, {0x0d1000252b130000ULL, 0x0004},
+	{0x080c002d2bce7580ULL, 0x0867}, {0x07dc002678000000ULL, 0x1809}, {0x0be4000000000000ULL, 0x0020}, {0x0b6c002098000000ULL, 0x081D},
+	{0x0aea3022f0000000ULL, 0x0486}, {0, 0}, {0x0d10003a88000000ULL, 0x1004}, {0x0812000000000000ULL, 0x000B},
+	{0x0b73200000000000ULL, 0x005A}, {0x06e4000000000000ULL, 0x0001}, {0x0d2a004858000000ULL, 0x0435}, {0x0b2e003908000000ULL, 0x0487},
+	{0x0b58003a98000000ULL, 0x0424}, {0x0772000000000000ULL, 0x0052}, {0x0b9c001908000000ULL, 0x0832}, {0, 0},
+	{0x0cde003088000000ULL, 0x046A}, {0, 0}, {0, 0}, {0x0be40034a8000000ULL, 0x0420},
+	{0x0b82000000000000ULL, 0x0049}, {0, 0}, {0, 0}, {0x07e60016e0000000ULL, 0x2C0A},
+	{0x0cde000000000000ULL, 0x006A}, {0x0812c03490000000ULL, 0x0464}, {0x088a000000000000ULL, 0x000D}, {0x09de800000000000ULL, 0x007C},
+	{0x08b20016b8000000ULL, 0x042B}, {0x08d2000000000000ULL, 0x0078}, {0x07dc002f18000000ULL, 0x4409}, {0x07dc003490000000ULL, 0x3409},
+	{0x08020026e0000000ULL, 0x0429}, {0, 0}, {0x078a002c98000000ULL, 0x1407}, {0x0c90000000000000ULL, 0x0034},
+	{0, 0}, {0x095c0026c0000000ULL, 0x044B}, {0x0b2a000000000000ULL, 0x0019}, {0x070a001918000000ULL, 0x0423},
+	{0x06e4001678000000ULL, 0x3801}, {0, 0}, {0x08a6201c78000000ULL, 0x042E}, {0x08aa0024f8000000ULL, 0x040E},
+	{0x0ba8000000000000ULL, 0x0044}, {0x0a1e000000000000ULL, 0x0014}, {0, 0}, {0x07e6003f18000000ULL, 0x380A},
+	{0x09d2003120000000ULL, 0x0481}, {0, 0}, {0x0aa5300000000000ULL, 0x008C}, {0, 0},
+	{0, 0}, {0, 0}, {0x0a5a001ef0000000ULL, 0x0472}, {0x0b56003aa8000000ULL, 0x041B},
+	{0, 0}, {0x0bd6000000000000ULL, 0x0022}, {0x07ea000000000000ULL, 0x002D}, {0x0d2a000000000000ULL, 0x0035},
+	{0x06e4003cc0000000ULL, 0x1C01}, {0x09dc002ec0000000ULL, 0x0450}, {0, 0}, {0x0b58000000000000ULL, 0x0024},
+	{0x086a0026c0000000ULL, 0x0447}, {0, 0}, {0x09d80026c0000000ULL, 0x044C}, {0x06e40026d8000000ULL, 0x0801},
+	{0, 0}, {0x06e40028c8000000ULL, 0x2C01}, {0x0aa80018e0000000ULL, 0x0416}, {0, 0},
+	{0x0892000000000000ULL, 0x0039}, {0x0b64002d2bce30b0ULL, 0x181A}, {0x0bf4000000000000ULL, 0x0043}, {0, 0},
+	{0, 0}, {0x0d10001ac0000000ULL, 0x0804}, {0x0d10002ec8000000ULL, 0x1404}, {0x0782001ca8000000ULL, 0x0406},
+	{0x08b2000000000000ULL, 0x002B}, {0x0bb4d01d20000000ULL, 0x085F}, {0x0aa6000000000000ULL, 0x0063}, {0x07ac002f00000000ULL, 0x0465},
+	{0, 0}, {0x09d6002ea8000000ULL, 0x042F}, {0x078a002cf8000000ULL, 0x1007}, {0, 0},
+	{0x07e8001e78000000ULL, 0x0425}, {0x075e0020e0000000ULL, 0x0483}, {0, 0}, {0x09d8000000000000ULL, 0x004C},
+	{0x09e8000000000000ULL, 0x003A}, {0x08c8002670000000ULL, 0x0421}, {0x0b2a0038f8000000ULL, 0x0419}, {0x09a8002cf0000000ULL, 0x0427},
+	{0x0bf4002d2bce7e40ULL, 0x0443}, {0x0a1c0030c8000000ULL, 0x0814}, {0, 0}, {0x06f4000000000000ULL, 0x002C},
+	{0, 0}, {0x07e60034e0000000ULL, 0x500A}, {0, 0}, {0x0824001a90000000ULL, 0x100C},
+	{0x081e0020c8000000ULL, 0x0438}, {0, 0}, {0x0a0a000000000000ULL, 0x0061}, {0x0b1a000000000000ULL, 0x0017},
+	{0, 0}, {0x0ba6000000000000ULL, 0x0031}, {0x0b92001ef0000000ULL, 0x0473}, {0x07e6000000000000ULL, 0x000A},
+	{0x06e4001d20000000ULL, 0x1401}, {0x0824001a58000000ULL, 0x0C0C}, {0, 0}, {0x0b640038e8000000ULL, 0x281A},
+	{0x0766001b20000000ULL, 0x0405}, {0x09020028d0000000ULL, 0x0411}, {0x09de801a58000000ULL, 0x047C}, {0x08ea001b2b1334b0ULL, 0x045D},
+	{0x07dc001a58000000ULL, 0x1009}, {0x0bce001ac0000000ULL, 0x0480}, {0x08aa000000000000ULL, 0x000E}, {0x07d8000000000000ULL, 0x0008},
+	{0x0b4a0030c8000000ULL, 0x043B}, {0x085c000000000000ULL, 0x0074}, {0, 0}, {0x08e80026f0000000ULL, 0x0410},
+	{0x078a001a90000000ULL, 0x0807}, {0x0702000000000000ULL, 0x006D}, {0x0cd2000000000000ULL, 0x003D}, {0x06e4002c60000000ULL, 0x3001},
+	{0x070a000000000000ULL, 0x0023}, {0x07e6001ab0000000ULL, 0x340A}, {0x0b90000000000000ULL, 0x001E}, {0x0751200000000000ULL, 0x005C},
+	{0x0b68000000000000ULL, 0x0030}, {0x0b1e002e70000000ULL, 0x0818}, {0x0a26f00000000000ULL, 0x006C}, {0x07e6004078000000ULL, 0x200A},
+	{0x06e4002e58000000ULL, 0x1801}, {0x07dc004908000000ULL, 0x3009}, {0x07e6003ee8000000ULL, 0x540A}, {0x09e8002ef0000000ULL, 0x043A},
+	{0x0a820034a8000000ULL, 0x0846}, {0, 0}, {0x0b48000000000000ULL, 0x0059}, {0x0b6e000000000000ULL, 0x0041},
+	{0x07ac000000000000ULL, 0x0065}, {0, 0}, {0x08ea000000000000ULL, 0x005D}, {0x08920026c0000000ULL, 0x0439},
+	{0, 0}, {0x0a26f04858000000ULL, 0x046C}, {0x06e40032b8000000ULL, 0x2001}, {0, 0}
+};
+
+/*
+ * Get the LocaleKey of a Windows LCID (the sort ID is ignored).
+ * Returns 0 if the LCID is unknown.
+ */
+LocaleKey LCIDToLocaleKey(LCID lcid)
+{
+	unsigned int primaryLanguage, sublanguage;
+	primaryLanguage = lcid & 0x3ff;
+	sublanguage = (lcid >> 10) & 0x3f;
+	if (primaryLanguage >= LCID_PRIMARY_LANGUAGE_COUNT || sublanguage >= LCIDPrimaryLanguages[primaryLanguage].count) {
+		return 0;
+	}
+	return LCIDSublanguages[LCIDPrimaryLanguages[primaryLanguage].offset + sublanguage];
+}
+
+/*
+ * Get the Windows LCID of a LocaleKey.
+ * Returns 0 if there's no LCID for the key.
+ */
+LCID LocaleKeyToLCID(LocaleKey key)
+{
+	uint64_t hash;
+	size_t slot;
+	if (!key) {
+		return 0;
+	}
+	hash = HashLocaleKey(key);
+	slot = (size_t)HashLocaleKey(key + LCIDHashSeeds[(hash >> 32) % LCID_HASH_BUCKETS]) & (LCID_HASH_SLOTS - 1);
+	return LCIDHashSlots[slot].key == key ? LCIDHashSlots[slot].lcid : 0;
+}
+
+/*
+ * Convert an array of Windows LCIDs to LocaleKeys (unknown LCIDs are converted to 0).
+ */
+void LCIDsToLocaleKeys(const LCID* lcids, size_t count, LocaleKey* keys)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		keys[i] = LCIDToLocaleKey(lcids[i]);
+	}
+}
+
+/*
+ * Convert an array of LocaleKeys to Windows LCIDs (keys without an LCID are converted to 0).
+ */
+void LocaleKeysToLCIDs(const LocaleKey* keys, size_t count, LCID* lcids)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		lcids[i] = LocaleKeyToLCID(keys[i]);
+	}
+}
+
+/*
+ * Get the Windows LCID of a locale identifier, in Unicode or in Gettext format (without allocating anything).
+ * Returns 0 if locale is invalid or if there's no LCID for it.
+ */
+LCID LocaleIDToLCID(const char* locale, size_t length)
+{
+	return LocaleKeyToLCID(LocaleIDToLocaleKey(locale, length));
+}
+
+/*
+ * Get the Windows LCID of a LocaleChunks.
+ * Returns 0 if lc is NULL or if there's no LCID for it.
+ */
+LCID LocaleChunksToLCID(const LocaleChunks* lc)
+{
+	return LocaleKeyToLCID(LocaleChunksToLocaleKey(lc));
+}
+
+/*
+ * Write the locale identifier of a Windows LCID in a specific format (LOCALE_FORMAT_... constants) to a buffer.
+ * Like snprintf, the result is truncated (but still null-terminated) if the buffer is too small, and buffer may be NULL if size is 0.
+ * Returns the length of the whole locale ID (without the null terminator), or 0 if the LCID is unknown or if it can't be represented in the requested format.
+ */
+size_t LCIDToLocaleIDBuffer(LCID lcid, unsigned int format, char* buffer, size_t size)
+{
+	return FormatLocaleKey(LCIDToLocaleKey(lcid), format, buffer, size);
+}
+
+/*
+ * Convert a Windows LCID to a LocaleChunks.
+ * Returns NULL if the LCID is unknown, or in case of out-of-memory problems.
+ */
+LocaleChunks* LCIDToLocaleChunks(LCID lcid)
+{
+	char locale[LOCALE_ID_INLINE_SIZE];
+	if (!LocaleKeyToUnicodeLocaleIDBuffer(LCIDToLocaleKey(lcid), locale, sizeof(locale))) {
+		return NULL;
+	}
+	return UnicodeLocaleIDToLocaleChunks(locale);
+}
+
+/*
+ * Locale fallback chains, following the CLDR rules ( https://unicode.org/reports/tr35/#Locale_Inheritance ):
+ * the parent of a locale is the one listed in the parentLocales data, or the locale without its last subtag,
+ * but the parent of a language with a script that's not its default one is the root.
+ * Source: CLDR parentLocales and likelySubtags data (through Babel 2.18: see tools/generate-locale-parents.py).
+ */
+
+/*
+ * The LocaleKey of the Unicode root.
+ */
+#define LOCALE_KEY_ROOT 0x0b1efa0000000000ULL
+
+/*
+ * Layout of the segments of a LocaleKey (see LocaleKeyPositionBits).
+ */
+#define LOCALE_KEY_THIRD_SEGMENT_MASK 0xffffULL
+#define LOCALE_KEY_SECOND_SEGMENT_SHIFT 16
+#define LOCALE_KEY_SECOND_SEGMENT_MASK (0x7fffffULL << LOCALE_KEY_SECOND_SEGMENT_SHIFT)
+#define LOCALE_KEY_FIRST_SEGMENT_SHIFT 39
+/* The last position of the second segment is used only by scripts */
+#define LOCALE_KEY_SCRIPT_LAST_POSITION_MASK (0x1fULL << LOCALE_KEY_SECOND_SEGMENT_SHIFT)
+/* The second segment of a LocaleKey with the Latin script */
+#define LOCALE_KEY_SCRIPT_LATN 0x0000002d2bce0000ULL
+
+#define LOCALE_PARENT_COUNT 191
+#define LOCALE_DEFAULT_SCRIPT_COUNT 1004
+
+/*
+ * The parents that don't follow the truncation rule, sorted by child.
+ * They include the languages with a territory whose likely script isn't the default one of the language
+ * (for example the parent of zh_TW is zh_Hant, since zh_TW is zh_Hant_TW).
+ */
+static const struct {
+	LocaleKey child;
+	LocaleKey parent;
+} LocaleParents[LOCALE_PARENT_COUNT] = {
+	{0x06f40026d8000000ULL, 0x06f40017b1620000ULL}, /* az_IQ -> az_Arab */
+	{0x06f40026e0000000ULL, 0x06f40017b1620000ULL}, /* az_IR -> az_Arab */
+	{0x06f40038f8000000ULL, 0x06f4001beb8c0000ULL}, /* az_RU -> az_Cyrl */
+	{0x07dc000430200000ULL, 0x07dc000208400000ULL}, /* en_150 -> en_001 */
+	{0x07dc001688000000ULL, 0x07dc000208400000ULL}, /* en_AG -> en_001 */
+	{0x07dc001698000000ULL, 0x07dc000208400000ULL}, /* en_AI -> en_001 */
+	{0x07dc0016f0000000ULL, 0x07dc000430200000ULL}, /* en_AT -> en_150 */
+	{0x07dc0016f8000000ULL, 0x07dc000208400000ULL}, /* en_AU -> en_001 */
+	{0x07dc001860000000ULL, 0x07dc000208400000ULL}, /* en_BB -> en_001 */
+	{0x07dc001878000000ULL, 0x07dc000430200000ULL}, /* en_BE -> en_150 */
+	{0x07dc0018b8000000ULL, 0x07dc000208400000ULL}, /* en_BM -> en_001 */
+	{0x07dc0018e8000000ULL, 0x07dc000208400000ULL}, /* en_BS -> en_001 */
+	{0x07dc001908000000ULL, 0x07dc000208400000ULL}, /* en_BW -> en_001 */
+	{0x07dc001920000000ULL, 0x07dc000208400000ULL}, /* en_BZ -> en_001 */
+	{0x07dc001a68000000ULL, 0x07dc000208400000ULL}, /* en_CC -> en_001 */
+	{0x07dc001a90000000ULL, 0x07dc000430200000ULL}, /* en_CH -> en_150 */
+	{0x07dc001aa8000000ULL, 0x07dc000208400000ULL}, /* en_CK -> en_001 */
+	{0x07dc001ab8000000ULL, 0x07dc000208400000ULL}, /* en_CM -> en_001 */
+	{0x07dc001b10000000ULL, 0x07dc000208400000ULL}, /* en_CX -> en_001 */
+	{0x07dc001b18000000ULL, 0x07dc000208400000ULL}, /* en_CY -> en_001 */
+	{0x07dc001b20000000ULL, 0x07dc000430200000ULL}, /* en_CZ -> en_150 */
+	{0x07dc001c78000000ULL, 0x07dc000430200000ULL}, /* en_DE -> en_150 */
+	{0x07dc001c88000000ULL, 0x07dc000208400000ULL}, /* en_DG -> en_001 */
+	{0x07dc001ca8000000ULL, 0x07dc000430200000ULL}, /* en_DK -> en_150 */
+	{0x07dc001cb8000000ULL, 0x07dc000208400000ULL}, /* en_DM -> en_001 */
+	{0x07dc001ee0000000ULL, 0x07dc000208400000ULL}, /* en_ER -> en_001 */
+	{0x07dc001ee8000000ULL, 0x07dc000430200000ULL}, /* en_ES -> en_150 */
+	{0x07dc002098000000ULL, 0x07dc000430200000ULL}, /* en_FI -> en_150 */
+	{0x07dc0020a0000000ULL, 0x07dc000208400000ULL}, /* en_FJ -> en_001 */
+	{0x07dc0020a8000000ULL, 0x07dc000208400000ULL}, /* en_FK -> en_001 */
+	{0x07dc0020b8000000ULL, 0x07dc000208400000ULL}, /* en_FM -> en_001 */
+	{0x07dc0020e0000000ULL, 0x07dc000430200000ULL}, /* en_FR -> en_150 */
+	{0x07dc002260000000ULL, 0x07dc000208400000ULL}, /* en_GB -> en_001 */
+	{0x07dc002270000000ULL, 0x07dc000208400000ULL}, /* en_GD -> en_001 */
+	{0x07dc002288000000ULL, 0x07dc000208400000ULL}, /* en_GG -> en_001 */
+	{0x07dc002290000000ULL, 0x07dc000208400000ULL}, /* en_GH -> en_001 */
+	{0x07dc002298000000ULL, 0x07dc000208400000ULL}, /* en_GI -> en_001 */
+	{0x07dc0022b8000000ULL, 0x07dc000208400000ULL}, /* en_GM -> en_001 */
+	{0x07dc0022e8000000ULL, 0x07dc000208400000ULL}, /* en_GS -> en_001 */
+	{0x07dc002318000000ULL, 0x07dc000208400000ULL}, /* en_GY -> en_001 */
+	{0x07dc0024a8000000ULL, 0x07dc000208400000ULL}, /* en_HK -> en_001 */
+	{0x07dc0024f8000000ULL, 0x07dc000430200000ULL}, /* en_HU -> en_150 */
+	{0x07dc002670000000ULL, 0x07dc000208400000ULL}, /* en_ID -> en_001 */
+	{0x07dc002678000000ULL, 0x07dc000208400000ULL}, /* en_IE -> en_001 */
+	{0x07dc0026b0000000ULL, 0x07dc000208400000ULL}, /* en_IL -> en_001 */
+	{0x07dc0026b8000000ULL, 0x07dc000208400000ULL}, /* en_IM -> en_001 */
+	{0x07dc0026c0000000ULL, 0x07dc000208400000ULL}, /* en_IN -> en_001 */
+	{0x07dc0026c8000000ULL, 0x07dc000208400000ULL}, /* en_IO -> en_001 */
+	{0x07dc0026f0000000ULL, 0x07dc000430200000ULL}, /* en_IT -> en_150 */
+	{0x07dc002878000000ULL, 0x07dc000208400000ULL}, /* en_JE -> en_001 */
+	{0x07dc0028b8000000ULL, 0x07dc000208400000ULL}, /* en_JM -> en_001 */
+	{0x07dc002a78000000ULL, 0x07dc000208400000ULL}, /* en_KE -> en_001 */
+	{0x07dc002a98000000ULL, 0x07dc000208400000ULL}, /* en_KI -> en_001 */
+	{0x07dc002ac0000000ULL, 0x07dc000208400000ULL}, /* en_KN -> en_001 */
+	{0x07dc002b18000000ULL, 0x07dc000208400000ULL}, /* en_KY -> en_001 */
+	{0x07dc002c68000000ULL, 0x07dc000208400000ULL}, /* en_LC -> en_001 */
+	{0x07dc002ce0000000ULL, 0x07dc000208400000ULL}, /* en_LR -> en_001 */
+	{0x07dc002ce8000000ULL, 0x07dc000208400000ULL}, /* en_LS -> en_001 */
+	{0x07dc002e88000000ULL, 0x07dc000208400000ULL}, /* en_MG -> en_001 */
+	{0x07dc002ec8000000ULL, 0x07dc000208400000ULL}, /* en_MO -> en_001 */
+	{0x07dc002ee8000000ULL, 0x07dc000208400000ULL}, /* en_MS -> en_001 */
+	{0x07dc002ef0000000ULL, 0x07dc000208400000ULL}, /* en_MT -> en_001 */
+	{0x07dc002ef8000000ULL, 0x07dc000208400000ULL}, /* en_MU -> en_001 */
+	{0x07dc002f00000000ULL, 0x07dc000208400000ULL}, /* en_MV -> en_001 */
+	{0x07dc002f08000000ULL, 0x07dc000208400000ULL}, /* en_MW -> en_001 */
+	{0x07dc002f18000000ULL, 0x07dc000208400000ULL}, /* en_MY -> en_001 */
+	{0x07dc003058000000ULL, 0x07dc000208400000ULL}, /* en_NA -> en_001 */
+	{0x07dc003080000000ULL, 0x07dc000208400000ULL}, /* en_NF -> en_001 */
+	{0x07dc003088000000ULL, 0x07dc000208400000ULL}, /* en_NG -> en_001 */
+	{0x07dc0030b0000000ULL, 0x07dc000430200000ULL}, /* en_NL -> en_150 */
+	{0x07dc0030c8000000ULL, 0x07dc000430200000ULL}, /* en_NO -> en_150 */
+	{0x07dc0030e0000000ULL, 0x07dc000208400000ULL}, /* en_NR -> en_001 */
+	{0x07dc0030f8000000ULL, 0x07dc000208400000ULL}, /* en_NU -> en_001 */
+	{0x07dc003120000000ULL, 0x07dc000208400000ULL}, /* en_NZ -> en_001 */
+	{0x07dc003488000000ULL, 0x07dc000208400000ULL}, /* en_PG -> en_001 */
+	{0x07dc0034a8000000ULL, 0x07dc000208400000ULL}, /* en_PK -> en_001 */
+	{0x07dc0034b0000000ULL, 0x07dc000430200000ULL}, /* en_PL -> en_150 */
+	{0x07dc0034c0000000ULL, 0x07dc000208400000ULL}, /* en_PN -> en_001 */
+	{0x07dc0034f0000000ULL, 0x07dc000430200000ULL}, /* en_PT -> en_150 */
+	{0x07dc003508000000ULL, 0x07dc000208400000ULL}, /* en_PW -> en_001 */
+	{0x07dc0038c8000000ULL, 0x07dc000430200000ULL}, /* en_RO -> en_150 */
+	{0x07dc003908000000ULL, 0x07dc000208400000ULL}, /* en_RW -> en_001 */
+	{0x07dc003a60000000ULL, 0x07dc000208400000ULL}, /* en_SB -> en_001 */
+	{0x07dc003a68000000ULL, 0x07dc000208400000ULL}, /* en_SC -> en_001 */
+	{0x07dc003a70000000ULL, 0x07dc000208400000ULL}, /* en_SD -> en_001 */
+	{0x07dc003a78000000ULL, 0x07dc000430200000ULL}, /* en_SE -> en_150 */
+	{0x07dc003a88000000ULL, 0x07dc000208400000ULL}, /* en_SG -> en_001 */
+	{0x07dc003a90000000ULL, 0x07dc000208400000ULL}, /* en_SH -> en_001 */
+	{0x07dc003a98000000ULL, 0x07dc000430200000ULL}, /* en_SI -> en_150 */
+	{0x07dc003aa8000000ULL, 0x07dc000430200000ULL}, /* en_SK -> en_150 */
+	{0x07dc003ab0000000ULL, 0x07dc000208400000ULL}, /* en_SL -> en_001 */
+	{0x07dc003ae8000000ULL, 0x07dc000208400000ULL}, /* en_SS -> en_001 */
+	{0x07dc003b10000000ULL, 0x07dc000208400000ULL}, /* en_SX -> en_001 */
+	{0x07dc003b20000000ULL, 0x07dc000208400000ULL}, /* en_SZ -> en_001 */
+	{0x07dc003c68000000ULL, 0x07dc000208400000ULL}, /* en_TC -> en_001 */
+	{0x07dc003ca8000000ULL, 0x07dc000208400000ULL}, /* en_TK -> en_001 */
+	{0x07dc003cc8000000ULL, 0x07dc000208400000ULL}, /* en_TO -> en_001 */
+	{0x07dc003cf0000000ULL, 0x07dc000208400000ULL}, /* en_TT -> en_001 */
+	{0x07dc003d00000000ULL, 0x07dc000208400000ULL}, /* en_TV -> en_001 */
+	{0x07dc003d20000000ULL, 0x07dc000208400000ULL}, /* en_TZ -> en_001 */
+	{0x07dc003e88000000ULL, 0x07dc000208400000ULL}, /* en_UG -> en_001 */
+	{0x07dc004068000000ULL, 0x07dc000208400000ULL}, /* en_VC -> en_001 */
+	{0x07dc004088000000ULL, 0x07dc000208400000ULL}, /* en_VG -> en_001 */
+	{0x07dc0040f8000000ULL, 0x07dc000208400000ULL}, /* en_VU -> en_001 */
+	{0x07dc0042e8000000ULL, 0x07dc000208400000ULL}, /* en_WS -> en_001 */
+	{0x07dc004858000000ULL, 0x07dc000208400000ULL}, /* en_ZA -> en_001 */
+	{0x07dc0048b8000000ULL, 0x07dc000208400000ULL}, /* en_ZM -> en_001 */
+	{0x07dc004908000000ULL, 0x07dc000208400000ULL}, /* en_ZW -> en_001 */
+	{0x07e60016e0000000ULL, 0x07e6000a11400000ULL}, /* es_AR -> es_419 */
+	{0x07e60018c8000000ULL, 0x07e6000a11400000ULL}, /* es_BO -> es_419 */
+	{0x07e60018e0000000ULL, 0x07e6000a11400000ULL}, /* es_BR -> es_419 */
+	{0x07e6001920000000ULL, 0x07e6000a11400000ULL}, /* es_BZ -> es_419 */
+	{0x07e6001ab0000000ULL, 0x07e6000a11400000ULL}, /* es_CL -> es_419 */
+	{0x07e6001ac8000000ULL, 0x07e6000a11400000ULL}, /* es_CO -> es_419 */
+	{0x07e6001ae0000000ULL, 0x07e6000a11400000ULL}, /* es_CR -> es_419 */
+	{0x07e6001af8000000ULL, 0x07e6000a11400000ULL}, /* es_CU -> es_419 */
+	{0x07e6001cc8000000ULL, 0x07e6000a11400000ULL}, /* es_DO -> es_419 */
+	{0x07e6001e68000000ULL, 0x07e6000a11400000ULL}, /* es_EC -> es_419 */
+	{0x07e60022f0000000ULL, 0x07e6000a11400000ULL}, /* es_GT -> es_419 */
+	{0x07e60024c0000000ULL, 0x07e6000a11400000ULL}, /* es_HN -> es_419 */
+	{0x07e60028d0000000ULL, 0x07e6000a11400000ULL}, /* es_JP -> es_419 */
+	{0x07e6002f10000000ULL, 0x07e6000a11400000ULL}, /* es_MX -> es_419 */
+	{0x07e6003098000000ULL, 0x07e6000a11400000ULL}, /* es_NI -> es_419 */
+	{0x07e6003458000000ULL, 0x07e6000a11400000ULL}, /* es_PA -> es_419 */
+	{0x07e6003478000000ULL, 0x07e6000a11400000ULL}, /* es_PE -> es_419 */
+	{0x07e60034e0000000ULL, 0x07e6000a11400000ULL}, /* es_PR -> es_419 */
+	{0x07e6003518000000ULL, 0x07e6000a11400000ULL}, /* es_PY -> es_419 */
+	{0x07e6003b00000000ULL, 0x07e6000a11400000ULL}, /* es_SV -> es_419 */
+	{0x07e6003ee8000000ULL, 0x07e6000a11400000ULL}, /* es_US -> es_419 */
+	{0x07e6003f18000000ULL, 0x07e6000a11400000ULL}, /* es_UY -> es_419 */
+	{0x07e6004078000000ULL, 0x07e6000a11400000ULL}, /* es_VE -> es_419 */
+	{0x0882001ab8000000ULL, 0x08820017b1620000ULL}, /* ha_CM -> ha_Arab */
+	{0x0882003a70000000ULL, 0x08820017b1620000ULL}, /* ha_SD -> ha_Arab */
+	{0x0882b03d08000000ULL, 0x0882b0252b140000ULL}, /* hak_TW -> hak_Hant */
+	{0x0892002d2bce0000ULL, 0x07dc0026c0000000ULL}, /* hi_Latn -> en_IN */
+	{0x08a8000000000000ULL, 0x08240024f0000000ULL}, /* ht -> fr_HT */
+	{0x0956001680000000ULL, 0x09560017b1620000ULL}, /* kk_AF -> kk_Arab */
+	{0x0956001ac0000000ULL, 0x09560017b1620000ULL}, /* kk_CN -> kk_Arab */
+	{0x09560026e0000000ULL, 0x09560017b1620000ULL}, /* kk_IR -> kk_Arab */
+	{0x0956002ec0000000ULL, 0x09560017b1620000ULL}, /* kk_MN -> kk_Arab */
+	{0x096a002c60000000ULL, 0x096a0017b1620000ULL}, /* ku_LB -> ku_Arab */
+	{0x0972001ac0000000ULL, 0x09720017b1620000ULL}, /* ky_CN -> ky_Arab */
+	{0x0972003ce0000000ULL, 0x0972002d2bce0000ULL}, /* ky_TR -> ky_Latn */
+	{0x09b5a02278000000ULL, 0x09b5a0234b320000ULL}, /* lzz_GE -> lzz_Geor */
+	{0x09dc001ac0000000ULL, 0x09dc002f9b070000ULL}, /* mn_CN -> mn_Mong */
+	{0x09e6001a68000000ULL, 0x09e60017b1620000ULL}, /* ms_CC -> ms_Arab */
+	{0x0a02e03d08000000ULL, 0x0a02e0252b140000ULL}, /* nan_TW -> nan_Hant */
+	{0x0a04000000000000ULL, 0x0a1e000000000000ULL}, /* nb -> no */
+	{0x0a1c000000000000ULL, 0x0a1e000000000000ULL}, /* nn -> no */
+	{0x0a1e0030c8000000ULL, 0x0a1e000000000000ULL}, /* no_NO -> no */
+	{0x0a820034a8000000ULL, 0x0a820017b1620000ULL}, /* pa_PK -> pa_Arab */
+	{0x0a9d4038f8000000ULL, 0x0a9d401beb8c0000ULL}, /* pnt_RU -> pnt_Cyrl */
+	{0x0a9d403ce0000000ULL, 0x0a9d402d2bce0000ULL}, /* pnt_TR -> pnt_Latn */
+	{0x0aa80016c8000000ULL, 0x0aa80034f0000000ULL}, /* pt_AO -> pt_PT */
+	{0x0aa8001a90000000ULL, 0x0aa80034f0000000ULL}, /* pt_CH -> pt_PT */
+	{0x0aa8001b00000000ULL, 0x0aa80034f0000000ULL}, /* pt_CV -> pt_PT */
+	{0x0aa80020e0000000ULL, 0x0aa80034f0000000ULL}, /* pt_FR -> pt_PT */
+	{0x0aa80022d8000000ULL, 0x0aa80034f0000000ULL}, /* pt_GQ -> pt_PT */
+	{0x0aa8002308000000ULL, 0x0aa80034f0000000ULL}, /* pt_GW -> pt_PT */
+	{0x0aa8002cf8000000ULL, 0x0aa80034f0000000ULL}, /* pt_LU -> pt_PT */
+	{0x0aa8002ec8000000ULL, 0x0aa80034f0000000ULL}, /* pt_MO -> pt_PT */
+	{0x0aa8002f20000000ULL, 0x0aa80034f0000000ULL}, /* pt_MZ -> pt_PT */
+	{0x0aa8003af0000000ULL, 0x0aa80034f0000000ULL}, /* pt_ST -> pt_PT */
+	{0x0aa8003cb0000000ULL, 0x0aa80034f0000000ULL}, /* pt_TL -> pt_PT */
+	{0x0b480026c0000000ULL, 0x0b48001d4c010000ULL}, /* sd_IN -> sd_Deva */
+	{0x0b64002e78000000ULL, 0x0b64002d2bce0000ULL}, /* sr_ME -> sr_Latn */
+	{0x0b640038c8000000ULL, 0x0b64002d2bce0000ULL}, /* sr_RO -> sr_Latn */
+	{0x0b64003ce0000000ULL, 0x0b64002d2bce0000ULL}, /* sr_TR -> sr_Latn */
+	{0x0b8e0034a8000000ULL, 0x0b8e0017b1620000ULL}, /* tg_PK -> tg_Arab */
+	{0x0bce002b20000000ULL, 0x0bce001beb8c0000ULL}, /* ug_KZ -> ug_Cyrl */
+	{0x0bce002ec0000000ULL, 0x0bce001beb8c0000ULL}, /* ug_MN -> ug_Cyrl */
+	{0x0bdd2030d0000000ULL, 0x0bdd201d4c010000ULL}, /* unr_NP -> unr_Deva */
+	{0x0bf4001680000000ULL, 0x0bf40017b1620000ULL}, /* uz_AF -> uz_Arab */
+	{0x0bf4001ac0000000ULL, 0x0bf4001beb8c0000ULL}, /* uz_CN -> uz_Cyrl */
+	{0x0cea501ac0000000ULL, 0x0cea50252b130000ULL}, /* yue_CN -> yue_Hans */
+	{0x0d100016f8000000ULL, 0x0d1000252b140000ULL}, /* zh_AU -> zh_Hant */
+	{0x0d100018c0000000ULL, 0x0d1000252b140000ULL}, /* zh_BN -> zh_Hant */
+	{0x0d10002260000000ULL, 0x0d1000252b140000ULL}, /* zh_GB -> zh_Hant */
+	{0x0d10002280000000ULL, 0x0d1000252b140000ULL}, /* zh_GF -> zh_Hant */
+	{0x0d100024a8000000ULL, 0x0d1000252b140000ULL}, /* zh_HK -> zh_Hant */
+	{0x0d1000252b145d90ULL, 0x0d1000252b144950ULL}, /* zh_Hant_MO -> zh_Hant_HK */
+	{0x0d10002670000000ULL, 0x0d1000252b140000ULL}, /* zh_ID -> zh_Hant */
+	{0x0d10002ec8000000ULL, 0x0d1000252b144950ULL}, /* zh_MO -> zh_Hant_HK */
+	{0x0d10003458000000ULL, 0x0d1000252b140000ULL}, /* zh_PA -> zh_Hant */
+	{0x0d10003480000000ULL, 0x0d1000252b140000ULL}, /* zh_PF -> zh_Hant */
+	{0x0d10003490000000ULL, 0x0d1000252b140000ULL}, /* zh_PH -> zh_Hant */
+	{0x0d10003ae0000000ULL, 0x0d1000252b140000ULL}, /* zh_SR -> zh_Hant */
+	{0x0d10003c90000000ULL, 0x0d1000252b140000ULL}, /* zh_TH -> zh_Hant */
+	{0x0d10003d08000000ULL, 0x0d1000252b140000ULL}, /* zh_TW -> zh_Hant */
+	{0x0d10003ee8000000ULL, 0x0d1000252b140000ULL}, /* zh_US -> zh_Hant */
+	{0x0d100040c0000000ULL, 0x0d1000252b140000ULL}, /* zh_VN -> zh_Hant */
+};
+
+/*
+ * The default scripts of the languages (sorted), except for Latin: it's the default for the languages not listed here.
+ */
+static const LocaleKey LocaleDefaultScripts[LOCALE_DEFAULT_SCRIPT_COUNT] = {
+	0x06c2602f846d0000ULL, 0x06c2f017b1620000ULL, 0x06c34023b1eb0000ULL, 0x06c4001beb8c0000ULL, /* aaf_Mlym aao_Arab aat_Grek ab_Cyrl */
+	0x06c48017b1620000ULL, 0x06c4c03973070000ULL, 0x06c56017b1620000ULL, 0x06c6d017b1620000ULL, /* abh_Arab abl_Rjng abv_Arab acm_Arab */
+	0x06c71017b1620000ULL, 0x06c77017b1620000ULL, 0x06c78017b1620000ULL, 0x06c86017b1620000ULL, /* acq_Arab acw_Arab acx_Arab adf_Arab */
+	0x06c9803d69940000ULL, 0x06c9901beb8c0000ULL, 0x06ca0017d3b40000ULL, 0x06ca2017b1620000ULL, /* adx_Tibt ady_Cyrl ae_Avst aeb_Arab */
+	0x06ca3017b1620000ULL, 0x06ca5017b1620000ULL, 0x06cb1017b1620000ULL, 0x06cc2017b1620000ULL, /* aec_Arab aee_Arab aeq_Arab afb_Arab */
+	0x06ce901d4c010000ULL, 0x06cea01fc2490000ULL, 0x06cf801beb8c0000ULL, 0x06d0701fc2490000ULL, /* agi_Deva agj_Ethi agx_Cyrl ahg_Ethi */
+	0x06d0f017632d0000ULL, 0x06d1201d4c010000ULL, 0x06d22017b1620000ULL, 0x06d2903beb830000ULL, /* aho_Ahom ahr_Deva aib_Arab aii_Syrc */
+	0x06d2a02549920000ULL, 0x06d2e02b2b010000ULL, 0x06d2f02feaf20000ULL, 0x06d31017b1620000ULL, /* aij_Hebr ain_Kana aio_Mymr aiq_Arab */
+	0x06d6b045bbf80000ULL, 0x06d7601beb8c0000ULL, 0x06d8b02d2b2f0000ULL, 0x06d8c02f846d0000ULL, /* akk_Xsux akv_Cyrl alk_Laoo all_Mlym */
+	0x06d9201beb8c0000ULL, 0x06d9401beb8c0000ULL, 0x06d9701fc2490000ULL, 0x06da001fc2490000ULL, /* alr_Cyrl alt_Cyrl alw_Ethi am_Ethi */
+	0x06db3029a16e0000ULL, 0x06db703beb830000ULL, 0x06dc901beb8c0000ULL, 0x06dd001d4c010000ULL, /* ams_Jpan amw_Syrc ani_Cyrl anp_Deva */
+	0x06dd101d4c010000ULL, 0x06dd201d4c010000ULL, 0x06dd501fc2490000ULL, 0x06df40194b070000ULL, /* anq_Deva anr_Deva anu_Ethi aot_Beng */
+	0x06e03017b1620000ULL, 0x06e04017b1620000ULL, 0x06e0801d4c010000ULL, 0x06e2301beb8c0000ULL, /* apc_Arab apd_Arab aph_Deva aqc_Cyrl */
+	0x06e40017b1620000ULL, 0x06e43017b2e90000ULL, 0x06e51017b1620000ULL, 0x06e53017b1620000ULL, /* ar_Arab arc_Armi arq_Arab ars_Arab */
+	0x06e59017b1620000ULL, 0x06e5a017b1620000ULL, 0x06e600194b070000ULL, 0x06e6503b5b170000ULL, /* ary_Arab arz_Arab as_Beng ase_Sgnw */
+	0x06e6b017b1620000ULL, 0x06e7201d4c010000ULL, 0x06e8e017b1620000ULL, 0x06e9601beb8c0000ULL, /* ask_Arab asr_Deva atn_Arab atv_Cyrl */
+	0x06eaa017b1620000ULL, 0x06eba017b1620000ULL, 0x06ec001beb8c0000ULL, 0x06ec4017b1620000ULL, /* auj_Arab auz_Arab av_Cyrl avd_Arab */
+	0x06ecc017b1620000ULL, 0x06ee101d4c010000ULL, 0x06eee01fc2490000ULL, 0x06f0d017b2ee0000ULL, /* avl_Arab awa_Deva awn_Ethi axm_Armn */
+	0x06f28017b1620000ULL, 0x06f2c017b1620000ULL, 0x06f2e017b1620000ULL, 0x06f30017b1620000ULL, /* ayh_Arab ayl_Arab ayn_Arab ayp_Arab */
+	0x06f42017b1620000ULL, 0x0702001beb8c0000ULL, 0x0702c017b1620000ULL, 0x0703001d4c010000ULL, /* azb_Arab ba_Cyrl bal_Arab bap_Deva */
+	0x070380192af50000ULL, 0x0704c0234b320000ULL, 0x0707101fc2490000ULL, 0x07096033b4610000ULL, /* bax_Bamu bbl_Geor bcq_Ethi bdv_Orya */
+	0x0709a017b1620000ULL, 0x070a001beb8c0000ULL, 0x070a501d4c010000ULL, 0x070aa017b1620000ULL, /* bdz_Arab be_Cyrl bee_Deva bej_Arab */
+	0x070c201d4c010000ULL, 0x070d103d2aec0000ULL, 0x070d4017b1620000ULL, 0x070d503d69940000ULL, /* bfb_Deva bfq_Taml bft_Arab bfu_Tibt */
+	0x070d7033b4610000ULL, 0x070d901d4c010000ULL, 0x070da01d4c010000ULL, 0x070e001beb8c0000ULL, /* bfw_Orya bfy_Deva bfz_Deva bg_Cyrl */
+	0x070e301d4c010000ULL, 0x070e401d4c010000ULL, 0x070ee017b1620000ULL, 0x070f0017b1620000ULL, /* bgc_Deva bgd_Deva bgn_Arab bgp_Arab */
+	0x070f101d4c010000ULL, 0x070f701d4c010000ULL, 0x070f8023b1eb0000ULL, 0x0710101d4c010000ULL, /* bgq_Deva bgw_Deva bgx_Grek bha_Deva */
+	0x0710201d4c010000ULL, 0x0710401d4c010000ULL, 0x07105017b1620000ULL, 0x0710801beb8c0000ULL, /* bhb_Deva bhd_Deva bhe_Arab bhh_Cyrl */
+	0x0710901d4c010000ULL, 0x0710a01d4c010000ULL, 0x0710d017b1620000ULL, 0x0710e03beb830000ULL, /* bhi_Deva bhj_Deva bhm_Arab bhn_Syrc */
+	0x0710f01d4c010000ULL, 0x0711401d4c010000ULL, 0x0711501d4c010000ULL, 0x0713901d4c010000ULL, /* bho_Deva bht_Deva bhu_Deva biy_Deva */
+	0x0714603beb830000ULL, 0x0714a01d4c010000ULL, 0x0714d017b1620000ULL, 0x0716b03d69940000ULL, /* bjf_Syrc bjj_Deva bjm_Arab bkk_Tibt */
+	0x0718b02feaf20000ULL, 0x0719403d2c140000ULL, 0x071aa01d4c010000ULL, 0x071c00194b070000ULL, /* blk_Mymr blt_Tavt bmj_Deva bn_Beng */
+	0x071d301d4c010000ULL, 0x071e003d69940000ULL, 0x0720801beb8c0000ULL, 0x0721801d4c010000ULL, /* bns_Deva bo_Tibt bph_Cyrl bpx_Deva */
+	0x072190194b070000ULL, 0x07229017b1620000ULL, 0x0724101d4c010000ULL, 0x0724202b62f20000ULL, /* bpy_Beng bqi_Arab bra_Deva brb_Khmr */
+	0x0724401d4c010000ULL, 0x07248017b1620000ULL, 0x0724b017b1620000ULL, 0x0724f03d69940000ULL, /* brd_Deva brh_Arab brk_Arab bro_Tibt */
+	0x0725602d2b2f0000ULL, 0x0725702b91c10000ULL, 0x0725801d4c010000ULL, 0x07268017b1620000ULL, /* brv_Laoo brw_Knda brx_Deva bsh_Arab */
+	0x0726b017b1620000ULL, 0x072710192bb30000ULL, 0x0727401fc2490000ULL, 0x072840192bcb0000ULL, /* bsk_Arab bsq_Bass bst_Ethi btd_Batk */
+	0x0728d0192bcb0000ULL, 0x0729601d4c010000ULL, 0x072a101beb8c0000ULL, 0x072e502feaf20000ULL, /* btm_Batk btv_Deva bua_Cyrl bwe_Mymr */
+	0x0730d01beb8c0000ULL, 0x0731502f9b070000ULL, 0x0732801d4c010000ULL, 0x0732e01fc2490000ULL, /* bxm_Cyrl bxu_Mong byh_Deva byn_Ethi */
+	0x0733701d4c010000ULL, 0x0734903d61690000ULL, 0x0744e03d61690000ULL, 0x0747001b2aad0000ULL, /* byw_Deva bzi_Thai cbn_Thai ccp_Cakm */
+	0x0748503d4ad50000ULL, 0x0748801d4c010000ULL, 0x07489023ca920000ULL, 0x0748a01d4c010000ULL, /* cde_Telu cdh_Deva cdi_Gujr cdj_Deva */
+	0x0748d01d4c010000ULL, 0x0748f0252b130000ULL, 0x0749a0194b070000ULL, 0x074a001beb8c0000ULL, /* cdm_Deva cdo_Hans cdz_Beng ce_Cyrl */
+	0x074eb03d69940000ULL, 0x07507017b1620000ULL, 0x0750d01beb8c0000ULL, 0x0751201b61f20000ULL, /* cgk_Tibt chg_Arab chm_Cyrl chr_Cher */
+	0x0751801d4c010000ULL, 0x0752801d4c010000ULL, 0x07541017b1620000ULL, 0x0754901beb8c0000ULL, /* chx_Deva cih_Deva cja_Arab cji_Cyrl */
+	0x0754d01b616d0000ULL, 0x075590252b130000ULL, 0x07562017b1620000ULL, 0x0757401beb8c0000ULL, /* cjm_Cham cjy_Hans ckb_Arab ckt_Cyrl */
+	0x07588017b1620000ULL, 0x0759701beb8c0000ULL, 0x075a703b9c6f0000ULL, 0x075c103d69940000ULL, /* clh_Arab clw_Cyrl cmg_Soyo cna_Tibt */
+	0x075d00252b130000ULL, 0x075e703d61690000ULL, 0x075f001b9b540000ULL, 0x07607023b1eb0000ULL, /* cnp_Hans cog_Thai cop_Copt cpg_Grek */
+	0x0764001b2b130000ULL, 0x0764801beb8c0000ULL, 0x0764a01b2b130000ULL, 0x0764b01b2b130000ULL, /* cr_Cans crh_Cyrl crj_Cans crk_Cans */
+	0x0764c01b2b130000ULL, 0x0764d01b2b130000ULL, 0x0766802feaf20000ULL, 0x076700252b130000ULL, /* crl_Cans crm_Cans csh_Mymr csp_Hans */
+	0x0767701b2b130000ULL, 0x076840352be30000ULL, 0x076870194b070000ULL, 0x0768e01d4c010000ULL, /* csw_Cans ctd_Pauc ctg_Beng ctn_Deva */
+	0x0769403d2aec0000ULL, 0x0769903d2aec0000ULL, 0x076a001beb8c0000ULL, 0x076b502d2b010000ULL, /* ctt_Taml cty_Taml cu_Cyrl cuu_Lana */
+	0x076c001beb8c0000ULL, 0x077480252b130000ULL, 0x0774b02549920000ULL, 0x0783101d4c010000ULL, /* cv_Cyrl czh_Hans czk_Hebr daq_Deva */
+	0x0783201beb8c0000ULL, 0x07863017b1620000ULL, 0x0788f01beb8c0000ULL, 0x078a6017b1620000ULL, /* dar_Cyrl dcc_Arab ddo_Cyrl def_Arab */
+	0x078a8017b1620000ULL, 0x078b20194b070000ULL, 0x078ec017b1620000ULL, 0x0790901d4c010000ULL, /* deh_Arab der_Beng dgl_Arab dhi_Deva */
+	0x0790e023ca920000ULL, 0x0790f01d4c010000ULL, 0x0791701d4c010000ULL, 0x0796103d69940000ULL, /* dhn_Gujr dho_Deva dhw_Deva dka_Tibt */
+	0x0798701beb8c0000ULL, 0x079a602f49c60000ULL, 0x079ab017b1620000ULL, 0x079ac017b1620000ULL, /* dlg_Cyrl dmf_Medf dmk_Arab dml_Arab */
+	0x079c701beb8c0000ULL, 0x079d502feaf20000ULL, 0x079d602feaf20000ULL, 0x079e901d4c010000ULL, /* dng_Cyrl dnu_Mymr dnv_Mymr doi_Deva */
+	0x079f801fc2490000ULL, 0x07a4503d69940000ULL, 0x07a5101d4c010000ULL, 0x07a5301fc2490000ULL, /* dox_Ethi dre_Tibt drq_Deva drs_Ethi */
+	0x07a5901d4c010000ULL, 0x07a6f033b4610000ULL, 0x07a9901d4c010000ULL, 0x07aa2023ca920000ULL, /* dry_Deva dso_Orya dty_Deva dub_Gujr */
+	0x07aa801d4c010000ULL, 0x07ab301d4c010000ULL, 0x07ac003d61610000ULL, 0x07aeb033b4610000ULL, /* duh_Deva dus_Deva dv_Thaa dwk_Orya */
+	0x07afa01d4c010000ULL, 0x07b4003d69940000ULL, 0x07b4c03d69940000ULL, 0x07c72023b1eb0000ULL, /* dwz_Deva dz_Tibt dzl_Tibt ecr_Grek */
+	0x07c7901ba3940000ULL, 0x07cf901f5c700000ULL, 0x07d7902b2ac90000ULL, 0x07d80023b1eb0000ULL, /* ecy_Cprt egy_Egyp eky_Kali el_Grek */
+	0x07da701d4c010000ULL, 0x07db501d4c010000ULL, 0x07dc601beb8c0000ULL, 0x07dc801beb8c0000ULL, /* emg_Deva emu_Deva enf_Cyrl enh_Cyrl */
+	0x07e4103d2aec0000ULL, 0x07e670239b0d0000ULL, 0x07e68017b1620000ULL, 0x07e94027c16c0000ULL, /* era_Taml esg_Gonm esh_Arab ett_Ital */
+	0x07ec501beb8c0000ULL, 0x07ece01beb8c0000ULL, 0x08020017b1620000ULL, 0x08039017b1620000ULL, /* eve_Cyrl evn_Cyrl fa_Arab fay_Arab */
+	0x0803a017b1620000ULL, 0x08121017b1620000ULL, 0x081b501d4c010000ULL, 0x082a2017b1620000ULL, /* faz_Arab fia_Arab fmu_Deva fub_Arab */
+	0x0842e0252b130000ULL, 0x08431033b4610000ULL, 0x08433023ca920000ULL, 0x0843503d4ad50000ULL, /* gan_Hans gaq_Orya gas_Gujr gau_Telu */
+	0x0844a033b4610000ULL, 0x0844b01d4c010000ULL, 0x0844c023ca920000ULL, 0x0844d01d4c010000ULL, /* gbj_Orya gbk_Deva gbl_Gujr gbm_Deva */
+	0x0845a017b1620000ULL, 0x08482033b4610000ULL, 0x0848f01beb8c0000ULL, 0x0849801d4c010000ULL, /* gbz_Arab gdb_Orya gdo_Cyrl gdx_Deva */
+	0x084ba01fc2490000ULL, 0x084e7017b1620000ULL, 0x08501017b1620000ULL, 0x0850501d4c010000ULL, /* gez_Ethi ggg_Arab gha_Arab ghe_Deva */
+	0x0850f03d53070000ULL, 0x08512017b1620000ULL, 0x0851403d69940000ULL, 0x08527017b1620000ULL, /* gho_Tfng ghr_Arab ght_Tibt gig_Arab */
+	0x0852e01beb8c0000ULL, 0x0854b017b1620000ULL, 0x08555017b1620000ULL, 0x0858401beb8c0000ULL, /* gin_Cyrl gjk_Arab gju_Arab gld_Cyrl */
+	0x08588017b1620000ULL, 0x0858b017b1620000ULL, 0x085ac02d2bc60000ULL, 0x085b601fc2490000ULL, /* glh_Arab glk_Arab gml_Latf gmv_Ethi */
+	0x085b902d6b020000ULL, 0x085e503d69940000ULL, 0x085e601fc2490000ULL, 0x085ea01d4c010000ULL, /* gmy_Linb goe_Tibt gof_Ethi goj_Deva */
+	0x085eb01d4c010000ULL, 0x085ee01d4c010000ULL, 0x085f40239bc80000ULL, 0x0864101d4c010000ULL, /* gok_Deva gon_Deva got_Goth gra_Deva */
+	0x08643023b1eb0000ULL, 0x086540194b070000ULL, 0x0865501fc2490000ULL, 0x086a0023ca920000ULL, /* grc_Grek grt_Beng gru_Ethi gu_Gujr */
+	0x086d201d4c010000ULL, 0x086e3017b1620000ULL, 0x086e6017b1620000ULL, 0x086f4017b1620000ULL, /* gvr_Deva gwc_Arab gwf_Arab gwt_Arab */
+	0x0872f01d4c010000ULL, 0x08749017b1620000ULL, 0x08823017b1620000ULL, 0x0882b0252b130000ULL, /* gyo_Deva gzi_Arab hac_Arab hak_Hans */
+	0x0883201fc2490000ULL, 0x0883a017b1620000ULL, 0x0884f02549920000ULL, 0x0889901fc2490000ULL, /* har_Ethi haz_Arab hbo_Hebr hdy_Ethi */
+	0x088a002549920000ULL, 0x0892001d4c010000ULL, 0x0892601d4c010000ULL, 0x0892903d2ab20000ULL, /* he_Hebr hi_Deva hif_Deva hii_Takr */
+	0x08934045bbf80000ULL, 0x08968017b1620000ULL, 0x0898201d4c010000ULL, 0x0899502583f70000ULL, /* hit_Xsux hkh_Arab hlb_Deva hlu_Hluw */
+	0x089a403583840000ULL, 0x089aa0199b4f0000ULL, 0x089b10199b4f0000ULL, 0x089c4017b1620000ULL, /* hmd_Plrd hmj_Bopo hmq_Bopo hnd_Arab */
+	0x089c501d4c010000ULL, 0x089ca0258b100000ULL, 0x089cf017b1620000ULL, 0x089e301d4c010000ULL, /* hne_Deva hnj_Hmnp hno_Arab hoc_Deva */
+	0x089e8017b1620000ULL, 0x089ea01d4c010000ULL, 0x089f70252b090000ULL, 0x089f901d4c010000ULL, /* hoh_Arab hoj_Deva how_Hani hoy_Deva */
+	0x08a0f02feaf20000ULL, 0x08a5403beb830000ULL, 0x08a5a017b1620000ULL, 0x08a6e0252b130000ULL, /* hpo_Mymr hrt_Syrc hrz_Arab hsn_Hans */
+	0x08a73017b1620000ULL, 0x08a98045bbf80000ULL, 0x08ab401d4c010000ULL, 0x08ab902549920000ULL, /* hss_Arab htx_Xsux hut_Deva huy_Hebr */
+	0x08aba01beb8c0000ULL, 0x08b20017b2ee0000ULL, 0x08b37017b2ee0000ULL, 0x08d200476a690000ULL, /* huz_Cyrl hy_Armn hyw_Armn ii_Yiii */
+	0x08db902de9a90000ULL, 0x08dc801beb8c0000ULL, 0x08dd402feaf20000ULL, 0x08df201fc2490000ULL, /* imy_Lyci inh_Cyrl int_Mymr ior_Ethi */
+	0x08e5503d2aec0000ULL, 0x08e6b017b1620000ULL, 0x08e8b02549920000ULL, 0x08e8c01beb8c0000ULL, /* iru_Taml isk_Arab itk_Hebr itl_Cyrl */
+	0x08ea001b2b130000ULL, 0x08ee002549920000ULL, 0x09020029a16e0000ULL, 0x09024017b1620000ULL, /* iu_Cans iw_Hebr ja_Jpan jad_Arab */
+	0x09034017b1620000ULL, 0x0904502549920000ULL, 0x0904e017b1620000ULL, 0x0907401beb8c0000ULL, /* jat_Arab jbe_Hebr jbn_Arab jct_Cyrl */
+	0x0908103d69940000ULL, 0x09087017b1620000ULL, 0x0909401beb8c0000ULL, 0x090a501d4c010000ULL, /* jda_Tibt jdg_Arab jdt_Cyrl jee_Deva */
+	0x090e50234b320000ULL, 0x0912002549920000ULL, 0x091450252b070000ULL, 0x0916d02feaf20000ULL, /* jge_Geor ji_Hebr jje_Hang jkm_Mymr */
+	0x091ac01d4c010000ULL, 0x091c103d2ab20000ULL, 0x091c4017b1620000ULL, 0x091cc01d4c010000ULL, /* jml_Deva jna_Takr jnd_Arab jnl_Deva */
+	0x091d301d4c010000ULL, 0x091e7017b1620000ULL, 0x0920102549920000ULL, 0x0921202549920000ULL, /* jns_Deva jog_Arab jpa_Hebr jpr_Hebr */
+	0x0924202549920000ULL, 0x092ac01d4c010000ULL, 0x092ae033b4610000ULL, 0x092b9033b4610000ULL, /* jrb_Hebr jul_Deva jun_Orya juy_Orya */
+	0x0932103d69940000ULL, 0x0932502549920000ULL, 0x094200234b320000ULL, 0x0942101beb8c0000ULL, /* jya_Tibt jye_Hebr ka_Geor kaa_Cyrl */
+	0x0943001beb8c0000ULL, 0x094370192ac90000ULL, 0x0944401beb8c0000ULL, 0x0944703d69940000ULL, /* kap_Cyrl kaw_Bali kbd_Cyrl kbg_Tibt */
+	0x09455017b1620000ULL, 0x09459017b1620000ULL, 0x0946101beb8c0000ULL, 0x09479017b1620000ULL, /* kbu_Arab kby_Arab kca_Cyrl kcy_Arab */
+	0x094910194b070000ULL, 0x0949403d61690000ULL, 0x094b401beb8c0000ULL, 0x094b602f846d0000ULL, /* kdq_Beng kdt_Thai ket_Cyrl kev_Mlym */
+	0x094b801d4c010000ULL, 0x094b903d4ad50000ULL, 0x094c102b91c10000ULL, 0x094c201d4c010000ULL, /* kex_Deva key_Telu kfa_Knda kfb_Deva */
+	0x094c303d4ad50000ULL, 0x094c402b91c10000ULL, 0x094c503d2aec0000ULL, 0x094c702b91c10000ULL, /* kfc_Telu kfd_Knda kfe_Taml kfg_Knda */
+	0x094c802f846d0000ULL, 0x094c903d2aec0000ULL, 0x094cb01d4c010000ULL, 0x094cd017b1620000ULL, /* kfh_Mlym kfi_Taml kfk_Deva kfm_Arab */
+	0x094d001d4c010000ULL, 0x094d101d4c010000ULL, 0x094d201d4c010000ULL, 0x094d301d4c010000ULL, /* kfp_Deva kfq_Deva kfr_Deva kfs_Deva */
+	0x094d501d4c010000ULL, 0x094d801d4c010000ULL, 0x094d901d4c010000ULL, 0x094ea01d4c010000ULL, /* kfu_Deva kfx_Deva kfy_Deva kgj_Deva */
+	0x094f901d4c010000ULL, 0x0950203d2ad50000ULL, 0x0950603d61690000ULL, 0x0950703d69940000ULL, /* kgy_Deva khb_Talu khf_Thai khg_Tibt */
+	0x0950e01d4c010000ULL, 0x0950f019b1680000ULL, 0x0951402feaf20000ULL, 0x0951601beb8c0000ULL, /* khn_Deva kho_Brah kht_Mymr khv_Cyrl */
+	0x09517017b1620000ULL, 0x0952601d4c010000ULL, 0x0952d01beb8c0000ULL, 0x0953001d4c010000ULL, /* khw_Arab kif_Deva kim_Cyrl kip_Deva */
+	0x0954702d2b2f0000ULL, 0x0954801beb8c0000ULL, 0x0954c01d4c010000ULL, 0x0954f01d4c010000ULL, /* kjg_Laoo kjh_Cyrl kjl_Deva kjo_Deva */
+	0x0955002feaf20000ULL, 0x0955403d61690000ULL, 0x0955a03d69940000ULL, 0x0956001beb8c0000ULL, /* kjp_Mymr kjt_Thai kjz_Tibt kk_Cyrl */
+	0x0956603d69940000ULL, 0x0956802d2b010000ULL, 0x0957401d4c010000ULL, 0x0958501d4c010000ULL, /* kkf_Tibt kkh_Lana kkt_Deva kle_Deva */
+	0x0958a017b1620000ULL, 0x0959201d4c010000ULL, 0x095a002b62f20000ULL, 0x095aa01d4c010000ULL, /* klj_Arab klr_Deva km_Khmr kmj_Deva */
+	0x095ba017b1620000ULL, 0x095c002b91c10000ULL, 0x095ce01d4c010000ULL, 0x095e002b9b850000ULL, /* kmz_Arab kn_Knda knn_Deva ko_Kore */
+	0x095e901beb8c0000ULL, 0x095eb01d4c010000ULL, 0x0961401beb8c0000ULL, 0x0961901beb8c0000ULL, /* koi_Cyrl kok_Deva kpt_Cyrl kpy_Cyrl */
+	0x0962403beb830000ULL, 0x0963901fc2490000ULL, 0x0964101d4c010000ULL, 0x0964301beb8c0000ULL, /* kqd_Syrc kqy_Ethi kra_Deva krc_Cyrl */
+	0x0964b01beb8c0000ULL, 0x0965202b62f20000ULL, 0x0965501d4c010000ULL, 0x0965602b62f20000ULL, /* krk_Cyrl krr_Khmr kru_Deva krv_Khmr */
+	0x09660017b1620000ULL, 0x0967502feaf20000ULL, 0x0967702feaf20000ULL, 0x0967a01d4c010000ULL, /* ks_Arab ksu_Mymr ksw_Mymr ksz_Deva */
+	0x0968201fc2490000ULL, 0x0968501d4c010000ULL, 0x0968c017b1620000ULL, 0x0969003583840000ULL, /* ktb_Ethi kte_Deva ktl_Arab ktp_Plrd */
+	0x096a602d2b2f0000ULL, 0x096ad01beb8c0000ULL, 0x096c001beb8c0000ULL, 0x096c101beb8c0000ULL, /* kuf_Laoo kum_Cyrl kv_Cyrl kva_Cyrl */
+	0x096d102feaf20000ULL, 0x096d402feaf20000ULL, 0x096d8017b1620000ULL, 0x096d902b2ac90000ULL, /* kvq_Mymr kvt_Mymr kvx_Arab kvy_Kali */
+	0x0970602feaf20000ULL, 0x0970b02feaf20000ULL, 0x0970d03d61690000ULL, 0x09710017b1620000ULL, /* kxf_Mymr kxk_Mymr kxm_Thai kxp_Arab */
+	0x0972001beb8c0000ULL, 0x0973502b2ac90000ULL, 0x0973601d4c010000ULL, 0x0973701d4c010000ULL, /* ky_Cyrl kyu_Kali kyv_Deva kyw_Deva */
+	0x0982202d6b010000ULL, 0x0982402549920000ULL, 0x0982501d4c010000ULL, 0x09828017b1620000ULL, /* lab_Lina lad_Hebr lae_Deva lah_Arab */
+	0x0984501beb8c0000ULL, 0x0984601d4c010000ULL, 0x0984a03d69940000ULL, 0x0984d01d4c010000ULL, /* lbe_Cyrl lbf_Deva lbj_Tibt lbm_Deva */
+	0x0984f02d2b2f0000ULL, 0x0985201d4c010000ULL, 0x0987003d61690000ULL, 0x098b002d4b430000ULL, /* lbo_Laoo lbr_Deva lcp_Thai lep_Lepc */
+	0x098ba01beb8c0000ULL, 0x0990d01d4c010000ULL, 0x0991303beb830000ULL, 0x0992601d4c010000ULL, /* lez_Cyrl lhm_Deva lhs_Syrc lif_Deva */
+	0x0993302d6bb50000ULL, 0x0996803d69940000ULL, 0x09969017b1620000ULL, 0x099a801d4c010000ULL, /* lis_Lisu lkh_Tibt lki_Arab lmh_Deva */
+	0x099ae03d4ad50000ULL, 0x099e002d2b2f0000ULL, 0x099f901d4c010000ULL, 0x09a0f03583840000ULL, /* lmn_Telu lo_Laoo loy_Deva lpo_Plrd */
+	0x09a43017b1620000ULL, 0x09a4b017b1620000ULL, 0x09a4c017b1620000ULL, 0x09a61017b1620000ULL, /* lrc_Arab lrk_Arab lrl_Arab lsa_Arab */
+	0x09a6402549920000ULL, 0x09a73017b1620000ULL, 0x09a830252b140000ULL, 0x09aab03d69940000ULL, /* lsd_Hebr lss_Arab ltc_Hant luk_Tibt */
+	0x09ab501d4c010000ULL, 0x09ab6017b1620000ULL, 0x09aba017b1620000ULL, 0x09aec03d61690000ULL, /* luu_Deva luv_Arab luz_Arab lwl_Thai */
+	0x09aed03d61690000ULL, 0x09b2103d69940000ULL, 0x09b480252b130000ULL, 0x09c2701d4c010000ULL, /* lwm_Thai lya_Tibt lzh_Hans mag_Deva */
+	0x09c2901d4c010000ULL, 0x09c59017b1620000ULL, 0x09c85017b1620000ULL, 0x09c8601beb8c0000ULL, /* mai_Deva mby_Arab mde_Arab mdf_Cyrl */
+	0x09c9801fc2490000ULL, 0x09c9901fc2490000ULL, 0x09cc1017b1620000ULL, 0x09cc9017b1620000ULL, /* mdx_Ethi mdy_Ethi mfa_Arab mfi_Arab */
+	0x09ce102d2bc70000ULL, 0x09cf001d4c010000ULL, 0x09d0a017b1620000ULL, 0x09d2402f2b040000ULL, /* mga_Latg mgp_Deva mhj_Arab mid_Mand */
+	0x09d4c01d4c010000ULL, 0x09d5102f846d0000ULL, 0x09d5202f846d0000ULL, 0x09d5401d4c010000ULL, /* mjl_Deva mjq_Mlym mjr_Mlym mjt_Deva */
+	0x09d5503d4ad50000ULL, 0x09d5602f846d0000ULL, 0x09d5a01d4c010000ULL, 0x09d6001beb8c0000ULL, /* mju_Telu mjv_Mlym mjz_Deva mk_Cyrl */
+	0x09d6201d4c010000ULL, 0x09d6501d4c010000ULL, 0x09d69017b1620000ULL, 0x09d6d03d61690000ULL, /* mkb_Deva mke_Deva mki_Arab mkm_Thai */
+	0x09d8002f846d0000ULL, 0x09d8603d61690000ULL, 0x09dc001beb8c0000ULL, 0x09dc302f9b070000ULL, /* ml_Mlym mlf_Thai mn_Cyrl mnc_Mong */
+	0x09dc90194b070000ULL, 0x09dca017b1620000ULL, 0x09dd301beb8c0000ULL, 0x09dd702feaf20000ULL, /* mni_Beng mnj_Arab mns_Cyrl mnw_Mymr */
+	0x09e1a03d61690000ULL, 0x09e4001d4c010000ULL, 0x09e4103d61690000ULL, 0x09e4401d4c010000ULL, /* mpz_Thai mr_Deva mra_Thai mrd_Deva */
+	0x09e4a01beb8c0000ULL, 0x09e4f02fb32f0000ULL, 0x09e5201d4c010000ULL, 0x09e8d01beb8c0000ULL, /* mrj_Cyrl mro_Mroo mrr_Deva mtm_Cyrl */
+	0x09e9201d4c010000ULL, 0x09ea401beb8c0000ULL, 0x09eab03d69940000ULL, 0x09eb401d4c010000ULL, /* mtr_Deva mud_Cyrl muk_Tibt mut_Deva */
+	0x09eb603d2aec0000ULL, 0x09eba01fc2490000ULL, 0x09ec5017b1620000ULL, 0x09ec602f9b070000ULL, /* muv_Taml muz_Ethi mve_Arab mvf_Mong */
+	0x09ed9017b1620000ULL, 0x09eda01fc2490000ULL, 0x09ef201d4c010000ULL, 0x09ef402feaf20000ULL, /* mvy_Arab mvz_Ethi mwr_Deva mwt_Mymr */
+	0x09ef70258b100000ULL, 0x09f2002feaf20000ULL, 0x09f2d01fc2490000ULL, 0x09f3601beb8c0000ULL, /* mww_Hmnp my_Mymr mym_Ethi myv_Cyrl */
+	0x09f3a02f2b040000ULL, 0x09f4e017b1620000ULL, 0x0a02e0252b130000ULL, 0x0a02f01d4c010000ULL, /* myz_Mand mzn_Arab nan_Hans nao_Deva */
+	0x0a06401d4c010000ULL, 0x0a07102d2b2f0000ULL, 0x0a08601beb8c0000ULL, 0x0a0a001d4c010000ULL, /* ncd_Deva ncq_Laoo ndf_Cyrl ne_Deva */
+	0x0a0a701beb8c0000ULL, 0x0a0a803d69940000ULL, 0x0a0a9045bbf80000ULL, 0x0a0b701d4c010000ULL, /* neg_Cyrl neh_Tibt nei_Xsux new_Deva */
+	0x0a0f402d2b2f0000ULL, 0x0a12f01beb8c0000ULL, 0x0a13403d4ad50000ULL, 0x0a13601beb8c0000ULL, /* ngt_Laoo nio_Cyrl nit_Telu niv_Cyrl */
+	0x0a189017b1620000ULL, 0x0a18d017b1620000ULL, 0x0a19801d4c010000ULL, 0x0a1ad01d4c010000ULL, /* nli_Arab nlm_Arab nlx_Deva nmm_Deva */
+	0x0a1d00433a4f0000ULL, 0x0a1e402d2b010000ULL, 0x0a1e501d4c010000ULL, 0x0a1e701beb8c0000ULL, /* nnp_Wcho nod_Lana noe_Deva nog_Cyrl */
+	0x0a1e901d4c010000ULL, 0x0a1ee039cb120000ULL, 0x0a1f30476a690000ULL, 0x0a20203d69940000ULL, /* noi_Deva non_Runr nos_Yiii npb_Tibt */
+	0x0a22f0317b2f0000ULL, 0x0a24e039cb120000ULL, 0x0a2640476a690000ULL, 0x0a2660476a690000ULL, /* nqo_Nkoo nrn_Runr nsd_Yiii nsf_Yiii */
+	0x0a26b01b2b130000ULL, 0x0a27403d93a10000ULL, 0x0a2760476a690000ULL, 0x0a2990476a690000ULL, /* nsk_Cans nst_Tnsa nsv_Yiii nty_Yiii */
+	0x0a29a017b1620000ULL, 0x0a2e30314c210000ULL, 0x0a2f801d4c010000ULL, 0x0a32c03d61690000ULL, /* ntz_Arab nwc_Newa nwx_Deva nyl_Thai */
+	0x0a331017b1620000ULL, 0x0a33703d61690000ULL, 0x0a42101beb8c0000ULL, 0x0a42301beb8c0000ULL, /* nyq_Arab nyw_Thai oaa_Cyrl oac_Cyrl */
+	0x0a43203beb830000ULL, 0x0a4360234b320000ULL, 0x0a44d03563180000ULL, 0x0a45202feaf20000ULL, /* oar_Syrc oav_Geor obm_Phnx obr_Mymr */
+	0x0a48b017b1620000ULL, 0x0a514045bbf80000ULL, 0x0a54001b2b130000ULL, 0x0a55301b2b130000ULL, /* odk_Arab oht_Xsux oj_Cans ojs_Cans */
+	0x0a56d0252b070000ULL, 0x0a56f0252b090000ULL, 0x0a57a02b62f20000ULL, 0x0a58101d4c010000ULL, /* okm_Hang oko_Hani okz_Khmr ola_Deva */
+	0x0a58503d69940000ULL, 0x0a5ab01beb8c0000ULL, 0x0a5b002fc1e90000ULL, 0x0a5b202f99c90000ULL, /* ole_Tibt omk_Cyrl omp_Mtei omr_Modi */
+	0x0a5b802feaf20000ULL, 0x0a5ee01d4c010000ULL, 0x0a640033b4610000ULL, 0x0a65403d4ad50000ULL, /* omx_Mymr oon_Deva or_Orya ort_Telu */
+	0x0a655017b1620000ULL, 0x0a65601beb8c0000ULL, 0x0a66001beb8c0000ULL, 0x0a661033ba250000ULL, /* oru_Arab orv_Cyrl os_Cyrl osa_Osge */
+	0x0a663027c16c0000ULL, 0x0a6690292c010000ULL, 0x0a681017b1620000ULL, 0x0a68203d69940000ULL, /* osc_Ital osi_Java ota_Arab otb_Tibt */
+	0x0a68b033b2a80000ULL, 0x0a699023b16e0000ULL, 0x0a6a9033ca320000ULL, 0x0a820023cb950000ULL, /* otk_Orkh oty_Gran oui_Ougr pa_Guru */
+	0x0a82c03562c90000ULL, 0x0a83101beb8c0000ULL, 0x0a854017b1620000ULL, 0x0a86202b62f20000ULL, /* pal_Phli paq_Cyrl pbt_Arab pcb_Khmr */
+	0x0a86502feaf20000ULL, 0x0a86602f846d0000ULL, 0x0a86702f846d0000ULL, 0x0a86801d4c010000ULL, /* pce_Mymr pcf_Mlym pcg_Mlym pch_Deva */
+	0x0a86901d4c010000ULL, 0x0a86a03d4ad50000ULL, 0x0a8a7033b4610000ULL, 0x0a8af045a1ef0000ULL, /* pci_Deva pcj_Telu peg_Orya peo_Xpeo */
+	0x0a8e402b61720000ULL, 0x0a8e701d4c010000ULL, 0x0a8ec033596d0000ULL, 0x0a8ee027c16c0000ULL, /* pgd_Khar pgg_Deva pgl_Ogam pgn_Ital */
+	0x0a90401d4c010000ULL, 0x0a90b02feaf20000ULL, 0x0a90c017b1620000ULL, 0x0a90e03563180000ULL, /* phd_Deva phk_Mymr phl_Arab phn_Phnx */
+	0x0a90f02d2b2f0000ULL, 0x0a912017b1620000ULL, 0x0a91403d61690000ULL, 0x0a91503d61690000ULL, /* pho_Laoo phr_Arab pht_Thai phu_Thai */
+	0x0a916017b1620000ULL, 0x0a91701d4c010000ULL, 0x0a92003b6b080000ULL, 0x0a961019b1680000ULL, /* phv_Arab phw_Deva pi_Sinh pka_Brah */
+	0x0a97202f846d0000ULL, 0x0a98b017b1620000ULL, 0x0a98c02feaf20000ULL, 0x0a9a8019b1680000ULL, /* pkr_Mlym plk_Arab pll_Mymr pmh_Brah */
+	0x0a9d4023b1eb0000ULL, 0x0aa4102b61720000ULL, 0x0aa43017b1620000ULL, 0x0aa44017b1620000ULL, /* pnt_Grek pra_Khar prc_Arab prd_Arab */
+	0x0aa5403d61690000ULL, 0x0aa58017b1620000ULL, 0x0aa60017b1620000ULL, 0x0aa68017b1620000ULL, /* prt_Thai prx_Arab ps_Arab psh_Arab */
+	0x0aa69017b1620000ULL, 0x0aa74017b1620000ULL, 0x0aa75019b1680000ULL, 0x0aaad01d4c010000ULL, /* psi_Arab pst_Arab psu_Brah pum_Deva */
+	0x0aaef02feaf20000ULL, 0x0aaf201d4c010000ULL, 0x0aaf703d61690000ULL, 0x0ab3802feaf20000ULL, /* pwo_Mymr pwr_Deva pww_Thai pyx_Mymr */
+	0x0af11017b1620000ULL, 0x0b02101d4c010000ULL, 0x0b02201d4c010000ULL, 0x0b02601d4c010000ULL, /* qxq_Arab raa_Deva rab_Deva raf_Deva */
+	0x0b0280194b070000ULL, 0x0b02a01d4c010000ULL, 0x0b03601d4c010000ULL, 0x0b04202feaf20000ULL, /* rah_Beng raj_Deva rav_Deva rbb_Mymr */
+	0x0b082017b1620000ULL, 0x0b0a9033b4610000ULL, 0x0b1070399a470000ULL, 0x0b14901d4c010000ULL, /* rdb_Arab rei_Orya rhg_Rohg rji_Deva */
+	0x0b15301d4c010000ULL, 0x0b16102b62f20000ULL, 0x0b16902feaf20000ULL, 0x0b1740194b070000ULL, /* rjs_Deva rka_Khmr rki_Mymr rkt_Beng */
+	0x0b1a9017b2ee0000ULL, 0x0b1b4017b1620000ULL, 0x0b1ba02feaf20000ULL, 0x0b26b01beb8c0000ULL, /* rmi_Armn rmt_Arab rmz_Mymr rsk_Cyrl */
+	0x0b29701d4c010000ULL, 0x0b2a001beb8c0000ULL, 0x0b2a501beb8c0000ULL, 0x0b2b401beb8c0000ULL, /* rtw_Deva ru_Cyrl rue_Cyrl rut_Cyrl */
+	0x0b2f201d4c010000ULL, 0x0b33502b2b010000ULL, 0x0b42001d4c010000ULL, 0x0b42801beb8c0000ULL, /* rwr_Deva ryu_Kana sa_Deva sah_Cyrl */
+	0x0b42d03b2af20000ULL, 0x0b43403381ab0000ULL, 0x0b43a03b2bf20000ULL, 0x0b44e017b1620000ULL, /* sam_Samr sat_Olck saz_Saur sbn_Arab */
+	0x0b45503d69940000ULL, 0x0b46b01d4c010000ULL, 0x0b46c017b1620000ULL, 0x0b47001d4c010000ULL, /* sbu_Tibt sck_Deva scl_Arab scp_Deva */
+	0x0b47402d2b2f0000ULL, 0x0b47503d2ab20000ULL, 0x0b478023b1eb0000ULL, 0x0b480017b1620000ULL, /* sct_Laoo scu_Takr scx_Grek sd_Arab */
+	0x0b482017b1620000ULL, 0x0b486017b1620000ULL, 0x0b487017b1620000ULL, 0x0b488017b1620000ULL, /* sdb_Arab sdf_Arab sdg_Arab sdh_Arab */
+	0x0b4920194b070000ULL, 0x0b493017b1620000ULL, 0x0b4ac01beb8c0000ULL, 0x0b4cd03583840000ULL, /* sdr_Beng sds_Arab sel_Cyrl sfm_Plrd */
+	0x0b4e801beb8c0000ULL, 0x0b4ea01d4c010000ULL, 0x0b4f2017b1620000ULL, 0x0b4f403d69940000ULL, /* sgh_Cyrl sgj_Deva sgr_Arab sgt_Tibt */
+	0x0b4f701fc2490000ULL, 0x0b4f9017b1620000ULL, 0x0b504017b1620000ULL, 0x0b50903d53070000ULL, /* sgw_Ethi sgy_Arab shd_Arab shi_Tfng */
+	0x0b50d017b1620000ULL, 0x0b50e02feaf20000ULL, 0x0b515017b1620000ULL, 0x0b516017b1620000ULL, /* shm_Arab shn_Mymr shu_Arab shv_Arab */
+	0x0b52003b6b080000ULL, 0x0b52101beb8c0000ULL, 0x0b53003d69940000ULL, 0x0b539017b1620000ULL, /* si_Sinh sia_Cyrl sip_Tibt siy_Arab */
+	0x0b53a017b1620000ULL, 0x0b54401beb8c0000ULL, 0x0b55001d4c010000ULL, 0x0b55401beb8c0000ULL, /* siz_Arab sjd_Cyrl sjp_Deva sjt_Cyrl */
+	0x0b56203d61690000ULL, 0x0b56a01d4c010000ULL, 0x0b572017b1620000ULL, 0x0b5a80476a690000ULL, /* skb_Thai skj_Deva skr_Arab smh_Yiii */
+	0x0b5b003b2af20000ULL, 0x0b5b502b62f20000ULL, 0x0b5b9017b1620000ULL, 0x0b5e103d2c140000ULL, /* smp_Samr smu_Khmr smy_Arab soa_Tavt */
+	0x0b5e703b9a240000ULL, 0x0b5e901d4c010000ULL, 0x0b5f503d61690000ULL, 0x0b61403d69940000ULL, /* sog_Sogd soi_Deva sou_Thai spt_Tibt */
+	0x0b616033b4610000ULL, 0x0b62f017b1620000ULL, 0x0b63102d2b2f0000ULL, 0x0b634017b1620000ULL, /* spv_Orya sqo_Arab sqq_Laoo sqt_Arab */
+	0x0b64001beb8c0000ULL, 0x0b64203b9b810000ULL, 0x0b648017b1620000ULL, 0x0b65801d4c010000ULL, /* sr_Cyrl srb_Sora srh_Arab srx_Deva */
+	0x0b65a017b1620000ULL, 0x0b668017b1620000ULL, 0x0b67302d2b2f0000ULL, 0x0b693017b1620000ULL, /* srz_Arab ssh_Arab sss_Laoo sts_Arab */
+	0x0b69601fc2490000ULL, 0x0b69901beb8c0000ULL, 0x0b6ba03bcb150000ULL, 0x0b6c10234b320000ULL, /* stv_Ethi sty_Cyrl suz_Sunu sva_Geor */
+	0x0b6e2017b1620000ULL, 0x0b6e90252b090000ULL, 0x0b6f601d4c010000ULL, 0x0b715039cb120000ULL, /* swb_Arab swi_Hani swv_Deva sxu_Runr */
+	0x0b72303beb830000ULL, 0x0b72c0194b070000ULL, 0x0b72e03beb830000ULL, 0x0b73203beb830000ULL, /* syc_Syrc syl_Beng syn_Syrc syr_Syrc */
+	0x0b73701d4c010000ULL, 0x0b82003d2aec0000ULL, 0x0b82201beb8c0000ULL, 0x0b82a01d4c010000ULL, /* syw_Deva ta_Taml tab_Cyrl taj_Deva */
+	0x0b84b03d2a220000ULL, 0x0b86e03d69940000ULL, 0x0b86f02feaf20000ULL, 0x0b87803d2aec0000ULL, /* tbk_Tagb tcn_Tibt tco_Mymr tcx_Taml */
+	0x0b87902b91c10000ULL, 0x0b88103d53070000ULL, 0x0b88201d4c010000ULL, 0x0b88403d2ac50000ULL, /* tcy_Knda tda_Tfng tdb_Deva tdd_Tale */
+	0x0b88701d4c010000ULL, 0x0b88801d4c010000ULL, 0x0b8a003d4ad50000ULL, 0x0b8b30292c010000ULL, /* tdg_Deva tdh_Deva te_Telu tes_Java */
+	0x0b8e001beb8c0000ULL, 0x0b8e501d4c010000ULL, 0x0b8e603d69940000ULL, 0x0b90003d61690000ULL, /* tg_Cyrl tge_Deva tgf_Tibt th_Thai */
+	0x0b90501d4c010000ULL, 0x0b90601d4c010000ULL, 0x0b90903d2ac50000ULL, 0x0b90c01d4c010000ULL, /* the_Deva thf_Deva thi_Tale thl_Deva */
+	0x0b90d03d61690000ULL, 0x0b91101d4c010000ULL, 0x0b91201d4c010000ULL, 0x0b91301d4c010000ULL, /* thm_Thai thq_Deva thr_Deva ths_Deva */
+	0x0b92001fc2490000ULL, 0x0b92701fc2490000ULL, 0x0b92a01d4c010000ULL, 0x0b92e01beb8c0000ULL, /* ti_Ethi tig_Ethi tij_Deva tin_Cyrl */
+	0x0b94c02feaf20000ULL, 0x0b94f017b1620000ULL, 0x0b96201d4c010000ULL, 0x0b973017b1620000ULL, /* tjl_Mymr tjo_Arab tkb_Deva tks_Arab */
+	0x0b97401d4c010000ULL, 0x0b9b203beb830000ULL, 0x0b9d601b2aad0000ULL, 0x0b9f6017b1620000ULL, /* tkt_Deva tmr_Syrc tnv_Cakm tov_Arab */
+	0x0ba1502b62f20000ULL, 0x0ba41017b1620000ULL, 0x0ba4702549920000ULL, 0x0ba4d017b1620000ULL, /* tpu_Khmr tra_Arab trg_Hebr trm_Arab */
+	0x0ba57017b1620000ULL, 0x0ba64023b1eb0000ULL, 0x0ba6a03d69940000ULL, 0x0ba8001beb8c0000ULL, /* trw_Arab tsd_Grek tsj_Tibt tt_Cyrl */
+	0x0ba8802d2b2f0000ULL, 0x0ba8f02d2b2f0000ULL, 0x0ba9303d61690000ULL, 0x0ba9a01d4c010000ULL, /* tth_Laoo tto_Laoo tts_Thai ttz_Deva */
+	0x0bace02feaf20000ULL, 0x0baed01d4c010000ULL, 0x0bb0703d2b070000ULL, 0x0bb0f03d9bcf0000ULL, /* tvn_Mymr twm_Deva txg_Tang txo_Toto */
+	0x0bb3203d2c140000ULL, 0x0bb3601beb8c0000ULL, 0x0bc8501beb8c0000ULL, 0x0bc8702f846d0000ULL, /* tyr_Tavt tyv_Cyrl ude_Cyrl udg_Mlym */
+	0x0bc8901beb8c0000ULL, 0x0bc8d01beb8c0000ULL, 0x0bce0017b1620000ULL, 0x0bce103f59720000ULL, /* udi_Cyrl udm_Cyrl ug_Arab uga_Ugar */
+	0x0bce801beb8c0000ULL, 0x0bcef03d61690000ULL, 0x0bd6001beb8c0000ULL, 0x0bd69033b4610000ULL, /* ugh_Cyrl ugo_Thai uk_Cyrl uki_Orya */
+	0x0bd8301beb8c0000ULL, 0x0bdd20194b070000ULL, 0x0bdd80194b070000ULL, 0x0be40017b1620000ULL, /* ulc_Cyrl unr_Beng unx_Beng ur_Arab */
+	0x0be4b03d61690000ULL, 0x0be68017b1620000ULL, 0x0bead023b1eb0000ULL, 0x0bf53017b1620000ULL, /* urk_Thai ush_Arab uum_Grek uzs_Arab */
+	0x0c02103d2aec0000ULL, 0x0c026017b1620000ULL, 0x0c02801d4c010000ULL, 0x0c0290412a690000ULL, /* vaa_Taml vaf_Arab vah_Deva vai_Vaii */
+	0x0c03301d4c010000ULL, 0x0c03601d4c010000ULL, 0x0c03901d4c010000ULL, 0x0c0f2017b1620000ULL, /* vas_Deva vav_Deva vay_Deva vgr_Arab */
+	0x0c14b01d4c010000ULL, 0x0c1a402b91c10000ULL, 0x0c1a8017b1620000ULL, 0x0c42c01fc2490000ULL, /* vjk_Deva vmd_Knda vmh_Arab wal_Ethi */
+	0x0c44b017b1620000ULL, 0x0c45103d4ad50000ULL, 0x0c45201d4c010000ULL, 0x0c58501fc2490000ULL, /* wbk_Arab wbq_Telu wbr_Deva wle_Ethi */
+	0x0c58f017b1620000ULL, 0x0c5a501d4c010000ULL, 0x0c5c5017b1620000ULL, 0x0c5c9017b1620000ULL, /* wlo_Arab wme_Deva wne_Arab wni_Arab */
+	0x0c6670239b070000ULL, 0x0c676017b1620000ULL, 0x0c68d01d4c010000ULL, 0x0c6b50252b130000ULL, /* wsg_Gong wsv_Arab wtm_Deva wuu_Hans */
+	0x0c8270175a420000ULL, 0x0c82c01beb8c0000ULL, 0x0c82e01fc2490000ULL, 0x0c83301beb8c0000ULL, /* xag_Aghb xal_Cyrl xan_Ethi xas_Cyrl */
+	0x0c86f01b63930000ULL, 0x0c87201b2b890000ULL, 0x0c89101beb8c0000ULL, 0x0c905017b1620000ULL, /* xco_Chrs xcr_Cari xdq_Cyrl xhe_Arab */
+	0x0c90d02b62f20000ULL, 0x0c933033b4610000ULL, 0x0c961017b1620000ULL, 0x0c963017b1620000ULL, /* xhm_Khmr xis_Orya xka_Arab xkc_Arab */
+	0x0c96603d69940000ULL, 0x0c96a017b1620000ULL, 0x0c970017b1620000ULL, 0x0c98302de9a90000ULL, /* xkf_Tibt xkj_Arab xkp_Arab xlc_Lyci */
+	0x0c98402de9c90000ULL, 0x0c99901f846d0000ULL, 0x0c9a60234b320000ULL, 0x0c9ae02f2b090000ULL, /* xld_Lydi xly_Elym xmf_Geor xmn_Mani */
+	0x0c9b202f4b830000ULL, 0x0c9c10312b820000ULL, 0x0c9d201d4c010000ULL, 0x0ca07023b1eb0000ULL, /* xmr_Merc xna_Narb xnr_Deva xpg_Grek */
+	0x0ca09033596d0000ULL, 0x0ca0d01beb8c0000ULL, 0x0ca12035b3c90000ULL, 0x0ca4d01beb8c0000ULL, /* xpi_Ogam xpm_Cyrl xpr_Prti xrm_Cyrl */
+	0x0ca4e01beb8c0000ULL, 0x0ca6103b2b820000ULL, 0x0ca7201d4c010000ULL, 0x0ca91019b1680000ULL, /* xrn_Cyrl xsa_Sarb xsr_Deva xtq_Brah */
+	0x0caa203d2aec0000ULL, 0x0caaa03d2aec0000ULL, 0x0cac5027c16c0000ULL, 0x0cac9017b1620000ULL, /* xub_Taml xuj_Taml xve_Ital xvi_Arab */
+	0x0caef01beb8c0000ULL, 0x0cb4802f2b830000ULL, 0x0cc2901beb8c0000ULL, 0x0cc4801d4c010000ULL, /* xwo_Cyrl xzh_Marc yai_Cyrl ybh_Deva */
+	0x0cc4901d4c010000ULL, 0x0cc87017b1620000ULL, 0x0cca102f846d0000ULL, 0x0ccaa023b1eb0000ULL, /* ybi_Deva ydg_Arab yea_Mlym yej_Grek */
+	0x0ccb503d4ad50000ULL, 0x0ccf003583840000ULL, 0x0cd0402549920000ULL, 0x0cd2002549920000ULL, /* yeu_Telu ygp_Plrd yhd_Hebr yi_Hebr */
+	0x0cd270476a690000ULL, 0x0cd2802549920000ULL, 0x0cd360476a690000ULL, 0x0cd6701beb8c0000ULL, /* yig_Yiii yih_Hebr yiv_Yiii ykg_Cyrl */
+	0x0cd6801beb8c0000ULL, 0x0cdc103583840000ULL, 0x0cdcb01beb8c0000ULL, 0x0cde9029a16e0000ULL, /* ykh_Cyrl yna_Plrd ynk_Cyrl yoi_Jpan */
+	0x0cdf903d61690000ULL, 0x0ce4b01beb8c0000ULL, 0x0ce640476a690000ULL, 0x0ce6e0476a690000ULL, /* yoy_Thai yrk_Cyrl ysd_Yiii ysn_Yiii */
+	0x0ce700476a690000ULL, 0x0ce7201beb8c0000ULL, 0x0ce7903583840000ULL, 0x0cea402549920000ULL, /* ysp_Yiii ysr_Cyrl ysy_Plrd yud_Hebr */
+	0x0cea50252b140000ULL, 0x0cea701beb8c0000ULL, 0x0ceb801beb8c0000ULL, 0x0cef103583840000ULL, /* yue_Hant yug_Cyrl yux_Cyrl ywq_Plrd */
+	0x0cef503583840000ULL, 0x0d03503d69940000ULL, 0x0d041017b1620000ULL, 0x0d0680252b090000ULL, /* ywu_Plrd zau_Tibt zba_Arab zch_Hani */
+	0x0d08a017b1620000ULL, 0x0d0a80252b090000ULL, 0x0d0ae03d53070000ULL, 0x0d0e20252b090000ULL, /* zdj_Arab zeh_Hani zen_Tfng zgb_Hani */
+	0x0d0e803d53070000ULL, 0x0d0ed0252b090000ULL, 0x0d0ee0252b090000ULL, 0x0d1000252b130000ULL, /* zgh_Tfng zgm_Hani zgn_Hani zh_Hans */
+	0x0d1040252b090000ULL, 0x0d118031ba550000ULL, 0x0d16f01beb8c0000ULL, 0x0d17402b6bd30000ULL, /* zhd_Hani zhx_Nshu zko_Cyrl zkt_Kits */
+	0x0d17a01beb8c0000ULL, 0x0d18a0252b090000ULL, 0x0d18e0252b090000ULL, 0x0d1910252b090000ULL, /* zkz_Cyrl zlj_Hani zln_Hani zlq_Hani */
+	0x0d2250252b090000ULL, 0x0d247033b4610000ULL, 0x0d25002549920000ULL, 0x0d2ad017b1620000ULL, /* zqe_Hani zrg_Orya zrp_Hebr zum_Arab */
+	0x0d2e101fc2490000ULL, 0x0d3270252b090000ULL, 0x0d32e0252b090000ULL, 0x0d34a0252b090000ULL, /* zwa_Ethi zyg_Hani zyn_Hani zzj_Hani */
+};
+
+/*
+ * Finds the first item of a sorted LocaleKey array that's not smaller than key.
+ */
+static size_t LowerBoundLocaleKey(const LocaleKey* keys, size_t count, LocaleKey key)
+{
+	size_t low, high, middle;
+	low = 0;
+	high = count;
+	while (low < high) {
+		middle = low + (high - low) / 2;
+		if (keys[middle] < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/*
+ * Checks if the script of a language_Script key is the default one of the language.
+ */
+static int IsDefaultLocaleKeyScript(LocaleKey key)
+{
+	LocaleKey language;
+	size_t index;
+	language = key >> LOCALE_KEY_FIRST_SEGMENT_SHIFT;
+	index = LowerBoundLocaleKey(LocaleDefaultScripts, LOCALE_DEFAULT_SCRIPT_COUNT, language << LOCALE_KEY_FIRST_SEGMENT_SHIFT);
+	if (index < LOCALE_DEFAULT_SCRIPT_COUNT && LocaleDefaultScripts[index] >> LOCALE_KEY_FIRST_SEGMENT_SHIFT == language) {
+		return LocaleDefaultScripts[index] == key;
+	}
+	return (key & LOCALE_KEY_SECOND_SEGMENT_MASK) == LOCALE_KEY_SCRIPT_LATN;
+}
+
+/*
+ * Get the parent of a LocaleKey, following the CLDR inheritance rules (for example es_AR -> es_419 -> es -> root).
+ * Returns 0 if key is 0 or if it's the root.
+ */
+LocaleKey GetParentLocaleKey(LocaleKey key)
+{
+	size_t low, high, middle;
+	if (!key || key == LOCALE_KEY_ROOT) {
+		return 0;
+	}
+	low = 0;
+	high = LOCALE_PARENT_COUNT;
+	while (low < high) {
+		middle = low + (high - low) / 2;
+		if (LocaleParents[middle].child == key) {
+			return LocaleParents[middle].parent;
+		}
+		if (LocaleParents[middle].child < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	if (key & LOCALE_KEY_THIRD_SEGMENT_MASK) {
+		/* language_Script_TERRITORY -> language_Script */
+		return key & ~LOCALE_KEY_THIRD_SEGMENT_MASK;
+	}
+	if (!(key & LOCALE_KEY_SECOND_SEGMENT_MASK)) {
+		/* language or Script -> root */
+		return LOCALE_KEY_ROOT;
+	}
+	if ((key & LOCALE_KEY_SCRIPT_LAST_POSITION_MASK) && !IsDefaultLocaleKeyScript(key)) {
+		/* language_Script -> root, if Script is not the default script of the language */
+		return LOCALE_KEY_ROOT;
+	}
+	/* language_TERRITORY, Script_TERRITORY, or language_Script -> language or Script */
+	return key & ~LOCALE_KEY_SECOND_SEGMENT_MASK;
+}
+
+/*
+ * Options of LocaleFallbackIterator.
+ */
+/* Write the Gettext name of every step too (the steps that can't be represented in Gettext format have an empty Gettext name) */
+#define LOCALE_FALLBACK_GETTEXT 1
+/* Stop before the root */
+#define LOCALE_FALLBACK_SKIP_ROOT 2
+
+/*
+ * Iterates over the fallback chain of a locale (for example sr_Latn_RS_POSIX -> sr_Latn_RS -> sr_Latn -> root).
+ * The variants are removed first, one at a time, then the Gettext modifier (if it doesn't identify a script, like in ca_ES@valencia -> ca_ES),
+ * then the CLDR parents are followed (see GetParentLocaleKey).
+ * Every step is written to caller-provided buffers, so nothing is allocated.
+ */
+typedef struct _LocaleFallbackIterator {
+	/* The variants of the starting locale (the first variantCount ones are used in the next step) */
+	char* const* variants;
+	size_t variantCount;
+	/* The Gettext modifier of the starting locale that doesn't identify a script (NULL if it's not used in the next step) */
+	const char* modifier;
+	/* The language, script and territory of the next step (0 when the iteration is over) */
+	LocaleKey key;
+	/* Output format (LOCALE_FORMAT_... constants) */
+	unsigned int format;
+	/* LOCALE_FALLBACK_... flags */
+	unsigned int options;
+	/* The lengths of the whole identifiers of the last step (0 if they can't be represented in the requested format) */
+	size_t length;
+	size_t gettextLength;
+} LocaleFallbackIterator;
+
+/*
+ * Initializes a LocaleFallbackIterator (lc must not be freed or changed while iterating, since its variants and its modifier are not copied).
+ * The number of variants of lc is checked against the limits of a context, and in strict mode its subtags must be registered (NULL for the default context).
+ * Returns 0 if lc is NULL, if it exceeds the limits of the context or if its language, script and territory can't be represented as a LocaleKey
+ * (for instance, Gettext languages like "POSIX").
+ */
+int InitLocaleFallbackIterator(LocaleFallbackIterator* iterator, const LocaleChunks* lc, unsigned int format, unsigned int options, LocaleContext* context)
+{
+	LocaleChunkSlices slices;
+	memset(iterator, 0, sizeof(LocaleFallbackIterator));
+	if (!context) {
+		context = &DefaultLocaleContext;
+	}
+	if (!lc || lc->variantCount > context->maxVariants || ((context->flags & LOCALE_CONTEXT_STRICT) && !IsRegisteredLocaleChunks(lc))) {
+		return 0;
+	}
+	/* The variants are walked down separately, so only the language, the script and the territory go in the key */
+	SetLocaleKeySlices(&slices, lc);
+	iterator->key = LocaleChunkSlicesToLocaleKey(&slices);
+	if (!iterator->key) {
+		return 0;
+	}
+	iterator->variants = lc->variants;
+	iterator->variantCount = lc->variantCount;
+	if (lc->modifier && !GettextModifierToUnicodeScript(lc->modifier)) {
+		iterator->modifier = lc->modifier;
+	}
+	iterator->format = format;
+	iterator->options = options;
+	return 1;
+}
+
+/*
+ * Writes the next step of a LocaleFallbackIterator to buffer (and its Gettext name to gettextBuffer, if the LOCALE_FALLBACK_GETTEXT option is set).
+ * Like snprintf, the results are truncated (but still null-terminated) if the buffers are too small, and the buffers may be NULL if their size is 0:
+ * the lengths of the whole identifiers are stored in the length and gettextLength fields
+ * (they are 0 for the steps with a Gettext modifier, if the output format is not LOCALE_FORMAT_GETTEXT).
+ * Returns 0 when there are no more steps, 1 otherwise.
+ */
+int NextLocaleFallback(LocaleFallbackIterator* iterator, char* buffer, size_t size, char* gettextBuffer, size_t gettextSize)
+{
+	char canonical[LOCALE_ID_INLINE_SIZE];
+	LocaleChunkSlices slices;
+	LocaleIDBufferWriter destination;
+	LocaleKey key;
+	const char* modifier;
+	size_t variantCount;
+	key = iterator->key;
+	variantCount = iterator->variantCount;
+	modifier = iterator->modifier;
+	if (!key || (key == LOCALE_KEY_ROOT && (iterator->options & LOCALE_FALLBACK_SKIP_ROOT))) {
+		return 0;
+	}
+	if (iterator->variantCount) {
+		iterator->variantCount--;
+	} else if (iterator->modifier) {
+		iterator->modifier = NULL;
+	} else {
+		iterator->key = GetParentLocaleKey(key);
+	}
+	if (!ScanUnicodeLocaleID(canonical, LocaleKeyToUnicodeLocaleIDBuffer(key, canonical, sizeof(canonical)), &slices)) {
+		return 0;
+	}
+	slices.variantCount = variantCount;
+	SetLocaleSlice(&slices.modifier, modifier);
+	destination.buffer = buffer;
+	destination.size = size;
+	destination.length = 0;
+	/* Only Gettext identifiers have modifiers: the other formats would write the same identifier of the next step */
+	if (!modifier || (iterator->format & ~LOCALE_FORMAT_CANONICAL_CASE) == LOCALE_FORMAT_GETTEXT) {
+		WriteLocaleIDChunks(&slices, iterator->variants, iterator->format, WriteLocaleIDToBuffer, &destination);
+	}
+	TerminateLocaleIDBuffer(buffer, size, destination.length);
+	iterator->length = destination.length;
+	if (iterator->options & LOCALE_FALLBACK_GETTEXT) {
+		destination.buffer = gettextBuffer;
+		destination.size = gettextSize;
+		destination.length = 0;
+		/*
+		 * Gettext doesn't have variants, and a script without a Gettext modifier would be lost:
+		 * skip these steps, unless the territory implies the script (for example zh_Hant_TW -> zh_TW).
+		 */
+		if (!variantCount && !(slices.script.length && !slices.territory.length && !TranslateLocaleSlice(&slices.script, 0))) {
+			WriteLocaleIDChunks(&slices, NULL, LOCALE_FORMAT_GETTEXT, WriteLocaleIDToBuffer, &destination);
+		}
+		TerminateLocaleIDBuffer(gettextBuffer, gettextSize, destination.length);
+		iterator->gettextLength = destination.length;
+	}
+	return 1;
+}
+
+/*
+ * Languages spoken in the territories, from the CLDR territory data (through Babel 2.18: see tools/generate-territory-languages.py).
+ * For every territory, the LocaleKeys of its languages (with their script, if it's not the default one) are sorted by the percentage of the population that speaks them.
+ * Territories are identified by a dense ID (see GetLocaleTerritoryID).
+ */
+#define LOCALE_TERRITORY_ID_COUNT (26 * 26)
+#define LOCALE_TERRITORY_LANGUAGE_COUNT 1524
+
+/*
+ * Where the languages of every territory start in LocaleTerritoryLanguages (the last item is the end of the last territory).
+ */
+static const uint16_t LocaleTerritoryLanguageOffsets[LOCALE_TERRITORY_ID_COUNT + 1] = {
+	0, 0, 0, 1, 4, 10, 20, 22, 22, 23, 23, 23, 26, 29, 29, 33,
+	33, 34, 38, 40, 48, 53, 53, 56, 57, 57, 63, 69, 70, 70, 80, 86,
+	91, 96, 98, 102, 106, 106, 107, 108, 112, 117, 117, 119, 131, 132, 137, 137,
+	138, 141, 141, 143, 145, 205, 205, 207, 215, 215, 218, 220, 230, 236, 236, 237,
+	240, 268, 295, 298, 299, 300, 301, 301, 301, 302, 304, 307, 308, 315, 320, 320,
+	320, 320, 320, 345, 345, 346, 346, 346, 350, 357, 357, 358, 358, 360, 360, 360,
+	360, 360, 360, 360, 360, 360, 360, 360, 365, 366, 366, 369, 369, 375, 375, 380,
+	381, 381, 381, 381, 381, 381, 381, 381, 381, 381, 388, 397, 406, 406, 406, 406,
+	406, 406, 406, 406, 406, 406, 406, 406, 406, 406, 406, 416, 421, 422, 422, 428,
+	428, 429, 429, 429, 446, 446, 446, 446, 446, 446, 446, 446, 446, 448, 472, 472,
+	473, 481, 485, 486, 498, 500, 500, 500, 502, 507, 515, 515, 516, 521, 533, 534,
+	536, 538, 538, 543, 543, 544, 544, 544, 544, 544, 544, 544, 544, 544, 544, 544,
+	544, 548, 548, 549, 551, 551, 551, 551, 555, 555, 557, 565, 565, 565, 565, 565,
+	565, 565, 565, 566, 598, 601, 601, 601, 601, 601, 601, 601, 614, 616, 695, 696,
+	696, 703, 725, 727, 748, 748, 748, 748, 748, 748, 748, 748, 748, 748, 748, 749,
+	749, 749, 749, 749, 749, 749, 749, 751, 751, 754, 757, 757, 757, 757, 757, 757,
+	757, 757, 757, 757, 757, 757, 757, 757, 757, 777, 777, 780, 783, 785, 785, 785,
+	785, 789, 790, 790, 791, 791, 792, 792, 792, 792, 792, 793, 793, 794, 800, 804,
+	810, 811, 811, 811, 811, 811, 811, 814, 814, 817, 817, 817, 817, 817, 817, 817,
+	824, 829, 834, 839, 843, 843, 843, 844, 844, 855, 855, 856, 861, 864, 865, 868,
+	870, 870, 870, 873, 887, 894, 899, 906, 908, 909, 914, 915, 919, 925, 927, 932,
+	941, 952, 964, 972, 972, 973, 973, 982, 983, 1002, 1002, 1003, 1003, 1003, 1015, 1015,
+	1015, 1019, 1047, 1047, 1049, 1049, 1049, 1051, 1051, 1051, 1051, 1051, 1053, 1053, 1053, 1053,
+	1053, 1053, 1053, 1053, 1053, 1053, 1053, 1053, 1053, 1056, 1056, 1056, 1056, 1056, 1056, 1056,
+	1056, 1056, 1056, 1056, 1056, 1056, 1056, 1059, 1059, 1059, 1059, 1062, 1065, 1068, 1088, 1088,
+	1088, 1112, 1123, 1125, 1126, 1126, 1126, 1126, 1128, 1130, 1135, 1135, 1135, 1137, 1137, 1140,
+	1140, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143,
+	1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1143, 1146,
+	1146, 1146, 1146, 1146, 1146, 1146, 1146, 1146, 1146, 1157, 1157, 1157, 1157, 1165, 1165, 1203,
+	1203, 1206, 1206, 1206, 1206, 1208, 1211, 1214, 1223, 1233, 1233, 1239, 1240, 1247, 1249, 1256,
+	1262, 1264, 1278, 1282, 1282, 1282, 1286, 1289, 1291, 1291, 1295, 1295, 1299, 1305, 1309, 1310,
+	1310, 1311, 1313, 1313, 1314, 1318, 1332, 1332, 1336, 1339, 1341, 1346, 1349, 1351, 1351, 1351,
+	1377, 1377, 1379, 1379, 1381, 1385, 1385, 1385, 1401, 1413, 1413, 1413, 1413, 1413, 1413, 1426,
+	1426, 1426, 1426, 1426, 1426, 1427, 1427, 1427, 1427, 1427, 1427, 1455, 1455, 1455, 1455, 1455,
+	1455, 1456, 1461, 1463, 1463, 1464, 1464, 1466, 1466, 1467, 1467, 1468, 1468, 1468, 1468, 1468,
+	1473, 1473, 1473, 1473, 1473, 1473, 1473, 1476, 1476, 1476, 1476, 1476, 1476, 1476, 1476, 1476,
+	1476, 1476, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1479, 1481,
+	1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481, 1481,
+	1481, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485, 1485,
+	1485, 1485, 1485, 1485, 1485, 1487, 1487, 1487, 1487, 1487, 1487, 1487, 1487, 1487, 1487, 1487,
+	1487, 1487, 1487, 1487, 1491, 1491, 1491, 1491, 1491, 1491, 1491, 1504, 1504, 1504, 1504, 1504,
+	1504, 1504, 1504, 1504, 1504, 1504, 1504, 1515, 1515, 1515, 1515, 1515, 1515, 1515, 1515, 1515,
+	1515, 1524, 1524, 1524, 1524,
+};
+
+static const LocaleKey LocaleTerritoryLanguages[LOCALE_TERRITORY_LANGUAGE_COUNT] = {
+	0x07dc001668000000ULL, 0x0742001670000000ULL, 0x07e6001670000000ULL, 0x0824001670000000ULL, /* en_AC ca_AD es_AD fr_AD */
+	0x06e4001678000000ULL, 0x07dc001678000000ULL, 0x09d8001678000000ULL, 0x0aa6001678000000ULL, /* ar_AE en_AE ml_AE ps_AE */
+	0x0702c01678000000ULL, 0x0802001678000000ULL, 0x0802001680000000ULL, 0x0aa6001680000000ULL, /* bal_AE fa_AE fa_AF ps_AF */
+	0x0883a01680000000ULL, 0x0bf40017b1622d00ULL, 0x0b96001680000000ULL, 0x0aa4401680000000ULL, /* haz_AF uz_Arab_AF tk_AF prd_AF */
+	0x070ee01680000000ULL, 0x0942101680000000ULL, 0x0bce001680000000ULL, 0x09560017b1622d00ULL, /* bgn_AF kaa_AF ug_AF kk_Arab_AF */
+	0x07dc001688000000ULL, 0x0aa8001688000000ULL, 0x07dc001698000000ULL, 0x0b620016b0000000ULL, /* en_AG pt_AG en_AI sq_AL */
+	0x07d80016b0000000ULL, 0x09d60016b0000000ULL, 0x08b20016b8000000ULL, 0x096a0016b8000000ULL, /* el_AL mk_AL hy_AM ku_AM */
+	0x06f40016b8000000ULL, 0x0aa80016c8000000ULL, 0x0bda2016c8000000ULL, 0x095a2016c8000000ULL, /* az_AM pt_AO umb_AO kmb_AO */
+	0x099c0016c8000000ULL, 0x0bdc4016d8000000ULL, 0x07e60016e0000000ULL, 0x07dc0016e0000000ULL, /* ln_AO und_AQ es_AR en_AR */
+	0x07720016e0000000ULL, 0x085c0016e0000000ULL, 0x0b5a0016e8000000ULL, 0x07dc0016e8000000ULL, /* cy_AR gn_AR sm_AS en_AS */
+	0x078a0016f0000000ULL, 0x07032016f0000000ULL, 0x07dc0016f0000000ULL, 0x08240016f0000000ULL, /* de_AT bar_AT en_AT fr_AT */
+	0x08e80016f0000000ULL, 0x08a40016f0000000ULL, 0x0b580016f0000000ULL, 0x08aa0016f0000000ULL, /* it_AT hr_AT sl_AT hu_AT */
+	0x07dc0016f8000000ULL, 0x0d1000252b142df0ULL, 0x08e80016f8000000ULL, 0x0c450016f8000000ULL, /* en_AU zh_Hant_AU it_AU wbp_AU */
+	0x089ca016f8000000ULL, 0x0a18001708000000ULL, 0x0a83001708000000ULL, 0x07dc001708000000ULL, /* hnj_AU nl_AW pap_AW en_AW */
+	0x0b6c001710000000ULL, 0x06f4001720000000ULL, 0x06f4001beb8c2e40ULL, 0x0b99901720000000ULL, /* sv_AX az_AZ az_Cyrl_AZ tly_AZ */
+	0x096a001720000000ULL, 0x0ba9401720000000ULL, 0x0b97201720000000ULL, 0x0726001858000000ULL, /* ku_AZ ttt_AZ tkr_AZ bs_BA */
+	0x0726001beb8c30b0ULL, 0x07dc001858000000ULL, 0x08a4001858000000ULL, 0x0b64001858000000ULL, /* bs_Cyrl_BA en_BA hr_BA sr_BA */
+	0x0b64002d2bce30b0ULL, 0x07dc001860000000ULL, 0x071c001870000000ULL, 0x07dc001870000000ULL, /* sr_Latn_BA en_BB bn_BD en_BD */
+	0x0b17401870000000ULL, 0x0b72c01870000000ULL, 0x0b10701870000000ULL, 0x0747001870000000ULL, /* rkt_BD syl_BD rhg_BD ccp_BD */
+	0x09f2001870000000ULL, 0x0865401870000000ULL, 0x09e4f01870000000ULL, 0x09dc901870000000ULL, /* my_BD grt_BD mro_BD mni_BD */
+	0x07dc001878000000ULL, 0x0a18001878000000ULL, 0x0824001878000000ULL, 0x078a001878000000ULL, /* en_BE nl_BE fr_BE de_BE */
+	0x0c19301878000000ULL, 0x0c42001878000000ULL, 0x09df301880000000ULL, 0x07b3501880000000ULL, /* vls_BE wa_BE mos_BF dyu_BF */
+	0x0824001880000000ULL, 0x080c001880000000ULL, 0x080c001742cd3100ULL, 0x070e001888000000ULL, /* fr_BF ff_BF ff_Adlm_BF bg_BG */
+	0x07dc001888000000ULL, 0x0b2a001888000000ULL, 0x0ba4001888000000ULL, 0x078a001888000000ULL, /* en_BG ru_BG tr_BG de_BG */
+	0x06e4001890000000ULL, 0x09d8001890000000ULL, 0x0b1c001898000000ULL, 0x0824001898000000ULL, /* ar_BH ml_BH rn_BI fr_BI */
+	0x0b6e001898000000ULL, 0x07dc001898000000ULL, 0x08240018a0000000ULL, 0x081ee018a0000000ULL, /* sw_BI en_BI fr_BJ fon_BJ */
+	0x0cde0018a0000000ULL, 0x0718f018a0000000ULL, 0x08240018b0000000ULL, 0x07dc0018b8000000ULL, /* yo_BJ blo_BJ fr_BL en_BM */
+	0x09e60018c0000000ULL, 0x0d1000252b143180ULL, 0x09e60017b1623180ULL, 0x07dc0018c0000000ULL, /* ms_BN zh_Hant_BN ms_Arab_BN en_BN */
+	0x07e60018c8000000ULL, 0x0aea0018c8000000ULL, 0x06f20018c8000000ULL, 0x085c0018c8000000ULL, /* es_BO qu_BO ay_BO gn_BO */
+	0x06e4f018c8000000ULL, 0x0a830018d8000000ULL, 0x0a180018d8000000ULL, 0x0aa80018e0000000ULL, /* aro_BO pap_BQ nl_BQ pt_BR */
+	0x07dc0018e0000000ULL, 0x078a0018e0000000ULL, 0x08e80018e0000000ULL, 0x0c0a3018e0000000ULL, /* en_BR de_BR it_BR vec_BR */
+	0x09020018e0000000ULL, 0x07e60018e0000000ULL, 0x094f0018e0000000ULL, 0x095e0018e0000000ULL, /* ja_BR es_BR kgp_BR ko_BR */
+	0x0ce4c018e0000000ULL, 0x086a2018e0000000ULL, 0x0c836018e0000000ULL, 0x07dc0018e8000000ULL, /* yrl_BR gub_BR xav_BR en_BS */
+	0x07b40018f0000000ULL, 0x0a0a0018f0000000ULL, 0x0ba6a018f0000000ULL, 0x07dc0018f0000000ULL, /* dz_BT ne_BT tsj_BT en_BT */
+	0x098b0018f0000000ULL, 0x0a1e001900000000ULL, 0x07dc001908000000ULL, 0x0b9c001908000000ULL, /* lep_BT no_BV en_BW tn_BW */
+	0x06cc001908000000ULL, 0x070a001918000000ULL, 0x0b2a001918000000ULL, 0x07dc001920000000ULL, /* af_BW be_BY ru_BY en_BZ */
+	0x07e6001920000000ULL, 0x07dc001a58000000ULL, 0x0824001a58000000ULL, 0x07e6001a58000000ULL, /* es_BZ en_CA fr_CA es_CA */
+	0x0d10001a58000000ULL, 0x0a82001a58000000ULL, 0x06e4001a58000000ULL, 0x0892001a58000000ULL, /* zh_CA pa_CA ar_CA hi_CA */
+	0x0812c01a58000000ULL, 0x0cea501a58000000ULL, 0x08e8001a58000000ULL, 0x078a001a58000000ULL, /* fil_CA yue_CA it_CA de_CA */
+	0x0be4001a58000000ULL, 0x0aa8001a58000000ULL, 0x0b2a001a58000000ULL, 0x0b82001a58000000ULL, /* ur_CA pt_CA ru_CA ta_CA */
+	0x0c12001a58000000ULL, 0x0802001a58000000ULL, 0x086a001a58000000ULL, 0x095e001a58000000ULL, /* vi_CA fa_CA gu_CA ko_CA */
+	0x0a98001a58000000ULL, 0x07d8001a58000000ULL, 0x0bd6001a58000000ULL, 0x071c001a58000000ULL, /* pl_CA el_CA uk_CA bn_CA */
+	0x0b1e001a58000000ULL, 0x0a18001a58000000ULL, 0x0902001a58000000ULL, 0x0b64001a58000000ULL, /* ro_CA nl_CA ja_CA sr_CA */
+	0x0ba4001a58000000ULL, 0x08a4001a58000000ULL, 0x08aa001a58000000ULL, 0x0b5e001a58000000ULL, /* tr_CA hr_CA hu_CA so_CA */
+	0x08ea001a58000000ULL, 0x08ea002d2bce34b0ULL, 0x0a89401a58000000ULL, 0x0a54001a58000000ULL, /* iu_CA iu_Latn_CA pdt_CA oj_CA */
+	0x0a55301a58000000ULL, 0x0764b01a58000000ULL, 0x0751001a58000000ULL, 0x09de501a58000000ULL, /* ojs_CA crk_CA chp_CA moe_CA */
+	0x09d2301a58000000ULL, 0x06e8a01a58000000ULL, 0x0718101a58000000ULL, 0x0764001a58000000ULL, /* mic_CA atj_CA bla_CA cr_CA */
+	0x0764c01a58000000ULL, 0x0767701a58000000ULL, 0x0c43201a58000000ULL, 0x0a55701a58000000ULL, /* crl_CA csw_CA war_CA ojw_CA */
+	0x078ae01a58000000ULL, 0x078f201a58000000ULL, 0x0764701a58000000ULL, 0x09de801a58000000ULL, /* den_CA dgr_CA crg_CA moh_CA */
+	0x0782b01a58000000ULL, 0x08ab201a58000000ULL, 0x0a26b01a58000000ULL, 0x0758301a58000000ULL, /* dak_CA hur_CA nsk_CA clc_CA */
+	0x096eb01a58000000ULL, 0x0aa2d01a58000000ULL, 0x0a56101a58000000ULL, 0x0992c01a58000000ULL, /* kwk_CA pqm_CA oka_CA lil_CA */
+	0x086e901a58000000ULL, 0x09e60017b16234d0ULL, 0x07dc001a68000000ULL, 0x0824001a70000000ULL, /* gwi_CA ms_Arab_CC en_CC fr_CD */
+	0x0b6e001a70000000ULL, 0x09aa101a70000000ULL, 0x099c001a70000000ULL, 0x09aa001a70000000ULL, /* sw_CD lua_CD ln_CD lu_CD */
+	0x094e001a70000000ULL, 0x099ec01a70000000ULL, 0x0b2e001a70000000ULL, 0x0b4e001a80000000ULL, /* kg_CD lol_CD rw_CD sg_CF */
+	0x0824001a80000000ULL, 0x099c001a80000000ULL, 0x0824001a88000000ULL, 0x099c001a88000000ULL, /* fr_CF ln_CF fr_CG ln_CG */
+	0x078a001a90000000ULL, 0x0867701a90000000ULL, 0x07dc001a90000000ULL, 0x0824001a90000000ULL, /* de_CH gsw_CH en_CH fr_CH */
+	0x08e8001a90000000ULL, 0x099af01a90000000ULL, 0x0aa8001a90000000ULL, 0x0b1a001a90000000ULL, /* it_CH lmo_CH pt_CH rm_CH */
+	0x0b1af01a90000000ULL, 0x0c42501a90000000ULL, 0x0824001a98000000ULL, 0x0706901a98000000ULL, /* rmo_CH wae_CH fr_CI bci_CI */
+	0x0b4a601a98000000ULL, 0x079ca01a98000000ULL, 0x094cf01a98000000ULL, 0x0723601a98000000ULL, /* sef_CI dnj_CI kfo_CI bqv_CI */
+	0x07dc001aa8000000ULL, 0x07e6001ab0000000ULL, 0x07dc001ab0000000ULL, 0x06e4e01ab0000000ULL, /* en_CK es_CL en_CL arn_CL */
+	0x0824001ab8000000ULL, 0x07dc001ab8000000ULL, 0x072ad01ab8000000ULL, 0x080c001ab8000000ULL, /* fr_CM en_CM bum_CM ff_CM */
+	0x07eef01ab8000000ULL, 0x0cc4201ab8000000ULL, 0x0704a01ab8000000ULL, 0x0a1c801ab8000000ULL, /* ewo_CM ybb_CM bbj_CM nnh_CM */
+	0x0716d01ab8000000ULL, 0x0703301ab8000000ULL, 0x0703801ab8000000ULL, 0x0733601ab8000000ULL, /* bkm_CM bas_CM bax_CM byv_CM */
+	0x09ea101ab8000000ULL, 0x09c2601ab8000000ULL, 0x070c401ab8000000ULL, 0x0727301ab8000000ULL, /* mua_CM maf_CM bfd_CM bss_CM */
+	0x0956a01ab8000000ULL, 0x07aa101ab8000000ULL, 0x09cef01ab8000000ULL, 0x06e4001ab8000000ULL, /* kkj_CM dua_CM mgo_CM ar_CM */
+	0x090ef01ab8000000ULL, 0x0966601ab8000000ULL, 0x094ae01ab8000000ULL, 0x06cf101ab8000000ULL, /* jgo_CM ksf_CM ken_CM agq_CM */
+	0x08820017b1623570ULL, 0x0a1a701ab8000000ULL, 0x0cc3601ab8000000ULL, 0x080c001742cd3570ULL, /* ha_Arab_CM nmg_CM yav_CM ff_Adlm_CM */
+	0x0d10001ac0000000ULL, 0x0c6b501ac0000000ULL, 0x0cea501ac0000000ULL, 0x0cea50252b133580ULL, /* zh_CN wuu_CN yue_CN yue_Hans_CN */
+	0x08a6e01ac0000000ULL, 0x0882b01ac0000000ULL, 0x0a02e01ac0000000ULL, 0x0842e01ac0000000ULL, /* hsn_CN hak_CN nan_CN gan_CN */
+	0x08d2001ac0000000ULL, 0x0bce001ac0000000ULL, 0x0d02001ac0000000ULL, 0x09dc002f9b073580ULL, /* ii_CN ug_CN za_CN mn_Mong_CN */
+	0x071e001ac0000000ULL, 0x095e001ac0000000ULL, 0x09560017b1623580ULL, 0x0993301ac0000000ULL, /* bo_CN ko_CN kk_Arab_CN lis_CN */
+	0x09720017b1623580ULL, 0x0a31101ac0000000ULL, 0x0950201ac0000000ULL, 0x0b88401ac0000000ULL, /* ky_Arab_CN nxq_CN khb_CN tdd_CN */
+	0x0987001ac0000000ULL, 0x07dc001ac0000000ULL, 0x089ca01ac0000000ULL, 0x0b2a001ac0000000ULL, /* lcp_CN en_CN hnj_CN ru_CN */
+	0x0c12001ac0000000ULL, 0x0bf4001beb8c3580ULL, 0x09b4801ac0000000ULL, 0x07e6001ac8000000ULL, /* vi_CN uz_Cyrl_CN lzh_CN es_CO */
+	0x086a301ac8000000ULL, 0x0ce4c01ac8000000ULL, 0x0bdc401ad0000000ULL, 0x07dc001ad8000000ULL, /* guc_CO yrl_CO und_CP en_CQ */
+	0x07e6001ae0000000ULL, 0x07e6001af8000000ULL, 0x094a101b00000000ULL, 0x0aa8001b00000000ULL, /* es_CR es_CU kea_CV pt_CV */
+	0x0a83001b08000000ULL, 0x0a18001b08000000ULL, 0x07e6001b08000000ULL, 0x07dc001b10000000ULL, /* pap_CW nl_CW es_CW en_CX */
+	0x07d8001b18000000ULL, 0x07dc001b18000000ULL, 0x0ba4001b18000000ULL, 0x0824001b18000000ULL, /* el_CY en_CY tr_CY fr_CY */
+	0x08b2001b18000000ULL, 0x06e4001b18000000ULL, 0x07c7901b18000000ULL, 0x0766001b20000000ULL, /* hy_CY ar_CY ecy_CY cs_CZ */
+	0x07dc001b20000000ULL, 0x0b56001b20000000ULL, 0x078a001b20000000ULL, 0x0a98001b20000000ULL, /* en_CZ sk_CZ de_CZ pl_CZ */
+	0x078a001c78000000ULL, 0x07dc001c78000000ULL, 0x0824001c78000000ULL, 0x0703201c78000000ULL, /* de_DE en_DE fr_DE bar_DE */
+	0x0a09301c78000000ULL, 0x0a18001c78000000ULL, 0x08e8001c78000000ULL, 0x07e6001c78000000ULL, /* nds_DE nl_DE it_DE es_DE */
+	0x0b2a001c78000000ULL, 0x0c1a601c78000000ULL, 0x0ba4001c78000000ULL, 0x0867701c78000000ULL, /* ru_DE vmf_DE tr_DE gsw_DE */
+	0x0782001c78000000ULL, 0x0b6e701c78000000ULL, 0x08a4001c78000000ULL, 0x096a001c78000000ULL, /* da_DE swg_DE hr_DE ku_DE */
+	0x07d8001c78000000ULL, 0x0966801c78000000ULL, 0x0a98001c78000000ULL, 0x08a6201c78000000ULL, /* el_DE ksh_DE pl_DE hsb_DE */
+	0x0825201c78000000ULL, 0x07a6201c78000000ULL, 0x0825301c78000000ULL, 0x0b69101c78000000ULL, /* frr_DE dsb_DE frs_DE stq_DE */
+	0x0a8cc01c78000000ULL, 0x07dc001c88000000ULL, 0x0824001ca0000000ULL, 0x06c2001ca0000000ULL, /* pfl_DE en_DG fr_DJ aa_DJ */
+	0x0b5e001ca0000000ULL, 0x06e4001ca0000000ULL, 0x0782001ca8000000ULL, 0x07dc001ca8000000ULL, /* so_DJ ar_DJ da_DK en_DK */
+	0x078a001ca8000000ULL, 0x0b6c001ca8000000ULL, 0x081e001ca8000000ULL, 0x0958001ca8000000ULL, /* de_DK sv_DK fo_DK kl_DK */
+	0x092b401ca8000000ULL, 0x07dc001cb8000000ULL, 0x07e6001cc8000000ULL, 0x07dc001cc8000000ULL, /* jut_DK en_DM es_DO en_DO */
+	0x06e5101d20000000ULL, 0x06e4001d20000000ULL, 0x0824001d20000000ULL, 0x0942201d20000000ULL, /* arq_DZ ar_DZ fr_DZ kab_DZ */
+	0x07dc001d20000000ULL, 0x07e6001e58000000ULL, 0x07e6001e68000000ULL, 0x0aea001e68000000ULL, /* en_DZ es_EA es_EC qu_EC */
+	0x0aea701e68000000ULL, 0x07e8001e78000000ULL, 0x0b2a001e78000000ULL, 0x07dc001e78000000ULL, /* qug_EC et_EE ru_EE en_EE */
+	0x0812001e78000000ULL, 0x0c24f01e78000000ULL, 0x08ca001e78000000ULL, 0x06e4001e88000000ULL, /* fi_EE vro_EE ie_EE ar_EG */
+	0x06e5a01e88000000ULL, 0x07dc001e88000000ULL, 0x075f001e88000000ULL, 0x07d8001e88000000ULL, /* arz_EG en_EG cop_EG el_EG */
+	0x06e4001e90000000ULL, 0x0b92001ee0000000ULL, 0x07dc001ee0000000ULL, 0x0b92701ee0000000ULL, /* ar_EH ti_ER en_ER tig_ER */
+	0x06e4001ee0000000ULL, 0x06c2001ee0000000ULL, 0x0b67901ee0000000ULL, 0x0732e01ee0000000ULL, /* ar_ER aa_ER ssy_ER byn_ER */
+	0x07e6001ee8000000ULL, 0x07dc001ee8000000ULL, 0x0742001ee8000000ULL, 0x0858001ee8000000ULL, /* es_ES en_ES ca_ES gl_ES */
+	0x07ea001ee8000000ULL, 0x06e7401ee8000000ULL, 0x07f1401ee8000000ULL, 0x06dc001ee8000000ULL, /* eu_ES ast_ES ext_ES an_ES */
+	0x0a46001ee8000000ULL, 0x07dc001ef0000000ULL, 0x06da001ef0000000ULL, 0x0a5a001ef0000000ULL, /* oc_ES en_ET am_ET om_ET */
+	0x0b5e001ef0000000ULL, 0x0b92001ef0000000ULL, 0x0b52401ef0000000ULL, 0x0c42c01ef0000000ULL, /* so_ET ti_ET sid_ET wal_ET */
+	0x06c2001ef0000000ULL, 0x084ba01ef0000000ULL, 0x0812002098000000ULL, 0x07dc002098000000ULL, /* aa_ET gez_ET fi_FI en_FI */
+	0x0b6c002098000000ULL, 0x078a002098000000ULL, 0x0b2a002098000000ULL, 0x07e8002098000000ULL, /* sv_FI de_FI ru_FI et_FI */
+	0x0b1a602098000000ULL, 0x0b4a002098000000ULL, 0x0b5ae02098000000ULL, 0x0b5b302098000000ULL, /* rmf_FI se_FI smn_FI sms_FI */
+	0x07dc0020a0000000ULL, 0x08920020a0000000ULL, 0x08926020a0000000ULL, 0x08140020a0000000ULL, /* en_FJ hi_FJ hif_FJ fj_FJ */
+	0x0b28d020a0000000ULL, 0x07dc0020a8000000ULL, 0x07dc0020b8000000ULL, 0x0750b020b8000000ULL, /* rtm_FJ en_FK en_FM chk_FM */
+	0x0a9ee020b8000000ULL, 0x095f3020b8000000ULL, 0x0cc30020b8000000ULL, 0x0bd89020b8000000ULL, /* pon_FM kos_FM yap_FM uli_FM */
+	0x081e0020c8000000ULL, 0x08240020e0000000ULL, 0x07dc0020e0000000ULL, 0x07e60020e0000000ULL, /* fo_FO fr_FR en_FR es_FR */
+	0x078a0020e0000000ULL, 0x0a460020e0000000ULL, 0x08e80020e0000000ULL, 0x0aa80020e0000000ULL, /* de_FR oc_FR it_FR pt_FR */
+	0x0a864020e0000000ULL, 0x08677020e0000000ULL, 0x07240020e0000000ULL, 0x075e0020e0000000ULL, /* pcd_FR gsw_FR br_FR co_FR */
+	0x089ca020e0000000ULL, 0x07420020e0000000ULL, 0x07ea0020e0000000ULL, 0x0a180020e0000000ULL, /* hnj_FR ca_FR eu_FR nl_FR */
+	0x08250020e0000000ULL, 0x08c20020e0000000ULL, 0x0824002258000000ULL, 0x0aab502258000000ULL, /* frp_FR ia_FR fr_GA puu_GA */
+	0x07dc002260000000ULL, 0x0824002260000000ULL, 0x078a002260000000ULL, 0x07e6002260000000ULL, /* en_GB fr_GB de_GB es_GB */
+	0x0a98002260000000ULL, 0x0a82002260000000ULL, 0x0be4002260000000ULL, 0x0b82002260000000ULL, /* pl_GB pa_GB ur_GB ta_GB */
+	0x086a002260000000ULL, 0x0b46f02260000000ULL, 0x0772002260000000ULL, 0x0b1e002260000000ULL, /* gu_GB sco_GB cy_GB ro_GB */
+	0x071c002260000000ULL, 0x06e4002260000000ULL, 0x0d1000252b1444c0ULL, 0x08e8002260000000ULL, /* bn_GB ar_GB zh_Hant_GB it_GB */
+	0x09a8002260000000ULL, 0x0aa8002260000000ULL, 0x0b5e002260000000ULL, 0x0ba4002260000000ULL, /* lt_GB pt_GB so_GB tr_GB */
+	0x0842002260000000ULL, 0x0848002260000000ULL, 0x096e002260000000ULL, 0x07dc003b617744c0ULL, /* ga_GB gd_GB kw_GB en_Shaw_GB */
+	0x07dc002270000000ULL, 0x0942002278000000ULL, 0x0c9a602278000000ULL, 0x0b2a002278000000ULL, /* en_GD ka_GE xmf_GE ru_GE */
+	0x08b2002278000000ULL, 0x06c4002278000000ULL, 0x0a66002278000000ULL, 0x096a002278000000ULL, /* hy_GE ab_GE os_GE ku_GE */
+	0x09b5a0234b3244f0ULL, 0x0824002280000000ULL, 0x0847202280000000ULL, 0x0d1000252b144500ULL, /* lzz_Geor_GE fr_GF gcr_GF zh_Hant_GF */
+	0x089ca02280000000ULL, 0x07dc002288000000ULL, 0x06d6002290000000ULL, 0x07dc002290000000ULL, /* hnj_GF en_GG ak_GH en_GH */
+	0x07ca002290000000ULL, 0x06c5202290000000ULL, 0x086b202290000000ULL, 0x06c8102290000000ULL, /* ee_GH abr_GH gur_GH ada_GH */
+	0x0842102290000000ULL, 0x0a34902290000000ULL, 0x0882002290000000ULL, 0x0b42602290000000ULL, /* gaa_GH nzi_GH ha_GH saf_GH */
+	0x080c002290000000ULL, 0x080c001742cd4520ULL, 0x07dc002298000000ULL, 0x07e6002298000000ULL, /* ff_GH ff_Adlm_GH en_GI es_GI */
+	0x09580022b0000000ULL, 0x07820022b0000000ULL, 0x07dc0022b8000000ULL, 0x09c2e022b8000000ULL, /* kl_GL da_GL en_GM man_GM */
+	0x09c2e0317b2f4570ULL, 0x080c0022b8000000ULL, 0x080c001742cd4570ULL, 0x08240022c0000000ULL, /* man_Nkoo_GM ff_GM ff_Adlm_GM fr_GN */
+	0x080c0022c0000000ULL, 0x09c2e022c0000000ULL, 0x09c2e0317b2f4580ULL, 0x0b6b3022c0000000ULL, /* ff_GN man_GN man_Nkoo_GN sus_GN */
+	0x0a22f022c0000000ULL, 0x09605022c0000000ULL, 0x080c001742cd4580ULL, 0x08240022d0000000ULL, /* nqo_GN kpe_GN ff_Adlm_GN fr_GP */
+	0x07e60022d8000000ULL, 0x0802e022d8000000ULL, 0x08240022d8000000ULL, 0x072c2022d8000000ULL, /* es_GQ fan_GQ fr_GQ bvb_GQ */
+	0x0aa80022d8000000ULL, 0x07d80022e0000000ULL, 0x07dc0022e0000000ULL, 0x08240022e0000000ULL, /* pt_GQ el_GR en_GR fr_GR */
+	0x078a0022e0000000ULL, 0x0a9d4022e0000000ULL, 0x09d60022e0000000ULL, 0x0ba40022e0000000ULL, /* de_GR pnt_GR mk_GR tr_GR */
+	0x070e0022e0000000ULL, 0x0b620022e0000000ULL, 0x0ba64022e0000000ULL, 0x085b9022e0000000ULL, /* bg_GR sq_GR tsd_GR gmy_GR */
+	0x08643022e0000000ULL, 0x07dc0022e8000000ULL, 0x07e60022f0000000ULL, 0x0aea3022f0000000ULL, /* grc_GR en_GS es_GT quc_GT */
+	0x07dc0022f8000000ULL, 0x07500022f8000000ULL, 0x0aa8002308000000ULL, 0x0824002308000000ULL, /* en_GU ch_GU pt_GW fr_GW */
+	0x095c602308000000ULL, 0x080c002308000000ULL, 0x080c001742cd4610ULL, 0x07dc002318000000ULL, /* knf_GW ff_GW ff_Adlm_GW en_GY */
+	0x0d1000252b144950ULL, 0x0cea5024a8000000ULL, 0x07dc0024a8000000ULL, 0x0d100024a8000000ULL, /* zh_Hant_HK yue_HK en_HK zh_HK */
+	0x0bdc4024b8000000ULL, 0x07e60024c0000000ULL, 0x07dc0024c0000000ULL, 0x08a40024e0000000ULL, /* und_HM es_HN en_HN hr_HR */
+	0x07dc0024e0000000ULL, 0x08e80024e0000000ULL, 0x0c0a3024e0000000ULL, 0x08a80024f0000000ULL, /* en_HR it_HR vec_HR ht_HT */
+	0x08240024f0000000ULL, 0x08aa0024f8000000ULL, 0x07dc0024f8000000ULL, 0x078a0024f8000000ULL, /* fr_HT hu_HU en_HU de_HU */
+	0x08240024f8000000ULL, 0x0b1e0024f8000000ULL, 0x08a40024f8000000ULL, 0x0b560024f8000000ULL, /* fr_HU ro_HU hr_HU sk_HU */
+	0x0b580024f8000000ULL, 0x07e6002668000000ULL, 0x08c8002670000000ULL, 0x092c002670000000ULL, /* sl_HU es_IC id_ID jv_ID */
+	0x0b6a002670000000ULL, 0x09c2402670000000ULL, 0x09e6002670000000ULL, 0x09d2e02670000000ULL, /* su_ID mad_ID ms_ID min_ID */
+	0x070b702670000000ULL, 0x0702e02670000000ULL, 0x072a702670000000ULL, 0x0714e02670000000ULL, /* bew_ID ban_ID bug_ID bjn_ID */
+	0x06c6502670000000ULL, 0x09e60017b1624ce0ULL, 0x0b43302670000000ULL, 0x0704302670000000ULL, /* ace_ID ms_Arab_ID sas_ID bbc_ID */
+	0x0d1000252b144ce0ULL, 0x09c2b02670000000ULL, 0x0995002670000000ULL, 0x0b0aa02670000000ULL, /* zh_Hant_ID mak_ID ljp_ID rej_ID */
+	0x085f202670000000ULL, 0x0a12a02670000000ULL, 0x094e502670000000ULL, 0x06dfa02670000000ULL, /* gor_ID nij_ID kge_ID aoz_ID */
+	0x096d202670000000ULL, 0x0985702670000000ULL, 0x0843902670000000ULL, 0x0b1e202670000000ULL, /* kvr_ID lbw_ID gay_ID rob_ID */
+	0x09c9202670000000ULL, 0x0b70e02670000000ULL, 0x0b59902670000000ULL, 0x09ef602670000000ULL, /* mdr_ID sxn_ID sly_ID mwv_ID */
+	0x0702e0192ac94ce0ULL, 0x0943702670000000ULL, 0x07dc002678000000ULL, 0x0842002678000000ULL, /* ban_Bali_ID kaw_ID en_IE ga_IE */
+	0x0824002678000000ULL, 0x088a0026b0000000ULL, 0x07dc0026b0000000ULL, 0x06e40026b0000000ULL, /* fr_IE he_IL en_IL ar_IL */
+	0x06e03026b0000000ULL, 0x0b2a0026b0000000ULL, 0x0b1e0026b0000000ULL, 0x0cd20026b0000000ULL, /* apc_IL ru_IL ro_IL yi_IL */
+	0x0a980026b0000000ULL, 0x09824026b0000000ULL, 0x08aa0026b0000000ULL, 0x06da0026b0000000ULL, /* pl_IL lad_IL hu_IL am_IL */
+	0x0b920026b0000000ULL, 0x09d80026b0000000ULL, 0x07dc0026b8000000ULL, 0x086c0026b8000000ULL, /* ti_IL ml_IL en_IM gv_IM */
+	0x08920026c0000000ULL, 0x07dc0026c0000000ULL, 0x071c0026c0000000ULL, 0x0b8a0026c0000000ULL, /* hi_IN en_IN bn_IN te_IN */
+	0x09e40026c0000000ULL, 0x0b820026c0000000ULL, 0x0be40026c0000000ULL, 0x086a0026c0000000ULL, /* mr_IN ta_IN ur_IN gu_IN */
+	0x095c0026c0000000ULL, 0x09d80026c0000000ULL, 0x0a640026c0000000ULL, 0x0a820026c0000000ULL, /* kn_IN ml_IN or_IN pa_IN */
+	0x0710f026c0000000ULL, 0x06ee1026c0000000ULL, 0x06e60026c0000000ULL, 0x070e3026c0000000ULL, /* bho_IN awa_IN as_IN bgc_IN */
+	0x09c27026c0000000ULL, 0x09c29026c0000000ULL, 0x09ef2026c0000000ULL, 0x089c5026c0000000ULL, /* mag_IN mai_IN mwr_IN hne_IN */
+	0x07863026c0000000ULL, 0x0714a026c0000000ULL, 0x0a0a0026c0000000ULL, 0x0b434026c0000000ULL, /* dcc_IN bjj_IN ne_IN sat_IN */
+	0x0c68d026c0000000ULL, 0x0b174026c0000000ULL, 0x09660026c0000000ULL, 0x095ce026c0000000ULL, /* wtm_IN rkt_IN ks_IN knn_IN */
+	0x095eb026c0000000ULL, 0x0b6f6026c0000000ULL, 0x0844d026c0000000ULL, 0x099ae026c0000000ULL, /* kok_IN swv_IN gbm_IN lmn_IN */
+	0x0b480026c0000000ULL, 0x085ee026c0000000ULL, 0x094d9026c0000000ULL, 0x079e9026c0000000ULL, /* sd_IN gon_IN kfy_IN doi_IN */
+	0x09655026c0000000ULL, 0x0b46b026c0000000ULL, 0x0c451026c0000000ULL, 0x0c9d2026c0000000ULL, /* kru_IN sck_IN wbq_IN xnr_IN */
+	0x0950e026c0000000ULL, 0x0b879026c0000000ULL, 0x0c452026c0000000ULL, 0x07258026c0000000ULL, /* khn_IN tcy_IN wbr_IN brx_IN */
+	0x0b48001d4c014d80ULL, 0x0a1e5026c0000000ULL, 0x07102026c0000000ULL, 0x09dc9026c0000000ULL, /* sd_Deva_IN noe_IN bhb_IN mni_IN */
+	0x0892002d2bce4d80ULL, 0x0b02a026c0000000ULL, 0x089e3026c0000000ULL, 0x09e92026c0000000ULL, /* hi_Latn_IN raj_IN hoc_IN mtr_IN */
+	0x0bdd2026c0000000ULL, 0x07109026c0000000ULL, 0x089ea026c0000000ULL, 0x09501026c0000000ULL, /* unr_IN bhi_IN hoj_IN kha_IN */
+	0x094d2026c0000000ULL, 0x08654026c0000000ULL, 0x0bdd8026c0000000ULL, 0x070d9026c0000000ULL, /* kfr_IN grt_IN unx_IN bfy_IN */
+	0x0b658026c0000000ULL, 0x0b43a026c0000000ULL, 0x07470026c0000000ULL, 0x070d1026c0000000ULL, /* srx_IN saz_IN ccp_IN bfq_IN */
+	0x0a14f026c0000000ULL, 0x0b121026c0000000ULL, 0x071e0026c0000000ULL, 0x07219026c0000000ULL, /* njo_IN ria_IN bo_IN bpy_IN */
+	0x070d4026c0000000ULL, 0x07241026c0000000ULL, 0x098b0026c0000000ULL, 0x09716026c0000000ULL, /* bft_IN bra_IN lep_IN kxv_IN */
+	0x07296026c0000000ULL, 0x09926026c0000000ULL, 0x09828026c0000000ULL, 0x0b420026c0000000ULL, /* btv_IN lif_IN lah_IN sa_IN */
+	0x09514026c0000000ULL, 0x07ac0026c0000000ULL, 0x07b40026c0000000ULL, 0x07dc0026c8000000ULL, /* kht_IN dv_IN dz_IN en_IO */
+	0x06e40026d8000000ULL, 0x07dc0026d8000000ULL, 0x07562026d8000000ULL, 0x06f40017b1624db0ULL, /* ar_IQ en_IQ ckb_IQ az_Arab_IQ */
+	0x08020026d8000000ULL, 0x09a43026d8000000ULL, 0x0b732026d8000000ULL, 0x08020026e0000000ULL, /* fa_IQ lrc_IQ syr_IQ fa_IR */
+	0x06f40017b1624dc0ULL, 0x09f4e026e0000000ULL, 0x0858b026e0000000ULL, 0x07562026e0000000ULL, /* az_Arab_IR mzn_IR glk_IR ckb_IR */
+	0x0b488026e0000000ULL, 0x0b960026e0000000ULL, 0x09a43026e0000000ULL, 0x06e40026e0000000ULL, /* sdh_IR tk_IR lrc_IR ar_IR */
+	0x0702c026e0000000ULL, 0x0b1b4026e0000000ULL, 0x07229026e0000000ULL, 0x09aba026e0000000ULL, /* bal_IR rmt_IR bqi_IR luz_IR */
+	0x09969026e0000000ULL, 0x09421026e0000000ULL, 0x070ee026e0000000ULL, 0x0aa44026e0000000ULL, /* lki_IR kaa_IR bgn_IR prd_IR */
+	0x08b20026e0000000ULL, 0x0aa60026e0000000ULL, 0x09420026e0000000ULL, 0x0845a026e0000000ULL, /* hy_IR ps_IR ka_IR gbz_IR */
+	0x09560017b1624dc0ULL, 0x08e60026e8000000ULL, 0x07820026e8000000ULL, 0x08e80026f0000000ULL, /* kk_Arab_IR is_IS da_IS it_IT */
+	0x07dc0026f0000000ULL, 0x08240026f0000000ULL, 0x099af026f0000000ULL, 0x0b460026f0000000ULL, /* en_IT fr_IT lmo_IT sc_IT */
+	0x078a0026f0000000ULL, 0x0c0a3026f0000000ULL, 0x0a030026f0000000ULL, 0x0992a026f0000000ULL, /* de_IT vec_IT nap_IT lij_IT */
+	0x0b46e026f0000000ULL, 0x0b483026f0000000ULL, 0x0b580026f0000000ULL, 0x082b2026f0000000ULL, /* scn_IT sdc_IT sl_IT fur_IT */
+	0x07cec026f0000000ULL, 0x09984026f0000000ULL, 0x07420026f0000000ULL, 0x07d80026f0000000ULL, /* egl_IT lld_IT ca_IT el_IT */
+	0x0a9b3026f0000000ULL, 0x08a40026f0000000ULL, 0x09d0e026f0000000ULL, 0x0b0ee026f0000000ULL, /* pms_IT hr_IT mhn_IT rgn_IT */
+	0x07dc002878000000ULL, 0x07dc0028b8000000ULL, 0x0902d028b8000000ULL, 0x06e40028c8000000ULL, /* en_JE en_JM jam_JM ar_JO */
+	0x06e03028c8000000ULL, 0x07dc0028c8000000ULL, 0x09020028d0000000ULL, 0x0b335028d0000000ULL, /* apc_JO en_JO ja_JP ryu_JP */
+	0x095e0028d0000000ULL, 0x0b6e002a78000000ULL, 0x07dc002a78000000ULL, 0x0952002a78000000ULL, /* ko_JP sw_KE en_KE ki_KE */
+	0x09ab902a78000000ULL, 0x09aaf02a78000000ULL, 0x0942d02a78000000ULL, 0x0958e02a78000000ULL, /* luy_KE luo_KE kam_KE kln_KE */
+	0x086ba02a78000000ULL, 0x09cb202a78000000ULL, 0x09c3302a78000000ULL, 0x07c5502a78000000ULL, /* guz_KE mer_KE mas_KE ebu_KE */
+	0x0b5e002a78000000ULL, 0x0783602a78000000ULL, 0x0b8af02a78000000ULL, 0x0a96f02a78000000ULL, /* so_KE dav_KE teo_KE pko_KE */
+	0x0a5a002a78000000ULL, 0x0b43102a78000000ULL, 0x06e4002a78000000ULL, 0x0a82002a78000000ULL, /* om_KE saq_KE ar_KE pa_KE */
+	0x086a002a78000000ULL, 0x0972002a88000000ULL, 0x0b2a002a88000000ULL, 0x0942102a88000000ULL, /* gu_KE ky_KG ru_KG kaa_KG */
+	0x095a002a90000000ULL, 0x0754102a90000000ULL, 0x0949402a90000000ULL, 0x07dc002a98000000ULL, /* km_KH cja_KH kdt_KH en_KI */
+	0x0852c02a98000000ULL, 0x06e4002ab8000000ULL, 0x0d08a02ab8000000ULL, 0x0c5c902ab8000000ULL, /* gil_KI ar_KM zdj_KM wni_KM */
+	0x0824002ab8000000ULL, 0x07dc002ac0000000ULL, 0x095e002ad0000000ULL, 0x095e002ae0000000ULL, /* fr_KM en_KN ko_KP ko_KR */
+	0x06e4002b08000000ULL, 0x07dc002b18000000ULL, 0x0b2a002b20000000ULL, 0x0956002b20000000ULL, /* ar_KW en_KY ru_KZ kk_KZ */
+	0x07dc002b20000000ULL, 0x078a002b20000000ULL, 0x0bce001beb8c5640ULL, 0x0942102b20000000ULL, /* en_KZ de_KZ ug_Cyrl_KZ kaa_KZ */
+	0x099e002c58000000ULL, 0x0954702c58000000ULL, 0x089ca02c58000000ULL, 0x0949402c58000000ULL, /* lo_LA kjg_LA hnj_LA kdt_LA */
+	0x06e0302c60000000ULL, 0x06e4002c60000000ULL, 0x07dc002c60000000ULL, 0x0824002c60000000ULL, /* apc_LB ar_LB en_LB fr_LB */
+	0x08b2002c60000000ULL, 0x096a0017b16258c0ULL, 0x07dc002c68000000ULL, 0x078a002c98000000ULL, /* hy_LB ku_Arab_LB en_LC de_LI */
+	0x0867702c98000000ULL, 0x0c42502c98000000ULL, 0x0b52002ca8000000ULL, 0x0b82002ca8000000ULL, /* gsw_LI wae_LI si_LK ta_LK */
+	0x07dc002ca8000000ULL, 0x07dc002ce0000000ULL, 0x0960502ce0000000ULL, 0x0c02902ce0000000ULL, /* en_LK en_LR kpe_LR vai_LR */
+	0x09cae02ce0000000ULL, 0x080c002ce0000000ULL, 0x080c001742cd59c0ULL, 0x0c02902d2bce59c0ULL, /* men_LR ff_LR ff_Adlm_LR vai_Latn_LR */
+	0x0b68002ce8000000ULL, 0x07dc002ce8000000ULL, 0x0d2a002ce8000000ULL, 0x0b66002ce8000000ULL, /* st_LS en_LS zu_LS ss_LS */
+	0x0c90002ce8000000ULL, 0x09a8002cf0000000ULL, 0x0b2a002cf0000000ULL, 0x07dc002cf0000000ULL, /* xh_LS lt_LT ru_LT en_LT */
+	0x078a002cf0000000ULL, 0x0b4f302cf0000000ULL, 0x0824002cf8000000ULL, 0x0984002cf8000000ULL, /* de_LT sgs_LT fr_LU lb_LU */
+	0x078a002cf8000000ULL, 0x07dc002cf8000000ULL, 0x0aa8002cf8000000ULL, 0x09ac002d00000000ULL, /* de_LU en_LU pt_LU lv_LV */
+	0x07dc002d00000000ULL, 0x0b2a002d00000000ULL, 0x09a8702d00000000ULL, 0x06e4002d18000000ULL, /* en_LV ru_LV ltg_LV ar_LY */
+	0x06e5902e58000000ULL, 0x06e4002e58000000ULL, 0x0824002e58000000ULL, 0x0d0e802e58000000ULL, /* ary_MA ar_MA fr_MA zgh_MA */
+	0x07dc002e58000000ULL, 0x0bb4d02e58000000ULL, 0x0b50902e58000000ULL, 0x0b50902d2bce5cb0ULL, /* en_MA tzm_MA shi_MA shi_Latn_MA */
+	0x0b12602e58000000ULL, 0x0b12603d53075cb0ULL, 0x07e6002e58000000ULL, 0x0824002e68000000ULL, /* rif_MA rif_Tfng_MA es_MA fr_MC */
+	0x0b1e002e70000000ULL, 0x0bd6002e70000000ULL, 0x070e002e70000000ULL, 0x0842702e70000000ULL, /* ro_MD uk_MD bg_MD gag_MD */
+	0x0b2a002e70000000ULL, 0x0b64002d2bce5cf0ULL, 0x0b62002e78000000ULL, 0x0b64002e78000000ULL, /* ru_MD sr_Latn_ME sq_ME sr_ME */
+	0x0824002e80000000ULL, 0x09ce002e88000000ULL, 0x0824002e88000000ULL, 0x07dc002e88000000ULL, /* fr_MF mg_MG fr_MG en_MG */
+	0x07dc002e90000000ULL, 0x09d0002e90000000ULL, 0x09d6002ea8000000ULL, 0x0b62002ea8000000ULL, /* en_MH mh_MH mk_MK sq_MK */
+	0x0ba4002ea8000000ULL, 0x071a002eb0000000ULL, 0x0824002eb0000000ULL, 0x080cd02eb0000000ULL, /* tr_MK bm_ML fr_ML ffm_ML */
+	0x0b5cb02eb0000000ULL, 0x09eeb02eb0000000ULL, 0x0b4b302eb0000000ULL, 0x0b9a802eb0000000ULL, /* snk_ML mwk_ML ses_ML tmh_ML */
+	0x071a00317b2f5d60ULL, 0x0951102eb0000000ULL, 0x07a8d02eb0000000ULL, 0x0942f02eb0000000ULL, /* bm_Nkoo_ML khq_ML dtm_ML kao_ML */
+	0x06e4002eb0000000ULL, 0x071b102eb0000000ULL, 0x0734502eb0000000ULL, 0x09f2002eb8000000ULL, /* ar_ML bmq_ML bze_ML my_MM */
+	0x0b50e02eb8000000ULL, 0x0942302eb8000000ULL, 0x0b10702eb8000000ULL, 0x09dd702eb8000000ULL, /* shn_MM kac_MM rhg_MM mnw_MM */
+	0x089ca02eb8000000ULL, 0x0951402eb8000000ULL, 0x09dc002ec0000000ULL, 0x09560017b1625d80ULL, /* hnj_MM kht_MM mn_MN kk_Arab_MN */
+	0x0d10002ec0000000ULL, 0x0b2a002ec0000000ULL, 0x0bce001beb8c5d80ULL, 0x0d1000252b145d90ULL, /* zh_MN ru_MN ug_Cyrl_MN zh_Hant_MO */
+	0x0cea502ec8000000ULL, 0x07dc002ec8000000ULL, 0x0d10002ec8000000ULL, 0x0a02e02ec8000000ULL, /* yue_MO en_MO zh_MO nan_MO */
+	0x0812c02ec8000000ULL, 0x0aa8002ec8000000ULL, 0x07dc002ed0000000ULL, 0x0750002ed0000000ULL, /* fil_MO pt_MO en_MP ch_MP */
+	0x0824002ed8000000ULL, 0x06e4002ee0000000ULL, 0x0824002ee0000000ULL, 0x080c002ee0000000ULL, /* fr_MQ ar_MR fr_MR ff_MR */
+	0x0c5e002ee0000000ULL, 0x080c001742cd5dc0ULL, 0x07dc002ee8000000ULL, 0x09e8002ef0000000ULL, /* wo_MR ff_Adlm_MR en_MS mt_MT */
+	0x07dc002ef0000000ULL, 0x08e8002ef0000000ULL, 0x0824002ef0000000ULL, 0x09cc502ef8000000ULL, /* en_MT it_MT fr_MT mfe_MU */
+	0x0824002ef8000000ULL, 0x07dc002ef8000000ULL, 0x0710f02ef8000000ULL, 0x0be4002ef8000000ULL, /* fr_MU en_MU bho_MU ur_MU */
+	0x0b82002ef8000000ULL, 0x07ac002f00000000ULL, 0x07dc002f00000000ULL, 0x07dc002f08000000ULL, /* ta_MU dv_MV en_MV en_MW */
+	0x0a32002f08000000ULL, 0x0baad02f08000000ULL, 0x0b9e702f08000000ULL, 0x0d2a002f08000000ULL, /* ny_MW tum_MW tog_MW zu_MW */
+	0x07e6002f10000000ULL, 0x07dc002f10000000ULL, 0x0cea102f10000000ULL, 0x0a10502f10000000ULL, /* es_MX en_MX yua_MX nhe_MX */
+	0x0a11702f10000000ULL, 0x09c3a02f10000000ULL, 0x0a06802f10000000ULL, 0x0c0a302f10000000ULL, /* nhw_MX maz_MX nch_MX vec_MX */
+	0x0b4a902f10000000ULL, 0x09e6002f18000000ULL, 0x07dc002f18000000ULL, 0x0d10002f18000000ULL, /* sei_MX ms_MY en_MY zh_MY */
+	0x0b82002f18000000ULL, 0x08c4102f18000000ULL, 0x092c002f18000000ULL, 0x0d1a902f18000000ULL, /* ta_MY iba_MY jv_MY zmi_MY */
+	0x07a9002f18000000ULL, 0x09d8002f18000000ULL, 0x072a702f18000000ULL, 0x0714e02f18000000ULL, /* dtp_MY ml_MY bug_MY bjn_MY */
+	0x0aa8002f20000000ULL, 0x0c1b702f20000000ULL, 0x0a08302f20000000ULL, 0x0ba6002f20000000ULL, /* pt_MZ vmw_MZ ndc_MZ ts_MZ */
+	0x0a0ec02f20000000ULL, 0x0b4a802f20000000ULL, 0x09ce802f20000000ULL, 0x0b1c702f20000000ULL, /* ngl_MZ seh_MZ mgh_MZ rng_MZ */
+	0x0a32002f20000000ULL, 0x0cc2f02f20000000ULL, 0x0b6e002f20000000ULL, 0x0d2a002f20000000ULL, /* ny_MZ yao_MZ sw_MZ zu_MZ */
+	0x06cc003058000000ULL, 0x0954003058000000ULL, 0x0a0e003058000000ULL, 0x0a03103058000000ULL, /* af_NA kj_NA ng_NA naq_NA */
+	0x08b4003058000000ULL, 0x07dc003058000000ULL, 0x078a003058000000ULL, 0x0b9c003058000000ULL, /* hz_NA en_NA de_NA tn_NA */
+	0x0824003068000000ULL, 0x0882003078000000ULL, 0x0794503078000000ULL, 0x0824003078000000ULL, /* fr_NC ha_NE dje_NE fr_NE */
+	0x082b103078000000ULL, 0x0b9a803078000000ULL, 0x06e4003078000000ULL, 0x0baf103078000000ULL, /* fuq_NE tmh_NE ar_NE twq_NE */
+	0x080c003078000000ULL, 0x080c001742cd60f0ULL, 0x07dc003080000000ULL, 0x07dc003088000000ULL, /* ff_NE ff_Adlm_NE en_NF en_NG */
+	0x0a86d03088000000ULL, 0x0882003088000000ULL, 0x08ce003088000000ULL, 0x0cde003088000000ULL, /* pcm_NG ha_NG ig_NG yo_NG */
+	0x082b603088000000ULL, 0x0b93603088000000ULL, 0x07cc903088000000ULL, 0x08c4203088000000ULL, /* fuv_NG tiv_NG efi_NG ibb_NG */
+	0x08820017b1626110ULL, 0x0712e03088000000ULL, 0x0942a03088000000ULL, 0x0946703088000000ULL, /* ha_Arab_NG bin_NG kaj_NG kcg_NG */
+	0x06e4003088000000ULL, 0x0746803088000000ULL, 0x06daf03088000000ULL, 0x06dce03088000000ULL, /* ar_NG cch_NG amo_NG ann_NG */
+	0x080c003088000000ULL, 0x080c001742cd6110ULL, 0x07e6003098000000ULL, 0x0a180030b0000000ULL, /* ff_NG ff_Adlm_NG es_NI nl_NL */
+	0x07dc0030b0000000ULL, 0x078a0030b0000000ULL, 0x08240030b0000000ULL, 0x0a093030b0000000ULL, /* en_NL de_NL fr_NL nds_NL */
+	0x09920030b0000000ULL, 0x08320030b0000000ULL, 0x085f3030b0000000ULL, 0x08c80030b0000000ULL, /* li_NL fy_NL gos_NL id_NL */
+	0x0d0a1030b0000000ULL, 0x0b126030b0000000ULL, 0x0ba40030b0000000ULL, 0x0a040030c8000000ULL, /* zea_NL rif_NL tr_NL nb_NO */
+	0x0a1e0030c8000000ULL, 0x0a1c0030c8000000ULL, 0x0b4a0030c8000000ULL, 0x0a0a0030d0000000ULL, /* no_NO nn_NO se_NO ne_NP */
+	0x09c29030d0000000ULL, 0x0710f030d0000000ULL, 0x0a0b7030d0000000ULL, 0x091ac030d0000000ULL, /* mai_NP bho_NP new_NP jml_NP */
+	0x07dc0030d0000000ULL, 0x07a99030d0000000ULL, 0x06ee1030d0000000ULL, 0x0b90c030d0000000ULL, /* en_NP dty_NP awa_NP thl_NP */
+	0x07030030d0000000ULL, 0x0b887030d0000000ULL, 0x0b912030d0000000ULL, 0x09926030d0000000ULL, /* bap_NP tdg_NP thr_NP lif_NP */
+	0x09cf0030d0000000ULL, 0x0b911030d0000000ULL, 0x09e44030d0000000ULL, 0x070d9030d0000000ULL, /* mgp_NP thq_NP mrd_NP bfy_NP */
+	0x0ca72030d0000000ULL, 0x0b153030d0000000ULL, 0x0b82a030d0000000ULL, 0x08920030d0000000ULL, /* xsr_NP rjs_NP taj_NP hi_NP */
+	0x086d2030d0000000ULL, 0x071e0030d0000000ULL, 0x0b974030d0000000ULL, 0x0b888030d0000000ULL, /* gvr_NP bo_NP tkt_NP tdh_NP */
+	0x071c0030d0000000ULL, 0x0bdd201d4c0161a0ULL, 0x098b0030d0000000ULL, 0x07dc0030e0000000ULL, /* bn_NP unr_Deva_NP lep_NP en_NR */
+	0x0a020030e0000000ULL, 0x07dc0030f8000000ULL, 0x0a135030f8000000ULL, 0x07dc003120000000ULL, /* na_NR en_NU niu_NU en_NZ */
+	0x09d2003120000000ULL, 0x06e40032b8000000ULL, 0x0702c032b8000000ULL, 0x08020032b8000000ULL, /* mi_NZ ar_OM bal_OM fa_OM */
+	0x07e6003458000000ULL, 0x07dc003458000000ULL, 0x0d1000252b1468b0ULL, 0x07e6003478000000ULL, /* es_PA en_PA zh_Hant_PA es_PE */
+	0x0aea003478000000ULL, 0x06f2003478000000ULL, 0x0824003480000000ULL, 0x0bb2003480000000ULL, /* qu_PE ay_PE fr_PF ty_PF */
+	0x0d1000252b146900ULL, 0x0ba0903488000000ULL, 0x07dc003488000000ULL, 0x089e003488000000ULL, /* zh_Hant_PF tpi_PG en_PG ho_PG */
+	0x07dc003490000000ULL, 0x0812c03490000000ULL, 0x07e6003490000000ULL, 0x074a203490000000ULL, /* en_PH fil_PH es_PH ceb_PH */
+	0x08d8f03490000000ULL, 0x0892c03490000000ULL, 0x0712b03490000000ULL, 0x0c43203490000000ULL, /* ilo_PH hil_PH bik_PH war_PH */
+	0x0804c03490000000ULL, 0x0a82d03490000000ULL, 0x0a82703490000000ULL, 0x09c8803490000000ULL, /* fbl_PH pam_PH pag_PH mdh_PH */
+	0x0ba6703490000000ULL, 0x0d1000252b146920ULL, 0x0761303490000000ULL, 0x0964a03490000000ULL, /* tsg_PH zh_Hant_PH cps_PH krj_PH */
+	0x0728f03490000000ULL, 0x089ce03490000000ULL, 0x0b85703490000000ULL, 0x0717503490000000ULL, /* bto_PH hnn_PH tbw_PH bku_PH */
+	0x0be40034a8000000ULL, 0x0a820017b1626950ULL, 0x07dc0034a8000000ULL, 0x09828034a8000000ULL, /* ur_PK pa_Arab_PK en_PK lah_PK */
+	0x0aa60034a8000000ULL, 0x0b480034a8000000ULL, 0x0b572034a8000000ULL, 0x0702c034a8000000ULL, /* ps_PK sd_PK skr_PK bal_PK */
+	0x089cf034a8000000ULL, 0x07248034a8000000ULL, 0x08020034a8000000ULL, 0x070ee034a8000000ULL, /* hno_PK brh_PK fa_PK bgn_PK */
+	0x089c4034a8000000ULL, 0x0b8e0017b1626950ULL, 0x08555034a8000000ULL, 0x070d4034a8000000ULL, /* hnd_PK tg_Arab_PK gju_PK bft_PK */
+	0x096d8034a8000000ULL, 0x09517034a8000000ULL, 0x09ed9034a8000000ULL, 0x0854b034a8000000ULL, /* kvx_PK khw_PK mvy_PK gjk_PK */
+	0x09710034a8000000ULL, 0x09660034a8000000ULL, 0x0ba57034a8000000ULL, 0x07296034a8000000ULL, /* kxp_PK ks_PK trw_PK btv_PK */
+	0x0a980034b0000000ULL, 0x07dc0034b0000000ULL, 0x078a0034b0000000ULL, 0x0b2a0034b0000000ULL, /* pl_PL en_PL de_PL ru_PL */
+	0x0b74c034b0000000ULL, 0x070a0034b0000000ULL, 0x0bd60034b0000000ULL, 0x07662034b0000000ULL, /* szl_PL be_PL uk_PL csb_PL */
+	0x0b589034b0000000ULL, 0x09a80034b0000000ULL, 0x0aa47034b0000000ULL, 0x08240034b8000000ULL, /* sli_PL lt_PL prg_PL fr_PM */
+	0x07dc0034b8000000ULL, 0x07dc0034c0000000ULL, 0x07e60034e0000000ULL, 0x07dc0034e0000000ULL, /* en_PM en_PN es_PR en_PR */
+	0x06e40034e8000000ULL, 0x06e03034e8000000ULL, 0x0aa80034f0000000ULL, 0x07dc0034f0000000ULL, /* ar_PS apc_PS pt_PT en_PT */
+	0x08240034f0000000ULL, 0x07e60034f0000000ULL, 0x08580034f0000000ULL, 0x0a83503508000000ULL, /* fr_PT es_PT gl_PT pau_PW */
+	0x07dc003508000000ULL, 0x085c003518000000ULL, 0x07e6003518000000ULL, 0x078a003518000000ULL, /* en_PW gn_PY es_PY de_PY */
+	0x06e4003658000000ULL, 0x0802003658000000ULL, 0x09d8003658000000ULL, 0x0824003878000000ULL, /* ar_QA fa_QA ml_QA fr_RE */
+	0x0b06603878000000ULL, 0x0b82003878000000ULL, 0x0b1e0038c8000000ULL, 0x07dc0038c8000000ULL, /* rcf_RE ta_RE ro_RO en_RO */
+	0x08240038c8000000ULL, 0x07e60038c8000000ULL, 0x08aa0038c8000000ULL, 0x078a0038c8000000ULL, /* fr_RO es_RO hu_RO de_RO */
+	0x0ba40038c8000000ULL, 0x0b64002d2bce7190ULL, 0x070e0038c8000000ULL, 0x07d80038c8000000ULL, /* tr_RO sr_Latn_RO bg_RO el_RO */
+	0x0a980038c8000000ULL, 0x0b640038e8000000ULL, 0x0b64002d2bce71d0ULL, 0x0b620038e8000000ULL, /* pl_RO sr_RS sr_Latn_RS sq_RS */
+	0x08aa0038e8000000ULL, 0x0b1e0038e8000000ULL, 0x08a40038e8000000ULL, 0x0b560038e8000000ULL, /* hu_RS ro_RS hr_RS sk_RS */
+	0x0bd60038e8000000ULL, 0x0b2a0038f8000000ULL, 0x0ba80038f8000000ULL, 0x07020038f8000000ULL, /* uk_RS ru_RU tt_RU ba_RU */
+	0x076c0038f8000000ULL, 0x08b20038f8000000ULL, 0x074a0038f8000000ULL, 0x06ec0038f8000000ULL, /* cv_RU hy_RU ce_RU av_RU */
+	0x0bc8d038f8000000ULL, 0x0750d038f8000000ULL, 0x0a660038f8000000ULL, 0x0b428038f8000000ULL, /* udm_RU chm_RU os_RU sah_RU */
+	0x09444038f8000000ULL, 0x09f36038f8000000ULL, 0x07832038f8000000ULL, 0x072a1038f8000000ULL, /* kbd_RU myv_RU dar_RU bua_RU */
+	0x09c86038f8000000ULL, 0x096ad038f8000000ULL, 0x096c0038f8000000ULL, 0x098ba038f8000000ULL, /* mdf_RU kum_RU kv_RU lez_RU */
+	0x09643038f8000000ULL, 0x08dc8038f8000000ULL, 0x0bb36038f8000000ULL, 0x06f4001beb8c71f0ULL, /* krc_RU inh_RU tyv_RU az_Cyrl_RU */
+	0x06c99038f8000000ULL, 0x0964c038f8000000ULL, 0x09845038f8000000ULL, 0x095e9038f8000000ULL, /* ady_RU krl_RU lbe_RU koi_RU */
+	0x0a9d401beb8c71f0ULL, 0x09e4a038f8000000ULL, 0x06d94038f8000000ULL, 0x08120038f8000000ULL, /* pnt_Cyrl_RU mrj_RU alt_RU fi_RU */
+	0x0b640038f8000000ULL, 0x0c0b0038f8000000ULL, 0x09dc0038f8000000ULL, 0x09421038f8000000ULL, /* sr_RU vep_RU mn_RU kaa_RU */
+	0x08f48038f8000000ULL, 0x076a0038f8000000ULL, 0x0c1f4038f8000000ULL, 0x0b2e003908000000ULL, /* izh_RU cu_RU vot_RU rw_RW */
+	0x07dc003908000000ULL, 0x0824003908000000ULL, 0x06e4003a58000000ULL, 0x06e5303a58000000ULL, /* en_RW fr_RW ar_SA ars_SA */
+	0x07dc003a60000000ULL, 0x0a93303a60000000ULL, 0x0b2a703a60000000ULL, 0x0765303a68000000ULL, /* en_SB pis_SB rug_SB crs_SC */
+	0x0824003a68000000ULL, 0x07dc003a68000000ULL, 0x06e0403a70000000ULL, 0x06e4003a70000000ULL, /* fr_SC en_SC apd_SD ar_SD */
+	0x07dc003a70000000ULL, 0x070aa03a70000000ULL, 0x082d203a70000000ULL, 0x08820017b16274e0ULL, /* en_SD bej_SD fvr_SD ha_Arab_SD */
+	0x09d9303a70000000ULL, 0x0812103a70000000ULL, 0x0d02703a70000000ULL, 0x0b6c003a78000000ULL, /* mls_SD fia_SD zag_SD sv_SE */
+	0x07dc003a78000000ULL, 0x0812003a78000000ULL, 0x0813403a78000000ULL, 0x0b4a003a78000000ULL, /* en_SE fi_SE fit_SE se_SE */
+	0x0b1b503a78000000ULL, 0x0cd2003a78000000ULL, 0x0b5aa03a78000000ULL, 0x0b5a103a78000000ULL, /* rmu_SE yi_SE smj_SE sma_SE */
+	0x08c2003a78000000ULL, 0x07dc003a88000000ULL, 0x0d10003a88000000ULL, 0x09e6003a88000000ULL, /* ia_SE en_SG zh_SG ms_SG */
+	0x0b82003a88000000ULL, 0x09d8003a88000000ULL, 0x0a82003a88000000ULL, 0x07dc003a90000000ULL, /* ta_SG ml_SG pa_SG en_SH */
+	0x0b58003a98000000ULL, 0x08a4003a98000000ULL, 0x07dc003a98000000ULL, 0x078a003a98000000ULL, /* sl_SI hr_SI en_SI de_SI */
+	0x0c0a303a98000000ULL, 0x08aa003a98000000ULL, 0x08e8003a98000000ULL, 0x0a04003aa0000000ULL, /* vec_SI hu_SI it_SI nb_SJ */
+	0x0b2a003aa0000000ULL, 0x0b56003aa8000000ULL, 0x0766003aa8000000ULL, 0x07dc003aa8000000ULL, /* ru_SJ sk_SK cs_SK en_SK */
+	0x078a003aa8000000ULL, 0x08aa003aa8000000ULL, 0x0bd6003aa8000000ULL, 0x0a98003aa8000000ULL, /* de_SK hu_SK uk_SK pl_SK */
+	0x0964903ab0000000ULL, 0x07dc003ab0000000ULL, 0x09cae03ab0000000ULL, 0x0b8ad03ab0000000ULL, /* kri_SL en_SL men_SL tem_SL */
+	0x080c003ab0000000ULL, 0x080c001742cd7560ULL, 0x08e8003ab8000000ULL, 0x07de003ab8000000ULL, /* ff_SL ff_Adlm_SL it_SM eo_SM */
+	0x0c5e003ac0000000ULL, 0x0824003ac0000000ULL, 0x080c003ac0000000ULL, 0x0b65203ac0000000ULL, /* wo_SN fr_SN ff_SN srr_SN */
+	0x07b2f03ac0000000ULL, 0x0b43603ac0000000ULL, 0x09cd603ac0000000ULL, 0x0715403ac0000000ULL, /* dyo_SN sav_SN mfv_SN bjt_SN */
+	0x0b5c603ac0000000ULL, 0x095c603ac0000000ULL, 0x0726303ac0000000ULL, 0x09cb903ac0000000ULL, /* snf_SN knf_SN bsc_SN mey_SN */
+	0x0b9d203ac0000000ULL, 0x080c001742cd7580ULL, 0x0b5e003ac8000000ULL, 0x06e4003ac8000000ULL, /* tnr_SN ff_Adlm_SN so_SO ar_SO */
+	0x0b6e003ac8000000ULL, 0x0a5a003ac8000000ULL, 0x0a18003ae0000000ULL, 0x0b64e03ae0000000ULL, /* sw_SO om_SO nl_SR srn_SR */
+	0x0d1000252b1475c0ULL, 0x089ca03ae0000000ULL, 0x06e4003ae8000000ULL, 0x07dc003ae8000000ULL, /* zh_Hant_SR hnj_SR ar_SS en_SS */
+	0x0a2b303ae8000000ULL, 0x0aa8003af0000000ULL, 0x0824003af0000000ULL, 0x07e6003b00000000ULL, /* nus_SS pt_ST fr_ST es_SV */
+	0x0747203b00000000ULL, 0x0aa0c03b00000000ULL, 0x098ae03b00000000ULL, 0x07dc003b10000000ULL, /* ccr_SV ppl_SV len_SV en_SX */
+	0x07e6003b10000000ULL, 0x0c12303b10000000ULL, 0x0a18003b10000000ULL, 0x06e0303b18000000ULL, /* es_SX vic_SX nl_SX apc_SY */
+	0x06e4003b18000000ULL, 0x096a003b18000000ULL, 0x0824003b18000000ULL, 0x08b2003b18000000ULL, /* ar_SY ku_SY fr_SY hy_SY */
+	0x0b73203b18000000ULL, 0x07dc003b20000000ULL, 0x0b66003b20000000ULL, 0x0d2a003b20000000ULL, /* syr_SY en_SZ ss_SZ zu_SZ */
+	0x0ba6003b20000000ULL, 0x07dc003c58000000ULL, 0x07dc003c68000000ULL, 0x06e4003c70000000ULL, /* ts_SZ en_TA en_TC ar_TD */
+	0x0824003c70000000ULL, 0x0824003c80000000ULL, 0x0824003c88000000ULL, 0x07ca003c88000000ULL, /* fr_TD fr_TF fr_TG ee_TG */
+	0x08cc503c88000000ULL, 0x0718f03c88000000ULL, 0x0b90003c90000000ULL, 0x07dc003c90000000ULL, /* ife_TG blo_TG th_TH en_TH */
+	0x0ba9303c90000000ULL, 0x0a1e403c90000000ULL, 0x0b5f503c90000000ULL, 0x09cc103c90000000ULL, /* tts_TH nod_TH sou_TH mfa_TH */
+	0x0d1000252b147920ULL, 0x0970d03c90000000ULL, 0x0949403c90000000ULL, 0x09dd703c90000000ULL, /* zh_Hant_TH kxm_TH kdt_TH mnw_TH */
+	0x089ca03c90000000ULL, 0x0b50e03c90000000ULL, 0x0987003c90000000ULL, 0x09aec03c90000000ULL, /* hnj_TH shn_TH lcp_TH lwl_TH */
+	0x0b8e003ca0000000ULL, 0x0b2a003ca0000000ULL, 0x0802003ca0000000ULL, 0x06e4003ca0000000ULL, /* tg_TJ ru_TJ fa_TJ ar_TJ */
+	0x0b96c03ca8000000ULL, 0x07dc003ca8000000ULL, 0x0b5a003ca8000000ULL, 0x0aa8003cb0000000ULL, /* tkl_TK en_TK sm_TK pt_TL */
+	0x0b8b403cb0000000ULL, 0x0b96003cb8000000ULL, 0x0b2a003cb8000000ULL, 0x0bf4003cb8000000ULL, /* tet_TL tk_TM ru_TM uz_TM */
+	0x096a003cb8000000ULL, 0x0942103cb8000000ULL, 0x06ca203cc0000000ULL, 0x06e4003cc0000000ULL, /* ku_TM kaa_TM aeb_TN ar_TN */
+	0x0824003cc0000000ULL, 0x0b9e003cc8000000ULL, 0x07dc003cc8000000ULL, 0x0ba4003ce0000000ULL, /* fr_TN to_TO en_TO tr_TR */
+	0x07dc003ce0000000ULL, 0x096a003ce0000000ULL, 0x06e0303ce0000000ULL, 0x0d34103ce0000000ULL, /* en_TR ku_TR apc_TR zza_TR */
+	0x0944403ce0000000ULL, 0x06f4003ce0000000ULL, 0x06f40017b16279c0ULL, 0x06e4003ce0000000ULL, /* kbd_TR az_TR az_Arab_TR ar_TR */
+	0x070f803ce0000000ULL, 0x070e003ce0000000ULL, 0x06c9903ce0000000ULL, 0x0953503ce0000000ULL, /* bgx_TR bg_TR ady_TR kiu_TR */
+	0x0942103ce0000000ULL, 0x08b2003ce0000000ULL, 0x0942003ce0000000ULL, 0x09b5a03ce0000000ULL, /* kaa_TR hy_TR ka_TR lzz_TR */
+	0x0b64002d2bce79c0ULL, 0x0b62003ce0000000ULL, 0x0a9d402d2bce79c0ULL, 0x06c4003ce0000000ULL, /* sr_Latn_TR sq_TR pnt_Latn_TR ab_TR */
+	0x07d8003ce0000000ULL, 0x0ba5503ce0000000ULL, 0x0bf4003ce0000000ULL, 0x0972002d2bce79c0ULL, /* el_TR tru_TR uz_TR ky_Latn_TR */
+	0x0956003ce0000000ULL, 0x07dc003cf0000000ULL, 0x07e6003cf0000000ULL, 0x0bacc03d00000000ULL, /* kk_TR en_TT es_TT tvl_TV */
+	0x07dc003d00000000ULL, 0x0d1000252b147a10ULL, 0x0a02e0252b147a10ULL, 0x0882b0252b147a10ULL, /* en_TV zh_Hant_TW nan_Hant_TW hak_Hant_TW */
+	0x0ba5603d08000000ULL, 0x0b6e003d20000000ULL, 0x07dc003d20000000ULL, 0x0b6ab03d20000000ULL, /* trv_TW sw_TZ en_TZ suk_TZ */
+	0x0a32d03d20000000ULL, 0x0948503d20000000ULL, 0x070ba03d20000000ULL, 0x0966203d20000000ULL, /* nym_TZ kde_TZ bez_TZ ksb_TZ */
+	0x09c3303d20000000ULL, 0x09cf903d20000000ULL, 0x06e6103d20000000ULL, 0x0982703d20000000ULL, /* mas_TZ mgy_TZ asa_TZ lag_TZ */
+	0x091a303d20000000ULL, 0x0b1e603d20000000ULL, 0x0c2ae03d20000000ULL, 0x0b2eb03d20000000ULL, /* jmc_TZ rof_TZ vun_TZ rwk_TZ */
+	0x0b45003d20000000ULL, 0x0bd6003e58000000ULL, 0x0b2a003e58000000ULL, 0x0a98003e58000000ULL, /* sbp_TZ uk_UA ru_UA pl_UA */
+	0x0cd2003e58000000ULL, 0x0b2a503e58000000ULL, 0x070a003e58000000ULL, 0x0764803e58000000ULL, /* yi_UA rue_UA be_UA crh_UA */
+	0x0b1e003e58000000ULL, 0x070e003e58000000ULL, 0x0ba4003e58000000ULL, 0x08aa003e58000000ULL, /* ro_UA bg_UA tr_UA hu_UA */
+	0x07d8003e58000000ULL, 0x0b6e003e88000000ULL, 0x098e003e88000000ULL, 0x0a32e03e88000000ULL, /* el_UA sw_UG lg_UG nyn_UG */
+	0x074e703e88000000ULL, 0x0c9e703e88000000ULL, 0x07dc003e88000000ULL, 0x0b8af03e88000000ULL, /* cgg_UG xog_UG en_UG teo_UG */
+	0x0982a03e88000000ULL, 0x06c6803e88000000ULL, 0x09f3803e88000000ULL, 0x0b2e003e88000000ULL, /* laj_UG ach_UG myx_UG rw_UG */
+	0x0ba8a03e88000000ULL, 0x0892003e88000000ULL, 0x07dc003eb8000000ULL, 0x07dc003ee8000000ULL, /* ttj_UG hi_UG en_UM en_US */
+	0x07e6003ee8000000ULL, 0x0d1000252b147dd0ULL, 0x0824003ee8000000ULL, 0x078a003ee8000000ULL, /* es_US zh_Hant_US fr_US de_US */
+	0x0812c03ee8000000ULL, 0x08e8003ee8000000ULL, 0x0c12003ee8000000ULL, 0x095e003ee8000000ULL, /* fil_US it_US vi_US ko_US */
+	0x0b2a003ee8000000ULL, 0x0a2c003ee8000000ULL, 0x0cd2003ee8000000ULL, 0x0a88303ee8000000ULL, /* ru_US nv_US yi_US pdc_US */
+	0x089ca03ee8000000ULL, 0x0883703ee8000000ULL, 0x0824303ee8000000ULL, 0x0751203ee8000000ULL, /* hnj_US haw_US frc_US chr_US */
+	0x07e7503ee8000000ULL, 0x0782b03ee8000000ULL, 0x0750f03ee8000000ULL, 0x0997403ee8000000ULL, /* esu_US dak_US cho_US lkt_US */
+	0x08d6003ee8000000ULL, 0x09eb303ee8000000ULL, 0x0742403ee8000000ULL, 0x0752303ee8000000ULL, /* ik_US mus_US cad_US cic_US */
+	0x08de003ee8000000ULL, 0x0904f03ee8000000ULL, 0x0a66103ee8000000ULL, 0x07e6003f18000000ULL, /* io_US jbo_US osa_US es_UY */
+	0x0bf4003f20000000ULL, 0x0bf4001beb8c7e40ULL, 0x0b2a003f20000000ULL, 0x0942103f20000000ULL, /* uz_UZ uz_Cyrl_UZ ru_UZ kaa_UZ */
+	0x0ba4003f20000000ULL, 0x08e8004058000000ULL, 0x0982004058000000ULL, 0x07dc004068000000ULL, /* tr_UZ it_VA la_VA en_VC */
+	0x07e6004078000000ULL, 0x0ce4c04078000000ULL, 0x07dc004088000000ULL, 0x07dc004098000000ULL, /* es_VE yrl_VE en_VG en_VI */
+	0x0c120040c0000000ULL, 0x0d1000252b148180ULL, 0x07194040c0000000ULL, 0x089ca040c0000000ULL, /* vi_VN zh_Hant_VN blt_VN hnj_VN */
+	0x0754d040c0000000ULL, 0x07120040f8000000ULL, 0x07dc0040f8000000ULL, 0x08240040f8000000ULL, /* cjm_VN bi_VU en_VU fr_VU */
+	0x0824004280000000ULL, 0x0c59304280000000ULL, 0x082a404280000000ULL, 0x0b5a0042e8000000ULL, /* fr_WF wls_WF fud_WF sm_WS */
+	0x07dc0042e8000000ULL, 0x0b620044a8000000ULL, 0x06d8e044a8000000ULL, 0x0b640044a8000000ULL, /* en_WS sq_XK aln_XK sr_XK */
+	0x0b64002d2bce8950ULL, 0x06e4004678000000ULL, 0x07dc004678000000ULL, 0x0b6e2046f0000000ULL, /* sr_Latn_XK ar_YE en_YE swb_YT */
+	0x08240046f0000000ULL, 0x072a3046f0000000ULL, 0x0b6e0046f0000000ULL, 0x07dc004858000000ULL, /* fr_YT buc_YT sw_YT en_ZA */
+	0x0d2a004858000000ULL, 0x0c90004858000000ULL, 0x06cc004858000000ULL, 0x0a26f04858000000ULL, /* zu_ZA xh_ZA af_ZA nso_ZA */
+	0x0b9c004858000000ULL, 0x0b68004858000000ULL, 0x0ba6004858000000ULL, 0x0b66004858000000ULL, /* tn_ZA st_ZA ts_ZA ss_ZA */
+	0x0c0a004858000000ULL, 0x0892004858000000ULL, 0x0a24004858000000ULL, 0x0b6e004858000000ULL, /* ve_ZA hi_ZA nr_ZA sw_ZA */
+	0x070ad048b8000000ULL, 0x0a320048b8000000ULL, 0x07dc0048b8000000ULL, 0x0b9e9048b8000000ULL, /* bem_ZM ny_ZM en_ZM toi_ZM */
+	0x099fa048b8000000ULL, 0x0a265048b8000000ULL, 0x098a2048b8000000ULL, 0x0baad048b8000000ULL, /* loz_ZM nse_ZM leb_ZM tum_ZM */
+	0x0962e048b8000000ULL, 0x09aae048b8000000ULL, 0x09aa5048b8000000ULL, 0x0b5c004908000000ULL, /* kqn_ZM lun_ZM lue_ZM sn_ZW */
+	0x07dc004908000000ULL, 0x0a08004908000000ULL, 0x09f0304908000000ULL, 0x0a08304908000000ULL, /* en_ZW nd_ZW mxc_ZW ndc_ZW */
+	0x0946b04908000000ULL, 0x0a32004908000000ULL, 0x0c0a004908000000ULL, 0x0b9c004908000000ULL, /* kck_ZW ny_ZW ve_ZW tn_ZW */
+};
+
+/*
+ * Get the dense ID of a two-letter territory (for example "CH" or "ch"): a * 26 + b, where a and b are the letters of the code (0 for "A").
+ * Returns -1 if territory is not made of two letters.
+ */
+int GetLocaleTerritoryID(const char* territory, size_t length)
+{
+	if (!territory || length != 2 || !IsLocaleAlpha(territory[0]) || !IsLocaleAlpha(territory[1])) {
+		return -1;
+	}
+	return (ToUpperLocaleChar(territory[0]) - 'A') * 26 + (ToUpperLocaleChar(territory[1]) - 'A');
+}
+
+/*
+ * Get the locales used in a territory, given its dense ID, sorted by the percentage of the population that speaks them (for example de_CH, gsw_CH, en_CH, fr_CH, it_CH...).
+ * keys receives a pointer to a static list of LocaleKeys (nothing is allocated).
+ * Returns the number of locales (0 if territoryID is not valid or if there's no data about the territory).
+ */
+size_t GetLocaleTerritoryLocaleKeysByID(int territoryID, const LocaleKey** keys)
+{
+	if (territoryID < 0 || territoryID >= LOCALE_TERRITORY_ID_COUNT) {
+		*keys = NULL;
+		return 0;
+	}
+	*keys = LocaleTerritoryLanguages + LocaleTerritoryLanguageOffsets[territoryID];
+	return (size_t)(LocaleTerritoryLanguageOffsets[territoryID + 1] - LocaleTerritoryLanguageOffsets[territoryID]);
+}
+
+/*
+ * Get the locales used in a territory (for example "CH"), sorted by the percentage of the population that speaks them.
+ * keys receives a pointer to a static list of LocaleKeys (nothing is allocated): use FormatLocaleKey to get their IDs in a specific format.
+ * Returns the number of locales (0 if territory is not valid or if there's no data about the territory).
+ */
+size_t GetLocaleTerritoryLocaleKeys(const char* territory, size_t length, const LocaleKey** keys)
+{
+	return GetLocaleTerritoryLocaleKeysByID(GetLocaleTerritoryID(territory, length), keys);
+}
+
+/*
+ * Dense locale IDs: a LocaleIDRegistry assigns consecutive 16-bit IDs to canonical locales, identified by their LocaleKey,
+ * or by their canonical ID for the locales without a LocaleKey (like "ca_ES@valencia", "de-DE-1901" or "POSIX": see WriteBulkLocaleID).
+ */
+#define LOCALE_ID_REGISTRY_MAX_COUNT 65535
+
+typedef struct _LocaleIDRegistry {
+	/* The LocaleKeys, indexed by their ID (0 for the locales without a LocaleKey) */
+	LocaleKey* keys;
+	/* The canonical IDs of the locales without a LocaleKey, indexed by their ID (NULL for the locales with a LocaleKey) */
+	char** names;
+	/* Number of registered keys */
+	size_t count;
+	/* Number of keys that can be stored without growing the registry */
+	size_t capacity;
+	/* Open addressing hash table of the IDs plus one (0 for empty slots) */
+	uint16_t* slots;
+	/* Number of slots (a power of 2, at least twice the capacity) */
+	size_t slotCount;
+	/* The context used to scan the identifiers (NULL for the default one) */
+	LocaleContext* context;
+	/* The hooks used to allocate the memory of the registry (the ones of the context) */
+	const LocaleAllocator* allocator;
+} LocaleIDRegistry;
+
+/*
+ * Initializes an empty LocaleIDRegistry that scans the identifiers within the limits of a context, and allocates memory with its hooks
+ * (NULL for the default context; the context must outlive the registry).
+ */
+void InitLocaleIDRegistry(LocaleIDRegistry* registry, LocaleContext* context)
+{
+	memset(registry, 0, sizeof(LocaleIDRegistry));
+	registry->context = context;
+	registry->allocator = context ? context->allocator : NULL;
+}
+
+/*
+ * Frees the memory used by a LocaleIDRegistry (that can then be used again, as if it has just been initialized).
+ */
+void FreeLocaleIDRegistry(LocaleIDRegistry* registry)
+{
+	size_t i;
+	for (i = 0; i < registry->count; i++) {
+		LocaleRelease(registry->allocator, registry->names[i]);
+	}
+	LocaleRelease(registry->allocator, registry->names);
+	LocaleRelease(registry->allocator, registry->keys);
+	LocaleRelease(registry->allocator, registry->slots);
+	InitLocaleIDRegistry(registry, registry->context);
+}
+
+/*
+ * Calculates the hash of a locale in a registry: the hash of its LocaleKey, or the hash of its canonical ID if key is 0.
+ */
+static uint64_t HashLocaleIDRegistryLocale(LocaleKey key, const char* name)
+{
+	uint64_t hash;
+	if (key) {
+		return HashLocaleKey(key);
+	}
+	for (hash = 0xcbf29ce484222325ULL; *name; name++) {
+		hash = (hash ^ (unsigned char)*name) * 0x100000001b3ULL;
+	}
+	return HashLocaleKey(hash);
+}
+
+/*
+ * Finds the slot of a locale (its LocaleKey, or its canonical ID if key is 0) in the hash table of a registry (the slot is empty if the locale is not registered).
+ */
+static size_t FindLocaleIDRegistrySlot(const LocaleIDRegistry* registry, LocaleKey key, const char* name)
+{
+	size_t slot, id;
+	for (slot = (size_t)HashLocaleIDRegistryLocale(key, name) & (registry->slotCount - 1); registry->slots[slot]; slot = (slot + 1) & (registry->slotCount - 1)) {
+		id = registry->slots[slot] - 1;
+		if (key ? registry->keys[id] == key : registry->names[id] && !strcmp(registry->names[id], name)) {
+			break;
+		}
+	}
+	return slot;
+}
+
+/*
+ * Doubles the capacity of a registry, rebuilding its hash table.
+ * Returns 0 in case of out-of-memory problems (the registry is not changed), 1 otherwise.
+ */
+static int GrowLocaleIDRegistry(LocaleIDRegistry* registry)
+{
+	LocaleKey* keys;
+	char** names;
+	uint16_t* slots;
+	size_t capacity, slotCount, i;
+	capacity = registry->capacity ? registry->capacity * 2 : 64;
+	if (capacity > LOCALE_ID_REGISTRY_MAX_COUNT) {
+		capacity = LOCALE_ID_REGISTRY_MAX_COUNT;
+	}
+	slotCount = registry->slotCount ? registry->slotCount : 128;
+	while (slotCount < capacity * 2) {
+		slotCount *= 2;
+	}
+	keys = (LocaleKey*)LocaleAllocate(registry->allocator, capacity * sizeof(LocaleKey));
+	names = (char**)LocaleAllocate(registry->allocator, capacity * sizeof(char*));
+	slots = (uint16_t*)LocaleAllocate(registry->allocator, slotCount * sizeof(uint16_t));
+	if (!keys || !names || !slots) {
+		LocaleRelease(registry->allocator, keys);
+		LocaleRelease(registry->allocator, names);
+		LocaleRelease(registry->allocator, slots);
+		return 0;
+	}
+	if (registry->count) {
+		memcpy(keys, registry->keys, registry->count * sizeof(LocaleKey));
+		memcpy(names, registry->names, registry->count * sizeof(char*));
+	}
+	LocaleRelease(registry->allocator, registry->keys);
+	LocaleRelease(registry->allocator, registry->names);
+	LocaleRelease(registry->allocator, registry->slots);
+	memset(slots, 0, slotCount * sizeof(uint16_t));
+	registry->keys = keys;
+	registry->names = names;
+	registry->capacity = capacity;
+	registry->slots = slots;
+	registry->slotCount = slotCount;
+	for (i = 0; i < registry->count; i++) {
+		registry->slots[FindLocaleIDRegistrySlot(registry, keys[i], names[i])] = (uint16_t)(i + 1);
+	}
+	return 1;
+}
+
+/*
+ * Get the ID of a LocaleKey, without registering it.
+ * Returns -1 if key is not registered.
+ */
+int FindLocaleKeyID(const LocaleIDRegistry* registry, LocaleKey key)
+{
+	size_t slot;
+	if (!registry->count || !key) {
+		return -1;
+	}
+	slot = FindLocaleIDRegistrySlot(registry, key, NULL);
+	return registry->slots[slot] ? (int)registry->slots[slot] - 1 : -1;
+}
+
+/*
+ * Get the ID of a locale (its LocaleKey, or its canonical ID if key is 0), registering it if it's new.
+ * Returns -1 if the registry is full (LOCALE_ID_REGISTRY_MAX_COUNT locales) or in case of out-of-memory problems.
+ */
+static int RegisterLocaleIDRegistryLocale(LocaleIDRegistry* registry, LocaleKey key, const char* name)
+{
+	char* copy;
+	size_t slot, size;
+	if (registry->count) {
+		slot = FindLocaleIDRegistrySlot(registry, key, name);
+		if (registry->slots[slot]) {
+			return (int)registry->slots[slot] - 1;
+		}
+	}
+	if (registry->count == registry->capacity && (registry->count == LOCALE_ID_REGISTRY_MAX_COUNT || !GrowLocaleIDRegistry(registry))) {
+		return -1;
+	}
+	copy = NULL;
+	if (!key) {
+		size = strlen(name) + 1;
+		copy = (char*)LocaleAllocate(registry->allocator, size);
+		if (!copy) {
+			return -1;
+		}
+		memcpy(copy, name, size);
+	}
+	slot = FindLocaleIDRegistrySlot(registry, key, name);
+	registry->keys[registry->count] = key;
+	registry->names[registry->count] = copy;
+	registry->slots[slot] = (uint16_t)(++registry->count);
+	return (int)registry->count - 1;
+}
+
+/*
+ * Get the ID of a LocaleKey, registering it if it's new.
+ * Returns -1 if key is 0, if the registry is full (LOCALE_ID_REGISTRY_MAX_COUNT locales) or in case of out-of-memory problems.
+ */
+int RegisterLocaleKey(LocaleIDRegistry* registry, LocaleKey key)
+{
+	return key ? RegisterLocaleIDRegistryLocale(registry, key, NULL) : -1;
+}
+
+/*
+ * Get the ID of a locale identifier (in Unicode or in Gettext format), registering it if it's new.
+ * The identifiers without a LocaleKey are registered by their canonical ID (see WriteBulkLocaleID), so "ca_ES.UTF-8@valencia" and "ca_ES@valencia" have the same ID.
+ * locale doesn't need to be null-terminated.
+ * Returns -1 if locale is invalid, if it exceeds the limits of the context of the registry, if the registry is full or in case of out-of-memory problems.
+ */
+int RegisterLocaleID(LocaleIDRegistry* registry, const char* locale, size_t length)
+{
+	char name[LOCALE_BULK_ID_SIZE];
+	LocaleKey key;
+	if (ScanBulkLocaleID(registry->context, locale, length, &key, name, sizeof(name)) == LOCALE_BULK_ERROR) {
+		return -1;
+	}
+	return RegisterLocaleIDRegistryLocale(registry, key, key ? NULL : name);
+}
+
+/*
+ * Get the LocaleKey with a specific ID.
+ * Returns 0 if there's no such ID, or if its locale has no LocaleKey (see GetLocaleIDRegistryName).
+ */
+LocaleKey GetLocaleIDRegistryKey(const LocaleIDRegistry* registry, int id)
+{
+	return id >= 0 && (size_t)id < registry->count ? registry->keys[id] : 0;
+}
+
+/*
+ * Get the canonical ID (see WriteBulkLocaleID) of the locale with a specific ID, if it has no LocaleKey.
+ * Returns NULL if there's no such ID, or if its locale has a LocaleKey (see GetLocaleIDRegistryKey).
+ */
+const char* GetLocaleIDRegistryName(const LocaleIDRegistry* registry, int id)
+{
+	return id >= 0 && (size_t)id < registry->count ? registry->names[id] : NULL;
+}
+
+/*
+ * LocaleSet: a set of dense locale IDs, stored like a roaring bitmap container:
+ * small sets are sorted arrays of IDs, and they become a bitmap (with one bit for every possible ID) when they grow larger than LOCALE_SET_ARRAY_MAX_COUNT.
+ */
+#define LOCALE_SET_ARRAY_MAX_COUNT 4096
+#define LOCALE_SET_BITMAP_WORDS (65536 / 64)
+
+typedef struct _LocaleSet {
+	/* Number of IDs in the set */
+	size_t count;
+	/* The sorted IDs (if bitmap is NULL) */
+	uint16_t* ids;
+	/* Number of IDs that can be stored in ids without growing it */
+	size_t capacity;
+	/* The bitmap of the IDs (NULL for sets stored as arrays) */
+	uint64_t* bitmap;
+	/* The hooks used to allocate the memory of the set (NULL for malloc) */
+	const LocaleAllocator* allocator;
+} LocaleSet;
+
+/*
+ * Initializes an empty LocaleSet that allocates memory with the specified hooks (NULL for malloc).
+ */
+void InitLocaleSet(LocaleSet* set, const LocaleAllocator* allocator)
+{
+	memset(set, 0, sizeof(LocaleSet));
+	set->allocator = allocator;
+}
+
+/*
+ * Frees the memory used by a LocaleSet (that can then be used again, as an empty set).
+ */
+void FreeLocaleSet(LocaleSet* set)
+{
+	LocaleRelease(set->allocator, set->ids);
+	LocaleRelease(set->allocator, set->bitmap);
+	InitLocaleSet(set, set->allocator);
+}
+
+/*
+ * Counts the bits of a bitmap word.
+ */
+static unsigned int CountLocaleSetBits(uint64_t word)
+{
+#if defined(__GNUC__)
+	return (unsigned int)__builtin_popcountll(word);
+#else
+	unsigned int count;
+	for (count = 0; word; count++) {
+		word &= word - 1;
+	}
+	return count;
+#endif
+}
+
+/*
+ * Gets the position of the lowest bit of a (non zero) bitmap word.
+ */
+static unsigned int FindLowestLocaleSetBit(uint64_t word)
+{
+#if defined(__GNUC__)
+	return (unsigned int)__builtin_ctzll(word);
+#else
+	unsigned int position;
+	for (position = 0; !(word & 1); position++) {
+		word >>= 1;
+	}
+	return position;
+#endif
+}
+
+/*
+ * Makes sure that the array of a set stored as an array can hold a number of IDs.
+ * Returns 0 in case of out-of-memory problems (the set is not changed), 1 otherwise.
+ */
+static int ReserveLocaleSet(LocaleSet* set, size_t capacity)
+{
+	uint16_t* ids;
+	if (capacity <= set->capacity) {
+		return 1;
+	}
+	if (capacity < set->capacity * 2) {
+		capacity = set->capacity * 2;
+	}
+	ids = (uint16_t*)LocaleAllocate(set->allocator, capacity * sizeof(uint16_t));
+	if (!ids) {
+		return 0;
+	}
+	if (set->count) {
+		memcpy(ids, set->ids, set->count * sizeof(uint16_t));
+	}
+	LocaleRelease(set->allocator, set->ids);
+	set->ids = ids;
+	set->capacity = capacity;
+	return 1;
+}
+
+/*
+ * Converts a set stored as an array to a bitmap.
+ * Returns 0 in case of out-of-memory problems (the set is not changed), 1 otherwise.
+ */
+static int ConvertLocaleSetToBitmap(LocaleSet* set)
+{
+	uint64_t* bitmap;
+	size_t i;
+	bitmap = (uint64_t*)LocaleAllocate(set->allocator, LOCALE_SET_BITMAP_WORDS * sizeof(uint64_t));
+	if (!bitmap) {
+		return 0;
+	}
+	memset(bitmap, 0, LOCALE_SET_BITMAP_WORDS * sizeof(uint64_t));
+	for (i = 0; i < set->count; i++) {
+		bitmap[set->ids[i] >> 6] |= (uint64_t)1 << (set->ids[i] & 63);
+	}
+	LocaleRelease(set->allocator, set->ids);
+	set->ids = NULL;
+	set->capacity = 0;
+	set->bitmap = bitmap;
+	return 1;
+}
+
+/*
+ * Converts a set stored as a bitmap to an array, if it's small enough.
+ * Returns 0 in case of out-of-memory problems (the set is not changed), 1 otherwise.
+ */
+static int CompactLocaleSet(LocaleSet* set)
+{
+	uint16_t* ids;
+	uint64_t word;
+	size_t i, n;
+	if (!set->bitmap || set->count > LOCALE_SET_ARRAY_MAX_COUNT) {
+		return 1;
+	}
+	ids = NULL;
+	if (set->count) {
+		ids = (uint16_t*)LocaleAllocate(set->allocator, set->count * sizeof(uint16_t));
+		if (!ids) {
+			return 0;
+		}
+	}
+	for (i = 0, n = 0; i < LOCALE_SET_BITMAP_WORDS; i++) {
+		for (word = set->bitmap[i]; word; word &= word - 1) {
+			ids[n++] = (uint16_t)(i * 64 + FindLowestLocaleSetBit(word));
+		}
+	}
+	LocaleRelease(set->allocator, set->bitmap);
+	set->bitmap = NULL;
+	set->ids = ids;
+	set->capacity = set->count;
+	return 1;
+}
+
+/*
+ * Finds the position of an ID in the array of a set stored as an array (or where it should be inserted).
+ */
+static size_t FindLocaleSetPosition(const LocaleSet* set, uint16_t id)
+{
+	size_t low, high, middle;
+	for (low = 0, high = set->count; low < high;) {
+		middle = (low + high) / 2;
+		if (set->ids[middle] < id) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/*
+ * Checks if a LocaleSet contains an ID.
+ */
+int LocaleSetContains(const LocaleSet* set, int id)
+{
+	size_t position;
+	if (id < 0 || id > 0xffff) {
+		return 0;
+	}
+	if (set->bitmap) {
+		return (set->bitmap[id >> 6] >> (id & 63)) & 1;
+	}
+	position = FindLocaleSetPosition(set, (uint16_t)id);
+	return position < set->count && set->ids[position] == id;
+}
+
+/*
+ * Adds an ID to a LocaleSet.
+ * Returns 0 if id is not valid or in case of out-of-memory problems (the set is not changed), 1 otherwise.
+ */
+int AddToLocaleSet(LocaleSet* set, int id)
+{
+	size_t position;
+	if (id < 0 || id > 0xffff) {
+		return 0;
+	}
+	if (!set->bitmap) {
+		position = FindLocaleSetPosition(set, (uint16_t)id);
+		if (position < set->count && set->ids[position] == id) {
+			return 1;
+		}
+		if (set->count < LOCALE_SET_ARRAY_MAX_COUNT) {
+			if (!ReserveLocaleSet(set, set->count + 1)) {
+				return 0;
+			}
+			memmove(set->ids + position + 1, set->ids + position, (set->count - position) * sizeof(uint16_t));
+			set->ids[position] = (uint16_t)id;
+			set->count++;
+			return 1;
+		}
+		if (!ConvertLocaleSetToBitmap(set)) {
+			return 0;
+		}
+	}
+	if (!((set->bitmap[id >> 6] >> (id & 63)) & 1)) {
+		set->bitmap[id >> 6] |= (uint64_t)1 << (id & 63);
+		set->count++;
+	}
+	return 1;
+}
+
+/*
+ * Adds a list of locale identifiers (each one in Unicode or in Gettext format) to a LocaleSet, registering their IDs (see RegisterLocaleID).
+ * The invalid identifiers (and the ones that exceed the limits of the context of the registry) are skipped.
+ * Returns 0 if the registry is full or in case of out-of-memory problems, 1 otherwise.
+ */
+int AddLocaleIDsToLocaleSet(LocaleSet* set, LocaleIDRegistry* registry, const char* const* locales, size_t count)
+{
+	char name[LOCALE_BULK_ID_SIZE];
+	LocaleKey key;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		if (ScanBulkLocaleID(registry->context, locales[i], strlen(locales[i]), &key, name, sizeof(name)) != LOCALE_BULK_ERROR
+			&& !AddToLocaleSet(set, RegisterLocaleIDRegistryLocale(registry, key, key ? NULL : name))
+		) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Gets the IDs of a LocaleSet in ascending order.
+ * position must be 0 for the first call, and it's updated to continue from the next ID.
+ * Returns the next ID, or -1 when there are no more IDs.
+ */
+int NextLocaleSetID(const LocaleSet* set, size_t* position)
+{
+	uint64_t word;
+	size_t i;
+	if (!set->bitmap) {
+		return *position < set->count ? set->ids[(*position)++] : -1;
+	}
+	for (i = *position >> 6; i < LOCALE_SET_BITMAP_WORDS; i++) {
+		word = set->bitmap[i];
+		if (i == *position >> 6) {
+			word &= ~(uint64_t)0 << (*position & 63);
+		}
+		if (word) {
+			*position = i * 64 + FindLowestLocaleSetBit(word) + 1;
+			return (int)*position - 1;
+		}
+	}
+	*position = LOCALE_SET_BITMAP_WORDS * 64;
+	return -1;
+}
+
+/*
+ * Combines two bitmaps word by word (with SSE2, when available), returning the number of bits of the result.
+ */
+static size_t CombineLocaleSetBitmaps(uint64_t* result, const uint64_t* a, const uint64_t* b, int unite)
+{
+	size_t i, count;
+	count = 0;
+#if defined(__SSE2__)
+	for (i = 0; i < LOCALE_SET_BITMAP_WORDS; i += 2) {
+		__m128i va, vb, vr;
+		va = _mm_loadu_si128((const __m128i*)(a + i));
+		vb = _mm_loadu_si128((const __m128i*)(b + i));
+		vr = unite ? _mm_or_si128(va, vb) : _mm_and_si128(va, vb);
+		_mm_storeu_si128((__m128i*)(result + i), vr);
+		count += CountLocaleSetBits(result[i]) + CountLocaleSetBits(result[i + 1]);
+	}
+#else
+	for (i = 0; i < LOCALE_SET_BITMAP_WORDS; i++) {
+		result[i] = unite ? a[i] | b[i] : a[i] & b[i];
+		count += CountLocaleSetBits(result[i]);
+	}
+#endif
+	return count;
+}
+
+/*
+ * Stores the intersection or the union of two LocaleSets in another LocaleSet (whose previous IDs are discarded).
+ * result must not be a nor b.
+ * Returns 0 in case of out-of-memory problems, 1 otherwise.
+ */
+static int CombineLocaleSets(LocaleSet* result, const LocaleSet* a, const LocaleSet* b, int unite)
+{
+	const LocaleSet* swap;
+	size_t i, j;
+	FreeLocaleSet(result);
+	if (!a->bitmap && b->bitmap) {
+		swap = a;
+		a = b;
+		b = swap;
+	}
+	if (a->bitmap && b->bitmap) {
+		result->bitmap = (uint64_t*)LocaleAllocate(result->allocator, LOCALE_SET_BITMAP_WORDS * sizeof(uint64_t));
+		if (!result->bitmap) {
+			return 0;
+		}
+		result->count = CombineLocaleSetBitmaps(result->bitmap, a->bitmap, b->bitmap, unite);
+		return CompactLocaleSet(result);
+	}
+	if (a->bitmap) {
+		/* a is a bitmap, b is an array */
+		if (unite) {
+			result->bitmap = (uint64_t*)LocaleAllocate(result->allocator, LOCALE_SET_BITMAP_WORDS * sizeof(uint64_t));
+			if (!result->bitmap) {
+				return 0;
+			}
+			memcpy(result->bitmap, a->bitmap, LOCALE_SET_BITMAP_WORDS * sizeof(uint64_t));
+			result->count = a->count;
+			for (i = 0; i < b->count; i++) {
+				AddToLocaleSet(result, b->ids[i]);
+			}
+			return 1;
+		}
+		if (!ReserveLocaleSet(result, b->count)) {
+			return 0;
+		}
+		for (i = 0; i < b->count; i++) {
+			if ((a->bitmap[b->ids[i] >> 6] >> (b->ids[i] & 63)) & 1) {
+				result->ids[result->count++] = b->ids[i];
+			}
+		}
+		return 1;
+	}
+	/* Both a and b are arrays: merge them (without SSE2, since the branches of a merge depend on every comparison) */
+	if (!ReserveLocaleSet(result, unite ? a->count + b->count : (a->count < b->count ? a->count : b->count))) {
+		return 0;
+	}
+	for (i = 0, j = 0; i < a->count && j < b->count;) {
+		if (a->ids[i] == b->ids[j]) {
+			result->ids[result->count++] = a->ids[i];
+			i++;
+			j++;
+		} else if (a->ids[i] < b->ids[j]) {
+			if (unite) {
+				result->ids[result->count++] = a->ids[i];
+			}
+			i++;
+		} else {
+			if (unite) {
+				result->ids[result->count++] = b->ids[j];
+			}
+			j++;
+		}
+	}
+	if (unite) {
+		for (; i < a->count; i++) {
+			result->ids[result->count++] = a->ids[i];
+		}
+		for (; j < b->count; j++) {
+			result->ids[result->count++] = b->ids[j];
+		}
+		if (result->count > LOCALE_SET_ARRAY_MAX_COUNT) {
+			return ConvertLocaleSetToBitmap(result);
+		}
+	}
+	return 1;
+}
+
+/*
+ * Stores the intersection of two LocaleSets in another LocaleSet (whose previous IDs are discarded).
+ * result must not be a nor b.
+ * Returns 0 in case of out-of-memory problems, 1 otherwise.
+ */
+int IntersectLocaleSets(LocaleSet* result, const LocaleSet* a, const LocaleSet* b)
+{
+	return CombineLocaleSets(result, a, b, 0);
+}
+
+/*
+ * Stores the union of two LocaleSets in another LocaleSet (whose previous IDs are discarded).
+ * result must not be a nor b.
+ * Returns 0 in case of out-of-memory problems, 1 otherwise.
+ */
+int UniteLocaleSets(LocaleSet* result, const LocaleSet* a, const LocaleSet* b)
+{
+	return CombineLocaleSets(result, a, b, 1);
+}
+
+/*
+ * JSON Lines export of parsed locale identifiers: for every identifier, a line like
+ * {"input":"sr@latin","valid":true,"root":false,"language":"sr","territory":null,"codeset":null,"modifier":"latin","script":null,"variants":[],"extensions":null,"gettext":"sr@latin","unicode":"sr_Latn"}
+ * The lines are written to a buffer, which is passed to a callback every time it's full.
+ * Compile with -DLOCALE_PTHREADS (and -pthread) to convert lists of identifiers with more threads, keeping the order of the output.
+ */
+
+/*
+ * Receives the data written to the buffer of a LocaleJSONLinesWriter.
+ */
+typedef void (*LocaleJSONLinesFlush)(void* userData, const char* data, size_t length);
+
+typedef struct _LocaleJSONLinesWriter {
+	char* buffer;
+	size_t size;
+	size_t used;
+	LocaleJSONLinesFlush flush;
+	void* userData;
+} LocaleJSONLinesWriter;
+
+/*
+ * Initializes a LocaleJSONLinesWriter that writes to a buffer (of size bytes, the bigger the better), calling flush when it's full.
+ */
+void InitLocaleJSONLinesWriter(LocaleJSONLinesWriter* writer, char* buffer, size_t size, LocaleJSONLinesFlush flush, void* userData)
+{
+	writer->buffer = buffer;
+	writer->size = size;
+	writer->used = 0;
+	writer->flush = flush;
+	writer->userData = userData;
+}
+
+/*
+ * Passes the data of the buffer of a LocaleJSONLinesWriter to its callback.
+ */
+void FlushLocaleJSONLinesWriter(LocaleJSONLinesWriter* writer)
+{
+	if (writer->used) {
+		writer->flush(writer->userData, writer->buffer, writer->used);
+		writer->used = 0;
+	}
+}
+
+/*
+ * Makes sure that the buffer of a LocaleJSONLinesWriter has room for some bytes (if it's big enough).
+ * Returns 1 if there's room, 0 otherwise (the buffer has been flushed, but it's too small).
+ */
+static int ReserveLocaleJSONLines(LocaleJSONLinesWriter* writer, size_t length)
+{
+	if (writer->size - writer->used >= length) {
+		return 1;
+	}
+	FlushLocaleJSONLinesWriter(writer);
+	return writer->size >= length;
+}
+
+/*
+ * Writes raw data to a LocaleJSONLinesWriter.
+ */
+static void WriteLocaleJSONLinesData(LocaleJSONLinesWriter* writer, const char* data, size_t length)
+{
+	if (!length) {
+		return;
+	}
+	if (ReserveLocaleJSONLines(writer, length)) {
+		memcpy(writer->buffer + writer->used, data, length);
+		writer->used += length;
+	} else {
+		writer->flush(writer->userData, data, length);
+	}
+}
+
+/*
+ * Writes a JSON string that can contain any byte: quotes, backslashes and control characters are escaped,
+ * and the bytes that are not ASCII are written as \u00XX (as if they were Latin-1), so that the output is always valid UTF-8.
+ */
+static void WriteLocaleJSONLinesEscapedString(LocaleJSONLinesWriter* writer, const char* s, size_t length)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	char escaped[6];
+	unsigned char c;
+	size_t i, start;
+	WriteLocaleJSONLinesData(writer, "\"", 1);
+	for (i = 0, start = 0; i < length; i++) {
+		c = (unsigned char)s[i];
+		if (c >= 0x20 && c < 0x7f && c != '"' && c != '\\') {
+			continue;
+		}
+		WriteLocaleJSONLinesData(writer, s + start, i - start);
+		escaped[0] = '\\';
+		escaped[1] = 'u';
+		escaped[2] = '0';
+		escaped[3] = '0';
+		escaped[4] = hexDigits[c >> 4];
+		escaped[5] = hexDigits[c & 0xf];
+		if (c == '"' || c == '\\') {
+			escaped[1] = (char)c;
+			WriteLocaleJSONLinesData(writer, escaped, 2);
+		} else {
+			WriteLocaleJSONLinesData(writer, escaped, 6);
+		}
+		start = i + 1;
+	}
+	WriteLocaleJSONLinesData(writer, s + start, length - start);
+	WriteLocaleJSONLinesData(writer, "\"", 1);
+}
+
+/*
+ * Writes a field whose value is an ASCII string without characters to be escaped (like the chunks of the valid identifiers), or null if it's empty.
+ * name includes the separator, the quotes and the colon (for example ",\"language\":").
+ */
+static void WriteLocaleJSONLinesField(LocaleJSONLinesWriter* writer, const char* name, const char* value, size_t length)
+{
+	size_t nameLength;
+	char* p;
+	nameLength = strlen(name);
+	if (!ReserveLocaleJSONLines(writer, nameLength + (length ? length + 2 : 4))) {
+		/* Only for tiny buffers */
+		WriteLocaleJSONLinesData(writer, name, nameLength);
+		if (length) {
+			WriteLocaleJSONLinesEscapedString(writer, value, length);
+		} else {
+			WriteLocaleJSONLinesData(writer, "null", 4);
+		}
+		return;
+	}
+	p = writer->buffer + writer->used;
+	memcpy(p, name, nameLength);
+	p += nameLength;
+	if (length) {
+		*p++ = '"';
+		memcpy(p, value, length);
+		p += length;
+		*p++ = '"';
+	} else {
+		memcpy(p, "null", 4);
+		p += 4;
+	}
+	writer->used = (size_t)(p - writer->buffer);
+}
+
+/*
+ * Writes the JSON line of a locale identifier, trying the formats specified by LOCALE_STREAM_INPUT_... flags
+ * within the limits of a context (NULL for the default one): the identifiers that exceed them are not valid.
+ * locale doesn't need to be null-terminated, and nothing is allocated.
+ */
+void WriteLocaleIDJSONLine(LocaleJSONLinesWriter* writer, const char* locale, size_t length, unsigned int inputFormats, LocaleContext* context)
+{
+	LocaleChunkSlices slices;
+	char gettextID[LOCALE_ID_MAX_LENGTH], unicodeID[LOCALE_ID_MAX_LENGTH];
+	const char *p, *end, *variant;
+	size_t gettextLength, unicodeLength;
+	int valid;
+	WriteLocaleJSONLinesData(writer, "{\"input\":", 9);
+	WriteLocaleJSONLinesEscapedString(writer, locale, length);
+	valid = ScanLocaleIDInContext(context, locale, length, inputFormats, &slices);
+	if (!valid) {
+		WriteLocaleJSONLinesData(writer, ",\"valid\":false}\n", 16);
+		return;
+	}
+	gettextLength = FormatLocaleChunkSlices(&slices, LOCALE_FORMAT_GETTEXT | LOCALE_FORMAT_CANONICAL_CASE, gettextID, sizeof(gettextID));
+	unicodeLength = FormatLocaleChunkSlices(&slices, LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE, unicodeID, sizeof(unicodeID));
+	WriteLocaleJSONLinesData(writer, slices.isRoot ? ",\"valid\":true,\"root\":true" : ",\"valid\":true,\"root\":false", slices.isRoot ? 25 : 26);
+	WriteLocaleJSONLinesField(writer, ",\"language\":", slices.language.start, slices.language.length);
+	WriteLocaleJSONLinesField(writer, ",\"territory\":", slices.territory.start, slices.territory.length);
+	WriteLocaleJSONLinesField(writer, ",\"codeset\":", slices.codeset.start, slices.codeset.length);
+	WriteLocaleJSONLinesField(writer, ",\"modifier\":", slices.modifier.start, slices.modifier.length);
+	WriteLocaleJSONLinesField(writer, ",\"script\":", slices.script.start, slices.script.length);
+	WriteLocaleJSONLinesData(writer, ",\"variants\":[", 13);
+	if (slices.variantCount) {
+		end = slices.variants.start + slices.variants.length;
+		for (variant = p = slices.variants.start; p <= end; p++) {
+			if (p == end || IsLocaleIDTagSeparator(*p)) {
+				WriteLocaleJSONLinesField(writer, variant == slices.variants.start ? "" : ",", variant, (size_t)(p - variant));
+				variant = p + 1;
+			}
+		}
+	}
+	WriteLocaleJSONLinesData(writer, "]", 1);
+	WriteLocaleJSONLinesField(writer, ",\"extensions\":", slices.extensions.start, slices.extensions.length);
+	WriteLocaleJSONLinesField(writer, ",\"gettext\":", gettextID, gettextLength < sizeof(gettextID) ? gettextLength : 0);
+	WriteLocaleJSONLinesField(writer, ",\"unicode\":", unicodeID, unicodeLength < sizeof(unicodeID) ? unicodeLength : 0);
+	WriteLocaleJSONLinesData(writer, "}\n", 2);
+}
+
+#ifdef LOCALE_PTHREADS
+
+/*
+ * Upper bound of the length of the JSON line of an identifier of length bytes:
+ * the input is escaped in up to 6 bytes per character, the chunks and the variants are slices of it,
+ * and the Gettext and Unicode identifiers are shorter than LOCALE_ID_MAX_LENGTH.
+ */
+static size_t MaxLocaleIDJSONLineLength(size_t length)
+{
+	return 9 * length + 2 * LOCALE_ID_MAX_LENGTH + 256;
+}
+
+/*
+ * Number of identifiers converted by every thread of ExportLocaleIDsToJSONLines in a round.
+ */
+#define LOCALE_JSON_LINES_ROUND_SIZE 512
+
+/*
+ * Size of the buffer where every thread of ExportLocaleIDsToJSONLines writes the lines of a round.
+ */
+#define LOCALE_JSON_LINES_TASK_BUFFER_SIZE (1 << 18)
+
+/*
+ * The work of a thread of ExportLocaleIDsToJSONLines in a round: its lines are written to a fixed buffer,
+ * stopping at the first identifier whose line could not fit (the rest of the round is converted by the calling thread).
+ * Since contexts are not thread-safe, every thread scans with its own copy of the limits of the context, whose statistics are added to the context at the end.
+ */
+typedef struct _LocaleJSONLinesTask {
+	const char* const* locales;
+	size_t count;
+	unsigned int inputFormats;
+	LocaleContext context;
+	/* Number of identifiers whose lines are in buffer */
+	size_t written;
+	size_t length;
+	char buffer[LOCALE_JSON_LINES_TASK_BUFFER_SIZE];
+} LocaleJSONLinesTask;
+
+/*
+ * The flush callback of the writers of the threads: it's never called, because the room for every line is checked before writing it.
+ */
+static void OverflowLocaleJSONLinesTask(void* userData, const char* data, size_t length)
+{
+	(void)userData;
+	(void)data;
+	(void)length;
+}
+
+static void* RunLocaleJSONLinesTask(void* userData)
+{
+	LocaleJSONLinesTask* task;
+	LocaleJSONLinesWriter writer;
+	size_t i, length;
+	task = (LocaleJSONLinesTask*)userData;
+	InitLocaleJSONLinesWriter(&writer, task->buffer, sizeof(task->buffer), OverflowLocaleJSONLinesTask, task);
+	for (i = 0; i < task->count; i++) {
+		length = strlen(task->locales[i]);
+		if (writer.size - writer.used < MaxLocaleIDJSONLineLength(length)) {
+			break;
+		}
+		WriteLocaleIDJSONLine(&writer, task->locales[i], length, task->inputFormats, &task->context);
+	}
+	task->written = i;
+	task->length = writer.used;
+	return NULL;
+}
+
+#endif
+
+/*
+ * Writes the JSON lines of a list of null-terminated locale identifiers, trying the formats specified by LOCALE_STREAM_INPUT_... flags, and flushes the writer.
+ * The identifiers are scanned within the limits of a context (NULL for the default one): the ones that exceed them are not valid.
+ * If threadCount is greater than 1 (and the code has been compiled with LOCALE_PTHREADS), the list is converted in rounds of
+ * LOCALE_JSON_LINES_ROUND_SIZE identifiers per thread, each one with a fixed buffer allocated with the hooks of the context:
+ * the lines of every round are written in the order of the list, and the writer is flushed, before starting the next round.
+ * If a thread can't be started, its part of the round is converted by the calling thread.
+ * Returns 0 in case of out-of-memory problems (nothing is written), 1 otherwise.
+ */
+int ExportLocaleIDsToJSONLines(LocaleJSONLinesWriter* writer, const char* const* locales, size_t count, unsigned int inputFormats, unsigned int threadCount, LocaleContext* context)
+{
+	size_t i;
+#ifdef LOCALE_PTHREADS
+	const LocaleAllocator* allocator;
+	LocaleJSONLinesTask* tasks;
+	pthread_t* threads;
+	unsigned char* started;
+	unsigned int t, taskCount;
+	size_t round;
+	if (threadCount > 1 && count > LOCALE_JSON_LINES_ROUND_SIZE) {
+		if (!context) {
+			context = &DefaultLocaleContext;
+		}
+		allocator = context->allocator;
+		tasks = (LocaleJSONLinesTask*)LocaleAllocate(allocator, threadCount * sizeof(LocaleJSONLinesTask));
+		threads = (pthread_t*)LocaleAllocate(allocator, threadCount * sizeof(pthread_t));
+		started = (unsigned char*)LocaleAllocate(allocator, threadCount);
+		if (!tasks || !threads || !started) {
+			LocaleRelease(allocator, tasks);
+			LocaleRelease(allocator, threads);
+			LocaleRelease(allocator, started);
+			return 0;
+		}
+		for (round = 0; round < count; round += taskCount * LOCALE_JSON_LINES_ROUND_SIZE) {
+			taskCount = (unsigned int)((count - round + LOCALE_JSON_LINES_ROUND_SIZE - 1) / LOCALE_JSON_LINES_ROUND_SIZE);
+			if (taskCount > threadCount) {
+				taskCount = threadCount;
+			}
+			for (t = 0; t < taskCount; t++) {
+				tasks[t].locales = locales + round + (size_t)t * LOCALE_JSON_LINES_ROUND_SIZE;
+				tasks[t].count = count - round - (size_t)t * LOCALE_JSON_LINES_ROUND_SIZE;
+				if (tasks[t].count > LOCALE_JSON_LINES_ROUND_SIZE) {
+					tasks[t].count = LOCALE_JSON_LINES_ROUND_SIZE;
+				}
+				tasks[t].inputFormats = inputFormats;
+				InitLocaleContext(&tasks[t].context, allocator, context->flags | LOCALE_CONTEXT_NO_CACHE);
+				tasks[t].context.maxLength = context->maxLength;
+				tasks[t].context.maxVariants = context->maxVariants;
+				started[t] = !pthread_create(&threads[t], NULL, RunLocaleJSONLinesTask, &tasks[t]);
+				if (!started[t]) {
+					RunLocaleJSONLinesTask(&tasks[t]);
+				}
+			}
+			for (t = 0; t < taskCount; t++) {
+				if (started[t]) {
+					pthread_join(threads[t], NULL);
+				}
+				WriteLocaleJSONLinesData(writer, tasks[t].buffer, tasks[t].length);
+				for (i = tasks[t].written; i < tasks[t].count; i++) {
+					WriteLocaleIDJSONLine(writer, tasks[t].locales[i], strlen(tasks[t].locales[i]), inputFormats, context);
+				}
+				if (!(context->flags & LOCALE_CONTEXT_NO_STATS)) {
+					context->stats.scanned += tasks[t].context.stats.scanned;
+					context->stats.rejected += tasks[t].context.stats.rejected;
+				}
+			}
+			FlushLocaleJSONLinesWriter(writer);
+		}
+		LocaleRelease(allocator, tasks);
+		LocaleRelease(allocator, threads);
+		LocaleRelease(allocator, started);
+		return 1;
+	}
+#else
+	(void)threadCount;
+#endif
+	for (i = 0; i < count; i++) {
+		WriteLocaleIDJSONLine(writer, locales[i], strlen(locales[i]), inputFormats, context);
+	}
+	FlushLocaleJSONLinesWriter(writer);
+	return 1;
+}
+
+/*
+ * Routing of URL paths by locale prefix (like "/it-it/page" or "/pt_BR/page"): the configured identifiers are compiled into a DFA,
+ * that matches the first segment of a path in one pass, ignoring the case and the difference between hyphens and underscores.
+ */
+
+/*
+ * Number of character classes of a LocaleRouter (0 is for the characters that can't be part of a locale prefix).
+ */
+#define LOCALE_ROUTER_CLASS_COUNT 40
+
+/*
+ * Maximum number of states of a LocaleRouter.
+ */
+#define LOCALE_ROUTER_MAX_STATES 65535
+
+/*
+ * Result of RouteLocalePath when the first segment of a path is not a configured locale.
+ */
+#define LOCALE_ROUTER_NO_MATCH -1
+
+/*
+ * Character classes of a LocaleRouter: the letters are case-insensitive, hyphens are the same as underscores.
+ */
+static const unsigned char LocaleRouterCharClasses[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 37, 38, 0,
+	27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 0, 0, 0, 0, 0, 0,
+	39, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 0, 0, 0, 0, 37,
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+typedef struct _LocaleRouter {
+	/* Transitions of the states, indexed by character class (0 means no transition: state 0 is the initial one) */
+	uint16_t (*transitions)[LOCALE_ROUTER_CLASS_COUNT];
+	/* The ID of the locale matched by every state, plus one (0 for the states that don't match anything) */
+	uint16_t* ids;
+	size_t stateCount;
+	/* Number of configured locales: their IDs go from 0 to localeCount - 1 */
+	size_t localeCount;
+	const LocaleAllocator* allocator;
+} LocaleRouter;
+
+/*
+ * Collects the spellings of a scanned locale identifier accepted by a LocaleRouter: the identifier itself, and its Gettext, Unicode and BCP 47 forms.
+ * Returns the number of spellings (0 if they are all too long).
+ */
+static size_t GetLocaleRouterSpellings(const char* locale, size_t length, const LocaleChunkSlices* slices, char spellings[4][LOCALE_ID_MAX_LENGTH], size_t lengths[4])
+{
+	static const unsigned int formats[3] = {LOCALE_FORMAT_GETTEXT, LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_BCP47};
+	size_t count, i;
+	count = 0;
+	if (length < LOCALE_ID_MAX_LENGTH) {
+		memcpy(spellings[count], locale, length);
+		lengths[count++] = length;
+	}
+	for (i = 0; i < 3; i++) {
+		length = FormatLocaleChunkSlices(slices, formats[i], spellings[count], LOCALE_ID_MAX_LENGTH);
+		if (length > 0 && length < LOCALE_ID_MAX_LENGTH) {
+			lengths[count++] = length;
+		}
+	}
+	return count;
+}
+
+/*
+ * Adds a spelling of a locale identifier to a LocaleRouter (whose states have been allocated).
+ * Spellings with characters that can't be part of a locale prefix are ignored, and the first locale added with a spelling wins.
+ */
+static void AddLocaleRouterSpelling(LocaleRouter* router, const char* spelling, size_t length, size_t id)
+{
+	size_t state, i;
+	for (i = 0; i < length; i++) {
+		if (!LocaleRouterCharClasses[(unsigned char)spelling[i]]) {
+			return;
+		}
+	}
+	for (i = 0, state = 0; i < length; i++) {
+		if (!router->transitions[state][LocaleRouterCharClasses[(unsigned char)spelling[i]]]) {
+			router->transitions[state][LocaleRouterCharClasses[(unsigned char)spelling[i]]] = (uint16_t)router->stateCount++;
+		}
+		state = router->transitions[state][LocaleRouterCharClasses[(unsigned char)spelling[i]]];
+	}
+	if (!router->ids[state]) {
+		router->ids[state] = (uint16_t)(id + 1);
+	}
+}
+
+/*
+ * Frees the memory used by a LocaleRouter (but not the LocaleRouter itself).
+ */
+void FreeLocaleRouter(LocaleRouter* router)
+{
+	LocaleRelease(router->allocator, router->transitions);
+	LocaleRelease(router->allocator, router->ids);
+	router->transitions = NULL;
+	router->ids = NULL;
+	router->stateCount = 0;
+}
+
+/*
+ * Compiles a list of null-terminated locale identifiers (in the formats specified by LOCALE_STREAM_INPUT_... flags) into a LocaleRouter.
+ * The ID of every locale is its index in the list: the spellings of a locale are the identifier itself and its Gettext, Unicode and BCP 47 forms.
+ * The identifiers are scanned within the limits of a context, and the memory is allocated with its hooks (NULL for the default context): free it with FreeLocaleRouter.
+ * Returns 0 if an identifier is not valid (or exceeds the limits of the context), if there are too many identifiers, or in case of out-of-memory problems, 1 otherwise.
+ */
+int CompileLocaleRouter(LocaleRouter* router, const char* const* locales, size_t count, unsigned int inputFormats, LocaleContext* context)
+{
+	char spellings[4][LOCALE_ID_MAX_LENGTH];
+	LocaleChunkSlices slices;
+	size_t lengths[4], spellingCount, maxStates, i, j;
+	router->transitions = NULL;
+	router->ids = NULL;
+	router->stateCount = 1;
+	router->localeCount = count;
+	router->allocator = context ? context->allocator : NULL;
+	/* Every character of every spelling adds at most one state */
+	for (i = 0, maxStates = 1; i < count; i++) {
+		if (!ScanLocaleIDInContext(context, locales[i], strlen(locales[i]), inputFormats, &slices)) {
+			return 0;
+		}
+		spellingCount = GetLocaleRouterSpellings(locales[i], strlen(locales[i]), &slices, spellings, lengths);
+		if (!spellingCount) {
+			return 0;
+		}
+		for (j = 0; j < spellingCount; j++) {
+			maxStates += lengths[j];
+		}
+	}
+	if (count >= LOCALE_ROUTER_MAX_STATES || maxStates > LOCALE_ROUTER_MAX_STATES) {
+		return 0;
+	}
+	router->transitions = (uint16_t(*)[LOCALE_ROUTER_CLASS_COUNT])LocaleAllocate(router->allocator, maxStates * sizeof(router->transitions[0]));
+	router->ids = (uint16_t*)LocaleAllocate(router->allocator, maxStates * sizeof(uint16_t));
+	if (!router->transitions || !router->ids) {
+		FreeLocaleRouter(router);
+		return 0;
+	}
+	memset(router->transitions, 0, maxStates * sizeof(router->transitions[0]));
+	memset(router->ids, 0, maxStates * sizeof(uint16_t));
+	/* The identifiers have already been checked against the limits of the context */
+	for (i = 0; i < count; i++) {
+		ScanLocaleIDInFormats(locales[i], strlen(locales[i]), inputFormats, &slices);
+		spellingCount = GetLocaleRouterSpellings(locales[i], strlen(locales[i]), &slices, spellings, lengths);
+		for (j = 0; j < spellingCount; j++) {
+			AddLocaleRouterSpelling(router, spellings[j], lengths[j], i);
+		}
+	}
+	return 1;
+}
+
+/*
+ * Matches the first segment of a URL path (with or without the leading slash) against the locales of a LocaleRouter.
+ * The segment ends at the next slash, question mark or hash sign (or at the end of the path); nothing is allocated.
+ * Returns the ID of the matched locale, storing in rest (if not NULL) the remaining part of the path (starting with its separator),
+ * or LOCALE_ROUTER_NO_MATCH (storing the whole path in rest).
+ */
+int RouteLocalePath(const LocaleRouter* router, const char* path, size_t length, const char** rest)
+{
+	const char *p, *end;
+	unsigned int state;
+	unsigned char c;
+	p = path;
+	end = path + length;
+	if (p < end && *p == '/') {
+		p++;
+	}
+	for (state = 0; p < end; p++) {
+		c = LocaleRouterCharClasses[(unsigned char)*p];
+		if (!c) {
+			if (*p == '/' || *p == '?' || *p == '#') {
+				break;
+			}
+			state = 0;
+			break;
+		}
+		state = router->transitions[state][c];
+		if (!state) {
+			break;
+		}
+	}
+	if (!state || !router->ids[state]) {
+		if (rest) {
+			*rest = path;
+		}
+		return LOCALE_ROUTER_NO_MATCH;
+	}
+	if (rest) {
+		*rest = p;
+	}
+	return (int)router->ids[state] - 1;
+}
+
+/*
+ * CLDR cardinal plural rules, compiled to a bytecode (generated from the CLDR data of Babel 2.18 by tools/generate-plural-rules.py).
+ * The code of every category is a header word (the category in the low byte, the number of words of the condition in the other bytes)
+ * followed by the condition: a sequence of relations, each one a header word (LOCALE_PLURAL_RELATION_... bits) followed by
+ * the modulus (if any) and by the pairs of bounds of its ranges.
+ * A condition matches if all the relations of a group (terminated by LOCALE_PLURAL_RELATION_END_OF_GROUP) match.
+ */
+
+/*
+ * Plural categories.
+ */
+#define LOCALE_PLURAL_ZERO 0
+#define LOCALE_PLURAL_ONE 1
+#define LOCALE_PLURAL_TWO 2
+#define LOCALE_PLURAL_FEW 3
+#define LOCALE_PLURAL_MANY 4
+#define LOCALE_PLURAL_OTHER 5
+
+/*
+ * Bits of the header word of a relation: operand (1 to 7 for n, i, v, w, f, t and e), negation ("not in"),
+ * presence of the modulus, end of a group of relations joined by "and", number of ranges.
+ */
+#define LOCALE_PLURAL_RELATION_OPERAND 0x07
+#define LOCALE_PLURAL_RELATION_NOT 0x08
+#define LOCALE_PLURAL_RELATION_MODULUS 0x10
+#define LOCALE_PLURAL_RELATION_END_OF_GROUP 0x20
+#define LOCALE_PLURAL_RELATION_RANGES_SHIFT 8
+
+/*
+ * The n operand of a relation.
+ */
+#define LOCALE_PLURAL_OPERAND_N 1
+
+/*
+ * Bytecode of the CLDR cardinal plural rules (see SelectLocalePluralCategory), indexed by LocalePluralRuleOffsets.
+ */
+static const uint32_t LocalePluralCode[] = {
+	/* 1: one: n in 1 */
+	0x301, 0x121, 1, 1,
+	/* 2: one: n in 0..1 */
+	0x301, 0x121, 0, 1,
+	/* 3: one: i in 0 or n in 1 */
+	0x601, 0x122, 0, 0, 0x121, 1, 1,
+	/* 4: zero: n in 0; one: n in 1; two: n in 2; few: n mod 100 in 3..10; many: n mod 100 in 11..99 */
+	0x300, 0x121, 0, 0,
+	0x301, 0x121, 1, 1,
+	0x302, 0x121, 2, 2,
+	0x403, 0x131, 100, 3, 10,
+	0x404, 0x131, 100, 11, 99,
+	/* 5: one: i in 1 and v in 0 */
+	0x601, 0x102, 1, 1, 0x123, 0, 0,
+	/* 6: one: n mod 10 in 1 and n mod 100 not in 11; few: n mod 10 in 2..4 and n mod 100 not in 12..14; many: n mod 10 in 0 or n mod 10 in 5..9 or n mod 100 in 11..14 */
+	0x801, 0x111, 10, 1, 1, 0x139, 100, 11, 11,
+	0x803, 0x111, 10, 2, 4, 0x139, 100, 12, 14,
+	0xc04, 0x131, 10, 0, 0, 0x131, 10, 5, 9, 0x131, 100, 11, 14,
+	/* 7: zero: n in 0; one: n in 1 */
+	0x300, 0x121, 0, 0,
+	0x301, 0x121, 1, 1,
+	/* 8: one: n mod 10 in 1 and n mod 100 not in 11,71,91; two: n mod 10 in 2 and n mod 100 not in 12,72,92; few: n mod 10 in 3..4,9 and n mod 100 not in 10..19,70..79,90..99; many: n not in 0 and n mod 1000000 in 0 */
+	0xc01, 0x111, 10, 1, 1, 0x339, 100, 11, 11, 71, 71, 91, 91,
+	0xc02, 0x111, 10, 2, 2, 0x339, 100, 12, 12, 72, 72, 92, 92,
+	0xe03, 0x211, 10, 3, 4, 9, 9, 0x339, 100, 10, 19, 70, 79, 90, 99,
+	0x704, 0x109, 0, 0, 0x131, 1000000, 0, 0,
+	/* 9: one: v in 0 and i mod 10 in 1 and i mod 100 not in 11 or f mod 10 in 1 and f mod 100 not in 11; few: v in 0 and i mod 10 in 2..4 and i mod 100 not in 12..14 or f mod 10 in 2..4 and f mod 100 not in 12..14 */
+	0x1301, 0x103, 0, 0, 0x112, 10, 1, 1, 0x13a, 100, 11, 11, 0x115, 10, 1, 1, 0x13d, 100, 11, 11,
+	0x1303, 0x103, 0, 0, 0x112, 10, 2, 4, 0x13a, 100, 12, 14, 0x115, 10, 2, 4, 0x13d, 100, 12, 14,
+	/* 10: one: i in 1 and v in 0; many: e in 0 and i not in 0 and i mod 1000000 in 0 and v in 0 or e not in 0..5 */
+	0x601, 0x102, 1, 1, 0x123, 0, 0,
+	0x1004, 0x107, 0, 0, 0x10a, 0, 0, 0x112, 1000000, 0, 0, 0x123, 0, 0, 0x12f, 0, 5,
+	/* 11: one: v in 0 and i in 1,2,3 or v in 0 and i mod 10 not in 4,6,9 or v not in 0 and f mod 10 not in 4,6,9 */
+	0x2001, 0x103, 0, 0, 0x322, 1, 1, 2, 2, 3, 3, 0x103, 0, 0, 0x33a, 10, 4, 4, 6, 6, 9, 9, 0x10b, 0, 0, 0x33d, 10, 4, 4, 6, 6, 9, 9,
+	/* 12: one: i in 1 and v in 0; few: i in 2..4 and v in 0; many: v not in 0 */
+	0x601, 0x102, 1, 1, 0x123, 0, 0,
+	0x603, 0x102, 2, 4, 0x123, 0, 0,
+	0x304, 0x12b, 0, 0,
+	/* 13: zero: n in 0; one: n in 1; two: n in 2; few: n in 3; many: n in 6 */
+	0x300, 0x121, 0, 0,
+	0x301, 0x121, 1, 1,
+	0x302, 0x121, 2, 2,
+	0x303, 0x121, 3, 3,
+	0x304, 0x121, 6, 6,
+	/* 14: one: n in 1 or t not in 0 and i in 0,1 */
+	0xb01, 0x121, 1, 1, 0x10e, 0, 0, 0x222, 0, 0, 1, 1,
+	/* 15: one: v in 0 and i mod 100 in 1 or f mod 100 in 1; two: v in 0 and i mod 100 in 2 or f mod 100 in 2; few: v in 0 and i mod 100 in 3..4 or f mod 100 in 3..4 */
+	0xb01, 0x103, 0, 0, 0x132, 100, 1, 1, 0x135, 100, 1, 1,
+	0xb02, 0x103, 0, 0, 0x132, 100, 2, 2, 0x135, 100, 2, 2,
+	0xb03, 0x103, 0, 0, 0x132, 100, 3, 4, 0x135, 100, 3, 4,
+	/* 16: one: n in 1; many: e in 0 and i not in 0 and i mod 1000000 in 0 and v in 0 or e not in 0..5 */
+	0x301, 0x121, 1, 1,
+	0x1004, 0x107, 0, 0, 0x10a, 0, 0, 0x112, 1000000, 0, 0, 0x123, 0, 0, 0x12f, 0, 5,
+	/* 17: one: i in 0,1 */
+	0x501, 0x222, 0, 0, 1, 1,
+	/* 18: one: i in 0,1; many: e in 0 and i not in 0 and i mod 1000000 in 0 and v in 0 or e not in 0..5 */
+	0x501, 0x222, 0, 0, 1, 1,
+	0x1004, 0x107, 0, 0, 0x10a, 0, 0, 0x112, 1000000, 0, 0, 0x123, 0, 0, 0x12f, 0, 5,
+	/* 19: one: n in 1; two: n in 2; few: n in 3..6; many: n in 7..10 */
+	0x301, 0x121, 1, 1,
+	0x302, 0x121, 2, 2,
+	0x303, 0x121, 3, 6,
+	0x304, 0x121, 7, 10,
+	/* 20: one: n in 1,11; two: n in 2,12; few: n in 3..10,13..19 */
+	0x501, 0x221, 1, 1, 11, 11,
+	0x502, 0x221, 2, 2, 12, 12,
+	0x503, 0x221, 3, 10, 13, 19,
+	/* 21: one: v in 0 and i mod 10 in 1; two: v in 0 and i mod 10 in 2; few: v in 0 and i mod 100 in 0,20,40,60,80; many: v not in 0 */
+	0x701, 0x103, 0, 0, 0x132, 10, 1, 1,
+	0x702, 0x103, 0, 0, 0x132, 10, 2, 2,
+	0xf03, 0x103, 0, 0, 0x532, 100, 0, 0, 20, 20, 40, 40, 60, 60, 80, 80,
+	0x304, 0x12b, 0, 0,
+	/* 22: one: i in 1 and v in 0 or i in 0 and v not in 0; two: i in 2 and v in 0 */
+	0xc01, 0x102, 1, 1, 0x123, 0, 0, 0x102, 0, 0, 0x12b, 0, 0,
+	0x602, 0x102, 2, 2, 0x123, 0, 0,
+	/* 23: one: t in 0 and i mod 10 in 1 and i mod 100 not in 11 or t mod 10 in 1 and t mod 100 not in 11 */
+	0x1301, 0x106, 0, 0, 0x112, 10, 1, 1, 0x13a, 100, 11, 11, 0x116, 10, 1, 1, 0x13e, 100, 11, 11,
+	/* 24: one: n in 1; two: n in 2 */
+	0x301, 0x121, 1, 1,
+	0x302, 0x121, 2, 2,
+	/* 25: zero: n in 0; one: n in 1; two: n mod 100 in 2,22,42,62,82 or n mod 1000 in 0 and n mod 100000 in 1000..20000,40000,60000,80000 or n not in 0 and n mod 1000000 in 100000; few: n mod 100 in 3,23,43,63,83; many: n not in 1 and n mod 100 in 1,21,41,61,81 */
+	0x300, 0x121, 0, 0,
+	0x301, 0x121, 1, 1,
+	0x2102, 0x531, 100, 2, 2, 22, 22, 42, 42, 62, 62, 82, 82, 0x111, 1000, 0, 0, 0x431, 100000, 1000, 20000, 40000, 40000, 60000, 60000, 80000, 80000, 0x109, 0, 0, 0x131, 1000000, 100000, 100000,
+	0xc03, 0x531, 100, 3, 3, 23, 23, 43, 43, 63, 63, 83, 83,
+	0xf04, 0x109, 1, 1, 0x531, 100, 1, 1, 21, 21, 41, 41, 61, 61, 81, 81,
+	/* 26: zero: n in 0; one: i in 0,1 and n not in 0 */
+	0x300, 0x121, 0, 0,
+	0x801, 0x202, 0, 0, 1, 1, 0x129, 0, 0,
+	/* 27: one: n mod 10 in 1 and n mod 100 not in 11..19; few: n mod 10 in 2..9 and n mod 100 not in 11..19; many: f not in 0 */
+	0x801, 0x111, 10, 1, 1, 0x139, 100, 11, 19,
+	0x803, 0x111, 10, 2, 9, 0x139, 100, 11, 19,
+	0x304, 0x12d, 0, 0,
+	/* 28: zero: n mod 10 in 0 or n mod 100 in 11..19 or v in 2 and f mod 100 in 11..19; one: n mod 10 in 1 and n mod 100 not in 11 or v in 2 and f mod 10 in 1 and f mod 100 not in 11 or v not in 2 and f mod 10 in 1 */
+	0xf00, 0x131, 10, 0, 0, 0x131, 100, 11, 19, 0x103, 2, 2, 0x135, 100, 11, 19,
+	0x1a01, 0x111, 10, 1, 1, 0x139, 100, 11, 11, 0x103, 2, 2, 0x115, 10, 1, 1, 0x13d, 100, 11, 11, 0x10b, 2, 2, 0x135, 10, 1, 1,
+	/* 29: one: v in 0 and i mod 10 in 1 and i mod 100 not in 11 or f mod 10 in 1 and f mod 100 not in 11 */
+	0x1301, 0x103, 0, 0, 0x112, 10, 1, 1, 0x13a, 100, 11, 11, 0x115, 10, 1, 1, 0x13d, 100, 11, 11,
+	/* 30: one: n in 1; two: n in 2; few: n in 0 or n mod 100 in 3..10; many: n mod 100 in 11..19 */
+	0x301, 0x121, 1, 1,
+	0x302, 0x121, 2, 2,
+	0x703, 0x121, 0, 0, 0x131, 100, 3, 10,
+	0x404, 0x131, 100, 11, 19,
+	/* 31: one: i in 1 and v in 0; few: v in 0 and i mod 10 in 2..4 and i mod 100 not in 12..14; many: v in 0 and i not in 1 and i mod 10 in 0..1 or v in 0 and i mod 10 in 5..9 or v in 0 and i mod 100 in 12..14 */
+	0x601, 0x102, 1, 1, 0x123, 0, 0,
+	0xb03, 0x103, 0, 0, 0x112, 10, 2, 4, 0x13a, 100, 12, 14,
+	0x1804, 0x103, 0, 0, 0x10a, 1, 1, 0x132, 10, 0, 1, 0x103, 0, 0, 0x132, 10, 5, 9, 0x103, 0, 0, 0x132, 100, 12, 14,
+	/* 32: one: i in 0..1; many: e in 0 and i not in 0 and i mod 1000000 in 0 and v in 0 or e not in 0..5 */
+	0x301, 0x122, 0, 1,
+	0x1004, 0x107, 0, 0, 0x10a, 0, 0, 0x112, 1000000, 0, 0, 0x123, 0, 0, 0x12f, 0, 5,
+	/* 33: one: i in 1 and v in 0; few: v not in 0 or n in 0 or n not in 1 and n mod 100 in 1..19 */
+	0x601, 0x102, 1, 1, 0x123, 0, 0,
+	0xd03, 0x12b, 0, 0, 0x121, 0, 0, 0x109, 1, 1, 0x131, 100, 1, 19,
+	/* 34: one: v in 0 and i mod 10 in 1 and i mod 100 not in 11; few: v in 0 and i mod 10 in 2..4 and i mod 100 not in 12..14; many: v in 0 and i mod 10 in 0 or v in 0 and i mod 10 in 5..9 or v in 0 and i mod 100 in 11..14 */
+	0xb01, 0x103, 0, 0, 0x112, 10, 1, 1, 0x13a, 100, 11, 11,
+	0xb03, 0x103, 0, 0, 0x112, 10, 2, 4, 0x13a, 100, 12, 14,
+	0x1504, 0x103, 0, 0, 0x132, 10, 0, 0, 0x103, 0, 0, 0x132, 10, 5, 9, 0x103, 0, 0, 0x132, 100, 11, 14,
+	/* 35: one: i in 0 or n in 1; few: n in 2..10 */
+	0x601, 0x122, 0, 0, 0x121, 1, 1,
+	0x303, 0x121, 2, 10,
+	/* 36: one: n in 0,1 or i in 0 and f in 1 */
+	0xb01, 0x221, 0, 0, 1, 1, 0x102, 0, 0, 0x125, 1, 1,
+	/* 37: one: v in 0 and i mod 100 in 1; two: v in 0 and i mod 100 in 2; few: v in 0 and i mod 100 in 3..4 or v not in 0 */
+	0x701, 0x103, 0, 0, 0x132, 100, 1, 1,
+	0x702, 0x103, 0, 0, 0x132, 100, 2, 2,
+	0xa03, 0x103, 0, 0, 0x132, 100, 3, 4, 0x12b, 0, 0,
+	/* 38: one: n in 0..1 or n in 11..99 */
+	0x601, 0x121, 0, 1, 0x121, 11, 99
+};
+
+/*
+ * Offsets of the plural rules in LocalePluralCode (rules 0 are the ones of the root locale: everything is "other").
+ */
+static const uint16_t LocalePluralRuleOffsets[40] = {
+	0, 0, 4, 8, 15, 37, 44, 75, 83, 132, 172, 196, 229, 247, 267, 279,
+	315, 336, 342, 365, 381, 399, 435, 455, 475, 483, 554, 567, 589, 632, 652, 673,
+	717, 738, 759, 805, 816, 828, 855, 862
+};
+
+/*
+ * Sorted LocaleKeys of the languages (and of the language-territory pairs) with plural rules other than the root ones.
+ */
+static const LocaleKey LocalePluralKeys[189] = {
+	0x06cc000000000000ULL, 0x06d6000000000000ULL, 0x06da000000000000ULL, 0x06dc000000000000ULL,
+	0x06e4000000000000ULL, 0x06e6000000000000ULL, 0x06e6100000000000ULL, 0x06e7400000000000ULL,
+	0x06f4000000000000ULL, 0x0702c00000000000ULL, 0x070a000000000000ULL, 0x070ad00000000000ULL,
+	0x070ba00000000000ULL, 0x070e000000000000ULL, 0x0710f00000000000ULL, 0x0718f00000000000ULL,
+	0x071c000000000000ULL, 0x0724000000000000ULL, 0x0725800000000000ULL, 0x0726000000000000ULL,
+	0x0742000000000000ULL, 0x074a000000000000ULL, 0x074a200000000000ULL, 0x074e700000000000ULL,
+	0x0751200000000000ULL, 0x0756200000000000ULL, 0x0766000000000000ULL, 0x0767700000000000ULL,
+	0x0772000000000000ULL, 0x0782000000000000ULL, 0x078a000000000000ULL, 0x079e900000000000ULL,
+	0x07a6200000000000ULL, 0x07ac000000000000ULL, 0x07ca000000000000ULL, 0x07d8000000000000ULL,
+	0x07dc000000000000ULL, 0x07de000000000000ULL, 0x07e6000000000000ULL, 0x07e8000000000000ULL,
+	0x07ea000000000000ULL, 0x0802000000000000ULL, 0x080c000000000000ULL, 0x0812000000000000ULL,
+	0x0812c00000000000ULL, 0x081e000000000000ULL, 0x0824000000000000ULL, 0x082b200000000000ULL,
+	0x0832000000000000ULL, 0x0842000000000000ULL, 0x0848000000000000ULL, 0x0858000000000000ULL,
+	0x0867700000000000ULL, 0x086a000000000000ULL, 0x086c000000000000ULL, 0x0882000000000000ULL,
+	0x0883700000000000ULL, 0x088a000000000000ULL, 0x0892000000000000ULL, 0x08a4000000000000ULL,
+	0x08a6200000000000ULL, 0x08a8000000000000ULL, 0x08aa000000000000ULL, 0x08b2000000000000ULL,
+	0x08c2000000000000ULL, 0x08de000000000000ULL, 0x08e6000000000000ULL, 0x08e8000000000000ULL,
+	0x08ea000000000000ULL, 0x090ef00000000000ULL, 0x091a300000000000ULL, 0x0942000000000000ULL,
+	0x0942200000000000ULL, 0x0942a00000000000ULL, 0x0946700000000000ULL, 0x0956000000000000ULL,
+	0x0956a00000000000ULL, 0x0958000000000000ULL, 0x095c000000000000ULL, 0x0966000000000000ULL,
+	0x0966200000000000ULL, 0x0966800000000000ULL, 0x096a000000000000ULL, 0x096e000000000000ULL,
+	0x0972000000000000ULL, 0x0982700000000000ULL, 0x0984000000000000ULL, 0x098e000000000000ULL,
+	0x0992a00000000000ULL, 0x0998400000000000ULL, 0x099c000000000000ULL, 0x09a8000000000000ULL,
+	0x09ac000000000000ULL, 0x09c3300000000000ULL, 0x09ce000000000000ULL, 0x09cef00000000000ULL,
+	0x09d6000000000000ULL, 0x09d8000000000000ULL, 0x09dc000000000000ULL, 0x09e4000000000000ULL,
+	0x09e8000000000000ULL, 0x0a03100000000000ULL, 0x0a04000000000000ULL, 0x0a08000000000000ULL,
+	0x0a0a000000000000ULL, 0x0a18000000000000ULL, 0x0a1c000000000000ULL, 0x0a1c800000000000ULL,
+	0x0a1e000000000000ULL, 0x0a24000000000000ULL, 0x0a26f00000000000ULL, 0x0a32000000000000ULL,
+	0x0a32e00000000000ULL, 0x0a5a000000000000ULL, 0x0a64000000000000ULL, 0x0a66000000000000ULL,
+	0x0a82000000000000ULL, 0x0a83000000000000ULL, 0x0a86d00000000000ULL, 0x0a98000000000000ULL,
+	0x0aa4700000000000ULL, 0x0aa6000000000000ULL, 0x0aa8000000000000ULL, 0x0aa80016c8000000ULL,
+	0x0aa8001a90000000ULL, 0x0aa8001b00000000ULL, 0x0aa80022d8000000ULL, 0x0aa8002308000000ULL,
+	0x0aa8002cf8000000ULL, 0x0aa8002ec8000000ULL, 0x0aa8002f20000000ULL, 0x0aa80034f0000000ULL,
+	0x0aa8003af0000000ULL, 0x0aa8003cb0000000ULL, 0x0b1a000000000000ULL, 0x0b1e000000000000ULL,
+	0x0b1e600000000000ULL, 0x0b2a000000000000ULL, 0x0b2eb00000000000ULL, 0x0b43100000000000ULL,
+	0x0b43400000000000ULL, 0x0b46000000000000ULL, 0x0b46e00000000000ULL, 0x0b48000000000000ULL,
+	0x0b48800000000000ULL, 0x0b4a000000000000ULL, 0x0b4a800000000000ULL, 0x0b50900000000000ULL,
+	0x0b52000000000000ULL, 0x0b56000000000000ULL, 0x0b58000000000000ULL, 0x0b5a100000000000ULL,
+	0x0b5aa00000000000ULL, 0x0b5ae00000000000ULL, 0x0b5b300000000000ULL, 0x0b5c000000000000ULL,
+	0x0b5e000000000000ULL, 0x0b62000000000000ULL, 0x0b64000000000000ULL, 0x0b66000000000000ULL,
+	0x0b67900000000000ULL, 0x0b68000000000000ULL, 0x0b6c000000000000ULL, 0x0b6e000000000000ULL,
+	0x0b73200000000000ULL, 0x0b82000000000000ULL, 0x0b8a000000000000ULL, 0x0b8af00000000000ULL,
+	0x0b92000000000000ULL, 0x0b92700000000000ULL, 0x0b96000000000000ULL, 0x0b9c000000000000ULL,
+	0x0ba4000000000000ULL, 0x0ba6000000000000ULL, 0x0bb4d00000000000ULL, 0x0bce000000000000ULL,
+	0x0bd6000000000000ULL, 0x0be4000000000000ULL, 0x0bf4000000000000ULL, 0x0c0a000000000000ULL,
+	0x0c0a300000000000ULL, 0x0c1e000000000000ULL, 0x0c2ae00000000000ULL, 0x0c42000000000000ULL,
+	0x0c42500000000000ULL, 0x0c90000000000000ULL, 0x0c9e700000000000ULL, 0x0cd2000000000000ULL,
+	0x0d2a000000000000ULL
+};
+
+/*
+ * The plural rules of the LocalePluralKeys.
+ */
+static const unsigned char LocalePluralKeyRules[189] = {
+	1, 2, 3, 1, 4, 3, 1, 5, 1, 1, 6, 1, 1, 1, 2, 7, 3, 8, 1, 9, 10, 1, 11, 1,
+	1, 1, 12, 2, 13, 14, 5, 3, 15, 1, 1, 1, 5, 1, 16, 5, 1, 3, 17, 5, 11, 1, 18, 1,
+	5, 19, 20, 5, 1, 3, 21, 1, 1, 22, 3, 9, 15, 18, 1, 17, 5, 5, 23, 10, 24, 1, 1, 1,
+	17, 1, 1, 1, 1, 1, 3, 1, 1, 7, 1, 25, 1, 26, 1, 1, 5, 10, 2, 27, 28, 1, 2, 1,
+	29, 1, 1, 1, 30, 24, 1, 1, 1, 5, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 2, 1, 3, 31,
+	28, 1, 32, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 1, 33, 1, 34, 1, 1, 24, 5, 10, 1,
+	1, 24, 1, 35, 36, 12, 37, 24, 24, 24, 24, 1, 1, 1, 9, 1, 1, 1, 5, 5, 1, 1, 1, 1,
+	2, 1, 1, 1, 1, 1, 38, 1, 34, 5, 1, 1, 10, 1, 1, 2, 1, 1, 1, 5, 3
+};
+
+/*
+ * Number of the compiled plural rules.
+ */
+#define LOCALE_PLURAL_RULE_COUNT ((unsigned int)(sizeof(LocalePluralRuleOffsets) / sizeof(LocalePluralRuleOffsets[0]) - 1))
+
+/*
+ * The operands of a number used to select its plural category (see the CLDR specifications), for its absolute value.
+ */
+typedef struct _LocalePluralOperands {
+	/* Integer digits */
+	uint64_t i;
+	/* Visible fraction digits, with trailing zeros */
+	uint64_t f;
+	/* Visible fraction digits, without trailing zeros */
+	uint64_t t;
+	/* Number of visible fraction digits, with and without trailing zeros */
+	unsigned int v;
+	unsigned int w;
+	/* Exponent of the compact decimal notation (like 3 for "1.2c3") */
+	unsigned int e;
+} LocalePluralOperands;
+
+/*
+ * Initializes the LocalePluralOperands of an integer.
+ */
+void InitLocalePluralOperands(LocalePluralOperands* operands, uint64_t value)
+{
+	operands->i = value;
+	operands->f = 0;
+	operands->t = 0;
+	operands->v = 0;
+	operands->w = 0;
+	operands->e = 0;
+}
+
+/*
+ * Initializes the LocalePluralOperands of a decimal number, like "-1.50" or "1.2c3" (or "1.2e3"): the visible fraction digits matter.
+ * number doesn't need to be null-terminated.
+ * Returns 0 if number is not valid, or if it has more than 18 integer or fraction digits, 1 otherwise.
+ */
+int ParseLocalePluralOperands(LocalePluralOperands* operands, const char* number, size_t length)
+{
+	const char *p, *end, *fraction;
+	size_t fractionLength, i;
+	unsigned int e;
+	p = number;
+	end = number + length;
+	if (p < end && (*p == '-' || *p == '+')) {
+		p++;
+	}
+	if (p == end || !IsLocaleDigit(*p)) {
+		return 0;
+	}
+	InitLocalePluralOperands(operands, 0);
+	for (; p < end && IsLocaleDigit(*p); p++) {
+		if (operands->i >= 100000000000000000ULL) {
+			return 0;
+		}
+		operands->i = operands->i * 10 + (uint64_t)(*p - '0');
+	}
+	fraction = p;
+	if (p < end && *p == '.') {
+		fraction = ++p;
+		while (p < end && IsLocaleDigit(*p)) {
+			p++;
+		}
+		if (p == fraction) {
+			return 0;
+		}
+	}
+	fractionLength = (size_t)(p - fraction);
+	e = 0;
+	if (p < end && (*p == 'c' || *p == 'e')) {
+		if (++p == end) {
+			return 0;
+		}
+		for (; p < end && IsLocaleDigit(*p) && e <= 18; p++) {
+			e = e * 10 + (unsigned int)(*p - '0');
+		}
+	}
+	if (p != end || e > 18) {
+		return 0;
+	}
+	/* The exponent moves the fraction digits to the integer part */
+	for (i = 0; i < e; i++) {
+		if (operands->i >= 100000000000000000ULL) {
+			return 0;
+		}
+		operands->i = operands->i * 10 + (uint64_t)(i < fractionLength ? fraction[i] - '0' : 0);
+	}
+	operands->e = e;
+	for (i = e; i < fractionLength; i++) {
+		if (operands->v == 18) {
+			return 0;
+		}
+		operands->f = operands->f * 10 + (uint64_t)(fraction[i] - '0');
+		operands->v++;
+	}
+	operands->t = operands->f;
+	operands->w = operands->v;
+	while (operands->t && operands->t % 10 == 0) {
+		operands->t /= 10;
+		operands->w--;
+	}
+	if (!operands->t) {
+		operands->w = 0;
+	}
+	return 1;
+}
+
+/*
+ * Looks for the plural rules of a language, or of a language-territory pair, in LocalePluralKeys.
+ * Returns 0 (the root rules) if not found.
+ */
+static unsigned int FindLocalePluralRules(const LocaleSlice* language, const LocaleSlice* territory)
+{
+	LocaleChunkSlices slices;
+	LocaleKey key;
+	size_t low, high, middle;
+	memset(&slices, 0, sizeof(slices));
+	slices.language = *language;
+	if (territory) {
+		slices.territory = *territory;
+	}
+	key = LocaleChunkSlicesToLocaleKey(&slices);
+	low = 0;
+	high = sizeof(LocalePluralKeys) / sizeof(LocalePluralKeys[0]);
+	while (key && low < high) {
+		middle = (low + high) / 2;
+		if (LocalePluralKeys[middle] == key) {
+			return LocalePluralKeyRules[middle];
+		}
+		if (LocalePluralKeys[middle] < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Gets the plural rules of the language of a LocaleChunks (or of its language and territory, like for European Portuguese),
+ * to be used with SelectLocalePluralCategory.
+ * Returns 0 (the rules of the root locale, where everything is "other") for unknown languages.
+ */
+unsigned int GetLocaleChunksPluralRules(const LocaleChunks* lc)
+{
+	LocaleSlice language, territory;
+	unsigned int result;
+	if (!lc || lc->isRoot) {
+		return 0;
+	}
+	SetLocaleSlice(&language, lc->language);
+	SetLocaleSlice(&territory, lc->territory);
+	result = 0;
+	if (territory.length) {
+		result = FindLocalePluralRules(&language, &territory);
+	}
+	if (!result) {
+		result = FindLocalePluralRules(&language, NULL);
+	}
+	return result;
+}
+
+/*
+ * Selects the plural category (LOCALE_PLURAL_...) of a number, with the plural rules returned by GetLocaleChunksPluralRules.
+ */
+unsigned int SelectLocalePluralCategory(unsigned int rules, const LocalePluralOperands* operands)
+{
+	const uint32_t *code, *end, *conditionEnd;
+	uint64_t values[8], value;
+	uint32_t category, relation, ranges;
+	int match, group;
+	if (rules >= LOCALE_PLURAL_RULE_COUNT) {
+		return LOCALE_PLURAL_OTHER;
+	}
+	values[0] = 0;
+	values[LOCALE_PLURAL_OPERAND_N] = operands->i;
+	values[2] = operands->i;
+	values[3] = operands->v;
+	values[4] = operands->w;
+	values[5] = operands->f;
+	values[6] = operands->t;
+	values[7] = operands->e;
+	code = LocalePluralCode + LocalePluralRuleOffsets[rules];
+	end = LocalePluralCode + LocalePluralRuleOffsets[rules + 1];
+	while (code < end) {
+		category = *code & 0xff;
+		conditionEnd = code + 1 + (*code >> 8);
+		code++;
+		group = 1;
+		while (code < conditionEnd) {
+			relation = *code++;
+			value = values[relation & LOCALE_PLURAL_RELATION_OPERAND];
+			if (relation & LOCALE_PLURAL_RELATION_MODULUS) {
+				value %= *code++;
+			}
+			match = 0;
+			for (ranges = relation >> LOCALE_PLURAL_RELATION_RANGES_SHIFT; ranges; ranges--, code += 2) {
+				match |= value >= code[0] && value <= code[1];
+			}
+			/* Numbers with a fraction are never in the ranges of n */
+			if ((relation & LOCALE_PLURAL_RELATION_OPERAND) == LOCALE_PLURAL_OPERAND_N && operands->t) {
+				match = 0;
+			}
+			if (relation & LOCALE_PLURAL_RELATION_NOT) {
+				match = !match;
+			}
+			group &= match;
+			if (relation & LOCALE_PLURAL_RELATION_END_OF_GROUP) {
+				if (group) {
+					return category;
+				}
+				group = 1;
+			}
+		}
+	}
+	return LOCALE_PLURAL_OTHER;
+}
+
+/*
+ * Gets the CLDR name of a plural category ("zero", "one", "two", "few", "many" or "other").
+ */
+const char* GetLocalePluralCategoryName(unsigned int category)
+{
+	static const char* const names[] = {"zero", "one", "two", "few", "many", "other"};
+	return names[category <= LOCALE_PLURAL_OTHER ? category : LOCALE_PLURAL_OTHER];
+}
+
+/*
+ * Parsing of locale identifiers received in more pieces (for example split across network reads), in Unicode or in Gettext format.
+ * A LocaleIDParser scans the pieces as they arrive, keeping the state of both scanners (the chunk expected next, the chunks found so far, the formats that may still match)
+ * and ending every subtag as soon as its separator is received, so that the identifiers that can't be valid are rejected without waiting for the rest.
+ * The chunks point to the pieces, that are not copied: the pieces must stay valid (and unchanged) until the parser is finished.
+ * Only the subtags split across two pieces are copied to the spill buffer of the parser (together with the variants or the extensions they belong to,
+ * since those chunks must be contiguous).
+ */
+
+/*
+ * Chunks expected next by the Unicode scanner of a LocaleIDParser.
+ */
+#define LOCALE_ID_PARSER_LANGUAGE 0
+#define LOCALE_ID_PARSER_SCRIPT 1
+#define LOCALE_ID_PARSER_TERRITORY 2
+#define LOCALE_ID_PARSER_VARIANTS 3
+#define LOCALE_ID_PARSER_EXTENSIONS 4
+
+typedef struct _LocaleIDParser {
+	/* Formats (LOCALE_STREAM_INPUT_UNICODE and LOCALE_STREAM_INPUT_GETTEXT flags) that may still match what has been received */
+	unsigned int inputFormats;
+	/* Number of characters received */
+	size_t length;
+	/* The piece being scanned */
+	const char* piece;
+	/* The current subtag (in the piece being scanned, or in spill if it has been split), and its length so far */
+	const char* subtag;
+	size_t subtagLength;
+	int subtagSpilled;
+	/* The separator that precedes the current subtag ('\0' for the first one) */
+	char separator;
+	/* Unicode: the chunk expected next (LOCALE_ID_PARSER_...), the number of tags of the current extension, and whether it's the private use one */
+	int unicodeChunk;
+	int extensionTags;
+	int isPrivateExtension;
+	/* The chunks found so far by the two scanners */
+	LocaleChunkSlices unicode;
+	LocaleChunkSlices gettext;
+	/* The subtags split across pieces (preceded by their separator), and the variants and extensions that span more pieces: every character is copied at most twice */
+	char spill[2 * LOCALE_ID_MAX_LENGTH + 1];
+	size_t spillLength;
+} LocaleIDParser;
+
+/*
+ * Initializes (or resets) a LocaleIDParser, that accepts the formats specified by LOCALE_STREAM_INPUT_UNICODE and LOCALE_STREAM_INPUT_GETTEXT flags
+ * (Unicode is tried first; the other formats are ignored, since their names can only be recognized as a whole).
+ */
+void InitLocaleIDParser(LocaleIDParser* parser, unsigned int inputFormats)
+{
+	memset(parser, 0, sizeof(LocaleIDParser));
+	parser->inputFormats = inputFormats & (LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT);
+	parser->unicodeChunk = LOCALE_ID_PARSER_LANGUAGE;
+}
+
+/*
+ * Appends the current subtag of a LocaleIDParser to a Unicode chunk of more subtags (the variants or the extensions).
+ * If the subtag doesn't follow the chunk in memory, the chunk (unless it's already at the end of the spill buffer) and the subtag are copied to the spill buffer.
+ */
+static void AppendLocaleIDParserSubtag(LocaleIDParser* parser, LocaleSlice* chunk)
+{
+	if (!chunk->length) {
+		chunk->start = parser->subtag;
+		chunk->length = parser->subtagLength;
+		return;
+	}
+	if (!(parser->subtagSpilled || parser->subtag > parser->piece) || parser->subtag - 1 != chunk->start + chunk->length) {
+		if (chunk->start + chunk->length != parser->spill + parser->spillLength) {
+			memcpy(parser->spill + parser->spillLength, chunk->start, chunk->length);
+			chunk->start = parser->spill + parser->spillLength;
+			parser->spillLength += chunk->length;
+		}
+		parser->spill[parser->spillLength++] = parser->separator;
+		memcpy(parser->spill + parser->spillLength, parser->subtag, parser->subtagLength);
+		parser->spillLength += parser->subtagLength;
+	}
+	chunk->length += 1 + parser->subtagLength;
+}
+
+/*
+ * Checks the current subtag of a LocaleIDParser as a Unicode one (see ScanLocaleIDTags).
+ * Returns 0 if the identifier is not valid in Unicode format, 1 otherwise.
+ */
+static int EndUnicodeLocaleIDParserSubtag(LocaleIDParser* parser)
+{
+	LocaleSlice subtag;
+	int chunk;
+	subtag.start = parser->subtag;
+	subtag.length = parser->subtagLength;
+	chunk = parser->unicodeChunk;
+	if (chunk == LOCALE_ID_PARSER_LANGUAGE) {
+		if (subtag.length == 4 && !strncmp("root", subtag.start, 4)) {
+			parser->unicode.isRoot = 1;
+			parser->unicodeChunk = LOCALE_ID_PARSER_TERRITORY;
+		} else if (subtag.length >= 2 && subtag.length <= 3 && IsAlphaLocaleSlice(&subtag)) {
+			parser->unicode.language = subtag;
+			parser->unicodeChunk = LOCALE_ID_PARSER_SCRIPT;
+		} else if (subtag.length == 4 && IsAlphaLocaleSlice(&subtag)) {
+			parser->unicode.script = subtag;
+			parser->unicodeChunk = LOCALE_ID_PARSER_TERRITORY;
+		} else {
+			return 0;
+		}
+		return 1;
+	}
+	if (chunk == LOCALE_ID_PARSER_SCRIPT) {
+		if (subtag.length == 4 && IsAlphaLocaleSlice(&subtag)) {
+			parser->unicode.script = subtag;
+			parser->unicodeChunk = LOCALE_ID_PARSER_TERRITORY;
+			return 1;
+		}
+		/* This subtag is not a script: let's check it as a region */
+		chunk = LOCALE_ID_PARSER_TERRITORY;
+	}
+	if (chunk == LOCALE_ID_PARSER_TERRITORY) {
+		if (subtag.length == 2 || subtag.length == 3) {
+			if (!(subtag.length == 2 ? IsAlphaLocaleSlice(&subtag) : IsDigitLocaleSlice(&subtag))) {
+				return 0;
+			}
+			parser->unicode.territory = subtag;
+			parser->unicodeChunk = LOCALE_ID_PARSER_VARIANTS;
+			return 1;
+		}
+		chunk = LOCALE_ID_PARSER_VARIANTS;
+	}
+	if (chunk == LOCALE_ID_PARSER_VARIANTS && subtag.length != 1) {
+		if (!IsLocaleVariantSlice(&subtag)) {
+			return 0;
+		}
+		parser->unicode.variantCount++;
+		AppendLocaleIDParserSubtag(parser, &parser->unicode.variants);
+		parser->unicodeChunk = LOCALE_ID_PARSER_VARIANTS;
+		return 1;
+	}
+	/* Extensions: each one starts with a singleton followed by alphanum{2,8} tags (alphanum{1,8} for private use) */
+	if (subtag.length > 8) {
+		return 0;
+	}
+	if (chunk != LOCALE_ID_PARSER_EXTENSIONS || (subtag.length == 1 && !parser->isPrivateExtension)) {
+		/* A new singleton: the previous extension (if any) must have at least one tag */
+		if (chunk == LOCALE_ID_PARSER_EXTENSIONS && !parser->extensionTags) {
+			return 0;
+		}
+		parser->isPrivateExtension = *subtag.start == 'x' || *subtag.start == 'X';
+		parser->extensionTags = 0;
+	} else {
+		parser->extensionTags++;
+	}
+	AppendLocaleIDParserSubtag(parser, &parser->unicode.extensions);
+	parser->unicodeChunk = LOCALE_ID_PARSER_EXTENSIONS;
+	return 1;
+}
+
+/*
+ * Checks the current subtag of a LocaleIDParser as a Gettext chunk (see ScanGettextLocaleID).
+ * Returns 0 if the identifier is not valid in Gettext format, 1 otherwise.
+ */
+static int EndGettextLocaleIDParserSubtag(LocaleIDParser* parser)
+{
+	LocaleSlice* chunk;
+	switch (parser->separator) {
+		case '\0':
+			chunk = &parser->gettext.language;
+			break;
+		case '_':
+			if (parser->gettext.territory.length || parser->gettext.codeset.length || parser->gettext.modifier.length) {
+				/* Duplicated or misplaced territory */
+				return 0;
+			}
+			chunk = &parser->gettext.territory;
+			break;
+		case '.':
+			if (parser->gettext.codeset.length || parser->gettext.modifier.length) {
+				/* Duplicated or misplaced codeset */
+				return 0;
+			}
+			chunk = &parser->gettext.codeset;
+			break;
+		case '@':
+			if (parser->gettext.modifier.length) {
+				/* Duplicated modifier */
+				return 0;
+			}
+			chunk = &parser->gettext.modifier;
+			break;
+		default:
+			return 0;
+	}
+	chunk->start = parser->subtag;
+	chunk->length = parser->subtagLength;
+	return 1;
+}
+
+/*
+ * Ends the current subtag of a LocaleIDParser, at a separator (or at the end of the identifier, if separator is '\0'), discarding the formats that don't match.
+ */
+static void EndLocaleIDParserSubtag(LocaleIDParser* parser, char separator)
+{
+	if (!parser->subtagLength) {
+		/* Empty subtag */
+		parser->inputFormats = 0;
+		return;
+	}
+	if ((parser->inputFormats & LOCALE_STREAM_INPUT_UNICODE) && (!EndUnicodeLocaleIDParserSubtag(parser) || (separator && separator != '-' && separator != '_'))) {
+		parser->inputFormats &= ~LOCALE_STREAM_INPUT_UNICODE;
+	}
+	if ((parser->inputFormats & LOCALE_STREAM_INPUT_GETTEXT) && (!EndGettextLocaleIDParserSubtag(parser) || (separator && separator != '_' && separator != '.' && separator != '@'))) {
+		parser->inputFormats &= ~LOCALE_STREAM_INPUT_GETTEXT;
+	}
+	parser->separator = separator;
+	parser->subtagLength = 0;
+	parser->subtagSpilled = 0;
+}
+
+/*
+ * Scans the next piece of a locale identifier: data is not copied, so it must stay valid until the parser is finished
+ * (except for the subtag it ends with, if it's split: that one is copied, and data can be reused for the next piece).
+ * Identifiers longer than LOCALE_ID_MAX_LENGTH characters are always rejected.
+ * Returns 0 if the identifier is already known to be invalid (there's no need to feed the rest), 1 otherwise.
+ */
+int FeedLocaleIDParser(LocaleIDParser* parser, const char* data, size_t length)
+{
+	const char *p, *end;
+	if (!parser->inputFormats) {
+		return 0;
+	}
+	if (length > LOCALE_ID_MAX_LENGTH - parser->length) {
+		parser->inputFormats = 0;
+		return 0;
+	}
+	parser->length += length;
+	parser->piece = data;
+	end = data + length;
+	for (p = data; p < end && parser->inputFormats; p++) {
+		if (!IsLocaleAlnum(*p)) {
+			EndLocaleIDParserSubtag(parser, *p);
+		} else if (parser->subtagSpilled) {
+			parser->spill[parser->spillLength++] = *p;
+			parser->subtagLength++;
+		} else if (!parser->subtagLength++) {
+			parser->subtag = p;
+		}
+	}
+	if (parser->inputFormats && parser->subtagLength && !parser->subtagSpilled) {
+		/* The piece ends in the middle of a subtag: copy what we have of it, preceded by its separator */
+		parser->spill[parser->spillLength++] = parser->separator;
+		memcpy(parser->spill + parser->spillLength, parser->subtag, parser->subtagLength);
+		parser->subtag = parser->spill + parser->spillLength;
+		parser->spillLength += parser->subtagLength;
+		parser->subtagSpilled = 1;
+	}
+	return parser->inputFormats != 0;
+}
+
+/*
+ * Finishes parsing a locale identifier, with its last piece (data may be NULL if length is 0), storing its chunks in slices.
+ * Nothing is scanned again: only the last subtag is checked.
+ * The slices point to the pieces or to the spill buffer of the LocaleIDParser, so they are valid until one of them is changed.
+ * Returns 1 if the identifier is valid, 0 otherwise.
+ */
+int FinishLocaleIDParserSlices(LocaleIDParser* parser, const char* data, size_t length, LocaleChunkSlices* slices)
+{
+	memset(slices, 0, sizeof(LocaleChunkSlices));
+	if (length && !FeedLocaleIDParser(parser, data, length)) {
+		return 0;
+	}
+	if (!parser->inputFormats) {
+		return 0;
+	}
+	EndLocaleIDParserSubtag(parser, '\0');
+	if ((parser->inputFormats & LOCALE_STREAM_INPUT_UNICODE) && (parser->unicodeChunk != LOCALE_ID_PARSER_EXTENSIONS || parser->extensionTags)) {
+		*slices = parser->unicode;
+		return 1;
+	}
+	if (parser->inputFormats & LOCALE_STREAM_INPUT_GETTEXT) {
+		*slices = parser->gettext;
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Finishes parsing a locale identifier, with its last piece (data may be NULL if length is 0), allocating the result with the specified hooks (NULL for malloc).
+ * The result is the same as parsing the whole identifier at once (for example with UnicodeLocaleIDToLocaleChunks or GettextLocaleIDToLocaleChunks).
+ * Returns NULL if the identifier is invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* FinishLocaleIDParserWithAllocator(LocaleIDParser* parser, const char* data, size_t length, const LocaleAllocator* allocator)
+{
+	LocaleChunkSlices slices;
+	if (!FinishLocaleIDParserSlices(parser, data, length, &slices)) {
+		return NULL;
+	}
+	return LocaleChunkSlicesToLocaleChunksWithAllocator(&slices, allocator);
+}
+
+/*
+ * Finishes parsing a locale identifier, with its last piece (data may be NULL if length is 0).
+ * Returns NULL if the identifier is invalid, or in case of out-of-memory problems.
+ */
+LocaleChunks* FinishLocaleIDParser(LocaleIDParser* parser, const char* data, size_t length)
+{
+	return FinishLocaleIDParserWithAllocator(parser, data, length, NULL);
+}
+
+/************************/
+/* Simple testing stuff */
+/************************/
+void DumpLocaleChunksID(LocaleChunks* lc, const char* which, const char* expected, char* calculated)
+{
+	int die;
+	die = 0;
+	if (expected && calculated && CompareLocaleStringsIgnoringCase(expected, calculated, (size_t)-1)) {
+		printf("\t\tERROR: expected %s ID: %s, calculated: %s\n", which, expected, calculated);
+		die = 1;
+	} else if ((!expected) != (!calculated)) {
+		printf("\t\tERROR: expected %s ID: %s, calculated: %s\n", which, expected ? expected : "<NULL>", calculated ? calculated : "<NULL>");
+		die = 1;
+	} else {
+		printf("\t\t%s ID: %s (as expected)\n", which, expected ? expected : "<NULL>");
+	}
+	if (calculated) {
+		free(calculated);
+	}
+	if (die) {
+		FreeLocaleChunks(lc);
+		exit(1);
+	}
+}
+void DumpLocaleChunks(LocaleChunks* lc, const char* expectedGettextID, const char* expectedUnicodeID)
+{
+	size_t i;
+	if (!lc) {
+		printf("\t\t<NULL>\n");
+	} else {
+		printf("\t\tUnicode root? %s\n", lc->isRoot ? "yes" : "no");
+		printf("\t\tlanguage: %s\n", lc->language ? lc->language : "<NULL>");
+		printf("\t\tterritory: %s\n", lc->territory ? lc->territory : "<NULL>");
+		printf("\t\tcodeset: %s\n", lc->codeset ? lc->codeset : "<NULL>");
+		printf("\t\tmodifier: %s\n", lc->modifier ? lc->modifier : "<NULL>");
+		printf("\t\tscript: %s\n", lc->script ? lc->script : "<NULL>");
+		if (!lc->variantCount) {
+			printf("\t\tno variants\n");
+		} else {
+			for (i = 0; i < lc->variantCount; i++) {
+				printf("\t\tvariant %lu: %s\n", (long unsigned int) i, lc->variants[i]);
+			}
+		}
+		printf("\t\textensions: %s\n", lc->extensions ? lc->extensions : "<NULL>");
+		DumpLocaleChunksID(lc, "Gettext", expectedGettextID, LocaleChunksToGettextLocaleID(lc));
+		DumpLocaleChunksID(lc, "Unicode", expectedUnicodeID, LocaleChunksToUnicodeLocaleID(lc));
+	}
+}
+void Test(const char* id, int okForGettext, const char* expectedGettextID, int okForUnicode, const char* expectedUnicodeID)
+{
+	LocaleChunks* lc;
+	if (id) {
+		printf("\"%s\"\n", id);
+	} else {
+		printf("<NULL>\n");
+	}
+	lc = GettextLocaleIDToLocaleChunks(id);
+	if (lc == NULL) {
+		if (okForGettext) {
+			printf("\tERROR: it should be valid for Gettext\n");
+			exit(1);
+		}
+		printf("\tNot a Gettext identifier (as expected)\n");
+	} else if (!okForGettext) {
+		FreeLocaleChunks(lc);
+		printf("\tERROR: it has been detected as valid for Gettext, but it should't\n");
+		exit(1);
+	} else {
+		printf("\tValid Gettext identifier\n");
+		DumpLocaleChunks(lc, expectedGettextID, expectedUnicodeID);
+		FreeLocaleChunks(lc);
+	}
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	if (lc == NULL) {
+		if (okForUnicode) {
+			printf("\tERROR: it should be valid for Unicode\n");
+			exit(1);
+		}
+		printf("\tNot an Unicode identifier (as expected)\n");
+	} else if (!okForUnicode) {
+		FreeLocaleChunks(lc);
+		printf("\tERROR: it has been detected as valid for Unicode, but it should't\n");
+		exit(1);
+	} else {
+		printf("\tValid Unicode identifier\n");
+		DumpLocaleChunks(lc, expectedGettextID, expectedUnicodeID);
+		FreeLocaleChunks(lc);
+	}
+}
+void TestLocaleIDBuffer(const char* id, size_t size, const char* expectedGettextID, const char* expectedUnicodeID)
+{
+	LocaleChunks* lc;
+	char buffer[LOCALE_ID_INLINE_SIZE];
+	size_t length;
+	printf("\"%s\" in a %lu-bytes buffer\n", id, (long unsigned int) size);
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	if (!lc) {
+		lc = GettextLocaleIDToLocaleChunks(id);
+	}
+	if (!lc) {
+		printf("\tERROR: it should be a valid identifier\n");
+		exit(1);
+	}
+	length = LocaleChunksToGettextLocaleIDBuffer(lc, buffer, size);
+	if (length != strlen(expectedGettextID) || strncmp(buffer, expectedGettextID, size - 1) || strlen(buffer) >= size) {
+		printf("\tERROR: expected Gettext ID: %s (%lu), calculated: %s (%lu)\n", expectedGettextID, (long unsigned int) strlen(expectedGettextID), buffer, (long unsigned int) length);
+		FreeLocaleChunks(lc);
+		exit(1);
+	}
+	printf("\tGettext ID: %s (as expected)\n", buffer);
+	length = LocaleChunksToUnicodeLocaleIDBuffer(lc, buffer, size);
+	if (length != strlen(expectedUnicodeID) || strncmp(buffer, expectedUnicodeID, size - 1) || strlen(buffer) >= size) {
+		printf("\tERROR: expected Unicode ID: %s (%lu), calculated: %s (%lu)\n", expectedUnicodeID, (long unsigned int) strlen(expectedUnicodeID), buffer, (long unsigned int) length);
+		FreeLocaleChunks(lc);
+		exit(1);
+	}
+	printf("\tUnicode ID: %s (as expected)\n", buffer);
+	FreeLocaleChunks(lc);
+}
+void TestLocaleArena(size_t bufferSize, const LocaleAllocator* upstream, size_t numLocales, int shouldSucceed, const char* expectedLastUnicodeID)
+{
+	static const char* ids[] = {"it_IT.utf8@euro", "sr-Latn-RS-POSIX", "de_CH", "es-419", "zh-Hant-HK", "en"};
+	char* buffer;
+	LocaleArena arena;
+	LocaleList list;
+	size_t i;
+	char* id;
+	int ok;
+	printf("Parsing %lu locales in an arena with a %lu-bytes buffer and %s upstream allocator\n", (long unsigned int) numLocales, (long unsigned int) bufferSize, upstream ? "an" : "no");
+	buffer = (char*)malloc(bufferSize);
+	InitLocaleArena(&arena, buffer, bufferSize, upstream);
+	InitLocaleList(&list, &arena.allocator);
+	ok = 1;
+	for (i = 0; ok && i < numLocales; i++) {
+		if (i % 2) {
+			ok = AppendUnicodeLocaleIDToLocaleList(&list, ids[i % 6]) != NULL;
+		} else {
+			ok = AppendGettextLocaleIDToLocaleList(&list, "it_IT.utf8@euro") != NULL;
+		}
+	}
+	if (ok) {
+		id = LocaleChunksToUnicodeLocaleIDWithAllocator(list.items[numLocales - 1], &arena.allocator);
+		if (!id || strcmp(id, expectedLastUnicodeID)) {
+			printf("\tERROR: expected last Unicode ID: %s, calculated: %s\n", expectedLastUnicodeID, id ? id : "<NULL>");
+			exit(1);
+		}
+		if (list.count != numLocales) {
+			printf("\tERROR: the list contains %lu items\n", (long unsigned int) list.count);
+			exit(1);
+		}
+	}
+	if (ok != shouldSucceed) {
+		printf("\tERROR: parsing should have %s\n", shouldSucceed ? "succeeded" : "failed");
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", ok ? "Succeeded" : "Failed");
+	FreeLocaleList(&list);
+	ReleaseLocaleArena(&arena);
+	free(buffer);
+}
+void TestLocaleKey(const char* id, const char* expectedCanonicalID)
+{
+	LocaleKey key;
+	char canonical[LOCALE_ID_INLINE_SIZE];
+	printf("\"%s\"\n", id);
+	key = LocaleIDToLocaleKey(id, strlen(id));
+	if (!expectedCanonicalID) {
+		if (key) {
+			printf("\tERROR: it should not have a key\n");
+			exit(1);
+		}
+		printf("\tNo key (as expected)\n");
+		return;
+	}
+	LocaleKeyToUnicodeLocaleIDBuffer(key, canonical, sizeof(canonical));
+	if (strcmp(canonical, expectedCanonicalID)) {
+		printf("\tERROR: expected key for %s, calculated: %s\n", expectedCanonicalID, canonical);
+		exit(1);
+	}
+	if (HashLocaleID(expectedCanonicalID, strlen(expectedCanonicalID)) != HashLocaleKey(key) || CompareLocaleKeyToLocaleID(key, expectedCanonicalID, strlen(expectedCanonicalID))) {
+		printf("\tERROR: the key of %s is not the same\n", expectedCanonicalID);
+		exit(1);
+	}
+	printf("\tkey %016llx for %s (as expected)\n", (unsigned long long) key, canonical);
+}
+void TestLocaleKeyOrder(void)
+{
+	static const char* ids[] = {"root", "root_IT", "Latn", "Latn_IT", "Zzzz", "en", "es", "es_419", "es_AR", "es_ES", "es_Latn", "es_Latn_419", "it", "it_IT", "it_Latn", "it_Latn_IT", "it_LT", "ita", "zh", "zh_Hans", "zh_Hant", "zh_Hant_HK", NULL};
+	size_t i, j;
+	LocaleKey a, b;
+	printf("Comparing keys\n");
+	for (i = 0; ids[i]; i++) {
+		for (j = 0; ids[j]; j++) {
+			a = LocaleIDToLocaleKey(ids[i], strlen(ids[i]));
+			b = LocaleIDToLocaleKey(ids[j], strlen(ids[j]));
+			if (!a || !b || (CompareLocaleKeys(a, b) > 0) != (strcmp(ids[i], ids[j]) > 0) || (CompareLocaleKeys(a, b) < 0) != (strcmp(ids[i], ids[j]) < 0)) {
+				printf("\tERROR: the keys of %s and %s are not sorted like the identifiers\n", ids[i], ids[j]);
+				exit(1);
+			}
+		}
+	}
+	printf("\tKeys are sorted like canonical Unicode IDs (as expected)\n");
+}
+void TestFormatLocaleChunks(const char* id, unsigned int format, const char* expected)
+{
+	LocaleChunks* lc;
+	LocaleChunkSlices slices;
+	char buffer[64];
+	printf("\"%s\" with format %u\n", id, format);
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	if (!lc) {
+		lc = GettextLocaleIDToLocaleChunks(id);
+	}
+	if (!ScanUnicodeLocaleID(id, strlen(id), &slices)) {
+		ScanGettextLocaleID(id, strlen(id), &slices);
+	}
+	FormatLocaleChunks(lc, format, buffer, sizeof(buffer));
+	if (strcmp(buffer, expected)) {
+		printf("\tERROR: expected %s, calculated: %s\n", expected, buffer);
+		exit(1);
+	}
+	FormatLocaleChunkSlices(&slices, format, buffer, sizeof(buffer));
+	if (strcmp(buffer, expected)) {
+		printf("\tERROR: expected %s, calculated from the slices: %s\n", expected, buffer);
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", buffer);
+	FreeLocaleChunks(lc);
+}
+void TestLocaleIDStream(void)
+{
+	static const char* lines = "it_IT.utf8\nSR@latin\r\n\nnot valid\nes-419\nsr-latn-rs";
+	static const char* expected[] = {"it-IT", "sr-Latn", "", "", "es-419", "sr-Latn-RS"};
+	static const char* ids[] = {"it-IT", NULL, "zh_TW"};
+	LocaleIDStream stream;
+	printf("Streaming lines\n");
+	InitLocaleIDStreamFromLines(&stream, lines, strlen(lines), LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_BCP47 | LOCALE_FORMAT_CANONICAL_CASE);
+	while (NextLocaleIDStream(&stream)) {
+		if (stream.index >= sizeof(expected) / sizeof(expected[0]) || strcmp(stream.output, expected[stream.index]) || stream.isValid != (expected[stream.index][0] != '\0')) {
+			printf("\tERROR: unexpected item %lu: %s\n", (long unsigned int) stream.index, stream.output);
+			exit(1);
+		}
+		printf("\t%lu: \"%.*s\" -> %s (as expected)\n", (long unsigned int) stream.index, (int) stream.inputLength, stream.input, stream.isValid ? stream.output : "<invalid>");
+	}
+	if (stream.index != sizeof(expected) / sizeof(expected[0]) - 1) {
+		printf("\tERROR: %lu items have been streamed\n", (long unsigned int) (stream.index + 1));
+		exit(1);
+	}
+	printf("Streaming an array\n");
+	InitLocaleIDStreamFromArray(&stream, ids, 3, LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_GETTEXT);
+	if (!NextLocaleIDStream(&stream) || strcmp(stream.output, "it_IT") || !NextLocaleIDStream(&stream) || stream.isValid || !NextLocaleIDStream(&stream) || strcmp(stream.output, "zh_TW") || NextLocaleIDStream(&stream)) {
+		printf("\tERROR: unexpected item %lu: %s\n", (long unsigned int) stream.index, stream.output);
+		exit(1);
+	}
+	printf("\tit_IT, <invalid>, zh_TW (as expected)\n");
+}
+void TestLCID(LCID lcid, const char* id, LCID expectedLCID, const char* expectedGettextID)
+{
+	char buffer[LOCALE_ID_INLINE_SIZE];
+	LCID calculated;
+	LocaleChunks* lc;
+	printf("LCID 0x%04X, \"%s\"\n", (unsigned int) lcid, id);
+	LCIDToLocaleIDBuffer(lcid, LOCALE_FORMAT_GETTEXT, buffer, sizeof(buffer));
+	if (strcmp(buffer, expectedGettextID)) {
+		printf("\tERROR: expected Gettext ID: %s, calculated: %s\n", expectedGettextID, buffer);
+		exit(1);
+	}
+	calculated = LocaleIDToLCID(id, strlen(id));
+	if (calculated != expectedLCID) {
+		printf("\tERROR: expected LCID: 0x%04X, calculated: 0x%04X\n", (unsigned int) expectedLCID, (unsigned int) calculated);
+		exit(1);
+	}
+	lc = LCIDToLocaleChunks(lcid);
+	if ((lc != NULL) != (expectedGettextID[0] != '\0') || (lc && LocaleChunksToLCID(lc) != LocaleKeyToLCID(LCIDToLocaleKey(lcid)))) {
+		printf("\tERROR: LCIDToLocaleChunks failed\n");
+		exit(1);
+	}
+	FreeLocaleChunks(lc);
+	printf("\tGettext ID: %s, LCID: 0x%04X (as expected)\n", buffer, (unsigned int) calculated);
+}
+void TestLCIDTables(void)
+{
+	static LCID lcids[0x10000];
+	static LocaleKey keys[0x10000];
+	static LCID converted[0x10000];
+	size_t i, count;
+	printf("Checking all the LCIDs\n");
+	for (i = 0; i < 0x10000; i++) {
+		lcids[i] = (LCID) i;
+	}
+	LCIDsToLocaleKeys(lcids, 0x10000, keys);
+	LocaleKeysToLCIDs(keys, 0x10000, converted);
+	count = 0;
+	for (i = 0; i < 0x10000; i++) {
+		if (keys[i]) {
+			count++;
+			/* Only one of the duplicated LCIDs is the result of the reverse conversion */
+			if (!converted[i] || LCIDToLocaleKey(converted[i]) != keys[i]) {
+				printf("\tERROR: LCID 0x%04X is not converted back\n", (unsigned int) i);
+				exit(1);
+			}
+		}
+	}
+	printf("\t%lu LCIDs converted back and forth (as expected)\n", (long unsigned int) count);
+}
+void TestEmptyICULocaleID(const char* id)
+{
+	LocaleChunkSlices slices;
+	char extensions[LOCALE_EXTENSIONS_BUFFER_SIZE];
+	char* piece;
+	int isValid;
+	printf("Empty piece of an ICU locale ID after \"%s\"\n", id);
+	/* The empty piece is at the end of the allocation, so that reading it is caught by the address sanitizer */
+	piece = (char*)malloc(strlen(id));
+	memcpy(piece, id, strlen(id));
+	isValid = ScanICULocaleID(piece + strlen(id), 0, &slices, extensions, sizeof(extensions));
+	free(piece);
+	if (isValid) {
+		printf("\tERROR: expected to be invalid\n");
+		exit(1);
+	}
+	printf("\tinvalid (as expected)\n");
+}
+void TestLocaleIDFormat(const char* id, unsigned int inputFormat, unsigned int outputFormat, const char* expected)
+{
+	LocaleChunks* lc;
+	LocaleChunkSlices slices;
+	char buffer[96], extensions[LOCALE_EXTENSIONS_BUFFER_SIZE];
+	int isValid;
+	printf("\"%s\" from format %u to format %u\n", id, inputFormat, outputFormat);
+	switch (inputFormat) {
+		case LOCALE_FORMAT_JAVA:
+			lc = JavaLocaleIDToLocaleChunks(id);
+			isValid = ScanJavaLocaleID(id, strlen(id), &slices);
+			break;
+		case LOCALE_FORMAT_ICU:
+			lc = ICULocaleIDToLocaleChunks(id);
+			isValid = ScanICULocaleID(id, strlen(id), &slices, extensions, sizeof(extensions));
+			break;
+		case LOCALE_FORMAT_ANDROID:
+			lc = AndroidLocaleIDToLocaleChunks(id);
+			isValid = ScanAndroidLocaleID(id, strlen(id), &slices);
+			break;
+		case LOCALE_FORMAT_APPLE:
+			lc = AppleLocaleIDToLocaleChunks(id);
+			isValid = ScanAppleLocaleID(id, strlen(id), &slices);
+			break;
+		default:
+			lc = UnicodeLocaleIDToLocaleChunks(id);
+			isValid = ScanUnicodeLocaleID(id, strlen(id), &slices);
+			break;
+	}
+	if (!expected) {
+		if (lc || isValid) {
+			printf("\tERROR: expected to be invalid\n");
+			exit(1);
+		}
+		printf("\tinvalid (as expected)\n");
+		return;
+	}
+	if (!lc || !isValid) {
+		printf("\tERROR: expected to be valid\n");
+		exit(1);
+	}
+	FormatLocaleChunks(lc, outputFormat, buffer, sizeof(buffer));
+	if (strcmp(buffer, expected)) {
+		printf("\tERROR: expected %s, calculated: %s\n", expected, buffer);
+		exit(1);
+	}
+	FormatLocaleChunkSlices(&slices, outputFormat, buffer, sizeof(buffer));
+	if (strcmp(buffer, expected)) {
+		printf("\tERROR: expected %s, calculated from the slices: %s\n", expected, buffer);
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", buffer);
+	FreeLocaleChunks(lc);
+}
+
+void TestLocaleDirectoryListing(void)
+{
+	const char* listing = "values\nvalues-zh-rTW\nvalues-b+sr+Latn\nvalues-mcc310-en-rUS-land\ndrawable-hdpi\nzh-Hans.lproj\nBase.lproj\nEnglish.lproj\nes-419.lproj\n";
+	const char* expected = "\nzh_TW.po\nsr@latin.po\nen_US.po\n\nzh.po\n\nen.po\nes_419.po\n";
+	char buffer[256];
+	size_t length, count;
+	printf("Converting a directory listing\n");
+	length = ConvertLocaleDirectoryListing(listing, strlen(listing), LOCALE_STREAM_INPUT_ANDROID | LOCALE_STREAM_INPUT_APPLE, LOCALE_FORMAT_GETTEXT | LOCALE_FORMAT_CANONICAL_CASE, NULL, ".po", buffer, sizeof(buffer), &count);
+	if (strcmp(buffer, expected) || length != strlen(expected) || count != 6) {
+		printf("\tERROR: expected\n%s\ncalculated (%lu converted):\n%s\n", expected, (long unsigned int) count, buffer);
+		exit(1);
+	}
+	expected = "values-en-rUS\nvalues-b+sr+Latn+RS\nvalues-b+es+419\n\n";
+	listing = "en_US.po\nsr-Latn-RS\nes_419\n\n";
+	length = ConvertLocaleDirectoryListing(listing, strlen(listing), LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT, LOCALE_FORMAT_ANDROID, "values-", NULL, buffer, 16, &count);
+	if (length != strlen(expected) || strncmp(buffer, expected, 15) || buffer[15] || count != 3) {
+		printf("\tERROR: expected the truncated\n%s\ncalculated (%lu converted):\n%s\n", expected, (long unsigned int) count, buffer);
+		exit(1);
+	}
+	printf("\tok\n");
+}
+
+void TestUTF16LocaleID(const char* id, int nonASCIIPosition, const char* expectedUnicodeID)
+{
+	uint16_t utf16[LOCALE_ID_MAX_LENGTH + 1];
+	wchar_t wide[LOCALE_ID_MAX_LENGTH + 1];
+	LocaleChunks* lc[2];
+	char buffer[64];
+	size_t length, i, j;
+	printf("UTF-16 \"%s\"", id);
+	length = strlen(id);
+	for (i = 0; i < length; i++) {
+		utf16[i] = (uint16_t)(unsigned char)id[i];
+		wide[i] = (wchar_t)(unsigned char)id[i];
+	}
+	if (nonASCIIPosition >= 0) {
+		printf(" with a non-ASCII character at %d", nonASCIIPosition);
+		utf16[nonASCIIPosition] = 0x0100 | utf16[nonASCIIPosition];
+		wide[nonASCIIPosition] = (wchar_t)0x0100 | wide[nonASCIIPosition];
+	}
+	printf("\n");
+	lc[0] = UTF16LocaleIDToLocaleChunks(utf16, length, LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT);
+	lc[1] = WideLocaleIDToLocaleChunks(wide, length, LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT);
+	for (j = 0; j < 2; j++) {
+		if (!expectedUnicodeID) {
+			if (lc[j]) {
+				printf("\tERROR: expected to be invalid\n");
+				exit(1);
+			}
+			continue;
+		}
+		FormatLocaleChunks(lc[j], LOCALE_FORMAT_UNICODE, buffer, sizeof(buffer));
+		if (!lc[j] || strcmp(buffer, expectedUnicodeID)) {
+			printf("\tERROR: expected %s, calculated from the %s string: %s\n", expectedUnicodeID, j ? "wide" : "UTF-16", lc[j] ? buffer : "<NULL>");
+			exit(1);
+		}
+		FreeLocaleChunks(lc[j]);
+	}
+	printf("\t%s (as expected)\n", expectedUnicodeID ? expectedUnicodeID : "invalid");
+}
+
+void TestLocaleFallback(const char* id, unsigned int options, const char* expectedChain, const char* expectedGettextChain)
+{
+	LocaleChunks* lc;
+	LocaleFallbackIterator iterator;
+	char step[32], gettextStep[32], chain[256], gettextChain[256];
+	size_t length, gettextLength;
+	printf("Fallback of \"%s\"\n", id);
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	if (!lc) {
+		lc = GettextLocaleIDToLocaleChunks(id);
+	}
+	if (!InitLocaleFallbackIterator(&iterator, lc, LOCALE_FORMAT_UNICODE, options, NULL)) {
+		if (expectedChain) {
+			printf("\tERROR: expected to be valid\n");
+			exit(1);
+		}
+		printf("\tinvalid (as expected)\n");
+		FreeLocaleChunks(lc);
+		return;
+	}
+	length = gettextLength = 0;
+	while (NextLocaleFallback(&iterator, step, sizeof(step), gettextStep, sizeof(gettextStep))) {
+		if (iterator.length) {
+			AppendToLocaleIDBuffer(chain, sizeof(chain), &length, " > ", length ? 3 : 0);
+			AppendToLocaleIDBuffer(chain, sizeof(chain), &length, step, iterator.length);
+		}
+		if (iterator.gettextLength) {
+			AppendToLocaleIDBuffer(gettextChain, sizeof(gettextChain), &gettextLength, " > ", gettextLength ? 3 : 0);
+			AppendToLocaleIDBuffer(gettextChain, sizeof(gettextChain), &gettextLength, gettextStep, iterator.gettextLength);
+		}
+	}
+	TerminateLocaleIDBuffer(chain, sizeof(chain), length);
+	TerminateLocaleIDBuffer(gettextChain, sizeof(gettextChain), gettextLength);
+	if (!expectedChain || strcmp(chain, expectedChain) || strcmp(gettextChain, expectedGettextChain)) {
+		printf("\tERROR: expected %s (Gettext: %s), calculated: %s (Gettext: %s)\n", expectedChain ? expectedChain : "<invalid>", expectedGettextChain, chain, gettextChain);
+		exit(1);
+	}
+	printf("\t%s (Gettext: %s) (as expected)\n", chain, gettextChain);
+	FreeLocaleChunks(lc);
+}
+
+void TestCachedLocaleID(const char* id, const char* expectedGettextID, const char* expectedUnicodeID)
+{
+	LocaleChunks* lc;
+	const char *gettextID, *unicodeID;
+	printf("Cached IDs of \"%s\"\n", id);
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	if (!lc) {
+		lc = GettextLocaleIDToLocaleChunks(id);
+	}
+	gettextID = GetCachedGettextLocaleID(lc);
+	unicodeID = GetCachedUnicodeLocaleID(lc);
+	if ((gettextID && !expectedGettextID) || (!gettextID && expectedGettextID) || (gettextID && strcmp(gettextID, expectedGettextID))) {
+		printf("\tERROR: expected Gettext ID %s, calculated: %s\n", expectedGettextID ? expectedGettextID : "<NULL>", gettextID ? gettextID : "<NULL>");
+		exit(1);
+	}
+	if ((unicodeID && !expectedUnicodeID) || (!unicodeID && expectedUnicodeID) || (unicodeID && strcmp(unicodeID, expectedUnicodeID))) {
+		printf("\tERROR: expected Unicode ID %s, calculated: %s\n", expectedUnicodeID ? expectedUnicodeID : "<NULL>", unicodeID ? unicodeID : "<NULL>");
+		exit(1);
+	}
+	if (GetCachedGettextLocaleID(lc) != gettextID || GetCachedUnicodeLocaleID(lc) != unicodeID) {
+		printf("\tERROR: the cached IDs should be reused\n");
+		exit(1);
+	}
+	InvalidateLocaleChunksCache(lc);
+	if (lc && (lc->cachedGettextID || lc->cachedUnicodeID)) {
+		printf("\tERROR: the cached IDs should have been discarded\n");
+		exit(1);
+	}
+	gettextID = GetCachedGettextLocaleID(lc);
+	unicodeID = GetCachedUnicodeLocaleID(lc);
+	if ((unicodeID && !expectedUnicodeID) || (unicodeID && strcmp(unicodeID, expectedUnicodeID))) {
+		printf("\tERROR: expected Unicode ID %s after the invalidation, calculated: %s\n", expectedUnicodeID ? expectedUnicodeID : "<NULL>", unicodeID ? unicodeID : "<NULL>");
+		exit(1);
+	}
+	printf("\t%s, %s (as expected)\n", gettextID ? gettextID : "<NULL>", unicodeID ? unicodeID : "<NULL>");
+	FreeLocaleChunks(lc);
+}
+
+/*
+ * Checks the Gettext and Unicode IDs of a LocaleChunks (through the cache, to check that the changes invalidate it).
+ */
+void CheckLocaleChunksIDs(const LocaleChunks* lc, const char* expectedGettextID, const char* expectedUnicodeID)
+{
+	const char *gettextID, *unicodeID;
+	gettextID = GetCachedGettextLocaleID(lc);
+	unicodeID = GetCachedUnicodeLocaleID(lc);
+	if ((gettextID && !expectedGettextID) || (!gettextID && expectedGettextID) || (gettextID && strcmp(gettextID, expectedGettextID))) {
+		printf("\tERROR: expected Gettext ID %s, calculated: %s\n", expectedGettextID ? expectedGettextID : "<NULL>", gettextID ? gettextID : "<NULL>");
+		exit(1);
+	}
+	if ((unicodeID && !expectedUnicodeID) || (!unicodeID && expectedUnicodeID) || (unicodeID && strcmp(unicodeID, expectedUnicodeID))) {
+		printf("\tERROR: expected Unicode ID %s, calculated: %s\n", expectedUnicodeID ? expectedUnicodeID : "<NULL>", unicodeID ? unicodeID : "<NULL>");
+		exit(1);
+	}
+	printf("\t%s, %s (as expected)\n", gettextID ? gettextID : "<NULL>", unicodeID ? unicodeID : "<NULL>");
+}
+
+void TestLocaleChunksMutation()
+{
+	LocaleChunks *lc, *clone;
+	char* territory;
+	printf("Changing the chunks of \"it_IT.utf8@euro\"\n");
+	lc = GettextLocaleIDToLocaleChunks("it_IT.utf8@euro");
+	CheckLocaleChunksIDs(lc, "it_IT.utf8@euro", "it_IT");
+	territory = lc->territory;
+	if (!SetLocaleChunksTerritory(lc, "CH") || lc->territory != territory) {
+		printf("\tERROR: the territory should have been changed in place\n");
+		exit(1);
+	}
+	if (!SetLocaleChunksLanguage(lc, "rm") || !SetLocaleChunksCodeset(lc, NULL) || !AddLocaleChunksVariant(lc, "1996")) {
+		printf("\tERROR: the chunks should have been changed\n");
+		exit(1);
+	}
+	CheckLocaleChunksIDs(lc, "rm_CH@euro", "rm_CH_1996");
+	if (SetLocaleChunksTerritory(lc, "C1") || SetLocaleChunksScript(lc, "Lat") || SetLocaleChunksModifier(lc, "eu-ro") || AddLocaleChunksVariant(lc, "abc") || AddLocaleChunksVariant(lc, "abcd") || RemoveLocaleChunksVariant(lc, 1)) {
+		printf("\tERROR: the invalid changes should have been rejected\n");
+		exit(1);
+	}
+	if (!SetLocaleChunksScript(lc, "Latn") || !SetLocaleChunksModifier(lc, "") || !AddLocaleChunksVariant(lc, "rozaj")) {
+		printf("\tERROR: the chunks should have been changed\n");
+		exit(1);
+	}
+	CheckLocaleChunksIDs(lc, "rm_CH@latin", "rm_Latn_CH_1996_ROZAJ");
+	clone = CloneLocaleChunks(lc);
+	if (!RemoveLocaleChunksVariant(lc, 0) || !RemoveLocaleChunksVariant(lc, 0) || lc->variants) {
+		printf("\tERROR: the variants should have been removed\n");
+		exit(1);
+	}
+	CheckLocaleChunksIDs(lc, "rm_CH@latin", "rm_Latn_CH");
+	FreeLocaleChunks(lc);
+	printf("Cloning the changed chunks\n");
+	if (!clone || !IsLocaleChunksCompact(clone)) {
+		printf("\tERROR: the clone should be compact\n");
+		exit(1);
+	}
+	CheckLocaleChunksIDs(clone, "rm_CH@latin", "rm_Latn_CH_1996_ROZAJ");
+	FreeLocaleChunks(clone);
+	printf("Building chunks\n");
+	lc = ConstructLocaleChunksWithAllocator(NULL);
+	if (!SetLocaleChunksLanguage(lc, "sr") || !SetLocaleChunksScript(lc, "Cyrl") || !SetLocaleChunksTerritory(lc, "RS")) {
+		printf("\tERROR: the chunks should have been set\n");
+		exit(1);
+	}
+	CheckLocaleChunksIDs(lc, "sr_RS@cyrillic", "sr_Cyrl_RS");
+	FreeLocaleChunks(lc);
+}
+
+void TestCloneLocaleChunks(const char* id, const char* expectedUnicodeID)
+{
+	LocaleChunks *lc, *clone;
+	printf("Cloning \"%s\"\n", id);
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	GetCachedUnicodeLocaleID(lc);
+	clone = CloneLocaleChunks(lc);
+	FreeLocaleChunks(lc);
+	if (!clone || !IsLocaleChunksCompact(clone) || clone->cachedUnicodeID) {
+		printf("\tERROR: the clone should be compact, without cached IDs\n");
+		exit(1);
+	}
+	CheckLocaleChunksIDs(clone, GetCachedGettextLocaleID(clone), expectedUnicodeID);
+	FreeLocaleChunks(clone);
+}
+
+void TestLocaleChunksScriptID(const char* id, const char* expectedScript, const char* expectedModifier)
+{
+	LocaleChunks* lc;
+	const char *script, *modifier;
+	int scriptID;
+	printf("Derived script of \"%s\"\n", id);
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	if (!lc) {
+		lc = GettextLocaleIDToLocaleChunks(id);
+	}
+	if (lc->scriptID != LOCALE_SCRIPT_ID_UNRESOLVED) {
+		printf("\tERROR: the script should not be resolved while parsing\n");
+		exit(1);
+	}
+	script = GetLocaleChunksUnicodeScript(lc);
+	modifier = GetLocaleChunksGettextModifier(lc);
+	scriptID = lc->scriptID;
+	if ((script && !expectedScript) || (!script && expectedScript) || (script && strcmp(script, expectedScript))) {
+		printf("\tERROR: expected script %s, calculated: %s\n", expectedScript ? expectedScript : "<NULL>", script ? script : "<NULL>");
+		exit(1);
+	}
+	if ((modifier && !expectedModifier) || (!modifier && expectedModifier) || (modifier && strcmp(modifier, expectedModifier))) {
+		printf("\tERROR: expected modifier %s, calculated: %s\n", expectedModifier ? expectedModifier : "<NULL>", modifier ? modifier : "<NULL>");
+		exit(1);
+	}
+	if (scriptID == LOCALE_SCRIPT_ID_UNRESOLVED || GetLocaleChunksScriptID(lc) != scriptID) {
+		printf("\tERROR: the script should have been resolved once\n");
+		exit(1);
+	}
+	printf("\t%s, %s (as expected)\n", script ? script : "<NULL>", modifier ? modifier : "<NULL>");
+	FreeLocaleChunks(lc);
+}
+
+void TestLocaleContext()
+{
+	LocaleContext* context;
+	LocaleArena arena;
+	LocaleChunks* lc;
+	char arenaBuffer[1024], buffer[64];
+	char* unicodeID;
+	size_t i;
+	printf("Converting in a context\n");
+	context = (LocaleContext*)malloc(sizeof(LocaleContext));
+	InitLocaleArena(&arena, arenaBuffer, sizeof(arenaBuffer), NULL);
+	InitLocaleContext(context, &arena.allocator, 0);
+	for (i = 0; i < 3; i++) {
+		if (ConvertLocaleIDInContext(context, "sr@latin", 8, LOCALE_STREAM_INPUT_GETTEXT, LOCALE_FORMAT_BCP47, buffer, sizeof(buffer)) != 7 || strcmp(buffer, "sr-Latn")) {
+			printf("\tERROR: expected sr-Latn, calculated: %s\n", buffer);
+			exit(1);
+		}
+	}
+	if (ConvertLocaleIDInContext(context, "sr@latin", 8, LOCALE_STREAM_INPUT_GETTEXT, LOCALE_FORMAT_BCP47, buffer, 3) != 7 || strcmp(buffer, "sr")) {
+		printf("\tERROR: expected the cached result to be truncated to sr, calculated: %s\n", buffer);
+		exit(1);
+	}
+	if (ConvertLocaleIDInContext(context, "qq-", 3, LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_GETTEXT, buffer, sizeof(buffer)) || ConvertLocaleIDInContext(context, "qq-", 3, LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_GETTEXT, buffer, sizeof(buffer)) || buffer[0]) {
+		printf("\tERROR: the invalid ID should have been rejected\n");
+		exit(1);
+	}
+	if (context->stats.cacheHits != 4 || context->stats.cacheMisses != 2 || context->stats.scanned != 1 || context->stats.rejected != 1) {
+		printf("\tERROR: unexpected statistics (hits: %u, misses: %u, scanned: %u, rejected: %u)\n", (unsigned int)context->stats.cacheHits, (unsigned int)context->stats.cacheMisses, (unsigned int)context->stats.scanned, (unsigned int)context->stats.rejected);
+		exit(1);
+	}
+	printf("\tsr@latin -> sr-Latn, 4 cache hits (as expected)\n");
+	printf("Parsing in a context\n");
+	context->maxVariants = 1;
+	lc = LocaleIDToLocaleChunksInContext(context, "ca-ES-VALENCIA", 14, LOCALE_STREAM_INPUT_UNICODE);
+	unicodeID = LocaleChunksToLocaleIDInContext(context, lc, LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE);
+	if ((char*)lc < arenaBuffer || (char*)lc >= arenaBuffer + sizeof(arenaBuffer)) {
+		printf("\tERROR: the chunks should have been allocated in the arena\n");
+		exit(1);
+	}
+	if (!unicodeID || strcmp(unicodeID, "ca_ES_VALENCIA") || (char*)unicodeID < arenaBuffer || (char*)unicodeID >= arenaBuffer + sizeof(arenaBuffer)) {
+		printf("\tERROR: expected ca_ES_VALENCIA allocated in the arena, calculated: %s\n", unicodeID ? unicodeID : "<NULL>");
+		exit(1);
+	}
+	if (LocaleIDToLocaleChunksInContext(context, "sl-IT-ROZAJ-NEDIS", 17, LOCALE_STREAM_INPUT_UNICODE)) {
+		printf("\tERROR: the ID with too many variants should have been rejected\n");
+		exit(1);
+	}
+	context->maxLength = 4;
+	if (LocaleIDToLocaleChunksInContext(context, "en-US", 5, LOCALE_STREAM_INPUT_UNICODE)) {
+		printf("\tERROR: the ID longer than the limit should have been rejected\n");
+		exit(1);
+	}
+	printf("\tca_ES_VALENCIA, limits applied (as expected)\n");
+	ReleaseLocaleArena(&arena);
+	free(context);
+	printf("Converting in the default context\n");
+	if (ConvertLocaleIDInContext(NULL, "it_IT.utf8@euro", 15, LOCALE_STREAM_INPUT_GETTEXT, LOCALE_FORMAT_BCP47, buffer, sizeof(buffer)) != 5 || strcmp(buffer, "it-IT")) {
+		printf("\tERROR: expected it-IT, calculated: %s\n", buffer);
+		exit(1);
+	}
+	printf("\tit-IT (as expected)\n");
+}
+
+void TestRegisteredLocaleID(const char* id, int expected)
+{
+	LocaleContext* context;
+	LocaleChunks* lc;
+	int registered;
+	printf("Strict validation of \"%s\"\n", id);
+	context = (LocaleContext*)malloc(sizeof(LocaleContext));
+	InitLocaleContext(context, NULL, LOCALE_CONTEXT_STRICT);
+	lc = LocaleIDToLocaleChunksInContext(context, id, strlen(id), LOCALE_STREAM_INPUT_UNICODE | LOCALE_STREAM_INPUT_GETTEXT);
+	registered = lc != NULL;
+	if (registered != expected || context->stats.rejected != (size_t)!expected) {
+		printf("\tERROR: expected %s, calculated: %s\n", expected ? "registered" : "not registered", registered ? "registered" : "not registered");
+		exit(1);
+	}
+	if (lc && !IsRegisteredLocaleChunks(lc)) {
+		printf("\tERROR: the LocaleChunks should be registered too\n");
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", registered ? "registered" : "not registered");
+	FreeLocaleChunks(lc);
+	free(context);
+}
+
+void TestTerritoryLocales(const char* territory, size_t maxCount, const char* expected)
+{
+	const LocaleKey* keys;
+	char list[256], id[32];
+	size_t count, length, i;
+	printf("Locales of the territory \"%s\"\n", territory);
+	count = GetLocaleTerritoryLocaleKeys(territory, strlen(territory), &keys);
+	length = 0;
+	list[0] = '\0';
+	for (i = 0; i < count && i < maxCount; i++) {
+		FormatLocaleKey(keys[i], LOCALE_FORMAT_GETTEXT, id, sizeof(id));
+		length += (size_t)snprintf(list + length, sizeof(list) - length, "%s%s", i ? " " : "", id);
+	}
+	if (strcmp(list, expected)) {
+		printf("\tERROR: expected \"%s\", calculated: \"%s\"\n", expected, list);
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", list);
+}
+
+/*
+ * Lists the locale IDs of a LocaleSet (in Unicode format) in a buffer.
+ */
+void ListLocaleSet(const LocaleSet* set, const LocaleIDRegistry* registry, char* buffer, size_t size)
+{
+	size_t position, length;
+	int id;
+	position = 0;
+	length = 0;
+	buffer[0] = '\0';
+	while ((id = NextLocaleSetID(set, &position)) >= 0 && length < size) {
+		if (length) {
+			buffer[length++] = ' ';
+		}
+		if (GetLocaleIDRegistryName(registry, id)) {
+			length += (size_t)snprintf(buffer + length, size - length, "%s", GetLocaleIDRegistryName(registry, id));
 		} else {
-			length += strlen(lc->language ? lc->language : script);
+			length += FormatLocaleKey(GetLocaleIDRegistryKey(registry, id), LOCALE_FORMAT_UNICODE, buffer + length, size - length);
+		}
+	}
+}
+
+void TestLocaleSets()
+{
+	static const char* const domainLocales[] = {"it_IT.utf8", "de-CH", "fr_CH", "sr@latin", "POSIX", "ca_ES.utf8@valencia"};
+	static const char* const tenantLocales[] = {"DE_ch", "sr-Latn", "ca_ES@Valencia", "ca_ES", "en", "not a locale"};
+	LocaleIDRegistry registry;
+	LocaleSet a, b, result;
+	char list[128];
+	size_t position;
+	int id, expected;
+	printf("Intersecting and uniting sets of locales\n");
+	InitLocaleIDRegistry(&registry, NULL);
+	InitLocaleSet(&a, NULL);
+	InitLocaleSet(&b, NULL);
+	InitLocaleSet(&result, NULL);
+	AddLocaleIDsToLocaleSet(&a, &registry, domainLocales, 6);
+	AddLocaleIDsToLocaleSet(&b, &registry, tenantLocales, 6);
+	if (registry.count != 8 || FindLocaleKeyID(&registry, LocaleIDToLocaleKey("sr_Latn", 7)) != 3 || RegisterLocaleID(&registry, "ca_ES@valencia", 14) != 5 || registry.count != 8) {
+		printf("\tERROR: unexpected registered IDs\n");
+		exit(1);
+	}
+	IntersectLocaleSets(&result, &a, &b);
+	ListLocaleSet(&result, &registry, list, sizeof(list));
+	if (strcmp(list, "de_CH sr_Latn ca_ES@valencia")) {
+		printf("\tERROR: expected intersection \"de_CH sr_Latn ca_ES@valencia\", calculated: \"%s\"\n", list);
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", list);
+	UniteLocaleSets(&result, &a, &b);
+	ListLocaleSet(&result, &registry, list, sizeof(list));
+	if (strcmp(list, "it_IT de_CH fr_CH sr_Latn posix ca_ES@valencia ca_ES en")) {
+		printf("\tERROR: expected union \"it_IT de_CH fr_CH sr_Latn posix ca_ES@valencia ca_ES en\", calculated: \"%s\"\n", list);
+		exit(1);
+	}
+	printf("\t%s (as expected)\n", list);
+	printf("Intersecting and uniting large sets of locales\n");
+	FreeLocaleSet(&a);
+	FreeLocaleSet(&b);
+	for (id = 0; id < 10000; id += 2) {
+		AddToLocaleSet(&a, id);
+	}
+	for (id = 0; id < 15000; id += 3) {
+		AddToLocaleSet(&b, id);
+	}
+	IntersectLocaleSets(&result, &a, &b);
+	if (!a.bitmap || !b.bitmap || result.bitmap || result.count != 1667 || LocaleSetContains(&result, 4) || !LocaleSetContains(&result, 9996)) {
+		printf("\tERROR: unexpected intersection of bitmaps (%u IDs)\n", (unsigned int)result.count);
+		exit(1);
+	}
+	UniteLocaleSets(&result, &a, &b);
+	if (!result.bitmap || result.count != 5000 + 5000 - 1667) {
+		printf("\tERROR: unexpected union of bitmaps (%u IDs)\n", (unsigned int)result.count);
+		exit(1);
+	}
+	for (position = 0, expected = 0; (id = NextLocaleSetID(&result, &position)) >= 0; expected++) {
+		while (!(expected < 10000 && expected % 2 == 0) && expected % 3) {
+			expected++;
+		}
+		if (id != expected) {
+			printf("\tERROR: expected ID %d, found %d\n", expected, id);
+			exit(1);
+		}
+	}
+	FreeLocaleSet(&b);
+	AddToLocaleSet(&b, 3);
+	AddToLocaleSet(&b, 4);
+	AddToLocaleSet(&b, 20000);
+	IntersectLocaleSets(&result, &b, &a);
+	if (result.count != 1 || !LocaleSetContains(&result, 4)) {
+		printf("\tERROR: unexpected intersection of an array and a bitmap (%u IDs)\n", (unsigned int)result.count);
+		exit(1);
+	}
+	printf("\t%u IDs (as expected)\n", 5000 + 5000 - 1667);
+	FreeLocaleSet(&a);
+	FreeLocaleSet(&b);
+	FreeLocaleSet(&result);
+	FreeLocaleIDRegistry(&registry);
+}
+
+static int CompareLocaleIDStrings(const void* a, const void* b)
+{
+	return strcmp((const char*)a, (const char*)b);
+}
+
+void TestSortLocaleKeys()
+{
+	static const char* const ids[] = {"zh-Hant-TW", "en_US", "root", "es-419", "Latn-IT", "eng", "en", "es_AR", "sr@latin", "en-Latn", "sr_RS@latin", "en_001", "Cyrl", "it", "en-US", "ar_EG"};
+	LocaleKey keys[16], keyScratch[16];
+	LocaleKeyRow rows[16], rowScratch[16];
+	char expected[16][32], sorted[32];
+	size_t count, i;
+	printf("Sorting locale keys\n");
+	count = sizeof(ids) / sizeof(ids[0]);
+	for (i = 0; i < count; i++) {
+		keys[i] = LocaleIDToLocaleKey(ids[i], strlen(ids[i]));
+		rows[i].key = keys[i];
+		rows[i].row = i;
+		FormatLocaleKey(keys[i], LOCALE_FORMAT_UNICODE, expected[i], sizeof(expected[i]));
+	}
+	qsort(expected, count, sizeof(expected[0]), CompareLocaleIDStrings);
+	SortLocaleKeys(keys, count, keyScratch);
+	SortLocaleKeyRows(rows, count, rowScratch);
+	for (i = 0; i < count; i++) {
+		FormatLocaleKey(keys[i], LOCALE_FORMAT_UNICODE, sorted, sizeof(sorted));
+		if (strcmp(sorted, expected[i]) || rows[i].key != keys[i]) {
+			printf("\tERROR: expected %s at position %u, found %s\n", expected[i], (unsigned int)i, sorted);
+			exit(1);
+		}
+		if (i && rows[i].key == rows[i - 1].key && rows[i].row < rows[i - 1].row) {
+			printf("\tERROR: the rows with the same key should keep their order\n");
+			exit(1);
+		}
+	}
+	printf("\t%s ... %s (as expected)\n", expected[0], expected[count - 1]);
+}
+
+void TestBulkLocaleIDs()
+{
+	static const char* const catalogs[] = {"sr@latin", "it_IT.utf8", "de_DE", "sr_RS@latin", "xx-", "IT_it", "sr"};
+	static const char* const configured[] = {"sr-Latn", "de-DE", "fr", "DE-de"};
+	static const char* const variants[] = {"ca_ES@valencia", "de_DE", "it_IT.UTF-8", "C", "ca-ES", "de-DE-1901", "CA_es@Valencia", "POSIX"};
+	static const char* const available[] = {"ca-ES", "de_DE_1901", "C"};
+	size_t indices[16], invalid[16], count, invalidCount;
+	printf("Bulk operations on locale IDs\n");
+	count = DedupeLocaleIDs(catalogs, 7, NULL, indices, invalid, &invalidCount);
+	if (count != 5 || indices[0] != 0 || indices[1] != 1 || indices[2] != 2 || indices[3] != 3 || indices[4] != 6 || invalidCount != 1 || invalid[0] != 4) {
+		printf("\tERROR: unexpected distinct locales (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	if (DedupeLocaleIDs(catalogs, 7, NULL, indices, invalid, NULL) != 5 || SubtractLocaleIDs(catalogs, 7, configured, 4, NULL, indices, invalid, NULL) != 3) {
+		printf("\tERROR: the invalid indices should be ignored without invalidCount\n");
+		exit(1);
+	}
+	count = UniteLocaleIDs(catalogs, 7, configured, 4, NULL, indices, NULL, NULL);
+	if (count != 6 || indices[4] != 6 || indices[5] != 7 + 2) {
+		printf("\tERROR: unexpected union (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	count = IntersectLocaleIDs(catalogs, 7, configured, 4, NULL, indices, NULL, NULL);
+	if (count != 2 || indices[0] != 0 || indices[1] != 2) {
+		printf("\tERROR: unexpected intersection (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	count = SubtractLocaleIDs(catalogs, 7, configured, 4, NULL, indices, invalid, &invalidCount);
+	if (count != 3 || indices[0] != 1 || indices[1] != 3 || indices[2] != 6 || invalidCount != 1 || invalid[0] != 4) {
+		printf("\tERROR: unexpected difference (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	printf("\tmissing: %s, %s, %s (as expected)\n", catalogs[indices[0]], catalogs[indices[1]], catalogs[indices[2]]);
+	count = DedupeLocaleIDs(variants, 8, NULL, indices, invalid, &invalidCount);
+	if (count != 6 || indices[0] != 0 || indices[1] != 1 || indices[2] != 3 || indices[3] != 4 || indices[4] != 5 || indices[5] != 7 || invalidCount != 1 || invalid[0] != 2) {
+		printf("\tERROR: unexpected distinct locales with variants and modifiers (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	count = IntersectLocaleIDs(variants, 8, available, 3, NULL, indices, NULL, NULL);
+	if (count != 3 || indices[0] != 3 || indices[1] != 4 || indices[2] != 5) {
+		printf("\tERROR: unexpected intersection with variants and modifiers (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	count = SubtractLocaleIDs(variants, 8, available, 3, NULL, indices, invalid, &invalidCount);
+	if (count != 3 || indices[0] != 0 || indices[1] != 1 || indices[2] != 7 || invalidCount != 1 || invalid[0] != 2) {
+		printf("\tERROR: unexpected difference with variants and modifiers (%u)\n", (unsigned int)count);
+		exit(1);
+	}
+	printf("\tmissing: %s, %s, %s; invalid: %s (as expected)\n", variants[indices[0]], variants[indices[1]], variants[indices[2]], variants[invalid[0]]);
+}
+
+void TestLocaleAggregator()
+{
+	static const char* const lines[] = {"sr@latin", "it_IT.utf8", "sr-Latn", "en", "SR_latn", "qq-", "it-IT", "de", "fr", "sr_Latn", "es", "it_IT"};
+	LocaleAggregator* aggregators;
+	LocaleAggregatorEntry top[4];
+	char id[32];
+	size_t count, i;
+	int k;
+	printf("Aggregating locale IDs\n");
+	aggregators = (LocaleAggregator*)malloc(3 * sizeof(LocaleAggregator));
+	/* Exact counts in two "threads", and a Space-Saving summary of 3 keys */
+	InitLocaleAggregator(&aggregators[0], 0, NULL);
+	InitLocaleAggregator(&aggregators[1], 0, NULL);
+	InitLocaleAggregator(&aggregators[2], 3, NULL);
+	for (k = 0; k < 2; k++) {
+		for (i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+			AggregateLocaleID(&aggregators[i % 2], lines[i], strlen(lines[i]));
+			AggregateLocaleID(&aggregators[2], lines[i], strlen(lines[i]));
 		}
-		if (lc->territory) {
-			length += 1 + strlen(lc->territory);
+	}
+	MergeLocaleAggregators(&aggregators[0], &aggregators[1]);
+	count = GetLocaleAggregatorTop(&aggregators[0], top, 4);
+	if (aggregators[0].total != 24 || aggregators[0].invalid != 2 || aggregators[0].count != 6 || count != 4) {
+		printf("\tERROR: unexpected totals (%u keys)\n", (unsigned int)aggregators[0].count);
+		exit(1);
+	}
+	FormatLocaleKey(top[0].key, LOCALE_FORMAT_UNICODE, id, sizeof(id));
+	if (strcmp(id, "sr_Latn") || top[0].count != 8 || GetLocaleAggregatorCount(&aggregators[0], LocaleIDToLocaleKey("it", 2)) || top[1].count != 6 || top[2].count != 2 || CompareLocaleKeys(top[2].key, top[3].key) >= 0) {
+		printf("\tERROR: unexpected top locale %s (%u)\n", id, (unsigned int)top[0].count);
+		exit(1);
+	}
+	printf("\t%s: %u (as expected)\n", id, (unsigned int)top[0].count);
+	printf("Finding the heavy hitters of locale IDs\n");
+	count = GetLocaleAggregatorTop(&aggregators[2], top, 2);
+	FormatLocaleKey(top[0].key, LOCALE_FORMAT_UNICODE, id, sizeof(id));
+	if (aggregators[2].count != 3 || count != 2 || strcmp(id, "sr_Latn") || top[0].count - top[0].error > 8 || top[0].count < 8 || top[1].count < 6) {
+		printf("\tERROR: unexpected heavy hitter %s (%u)\n", id, (unsigned int)top[0].count);
+		exit(1);
+	}
+	printf("\t%s: %u (as expected)\n", id, (unsigned int)top[0].count);
+	for (k = 0; k < 3; k++) {
+		FreeLocaleAggregator(&aggregators[k]);
+	}
+	printf("Merging the heavy hitters of locale IDs\n");
+	/* en x5, fr, de -> {en: 5, de: 2 (error 1)}; it x4, es, fr -> {it: 4, fr: 2 (error 1)} */
+	InitLocaleAggregator(&aggregators[0], 2, NULL);
+	InitLocaleAggregator(&aggregators[1], 2, NULL);
+	InitLocaleAggregator(&aggregators[2], 0, NULL);
+	AggregateLocaleKey(&aggregators[0], LocaleIDToLocaleKey("en", 2), 5);
+	AggregateLocaleKey(&aggregators[0], LocaleIDToLocaleKey("fr", 2), 1);
+	AggregateLocaleKey(&aggregators[0], LocaleIDToLocaleKey("de", 2), 1);
+	AggregateLocaleKey(&aggregators[1], LocaleIDToLocaleKey("it", 2), 4);
+	AggregateLocaleKey(&aggregators[1], LocaleIDToLocaleKey("es", 2), 1);
+	AggregateLocaleKey(&aggregators[1], LocaleIDToLocaleKey("fr", 2), 1);
+	if (!MergeLocaleAggregators(&aggregators[2], &aggregators[1]) || aggregators[2].count != 2 || GetLocaleAggregatorTop(&aggregators[2], top, 4) != 2 || top[1].count != 2 || top[1].error != 1) {
+		printf("\tERROR: the error has not been kept\n");
+		exit(1);
+	}
+	/* en: 5 + 2 (error 2), it: 4 + 2 (error 2), de and fr: 2 + 2 (error 3) */
+	if (!MergeLocaleAggregators(&aggregators[0], &aggregators[1]) || GetLocaleAggregatorTop(&aggregators[0], top, 4) != 2) {
+		printf("\tERROR: the merged aggregator should have 2 keys\n");
+		exit(1);
+	}
+	FormatLocaleKey(top[0].key, LOCALE_FORMAT_UNICODE, id, sizeof(id));
+	FormatLocaleKey(top[1].key, LOCALE_FORMAT_UNICODE, id + 16, sizeof(id) - 16);
+	if (strcmp(id, "en") || top[0].count != 7 || top[0].error != 2 || strcmp(id + 16, "it") || top[1].count != 6 || top[1].error != 2) {
+		printf("\tERROR: unexpected merged heavy hitters %s (%u, error %u), %s (%u, error %u)\n", id, (unsigned int)top[0].count, (unsigned int)top[0].error, id + 16, (unsigned int)top[1].count, (unsigned int)top[1].error);
+		exit(1);
+	}
+	/* The smallest count (it) is replaced */
+	AggregateLocaleKey(&aggregators[0], LocaleIDToLocaleKey("de", 2), 1);
+	if (GetLocaleAggregatorCount(&aggregators[0], LocaleIDToLocaleKey("de", 2)) != 7 || GetLocaleAggregatorCount(&aggregators[0], LocaleIDToLocaleKey("en", 2)) != 7) {
+		printf("\tERROR: the key with the smallest count has not been replaced\n");
+		exit(1);
+	}
+	printf("\t%s: %u (error %u), %s: %u (error %u) (as expected)\n", id, (unsigned int)top[0].count, (unsigned int)top[0].error, id + 16, (unsigned int)top[1].count, (unsigned int)top[1].error);
+	for (k = 0; k < 3; k++) {
+		FreeLocaleAggregator(&aggregators[k]);
+	}
+	free(aggregators);
+}
+
+/*
+ * Collects the output of a LocaleJSONLinesWriter in a null-terminated string (the userData, big enough).
+ */
+static void CollectLocaleJSONLinesForTest(void* userData, const char* data, size_t length)
+{
+	char* output;
+	output = (char*)userData;
+	output += strlen(output);
+	memcpy(output, data, length);
+	output[length] = '\0';
+}
+
+void TestLocaleJSONLines()
+{
+	static const char* const lines[] = {"sr@latin", "de-DE-1996-u-co-phonebk", "root", "q\"\\\x01\xe8"};
+	static const char* const expected = ""
+		"{\"input\":\"sr@latin\",\"valid\":true,\"root\":false,\"language\":\"sr\",\"territory\":null,\"codeset\":null,\"modifier\":\"latin\",\"script\":null,\"variants\":[],\"extensions\":null,\"gettext\":\"sr@latin\",\"unicode\":\"sr_Latn\"}\n"
+		"{\"input\":\"de-DE-1996-u-co-phonebk\",\"valid\":true,\"root\":false,\"language\":\"de\",\"territory\":\"DE\",\"codeset\":null,\"modifier\":null,\"script\":null,\"variants\":[\"1996\"],\"extensions\":\"u-co-phonebk\",\"gettext\":\"de_DE\",\"unicode\":\"de_DE_1996_u_co_phonebk\"}\n"
+		"{\"input\":\"root\",\"valid\":true,\"root\":true,\"language\":null,\"territory\":null,\"codeset\":null,\"modifier\":null,\"script\":null,\"variants\":[],\"extensions\":null,\"gettext\":null,\"unicode\":\"root\"}\n"
+		"{\"input\":\"q\\\"\\\\\\u0001\\u00e8\",\"valid\":false}\n";
+	LocaleJSONLinesWriter writer;
+	char buffer[64], *output, *expectedOutput, *bigBuffer, *longID;
+	const char** list;
+	LocaleContext* context;
+	size_t size, i;
+	unsigned int threadCount;
+	printf("Exporting locale IDs to JSON Lines\n");
+	output = (char*)malloc(4096);
+	/* A tiny buffer, a small one and a big one (with threads, if available) */
+	for (size = 1, threadCount = 1; size <= 64; size *= 8, threadCount++) {
+		output[0] = '\0';
+		InitLocaleJSONLinesWriter(&writer, buffer, size, CollectLocaleJSONLinesForTest, output);
+		if (!ExportLocaleIDsToJSONLines(&writer, lines, 4, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, threadCount, NULL)) {
+			printf("\tERROR: export failed\n");
+			exit(1);
 		}
-		for (i = 0; i < lc->variantCount; i++) {
-			length += 1 + strlen(lc->variants[i]);
-		}
-		result = (char*)malloc(length * sizeof(char));
-		if(result) {
-			if (lc->isRoot) {
-				strcpy(result, "root");
-			} else if (lc->language) {
-				strcpy(result, lc->language);
-				if (script) {
-					strcat(result, "_");
-					strcat(result, script);
-				}
-			} else {
-				strcpy(result, script);
-			}
-			if (lc->territory) {
-				strcat(result, "_");
-				strcat(result, lc->territory);
-			}
-			for (i = 0; i < lc->variantCount; i++) {
-				strcat(result, "_");
-				strcat(result, lc->variants[i]);
-			}
+		if (strcmp(output, expected)) {
+			printf("\tERROR: unexpected output with a buffer of %u bytes:\n%s\n", (unsigned int)size, output);
+			exit(1);
 		}
+		printf("\t%u bytes with a buffer of %u bytes (as expected)\n", (unsigned int)strlen(output), (unsigned int)size);
 	}
-	return result;
+	free(output);
+	/* More rounds (with threads, if available), with an identifier too long for the buffers of the threads */
+	list = (const char**)malloc(3000 * sizeof(const char*));
+	longID = (char*)malloc(50001);
+	memset(longID, 'a', 50000);
+	longID[50000] = '\0';
+	for (i = 0; i < 3000; i++) {
+		list[i] = i == 1234 ? longID : lines[i % 4];
+	}
+	output = (char*)malloc(1 << 21);
+	expectedOutput = (char*)malloc(1 << 21);
+	expectedOutput[0] = '\0';
+	bigBuffer = (char*)malloc(1 << 16);
+	InitLocaleJSONLinesWriter(&writer, bigBuffer, 1 << 16, CollectLocaleJSONLinesForTest, expectedOutput);
+	ExportLocaleIDsToJSONLines(&writer, list, 3000, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, 1, NULL);
+	output[0] = '\0';
+	InitLocaleJSONLinesWriter(&writer, bigBuffer, 1 << 16, CollectLocaleJSONLinesForTest, output);
+	context = (LocaleContext*)malloc(sizeof(LocaleContext));
+	InitLocaleContext(context, &LocaleMallocAllocator, 0);
+	context->maxLength = LOCALE_ID_MAX_LENGTH;
+	if (!ExportLocaleIDsToJSONLines(&writer, list, 3000, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, 4, context) || strcmp(output, expectedOutput)) {
+		printf("\tERROR: the output of 4 threads is different\n");
+		exit(1);
+	}
+	/* 3 valid IDs out of 4, but the long one takes the place of a valid one */
+	if (context->stats.scanned != 2249 || context->stats.rejected != 751) {
+		printf("\tERROR: unexpected statistics (scanned: %u, rejected: %u)\n", (unsigned int)context->stats.scanned, (unsigned int)context->stats.rejected);
+		exit(1);
+	}
+	free(context);
+	printf("\t%u bytes for 3000 locale IDs with 4 threads (as expected)\n", (unsigned int)strlen(output));
+	free(list);
+	free(longID);
+	free(output);
+	free(expectedOutput);
+	free(bigBuffer);
 }
 
-
-/************************/
-/* Simple testing stuff */
-/************************/
-void DumpLocaleChunksID(LocaleChunks* lc, const char* which, const char* expected, char* calculated)
+void TestLocaleRouter()
 {
-	int die;
-	die = 0;
-	if (expected && calculated && strcasecmp(expected, calculated)) {
-		printf("\t\tERROR: expected %s ID: %s, calculated: %s\n", which, expected, calculated);
-		die = 1;
-	} else if ((!expected) != (!calculated)) {
-		printf("\t\tERROR: expected %s ID: %s, calculated: %s\n", which, expected ? expected : "<NULL>", calculated ? calculated : "<NULL>");
-		die = 1;
-	} else {
-		printf("\t\t%s ID: %s (as expected)\n", which, expected ? expected : "<NULL>");
+	static const char* const locales[] = {"it_IT", "pt-BR", "sr@latin", "root", "de_CH.utf8", "it"};
+	static const struct {
+		const char* path;
+		int id;
+		const char* rest;
+	} routes[] = {
+		{"/it-it/page", 0, "/page"},
+		{"/PT_br?x=1", 1, "?x=1"},
+		{"/sr-latn/", 2, "/"},
+		{"/sr@Latin", 2, ""},
+		{"/und/x", 3, "/x"},
+		{"/ROOT#top", 3, "#top"},
+		{"/de-ch.UTF8/", 4, "/"},
+		{"/de_CH/", 4, "/"},
+		{"it_IT", 0, ""},
+		{"/It/", 5, "/"},
+		{"/i/", LOCALE_ROUTER_NO_MATCH, NULL},
+		{"/it-itx/", LOCALE_ROUTER_NO_MATCH, NULL},
+		{"/it!/", LOCALE_ROUTER_NO_MATCH, NULL},
+		{"//it/", LOCALE_ROUTER_NO_MATCH, NULL},
+		{"/", LOCALE_ROUTER_NO_MATCH, NULL},
+	};
+	static const char* const invalid[] = {"it_IT", "qq-"};
+	LocaleRouter router;
+	const char* rest;
+	size_t i;
+	int id;
+	printf("Routing paths by locale prefix\n");
+	if (CompileLocaleRouter(&router, invalid, 2, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, NULL)) {
+		printf("\tERROR: a router with an invalid locale has been compiled\n");
+		exit(1);
 	}
-	if (calculated) {
-		free(calculated);
+	if (!CompileLocaleRouter(&router, locales, 6, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, NULL)) {
+		printf("\tERROR: the router could not be compiled\n");
+		exit(1);
 	}
-	if (die) {
+	for (i = 0; i < sizeof(routes) / sizeof(routes[0]); i++) {
+		id = RouteLocalePath(&router, routes[i].path, strlen(routes[i].path), &rest);
+		if (id != routes[i].id || strcmp(rest, routes[i].rest ? routes[i].rest : routes[i].path)) {
+			printf("\tERROR: %s routed to %d with %s\n", routes[i].path, id, rest);
+			exit(1);
+		}
+		printf("\t%s: %d (as expected)\n", routes[i].path, id);
+	}
+	FreeLocaleRouter(&router);
+}
+
+void TestLocalePluralRules()
+{
+	static const struct {
+		const char* locale;
+		const char* number;
+		unsigned int category;
+	} cases[] = {
+		{"en_US", "1", LOCALE_PLURAL_ONE},
+		{"en_US", "1.0", LOCALE_PLURAL_OTHER},
+		{"ja_JP", "1", LOCALE_PLURAL_OTHER},
+		{"ru_RU", "21", LOCALE_PLURAL_ONE},
+		{"ru_RU", "11", LOCALE_PLURAL_MANY},
+		{"ru_RU", "1.5", LOCALE_PLURAL_OTHER},
+		{"pl_PL", "22", LOCALE_PLURAL_FEW},
+		{"ar_EG", "0", LOCALE_PLURAL_ZERO},
+		{"ar_EG", "102", LOCALE_PLURAL_OTHER},
+		{"ar_EG", "103", LOCALE_PLURAL_FEW},
+		{"cy_GB", "2", LOCALE_PLURAL_TWO},
+		{"fr_FR", "0.5", LOCALE_PLURAL_ONE},
+		{"fr_FR", "1c6", LOCALE_PLURAL_MANY},
+		{"fr_FR", "1.2c3", LOCALE_PLURAL_OTHER},
+		{"pt_BR", "0", LOCALE_PLURAL_ONE},
+		{"pt_PT", "0", LOCALE_PLURAL_OTHER},
+		{"pt_AO", "1", LOCALE_PLURAL_ONE},
+		{"bs@latin", "2.3", LOCALE_PLURAL_FEW},
+		{"C", "1", LOCALE_PLURAL_OTHER},
+	};
+	LocalePluralOperands operands;
+	LocaleChunks* lc;
+	unsigned int category;
+	size_t i;
+	printf("Selecting plural categories\n");
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		lc = GettextLocaleIDToLocaleChunks(cases[i].locale);
+		if (!lc || !ParseLocalePluralOperands(&operands, cases[i].number, strlen(cases[i].number))) {
+			printf("\tERROR: failed to parse %s %s\n", cases[i].locale, cases[i].number);
+			exit(1);
+		}
+		category = SelectLocalePluralCategory(GetLocaleChunksPluralRules(lc), &operands);
 		FreeLocaleChunks(lc);
+		if (category != cases[i].category) {
+			printf("\tERROR: %s %s is %s instead of %s\n", cases[i].locale, cases[i].number, GetLocalePluralCategoryName(category), GetLocalePluralCategoryName(cases[i].category));
+			exit(1);
+		}
+		printf("\t%s %s: %s (as expected)\n", cases[i].locale, cases[i].number, GetLocalePluralCategoryName(category));
+	}
+	if (!ParseLocalePluralOperands(&operands, "-1.50", 5) || operands.i != 1 || operands.v != 2 || operands.f != 50 || operands.w != 1 || operands.t != 5) {
+		printf("\tERROR: unexpected operands of -1.50\n");
+		exit(1);
+	}
+	if (ParseLocalePluralOperands(&operands, "1.", 2) || ParseLocalePluralOperands(&operands, "1c", 2) || ParseLocalePluralOperands(&operands, "1234567890123456789", 19)) {
+		printf("\tERROR: invalid numbers have been parsed\n");
 		exit(1);
 	}
 }
-void DumpLocaleChunks(LocaleChunks* lc, const char* expectedGettextID, const char* expectedUnicodeID)
+
+void TestLocaleIDParser()
 {
-	size_t i;
-	if (!lc) {
-		printf("\t\t<NULL>\n");
-	} else {
-		printf("\t\tUnicode root? %s\n", lc->isRoot ? "yes" : "no");
-		printf("\t\tlanguage: %s\n", lc->language ? lc->language : "<NULL>");
-		printf("\t\tterritory: %s\n", lc->territory ? lc->territory : "<NULL>");
-		printf("\t\tcodeset: %s\n", lc->codeset ? lc->codeset : "<NULL>");
-		printf("\t\tmodifier: %s\n", lc->modifier ? lc->modifier : "<NULL>");
-		printf("\t\tscript: %s\n", lc->script ? lc->script : "<NULL>");
-		if (!lc->variantCount) {
-			printf("\t\tno variants\n");
-		} else {
-			for (i = 0; i < lc->variantCount; i++) {
-				printf("\t\tvariant %lu: %s\n", (long unsigned int) i, lc->variants[i]);
+	static const char* const lines[] = {"sr@latin", "it_IT.utf8@euro", "de-DE-1996-u-co-phonebk", "root", "root-US", "Latn-RS", "zh-Hant_TW", "de-DE-1996-fonipa-u-co-phonebk-x-a-b", "sl_IT_rozaj_biske", "ca_ES.utf8@valencia", "it__IT", "it_IT@euro.utf8", "en-US!", "-en", "en-", "en-u", "en-u-co-x", "x"};
+	LocaleIDParser parser;
+	LocaleChunkSlices slices;
+	LocaleChunks *lc, *expected;
+	char result[128], expectedResult[128];
+	char* pieces[3];
+	size_t length, i, j, k;
+	unsigned int inputFormats;
+	printf("Parsing locale IDs split across buffers\n");
+	inputFormats = LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE;
+	for (i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+		length = strlen(lines[i]);
+		expected = NULL;
+		if (ScanLocaleIDInFormats(lines[i], length, inputFormats, &slices)) {
+			expected = LocaleChunkSlicesToLocaleChunks(&slices);
+		}
+		FormatLocaleChunks(expected, LOCALE_FORMAT_UNICODE, expectedResult, sizeof(expectedResult));
+		/* Every way of splitting the identifier in three pieces */
+		for (j = 0; j <= length; j++) {
+			for (k = j; k <= length; k++) {
+				/* Pieces in separate buffers, so that the chunks spanning more of them must be copied */
+				pieces[0] = (char*)malloc(j + 1);
+				pieces[1] = (char*)malloc(k - j + 1);
+				pieces[2] = (char*)malloc(length - k + 1);
+				memcpy(pieces[0], lines[i], j);
+				memcpy(pieces[1], lines[i] + j, k - j);
+				memcpy(pieces[2], lines[i] + k, length - k);
+				InitLocaleIDParser(&parser, inputFormats);
+				FeedLocaleIDParser(&parser, pieces[0], j);
+				FeedLocaleIDParser(&parser, pieces[1], k - j);
+				lc = FinishLocaleIDParser(&parser, pieces[2], length - k);
+				free(pieces[0]);
+				free(pieces[1]);
+				free(pieces[2]);
+				FormatLocaleChunks(lc, LOCALE_FORMAT_UNICODE, result, sizeof(result));
+				if (!lc != !expected || strcmp(result, expectedResult) || (lc && lc->codeset && strcmp(lc->codeset, expected->codeset))) {
+					printf("\tERROR: \"%s\" split at %u and %u parsed as \"%s\" instead of \"%s\"\n", lines[i], (unsigned int)j, (unsigned int)k, result, expectedResult);
+					exit(1);
+				}
+				FreeLocaleChunks(lc);
 			}
 		}
-		DumpLocaleChunksID(lc, "Gettext", expectedGettextID, LocaleChunksToGettextLocaleID(lc));
-		DumpLocaleChunksID(lc, "Unicode", expectedUnicodeID, LocaleChunksToUnicodeLocaleID(lc));
+		printf("\t\"%s\" -> %s (as expected)\n", lines[i], expected ? expectedResult : "invalid");
+		FreeLocaleChunks(expected);
+	}
+	/* Invalid identifiers are rejected as soon as possible */
+	InitLocaleIDParser(&parser, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE);
+	if (!FeedLocaleIDParser(&parser, "it_IT", 5) || FeedLocaleIDParser(&parser, "-x.", 3) || FinishLocaleIDParser(&parser, "utf8", 4)) {
+		printf("\tERROR: an invalid locale ID has not been rejected early\n");
+		exit(1);
 	}
 }
-void Test(const char* id, int okForGettext, const char* expectedGettextID, int okForUnicode, const char* expectedUnicodeID)
+
+void TestBatchedLocaleContext()
 {
-	LocaleChunks* lc;
-	if (id) {
-		printf("\"%s\"\n", id);
-	} else {
-		printf("<NULL>\n");
+	static const char* const locales[] = {"sr@latin", "it_IT.utf8", "qq-", "de-DE-u-co-phonebk-ca-gregory-x-private", "sr@latin", "en"};
+	static const char* const expected = "sr-Latn\nit-IT\n\nde-DE-u-co-phonebk-ca-gregory-x-private\nsr-Latn\nen\n";
+	LocaleContext* context;
+	char buffer[128], single[64];
+	size_t converted, length, i;
+	int k;
+	printf("Converting batches in a context\n");
+	context = (LocaleContext*)malloc(sizeof(LocaleContext));
+	InitLocaleContext(context, NULL, 0);
+	if (ResizeLocaleContextCache(context, 1000) || !ResizeLocaleContextCache(context, 1024)) {
+		printf("\tERROR: unexpected result resizing the cache\n");
+		exit(1);
 	}
-	lc = GettextLocaleIDToLocaleChunks(id);
-	if (lc == NULL) {
-		if (okForGettext) {
-			printf("\tERROR: it should be valid for Gettext\n");
+	for (k = 0; k < 2; k++) {
+		length = ConvertLocaleIDsInContext(context, locales, 6, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_BCP47, buffer, sizeof(buffer), &converted);
+		if (length != strlen(expected) || strcmp(buffer, expected) || converted != 5) {
+			printf("\tERROR: unexpected output:\n%s\n", buffer);
 			exit(1);
 		}
-		printf("\tNot a Gettext identifier (as expected)\n");
-	} else if (!okForGettext) {
-		FreeLocaleChunks(lc);
-		printf("\tERROR: it has been detected as valid for Gettext, but it should't\n");
+	}
+	/* The long ID is never cached, "sr@latin" is found the second time in the first batch */
+	if (context->stats.cacheHits != 6 || context->stats.cacheMisses != 4) {
+		printf("\tERROR: unexpected statistics (hits: %u, misses: %u)\n", (unsigned int)context->stats.cacheHits, (unsigned int)context->stats.cacheMisses);
 		exit(1);
-	} else {
-		printf("\tValid Gettext identifier\n");
-		DumpLocaleChunks(lc, expectedGettextID, expectedUnicodeID);
-		FreeLocaleChunks(lc);
 	}
-	lc = UnicodeLocaleIDToLocaleChunks(id);
-	if (lc == NULL) {
-		if (okForUnicode) {
-			printf("\tERROR: it should be valid for Unicode\n");
+	for (i = 0; i <= strlen(expected) + 1; i++) {
+		memset(buffer, '*', sizeof(buffer));
+		if (ConvertLocaleIDsInContext(context, locales, 6, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_BCP47, buffer, i, NULL) != strlen(expected) || (i && (strncmp(buffer, expected, i - 1) || buffer[i - 1 < strlen(expected) ? i - 1 : strlen(expected)] != '\0')) || buffer[i] != '*') {
+			printf("\tERROR: unexpected output truncated to %u bytes\n", (unsigned int)i);
 			exit(1);
 		}
-		printf("\tNot an Unicode identifier (as expected)\n");
-	} else if (!okForUnicode) {
-		FreeLocaleChunks(lc);
-		printf("\tERROR: it has been detected as valid for Unicode, but it should't\n");
+	}
+	if (ConvertLocaleIDInContext(context, "it_IT.utf8", 10, LOCALE_STREAM_INPUT_GETTEXT, LOCALE_FORMAT_BCP47, single, sizeof(single)) != 5 || strcmp(single, "it-IT")) {
+		printf("\tERROR: expected it-IT, calculated: %s\n", single);
 		exit(1);
-	} else {
-		printf("\tValid Unicode identifier\n");
-		DumpLocaleChunks(lc, expectedGettextID, expectedUnicodeID);
+	}
+	printf("\t%u IDs converted (as expected)\n", (unsigned int)converted);
+	ResizeLocaleContextCache(context, 0);
+	free(context);
+}
+
+void TestLocaleContextLimits()
+{
+	static const char* const locales[] = {"it_IT", "qzz_IT", "de-DE-1996", "it-IT", "sr@latin"};
+	LocaleContext* context;
+	LocaleAggregator aggregator;
+	LocaleIDRegistry registry;
+	LocaleRouter router;
+	LocaleFallbackIterator iterator;
+	LocaleJSONLinesWriter writer;
+	LocaleChunks* lc;
+	size_t indices[5], invalid[5], invalidCount, count;
+	char buffer[256], output[1024];
+	printf("Applying the limits of a context to the other APIs\n");
+	context = (LocaleContext*)malloc(sizeof(LocaleContext));
+	/* Only registered subtags, without variants */
+	InitLocaleContext(context, &LocaleMallocAllocator, LOCALE_CONTEXT_STRICT);
+	context->maxVariants = 0;
+	count = DedupeLocaleIDs(locales, 5, context, indices, invalid, &invalidCount);
+	if (count != 2 || indices[0] != 0 || indices[1] != 4 || invalidCount != 2 || invalid[0] != 1 || invalid[1] != 2 || context->stats.scanned != 3 || context->stats.rejected != 2) {
+		printf("\tERROR: unexpected result of the bulk operation (%u locales, %u invalid)\n", (unsigned int)count, (unsigned int)invalidCount);
+		exit(1);
+	}
+	InitLocaleAggregator(&aggregator, 0, context);
+	if (AggregateLocaleID(&aggregator, "qzz_IT", 6) || !AggregateLocaleID(&aggregator, "it_IT", 5) || aggregator.invalid != 1) {
+		printf("\tERROR: the aggregator should only count it_IT\n");
+		exit(1);
+	}
+	FreeLocaleAggregator(&aggregator);
+	InitLocaleIDRegistry(&registry, context);
+	if (RegisterLocaleID(&registry, "de-DE-1996", 10) != -1 || RegisterLocaleID(&registry, "it_IT", 5) != 0) {
+		printf("\tERROR: the registry should only register it_IT\n");
+		exit(1);
+	}
+	FreeLocaleIDRegistry(&registry);
+	if (CompileLocaleRouter(&router, locales, 2, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, context)) {
+		printf("\tERROR: the router should have rejected qzz_IT\n");
+		exit(1);
+	}
+	if (!CompileLocaleRouter(&router, locales + 3, 2, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, context) || RouteLocalePath(&router, "/sr-latn/", 9, NULL) != 1) {
+		printf("\tERROR: the router should have matched sr-latn\n");
+		exit(1);
+	}
+	FreeLocaleRouter(&router);
+	output[0] = '\0';
+	InitLocaleJSONLinesWriter(&writer, buffer, sizeof(buffer), CollectLocaleJSONLinesForTest, output);
+	WriteLocaleIDJSONLine(&writer, "qzz_IT", 6, LOCALE_STREAM_INPUT_GETTEXT, context);
+	FlushLocaleJSONLinesWriter(&writer);
+	if (strcmp(output, "{\"input\":\"qzz_IT\",\"valid\":false}\n")) {
+		printf("\tERROR: unexpected JSON line: %s\n", output);
+		exit(1);
+	}
+	lc = LocaleIDToLocaleChunksInContext(NULL, "de-DE-1996", 10, LOCALE_STREAM_INPUT_UNICODE);
+	if (InitLocaleFallbackIterator(&iterator, lc, LOCALE_FORMAT_UNICODE, 0, context) || !InitLocaleFallbackIterator(&iterator, lc, LOCALE_FORMAT_UNICODE, 0, NULL)) {
+		printf("\tERROR: the fallback chain should only start without limits\n");
+		exit(1);
+	}
+	FreeLocaleChunks(lc);
+	printf("\t%u IDs scanned, %u rejected (as expected)\n", (unsigned int)context->stats.scanned, (unsigned int)context->stats.rejected);
+	free(context);
+}
+
+/*
+ * Simple benchmarking stuff (compile with -DBENCHMARK)
+ */
+#ifdef BENCHMARK
+
+#include <time.h>
+
+#define BENCHMARK_ITERATIONS 1000000
+
+/*
+ * Measures the time needed to scan and to format a list of locale identifiers.
+ */
+int BenchmarkScanICULocaleID(const char* locale, size_t length, LocaleChunkSlices* slices)
+{
+	static char extensions[LOCALE_EXTENSIONS_BUFFER_SIZE];
+	return ScanICULocaleID(locale, length, slices, extensions, sizeof(extensions));
+}
+void BenchmarkLocaleIDFormat(const char* name, int (*scan)(const char*, size_t, LocaleChunkSlices*), const char* const* ids, size_t count, unsigned int format)
+{
+	LocaleChunkSlices slices;
+	char buffer[96];
+	size_t lengths[16], i, total;
+	clock_t start;
+	double seconds;
+	for (i = 0; i < count; i++) {
+		lengths[i] = strlen(ids[i]);
+	}
+	total = 0;
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (scan(ids[i % count], lengths[i % count], &slices)) {
+			total += FormatLocaleChunkSlices(&slices, format, buffer, sizeof(buffer));
+		}
+	}
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("%s: %.1f ns per locale ID (%lu characters written)\n", name, seconds * 1e9 / BENCHMARK_ITERATIONS, (long unsigned int) total);
+}
+
+/*
+ * Measures the time needed to scan a UTF-16 locale identifier.
+ */
+void BenchmarkUTF16LocaleID(const char* id)
+{
+	LocaleChunkSlices slices;
+	uint16_t utf16[LOCALE_ID_MAX_LENGTH];
+	char buffer[LOCALE_ID_MAX_LENGTH];
+	size_t length, i, valid;
+	clock_t start;
+	double seconds;
+	length = strlen(id);
+	for (i = 0; i < length; i++) {
+		utf16[i] = (uint16_t)(unsigned char)id[i];
+	}
+	valid = 0;
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		valid += ScanLocaleIDUTF16(utf16, length, LOCALE_STREAM_INPUT_UNICODE, buffer, sizeof(buffer), &slices);
+	}
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("UTF-16 \"%s\": %.1f ns per locale ID (%lu valid)\n", id, seconds * 1e9 / BENCHMARK_ITERATIONS, (long unsigned int) valid);
+}
+
+/*
+ * Measures the time needed to get the Unicode ID of a LocaleChunks, with and without the cache.
+ */
+void BenchmarkCachedLocaleID(const char* id)
+{
+	LocaleChunks* lc;
+	char buffer[64];
+	size_t i, total;
+	clock_t start;
+	double seconds[2];
+	lc = UnicodeLocaleIDToLocaleChunks(id);
+	total = 0;
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		total += FormatLocaleChunks(lc, LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE, buffer, sizeof(buffer));
+	}
+	seconds[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		total += *GetCachedUnicodeLocaleID(lc) != '\0';
+	}
+	seconds[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("Unicode ID of \"%s\": %.1f ns formatted, %.1f ns cached (%lu)\n", id, seconds[0] * 1e9 / BENCHMARK_ITERATIONS, seconds[1] * 1e9 / BENCHMARK_ITERATIONS, (long unsigned int) total);
+	FreeLocaleChunks(lc);
+}
+
+/*
+ * Measures the time needed to intersect two LocaleSets stored as bitmaps and as arrays.
+ */
+void BenchmarkLocaleSets(void)
+{
+	LocaleSet a[2], b[2], result;
+	size_t i, total;
+	clock_t start;
+	double seconds[2];
+	int id, k;
+	for (k = 0; k < 2; k++) {
+		InitLocaleSet(&a[k], NULL);
+		InitLocaleSet(&b[k], NULL);
+		/* 10000 IDs (bitmaps), or 1000 IDs (arrays) */
+		for (id = 0; id < (k ? 1000 : 10000); id++) {
+			AddToLocaleSet(&a[k], id * 5);
+			AddToLocaleSet(&b[k], id * 7);
+		}
+	}
+	InitLocaleSet(&result, NULL);
+	total = 0;
+	for (k = 0; k < 2; k++) {
+		start = clock();
+		for (i = 0; i < BENCHMARK_ITERATIONS / 100; i++) {
+			IntersectLocaleSets(&result, &a[k], &b[k]);
+			total += result.count;
+		}
+		seconds[k] = (double)(clock() - start) / CLOCKS_PER_SEC;
+		FreeLocaleSet(&a[k]);
+		FreeLocaleSet(&b[k]);
+	}
+	printf("LocaleSet intersection: %.1f ns bitmaps, %.1f ns arrays (%lu)\n", seconds[0] * 1e9 / (BENCHMARK_ITERATIONS / 100), seconds[1] * 1e9 / (BENCHMARK_ITERATIONS / 100), (long unsigned int) total);
+	FreeLocaleSet(&result);
+}
+
+static int CompareLocaleKeysForQSort(const void* a, const void* b)
+{
+	return CompareLocaleKeys(*(const LocaleKey*)a, *(const LocaleKey*)b);
+}
+
+/*
+ * Measures the time needed to sort LocaleKeys with the radix sort and with qsort.
+ */
+void BenchmarkSortLocaleKeys(void)
+{
+	static const char* const ids[] = {"it_IT", "de-CH", "sr-Latn-RS", "zh-Hant-TW", "en", "es-419", "fr_FR", "pt_BR"};
+	LocaleKey *keys, *copy, *scratch;
+	size_t count, i;
+	clock_t start;
+	double seconds[2];
+	uint64_t random;
+	count = BENCHMARK_ITERATIONS;
+	keys = (LocaleKey*)malloc(count * sizeof(LocaleKey));
+	copy = (LocaleKey*)malloc(count * sizeof(LocaleKey));
+	scratch = (LocaleKey*)malloc(count * sizeof(LocaleKey));
+	for (i = 0, random = 1; i < count; i++) {
+		random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+		keys[i] = LocaleIDToLocaleKey(ids[random >> 61], strlen(ids[random >> 61]));
+	}
+	memcpy(copy, keys, count * sizeof(LocaleKey));
+	start = clock();
+	SortLocaleKeys(copy, count, scratch);
+	seconds[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	memcpy(scratch, keys, count * sizeof(LocaleKey));
+	start = clock();
+	qsort(scratch, count, sizeof(LocaleKey), CompareLocaleKeysForQSort);
+	seconds[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("Sorting %lu LocaleKeys: %.1f ms radix sort, %.1f ms qsort (%s)\n", (long unsigned int) count, seconds[0] * 1e3, seconds[1] * 1e3, memcmp(copy, scratch, count * sizeof(LocaleKey)) ? "different" : "same");
+	free(keys);
+	free(copy);
+	free(scratch);
+}
+
+/*
+ * Measures the time needed to aggregate locale identifiers (exact counts and Space-Saving).
+ */
+void BenchmarkLocaleAggregator(void)
+{
+	static const char* const ids[] = {"it_IT.utf8", "de-CH", "sr@latin", "zh-Hant-TW", "en", "es-419", "fr_FR", "pt_BR"};
+	LocaleAggregator* aggregator;
+	size_t lengths[8], i;
+	clock_t start;
+	double seconds[2];
+	int k;
+	aggregator = (LocaleAggregator*)malloc(sizeof(LocaleAggregator));
+	for (i = 0; i < 8; i++) {
+		lengths[i] = strlen(ids[i]);
+	}
+	for (k = 0; k < 2; k++) {
+		InitLocaleAggregator(aggregator, k ? 4 : 0, NULL);
+		start = clock();
+		for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+			AggregateLocaleID(aggregator, ids[(i * 7) & 7], lengths[(i * 7) & 7]);
+		}
+		seconds[k] = (double)(clock() - start) / CLOCKS_PER_SEC;
+		FreeLocaleAggregator(aggregator);
+	}
+	printf("Aggregating locale IDs: %.1f ns exact, %.1f ns Space-Saving\n", seconds[0] * 1e9 / BENCHMARK_ITERATIONS, seconds[1] * 1e9 / BENCHMARK_ITERATIONS);
+	free(aggregator);
+}
+
+static void DiscardLocaleJSONLines(void* userData, const char* data, size_t length)
+{
+	(void)data;
+	*(size_t*)userData += length;
+}
+
+/*
+ * Measures the time needed to export locale identifiers to JSON Lines.
+ */
+void BenchmarkLocaleJSONLines(void)
+{
+	static const char* const ids[] = {"it_IT.utf8", "de-CH", "sr@latin", "zh-Hant-TW", "en", "es-419", "fr_FR", "pt_BR"};
+	const char** list;
+	LocaleJSONLinesWriter writer;
+	char* buffer;
+	size_t total, i;
+	clock_t start;
+	double seconds;
+	list = (const char**)malloc(BENCHMARK_ITERATIONS * sizeof(const char*));
+	buffer = (char*)malloc(1 << 16);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		list[i] = ids[(i * 7) & 7];
+	}
+	total = 0;
+	InitLocaleJSONLinesWriter(&writer, buffer, 1 << 16, DiscardLocaleJSONLines, &total);
+	start = clock();
+	ExportLocaleIDsToJSONLines(&writer, list, BENCHMARK_ITERATIONS, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, 1, NULL);
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("Exporting locale IDs to JSON Lines: %.1f ns per locale ID, %.1f MB/s\n", seconds * 1e9 / BENCHMARK_ITERATIONS, total / seconds / 1e6);
+	free(list);
+	free(buffer);
+}
+
+/*
+ * Measures the time needed to route URL paths by locale prefix.
+ */
+void BenchmarkLocaleRouter(void)
+{
+	static const char* const locales[] = {"it_IT", "de_CH", "sr@latin", "zh-Hant-TW", "en", "es-419", "fr_FR", "pt_BR"};
+	static const char* const paths[] = {"/it-it/page", "/DE-CH/page", "/sr-latn/page", "/zh_hant_tw/page", "/en/page", "/es-419/page", "/fr-fr/page", "/nl/page"};
+	LocaleRouter router;
+	size_t lengths[8], i, total;
+	const char* rest;
+	clock_t start;
+	double seconds;
+	for (i = 0; i < 8; i++) {
+		lengths[i] = strlen(paths[i]);
+	}
+	CompileLocaleRouter(&router, locales, 8, LOCALE_STREAM_INPUT_GETTEXT | LOCALE_STREAM_INPUT_UNICODE, NULL);
+	total = 0;
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		total += (size_t)(RouteLocalePath(&router, paths[(i * 7) & 7], lengths[(i * 7) & 7], &rest) + 1);
+	}
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("Routing paths by locale prefix: %.1f ns per path (%lu states, checksum %lu)\n", seconds * 1e9 / BENCHMARK_ITERATIONS, (long unsigned int) router.stateCount, (long unsigned int) total);
+	FreeLocaleRouter(&router);
+}
+
+/*
+ * Measures the time needed to select plural categories, for integer and decimal operands.
+ */
+void BenchmarkLocalePluralRules(void)
+{
+	static const char* const ids[] = {"ru_RU", "ar_EG", "pl_PL", "fr_FR", "en_US", "cy_GB", "lt_LT", "pt_PT"};
+	static const char* const decimals[] = {"1.5", "21", "0.25", "3.0", "104.75", "1c6", "11.1", "2"};
+	LocalePluralOperands integers[64], operands[8];
+	unsigned int rules[8];
+	LocaleChunks* lc;
+	size_t counts[LOCALE_PLURAL_OTHER + 1], i;
+	clock_t start;
+	double seconds[2];
+	for (i = 0; i < 8; i++) {
+		lc = GettextLocaleIDToLocaleChunks(ids[i]);
+		rules[i] = GetLocaleChunksPluralRules(lc);
 		FreeLocaleChunks(lc);
+		ParseLocalePluralOperands(&operands[i], decimals[i], strlen(decimals[i]));
+	}
+	for (i = 0; i < 64; i++) {
+		InitLocalePluralOperands(&integers[i], i * 37);
+	}
+	memset(counts, 0, sizeof(counts));
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		counts[SelectLocalePluralCategory(rules[i & 7], &integers[(i >> 3) & 63])]++;
+	}
+	seconds[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	start = clock();
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		counts[SelectLocalePluralCategory(rules[i & 7], &operands[(i * 5) & 7])]++;
+	}
+	seconds[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("Selecting plural categories: %.1f ns integers, %.1f ns decimals (%lu other)\n", seconds[0] * 1e9 / BENCHMARK_ITERATIONS, seconds[1] * 1e9 / BENCHMARK_ITERATIONS, (long unsigned int) counts[LOCALE_PLURAL_OTHER]);
+}
+
+/*
+ * Measures the time needed to convert identifiers found in a conversion cache bigger than the L3 cache, one at a time and in batches.
+ */
+void BenchmarkBatchedLocaleContext(void)
+{
+	LocaleContext* context;
+	const char** list;
+	char *ids, *output;
+	size_t count, i, total[2];
+	clock_t start;
+	double seconds[2];
+	uint64_t random;
+	/* 2M identifiers in a cache of 8M entries (more than 600 MB) */
+	count = (size_t)1 << 21;
+	context = (LocaleContext*)malloc(sizeof(LocaleContext));
+	InitLocaleContext(context, NULL, LOCALE_CONTEXT_NO_STATS);
+	ids = (char*)malloc(count * 16);
+	list = (const char**)malloc(count * sizeof(const char*));
+	output = (char*)malloc(count * 16);
+	if (!ResizeLocaleContextCache(context, count * 4) || !ids || !list || !output) {
+		printf("Converting in batches: not enough memory\n");
+		exit(1);
+	}
+	for (i = 0, random = 1; i < count; i++) {
+		random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+		sprintf(ids + i * 16, "en-x-%07lx", (long unsigned int)(random >> 36));
+		list[i] = ids + i * 16;
+	}
+	ConvertLocaleIDsInContext(context, list, count, LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_BCP47, output, count * 16, NULL);
+	start = clock();
+	for (i = 0, total[0] = 0; i < count; i++) {
+		total[0] += ConvertLocaleIDInContext(context, list[i], 12, LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_BCP47, output + total[0], count * 16 - total[0]);
 	}
+	seconds[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	start = clock();
+	total[1] = ConvertLocaleIDsInContext(context, list, count, LOCALE_STREAM_INPUT_UNICODE, LOCALE_FORMAT_BCP47, output, count * 16, NULL);
+	seconds[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("Converting with a big cache: %.1f ns one at a time, %.1f ns in batches of %d (%lu / %lu characters)\n", seconds[0] * 1e9 / count, seconds[1] * 1e9 / count, LOCALE_CONTEXT_PROBE_BATCH, (long unsigned int) total[0], (long unsigned int) total[1]);
+	ResizeLocaleContextCache(context, 0);
+	free(context);
+	free(ids);
+	free(list);
+	free(output);
 }
+
+void Benchmark(void)
+{
+	static const char* const unicodeIDs[] = {"sr-Latn-RS", "ja-JP-u-ca-japanese", "nn-NO", "de-DE-u-co-phonebk", "en-US-POSIX"};
+	static const char* const javaIDs[] = {"sr_RS_#Latn", "ja_JP_JP", "no_NO_NY", "de_DE_#u-co-phonebk", "en_US_POSIX"};
+	static const char* const icuIDs[] = {"sr_Latn_RS", "ja_JP@calendar=japanese", "nn_NO", "de_DE@collation=phonebook", "en_US_POSIX"};
+	printf("\n\nBenchmarks\n");
+	BenchmarkLocaleIDFormat("Unicode to BCP 47", ScanUnicodeLocaleID, unicodeIDs, 5, LOCALE_FORMAT_BCP47);
+	BenchmarkLocaleIDFormat("Java to BCP 47", ScanJavaLocaleID, javaIDs, 5, LOCALE_FORMAT_BCP47);
+	BenchmarkLocaleIDFormat("ICU to BCP 47", BenchmarkScanICULocaleID, icuIDs, 5, LOCALE_FORMAT_BCP47);
+	BenchmarkLocaleIDFormat("Unicode to Java", ScanUnicodeLocaleID, unicodeIDs, 5, LOCALE_FORMAT_JAVA);
+	BenchmarkLocaleIDFormat("Unicode to ICU", ScanUnicodeLocaleID, unicodeIDs, 5, LOCALE_FORMAT_ICU);
+	BenchmarkUTF16LocaleID("sr-Latn-RS");
+	BenchmarkUTF16LocaleID("de-DE-u-co-phonebk-x-private");
+	BenchmarkCachedLocaleID("sr-latn-rs-posix");
+	BenchmarkLocaleSets();
+	BenchmarkSortLocaleKeys();
+	BenchmarkLocaleAggregator();
+	BenchmarkLocaleJSONLines();
+	BenchmarkLocaleRouter();
+	BenchmarkLocalePluralRules();
+	BenchmarkBatchedLocaleContext();
+}
+
+#endif
+
 int main(void) {
 	Test("it_IT.utf8@euro", 1, "it_IT.utf8@euro", 0, "it_IT");
 	Test("it_IT.utf8", 1, "it_IT.utf8", 0, "it_IT");
@@ -772,6 +10325,14 @@ int main(void) {
 	Test("Latn-POSIX", 0, NULL, 1, "Latn_POSIX");
 	Test("Latn-NYNORSK", 0, NULL, 1, "Latn_NYNORSK");
 
+	Test("es-419", 0, "es_419", 1, "es_419");
+	Test("es-41", 0, NULL, 0, NULL);
+	Test("es-41a", 0, NULL, 0, NULL);
+	Test("it-IT-ab", 0, NULL, 0, NULL);
+	Test("it-IT-abc", 0, NULL, 0, NULL);
+	Test("it-IT-abcdefghi", 0, NULL, 0, NULL);
+	Test("it-IT-1901-ab", 0, NULL, 0, NULL);
+
 	Test("root-Latn", 0, NULL, 0, NULL);
 	Test("root-IT", 0, NULL, 1, "root_IT");
 
@@ -781,6 +10342,210 @@ int main(void) {
 	Test("  ", 0, NULL, 0, NULL);
 	Test("foo@bar@baz", 0, NULL, 0, NULL);
 
+	TestLocaleIDBuffer("sr-Latn-RS-POSIX", LOCALE_ID_INLINE_SIZE, "sr_RS@latin", "sr_Latn_RS_POSIX");
+	TestLocaleIDBuffer("it_IT.utf8@euro", LOCALE_ID_INLINE_SIZE, "it_IT.utf8@euro", "it_IT");
+	TestLocaleIDBuffer("sr-Latn-RS-POSIX", 8, "sr_RS@latin", "sr_Latn_RS_POSIX");
+	TestLocaleIDBuffer("it_IT", 1, "it_IT", "it_IT");
+
+	TestFormatLocaleChunks("SR-latn-rs-posix-nynorsk", LOCALE_FORMAT_BCP47 | LOCALE_FORMAT_CANONICAL_CASE, "sr-Latn-RS-posix-nynorsk");
+	TestFormatLocaleChunks("SR-latn-rs-posix-nynorsk", LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE, "sr_Latn_RS_POSIX_NYNORSK");
+	TestFormatLocaleChunks("SR-latn-rs-posix-nynorsk", LOCALE_FORMAT_GETTEXT | LOCALE_FORMAT_CANONICAL_CASE, "sr_RS@latin");
+	TestFormatLocaleChunks("SR-latn-rs-posix", LOCALE_FORMAT_BCP47, "SR-latn-rs-posix");
+	TestFormatLocaleChunks("IT_it.utf8@Euro", LOCALE_FORMAT_GETTEXT | LOCALE_FORMAT_CANONICAL_CASE, "it_IT.utf8@euro");
+	TestFormatLocaleChunks("sr_RS@latin", LOCALE_FORMAT_BCP47, "sr-Latn-RS");
+	TestFormatLocaleChunks("root-IT", LOCALE_FORMAT_BCP47, "und-IT");
+	TestFormatLocaleChunks("latn-it", LOCALE_FORMAT_UNICODE | LOCALE_FORMAT_CANONICAL_CASE, "Latn_IT");
+	TestFormatLocaleChunks("latn-it", LOCALE_FORMAT_GETTEXT, "");
+
+	TestLocaleIDFormat("ja-JP-u-ca-japanese", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_BCP47, "ja-JP-u-ca-japanese");
+	TestLocaleIDFormat("ja_JP_u_ca_japanese", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_UNICODE, "ja_JP_u_ca_japanese");
+	TestLocaleIDFormat("ja-JP-u-ca-japanese", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_GETTEXT, "ja_JP");
+	TestLocaleIDFormat("ja-JP-u-ca-japanese", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_JAVA, "ja_JP_#u-ca-japanese");
+	TestLocaleIDFormat("ja-JP-u-ca-japanese", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_ICU, "ja_JP@calendar=japanese");
+	TestLocaleIDFormat("en-US-POSIX-x-foo-u-bar", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_BCP47 | LOCALE_FORMAT_CANONICAL_CASE, "en-US-posix-x-foo-u-bar");
+	TestLocaleIDFormat("de-u-kn-co-phonebk-x-a", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_ICU, "de@collation=phonebook;colnumeric=yes;x=a");
+	TestLocaleIDFormat("en-u", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_BCP47, NULL);
+	TestLocaleIDFormat("en-u-ca-x", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_BCP47, NULL);
+	TestLocaleIDFormat("en-u-ca-abcdefghi", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_BCP47, NULL);
+
+	TestLocaleIDFormat("sr_RS_#Latn", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_BCP47, "sr-Latn-RS");
+	TestLocaleIDFormat("sr_RS_#Latn", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, "sr_RS_#Latn");
+	TestLocaleIDFormat("sr__#Latn", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, "sr__#Latn");
+	TestLocaleIDFormat("ja_JP_#u-ca-japanese", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_BCP47, "ja-JP-u-ca-japanese");
+	TestLocaleIDFormat("ja_JP_JP", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_BCP47, "ja-JP-u-ca-japanese");
+	TestLocaleIDFormat("ja_JP_JP_#u-ca-japanese", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, "ja_JP_#u-ca-japanese");
+	TestLocaleIDFormat("th_TH_TH", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_ICU, "th_TH@numbers=thai");
+	TestLocaleIDFormat("no_NO_NY", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_GETTEXT, "nn_NO");
+	TestLocaleIDFormat("iw_IL", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_BCP47, "he-IL");
+	TestLocaleIDFormat("en_US_POSIX", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, "en_US_POSIX");
+	TestLocaleIDFormat("en__POSIX", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_ICU, "en__POSIX");
+	TestLocaleIDFormat("_IT", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, "_IT");
+	TestLocaleIDFormat("sr_RS_#Latn_x-foo", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, "sr_RS_#Latn_x-foo");
+	TestLocaleIDFormat("sr_RS_#Latn_", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, NULL);
+	TestLocaleIDFormat("en_#", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, NULL);
+	TestLocaleIDFormat("__POSIX", LOCALE_FORMAT_JAVA, LOCALE_FORMAT_JAVA, NULL);
+
+	TestLocaleIDFormat("de_DE@collation=phonebook", LOCALE_FORMAT_ICU, LOCALE_FORMAT_BCP47, "de-DE-u-co-phonebk");
+	TestLocaleIDFormat("de_DE@collation=phonebook", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, "de_DE@collation=phonebook");
+	TestLocaleIDFormat("ja_JP@calendar=japanese;currency=JPY", LOCALE_FORMAT_ICU, LOCALE_FORMAT_JAVA, "ja_JP_#u-ca-japanese-cu-jpy");
+	TestLocaleIDFormat("en@x=priv;colStrength=primary;calendar=gregorian", LOCALE_FORMAT_ICU, LOCALE_FORMAT_BCP47, "en-u-ca-gregory-ks-level1-x-priv");
+	TestLocaleIDFormat("en@x=priv;colStrength=primary;calendar=gregorian", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, "en@calendar=gregorian;colstrength=primary;x=priv");
+	TestLocaleIDFormat("am_ET@calendar=ethiopic-amete-alem", LOCALE_FORMAT_ICU, LOCALE_FORMAT_BCP47, "am-ET-u-ca-ethioaa");
+	TestLocaleIDFormat("ar@calendar=islamic-civil", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, "ar@calendar=islamic-civil");
+	TestLocaleIDFormat("en__POSIX", LOCALE_FORMAT_ICU, LOCALE_FORMAT_BCP47, "en-POSIX");
+	TestLocaleIDFormat("_Latn_RS", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, "_Latn_RS");
+	TestLocaleIDFormat("sr_Latn_RS", LOCALE_FORMAT_ICU, LOCALE_FORMAT_GETTEXT, "sr_RS@latin");
+	TestLocaleIDFormat("de@foo=bar", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, NULL);
+	TestLocaleIDFormat("de@collation", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, NULL);
+	TestLocaleIDFormat("de@collation=", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, NULL);
+	TestLocaleIDFormat("en_US__POSIX", LOCALE_FORMAT_ICU, LOCALE_FORMAT_ICU, NULL);
+	TestEmptyICULocaleID("_Latn_RS");
+
+	TestLocaleIDFormat("values-zh-rTW", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_GETTEXT, "zh_TW");
+	TestLocaleIDFormat("zh-rTW", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, "zh-rTW");
+	TestLocaleIDFormat("values-b+sr+Latn", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_GETTEXT, "sr@latin");
+	TestLocaleIDFormat("b+sr+Latn+RS", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, "b+sr+Latn+RS");
+	TestLocaleIDFormat("values-mcc310-mnc004-en-rUS-land", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_BCP47, "en-US");
+	TestLocaleIDFormat("values-b+de+DE+1901+u+co+phonebk", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ICU, "de_DE_1901@collation=phonebook");
+	TestLocaleIDFormat("es-419", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_ANDROID, "b+es+419");
+	TestLocaleIDFormat("sr@latin", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, NULL);
+	TestLocaleIDFormat("values", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, NULL);
+	TestLocaleIDFormat("values-land", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, NULL);
+	TestLocaleIDFormat("values-car", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, NULL);
+	TestLocaleIDFormat("values-car-night", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, NULL);
+	TestLocaleIDFormat("values-b+car", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_BCP47, "car");
+	TestLocaleIDFormat("values-b+Latn", LOCALE_FORMAT_ANDROID, LOCALE_FORMAT_ANDROID, NULL);
+
+	TestLocaleIDFormat("zh-Hans.lproj", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_ANDROID, "b+zh+Hans");
+	TestLocaleIDFormat("zh-Hans.lproj", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_GETTEXT, "zh");
+	TestLocaleIDFormat("pt_BR.lproj", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_APPLE, "pt-BR");
+	TestLocaleIDFormat("English.lproj", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_APPLE, "en");
+	TestLocaleIDFormat("sr-Latn", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_ANDROID, "b+sr+Latn");
+	TestLocaleIDFormat("ja-JP-u-ca-japanese", LOCALE_FORMAT_UNICODE, LOCALE_FORMAT_APPLE, "ja-JP");
+	TestLocaleIDFormat("Base.lproj", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_APPLE, NULL);
+	TestLocaleIDFormat("root.lproj", LOCALE_FORMAT_APPLE, LOCALE_FORMAT_APPLE, NULL);
+	TestLocaleDirectoryListing();
+
+	TestUTF16LocaleID("sr-Latn-RS", -1, "sr_Latn_RS");
+	TestUTF16LocaleID("sr-Latn-RS", 5, NULL);
+	TestUTF16LocaleID("de-DE-u-co-phonebk-x-private", -1, "de_DE_u_co_phonebk_x_private");
+	TestUTF16LocaleID("de-DE-u-co-phonebk-x-private", 3, NULL);
+	TestUTF16LocaleID("de-DE-u-co-phonebk-x-private", 15, NULL);
+	TestUTF16LocaleID("de-DE-u-co-phonebk-x-private", 20, NULL);
+	TestUTF16LocaleID("it_IT.utf8@euro", -1, "it_IT");
+	TestUTF16LocaleID("", -1, NULL);
+
+	TestLocaleFallback("es-AR", LOCALE_FALLBACK_GETTEXT, "es_AR > es_419 > es > root", "es_AR > es_419 > es");
+	TestLocaleFallback("zh-Hant-HK", LOCALE_FALLBACK_GETTEXT, "zh_Hant_HK > zh_Hant > root", "zh_HK");
+	TestLocaleFallback("zh-Hant-MO", 0, "zh_Hant_MO > zh_Hant_HK > zh_Hant > root", "");
+	TestLocaleFallback("zh_TW", LOCALE_FALLBACK_GETTEXT | LOCALE_FALLBACK_SKIP_ROOT, "zh_TW > zh_Hant", "zh_TW");
+	TestLocaleFallback("zh-Hans-CN", LOCALE_FALLBACK_GETTEXT, "zh_Hans_CN > zh_Hans > zh > root", "zh_CN > zh");
+	TestLocaleFallback("sr_RS@latin", LOCALE_FALLBACK_GETTEXT, "sr_Latn_RS > sr_Latn > root", "sr_RS@latin > sr@latin");
+	TestLocaleFallback("sr-Cyrl-RS", LOCALE_FALLBACK_GETTEXT, "sr_Cyrl_RS > sr_Cyrl > sr > root", "sr_RS@cyrillic > sr@cyrillic > sr");
+	TestLocaleFallback("en-AU-POSIX-NYNORSK", LOCALE_FALLBACK_GETTEXT, "en_AU_POSIX_NYNORSK > en_AU_POSIX > en_AU > en_001 > en > root", "en_AU > en_001 > en");
+	TestLocaleFallback("it-Latn-IT", LOCALE_FALLBACK_GETTEXT, "it_Latn_IT > it_Latn > it > root", "it_IT@latin > it@latin > it");
+	TestLocaleFallback("it-Cyrl", 0, "it_Cyrl > root", "");
+	TestLocaleFallback("Latn-IT", 0, "Latn_IT > Latn > root", "");
+	TestLocaleFallback("root", LOCALE_FALLBACK_SKIP_ROOT, "", "");
+	TestLocaleFallback("ca_ES@valencia", LOCALE_FALLBACK_GETTEXT, "ca_ES > ca > root", "ca_ES@valencia > ca_ES > ca");
+	TestLocaleFallback("it_IT.utf8@euro", LOCALE_FALLBACK_GETTEXT | LOCALE_FALLBACK_SKIP_ROOT, "it_IT > it", "it_IT@euro > it_IT > it");
+	TestLocaleFallback("POSIX", 0, NULL, "");
+
+	TestCachedLocaleID("SR-latn-rs", "sr_RS@latin", "sr_Latn_RS");
+	TestCachedLocaleID("it_it.utf8@euro", "it_IT.utf8@euro", "it_IT");
+	TestCachedLocaleID("root", NULL, "root");
+	TestCachedLocaleID("", NULL, NULL);
+
+	TestLocaleChunksMutation();
+	TestCloneLocaleChunks("sr-Latn-RS-1996-u-ca-gregory", "sr_Latn_RS_1996_u_ca_gregory");
+	TestCloneLocaleChunks("root", "root");
+
+	TestLocaleChunksScriptID("sr_RS@latin", "Latn", "latin");
+	TestLocaleChunksScriptID("sr-Cyrl-RS", "Cyrl", "cyrillic");
+	TestLocaleChunksScriptID("it_IT@euro", NULL, "euro");
+	TestLocaleChunksScriptID("en-Qaaa", "Qaaa", NULL);
+	TestLocaleChunksScriptID("en_US", NULL, NULL);
+
+	TestLocaleContext();
+
+	TestRegisteredLocaleID("sr-Latn-RS", 1);
+	TestRegisteredLocaleID("sl-IT-rozaj-1994", 1);
+	TestRegisteredLocaleID("es-419", 1);
+	TestRegisteredLocaleID("yue-Hant-HK", 1);
+	TestRegisteredLocaleID("it_IT.utf8@euro", 1);
+	TestRegisteredLocaleID("POSIX", 1);
+	TestRegisteredLocaleID("root", 1);
+	TestRegisteredLocaleID("qaa-Qabx-QM", 1);
+	TestRegisteredLocaleID("en-XZ", 1);
+	TestRegisteredLocaleID("qq-Zzzx-QQ", 0);
+	TestRegisteredLocaleID("qzz", 0);
+	TestRegisteredLocaleID("en-Qaby", 0);
+	TestRegisteredLocaleID("en-Zzzx", 0);
+	TestRegisteredLocaleID("en-UK", 0);
+	TestRegisteredLocaleID("en-JJ", 0);
+	TestRegisteredLocaleID("en-777", 0);
+	TestRegisteredLocaleID("en-US-abcde", 0);
+
+	TestTerritoryLocales("CH", 5, "de_CH gsw_CH en_CH fr_CH it_CH");
+	TestTerritoryLocales("tw", 2, "zh_TW nan_TW");
+	TestTerritoryLocales("RS", 3, "sr_RS sr_RS@latin sq_RS");
+	TestTerritoryLocales("QQ", 5, "");
+	TestTerritoryLocales("123", 5, "");
+
+	TestLocaleSets();
+	TestSortLocaleKeys();
+	TestBulkLocaleIDs();
+	TestLocaleAggregator();
+	TestLocaleJSONLines();
+	TestLocaleRouter();
+	TestLocalePluralRules();
+	TestLocaleIDParser();
+	TestBatchedLocaleContext();
+	TestLocaleContextLimits();
+
+	TestLocaleIDStream();
+
+	TestLocaleKey("it_IT.utf8", "it_IT");
+	TestLocaleKey("it_IT.utf8@euro", NULL);
+	TestLocaleKey("IT-it", "it_IT");
+	TestLocaleKey("sr@latin", "sr_Latn");
+	TestLocaleKey("SR-latn", "sr_Latn");
+	TestLocaleKey("sr_RS@latin", "sr_Latn_RS");
+	TestLocaleKey("zh-Hant-HK", "zh_Hant_HK");
+	TestLocaleKey("es-419-POSIX", NULL);
+	TestLocaleKey("de-DE-1901", NULL);
+	TestLocaleKey("ca_ES@valencia", NULL);
+	TestLocaleKey("de-DE-u-co-phonebk", NULL);
+	TestLocaleKey("sr_RS@Latin", "sr_Latn_RS");
+	TestLocaleKey("latn-it", "Latn_IT");
+	TestLocaleKey("root-IT", "root_IT");
+	TestLocaleKey("POSIX", NULL);
+	TestLocaleKey("C", NULL);
+	TestLocaleKey("it_I1", NULL);
+	TestLocaleKey("", NULL);
+	TestLocaleKeyOrder();
+
+	TestLCID(0x0410, "it-IT", 0x0410, "it_IT");
+	TestLCID(0x0410, "it_IT.UTF-8", 0, "it_IT");
+	TestLCID(0x0C0A, "es_ES", 0x0C0A, "es_ES");
+	TestLCID(0x040A, "es-ES", 0x0C0A, "es_ES");
+	TestLCID(0x241A, "sr_RS@latin", 0x241A, "sr_RS@latin");
+	TestLCID(0x281A, "sr-RS", 0x281A, "sr_RS@cyrillic");
+	TestLCID(0x0404, "zh-Hant-TW", 0x0404, "zh_TW");
+	TestLCID(0x580A, "es-419", 0x580A, "es_419");
+	TestLCID(0x10410, "it", 0x0010, "it_IT");
+	TestLCID(0x0000, "it_SM", 0, "");
+	TestLCID(0xFFFF, "", 0, "");
+	TestLCIDTables();
+
+	TestLocaleArena(256 * 1024, NULL, 1000, 1, "es_419");
+	TestLocaleArena(1024, NULL, 1000, 0, NULL);
+	TestLocaleArena(1024, &LocaleMallocAllocator, 1000, 1, "es_419");
+	TestLocaleArena(0, &LocaleMallocAllocator, 10001, 1, "it_IT");
+
 	printf("\n\nAll ok.\n");
+#ifdef BENCHMARK
+	Benchmark();
+#endif
 	return 0;
 }
@@ -0,0 +1,35 @@
+/*
+ * Compares the plural categories selected by parse-locale-identifiers.c with the expected ones.
+ * Every line of the standard input is a test case: a Unicode locale ID, a number and its expected category
+ * (see check-plural-rules.py, that generates the test cases with Babel).
+ */
+#define main ParseLocaleIdentifiersMain
+#include "../parse-locale-identifiers.c"
+#undef main
+
+int main(void)
+{
+	char locale[64], number[64], expected[16];
+	LocalePluralOperands operands;
+	LocaleChunks* lc;
+	const char* category;
+	unsigned long total, failed;
+	total = failed = 0;
+	while (scanf("%63s %63s %15s", locale, number, expected) == 3) {
+		total++;
+		lc = UnicodeLocaleIDToLocaleChunks(locale);
+		if (!lc || !ParseLocalePluralOperands(&operands, number, strlen(number))) {
+			printf("%s %s: invalid test case\n", locale, number);
+			failed++;
+		} else {
+			category = GetLocalePluralCategoryName(SelectLocalePluralCategory(GetLocaleChunksPluralRules(lc), &operands));
+			if (strcmp(category, expected)) {
+				printf("%s %s: expected %s, selected %s\n", locale, number, expected, category);
+				failed++;
+			}
+		}
+		FreeLocaleChunks(lc);
+	}
+	printf("%lu test cases, %lu failed\n", total, failed);
+	return failed ? 1 : 0;
+}
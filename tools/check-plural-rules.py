@@ -0,0 +1,54 @@
+"""
+Compares the plural categories selected by parse-locale-identifiers.c (see SelectLocalePluralCategory)
+with the ones of Babel, for every locale of Babel and for a set of numbers that covers the CLDR rules
+(integers, decimals with trailing zeros, and compact decimal exponents like "1.2c6").
+
+Usage: python3 check-plural-rules.py
+
+It builds check-plural-rules.c with $CC (cc by default) in a temporary directory.
+"""
+import decimal
+import os
+import subprocess
+import sys
+import tempfile
+
+from babel.localedata import locale_identifiers, load
+
+NUMBERS = [
+    '0', '1', '2', '3', '4', '5', '6', '7', '10', '11', '12', '14', '19', '20', '21', '22', '25', '71', '91',
+    '100', '101', '102', '103', '111', '1000000', '2000000',
+    '0.0', '0.5', '1.0', '1.5', '1.50', '2.3', '0.1', '1.1', '10.0', '21.1', '1.20', '5.7', '100.5',
+    '1c6', '1.2c6', '2c3', '1e6', '1.0000001c6', '3c6',
+]
+
+
+def TestCases():
+    for locale in sorted(locale_identifiers()):
+        if locale == 'root':
+            continue
+        pluralForm = load(locale)['plural_form']
+        usesExponent = "('e'," in repr(pluralForm.abstract)
+        for number in NUMBERS:
+            if 'c' in number or 'e' in number:
+                # Babel can't compute the e operand from a Decimal: skip the exponents if the rules depend on it
+                if usesExponent:
+                    continue
+                mantissa, exponent = number.replace('e', 'c').split('c')
+                value = decimal.Decimal(mantissa).scaleb(int(exponent))
+            else:
+                value = decimal.Decimal(number)
+            yield '%s %s %s\n' % (locale, number, pluralForm(value))
+
+
+def main():
+    directory = os.path.dirname(os.path.abspath(__file__))
+    with tempfile.TemporaryDirectory() as temporary:
+        executable = os.path.join(temporary, 'check-plural-rules')
+        subprocess.check_call([os.environ.get('CC', 'cc'), '-O2', '-o', executable, os.path.join(directory, 'check-plural-rules.c')])
+        result = subprocess.run([executable], input=''.join(TestCases()), universal_newlines=True)
+    sys.exit(result.returncode)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,77 @@
+"""
+Generates the tables of the locale fallback chains of parse-locale-identifiers.c (LocaleParents and LocaleDefaultScripts)
+from the CLDR data of Babel: the parent locales, and the likely subtags.
+
+Usage: python3 generate-locale-parents.py [--check]
+
+The tables in parse-locale-identifiers.c have been generated with Babel 2.18 (CLDR 47).
+"""
+import sys
+
+from babel.core import get_global
+
+from localekey import FormatLocaleKey, IsLocaleKeyID, LocaleKey, LocaleKeyToLocaleID, Output, SplitLocaleID
+
+
+def main():
+    parentExceptions = get_global('parent_exceptions')
+    likelySubtags = get_global('likely_subtags')
+    # The likely script of every language (for example "Cyrl" for "sr")
+    defaultScripts = {}
+    for locale, likely in likelySubtags.items():
+        if '_' in locale or locale == 'und' or not (2 <= len(locale) <= 3) or not locale.isalpha():
+            continue
+        language, script, _ = SplitLocaleID(likely)
+        if language == locale:
+            defaultScripts[locale] = script
+    # The explicit parents of CLDR (for example es_AR -> es_419)
+    parents = {}
+    for child, parent in parentExceptions.items():
+        if IsLocaleKeyID(child) and IsLocaleKeyID(parent):
+            parents[child] = parent
+        else:
+            print('Skipping the parent of %s (%s): it has no LocaleKey' % (child, parent), file=sys.stderr)
+    # The territories whose likely script isn't the default one of the language (for example zh_TW -> zh_Hant)
+    for locale, likely in likelySubtags.items():
+        language, script, territory = SplitLocaleID(locale)
+        if language == 'und' or script or not territory or language not in defaultScripts or locale in parents:
+            continue
+        likelyLanguage, likelyScript, likelyTerritory = SplitLocaleID(likely)
+        if likelyLanguage != language or likelyTerritory != territory or likelyScript == defaultScripts[language]:
+            continue
+        parent = parentExceptions.get('%s_%s_%s' % (language, likelyScript, territory), '%s_%s' % (language, likelyScript))
+        if IsLocaleKeyID(locale) and IsLocaleKeyID(parent):
+            parents[locale] = parent
+    parentKeys = sorted((LocaleKey(child), LocaleKey(parent), child, parent) for child, parent in parents.items())
+    # Latin is the default script of the languages that are not listed
+    defaultScriptKeys = sorted(LocaleKey(language + '_' + script) for language, script in defaultScripts.items() if script != 'Latn' and IsLocaleKeyID(language + '_' + script))
+    out = []
+    out.append('#define LOCALE_PARENT_COUNT %d' % len(parentKeys))
+    out.append('#define LOCALE_DEFAULT_SCRIPT_COUNT %d' % len(defaultScriptKeys))
+    out.append('')
+    out.append('/*')
+    out.append(' * The parents that don\'t follow the truncation rule, sorted by child.')
+    out.append(' * They include the languages with a territory whose likely script isn\'t the default one of the language')
+    out.append(' * (for example the parent of zh_TW is zh_Hant, since zh_TW is zh_Hant_TW).')
+    out.append(' */')
+    out.append('static const struct {')
+    out.append('\tLocaleKey child;')
+    out.append('\tLocaleKey parent;')
+    out.append('} LocaleParents[LOCALE_PARENT_COUNT] = {')
+    for childKey, parentKey, child, parent in parentKeys:
+        out.append('\t{%s, %s}, /* %s -> %s */' % (FormatLocaleKey(childKey), FormatLocaleKey(parentKey), child, parent))
+    out.append('};')
+    out.append('')
+    out.append('/*')
+    out.append(' * The default scripts of the languages (sorted), except for Latin: it\'s the default for the languages not listed here.')
+    out.append(' */')
+    out.append('static const LocaleKey LocaleDefaultScripts[LOCALE_DEFAULT_SCRIPT_COUNT] = {')
+    for i in range(0, len(defaultScriptKeys), 4):
+        keys = defaultScriptKeys[i:i + 4]
+        out.append('\t' + ' '.join(FormatLocaleKey(key) + ',' for key in keys) + ' /* ' + ' '.join(LocaleKeyToLocaleID(key) for key in keys) + ' */')
+    out.append('};')
+    Output('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,135 @@
+"""
+Generates the registries of the valid subtags of parse-locale-identifiers.c (LocaleRegistryLanguages,
+LocaleRegistryAlphaTerritories, LocaleRegistryNumericTerritories, LocaleRegistryScripts and LocaleRegistryVariants)
+from the CLDR data of Babel and from the variants of the IANA Language Subtag Registry.
+
+Usage: python3 generate-locale-registry.py [--check]
+
+The tables in parse-locale-identifiers.c have been generated with Babel 2.18 (CLDR 47).
+"""
+import re
+
+from babel import Locale
+from babel.core import get_global
+
+from localekey import Output
+
+# Variants of the IANA Language Subtag Registry (Babel only has the names of some of them)
+IANA_VARIANTS = '''
+1606NICT 1694ACAD 1901 1959ACAD 1994 1996 ABL1943 AKUAPEM ALALC97 ALUKU AO1990 ARANES AREVELA AREVMDA ARKAIKA ASANTE
+AUVERN BAKU1926 BALANKA BARLA BASICENG BAUDDHA BCIAV BCIZBL BISCAYAN BISKE BOHORIC BOONT BORNHOLM CISAUP COLB1945 CORNU
+CREISS DAJNKO EKAVSK EMODENG FONIPA FONKIRSH FONNAPA FONUPA FONXSAMP GALLO GASCON GRCLASS GRITAL GRMISTR HEPBURN HEPLOC
+HOGNORSK HSISTEMO IJEKAVSK ITIHASA IVANCHOV JAUER JYUTPING KKCOR KOCIEWIE KSCOR LAUKIKA LEMOSIN LENGADOC LIPAW LTG1929
+LTG2007 LUNA1918 METELKO MONOTON NDYUKA NEDIS NEWFOUND NICARD NJIVA NULIK OSOJS OXENDICT PAHAWH2 PAHAWH3 PAHAWH4 PAMAKA
+PEANO PETR1708 PINYIN POLYTON PROVENC PUTER REVISED RIGIK ROZAJ RUMGR SAAHO SCOTLAND SCOUSE SIMPLE SOLBA SOTAV SPANGLIS
+SURMIRAN SURSILV SUTSILV SYNNEJYL TARASK TONGYONG TUNUMIIT UCCOR UCRCOR ULSTER UNIFON VAIDIKA VALENCIA VALLADER VECDRUK
+VIVARAUP WADEGILE XSISTEMO
+'''.split()
+
+
+def Bitmap(bits, indexes):
+    words = [0] * ((bits + 63) // 64)
+    for index in indexes:
+        words[index // 64] |= 1 << (index % 64)
+    return words
+
+
+def FormatRows(values, perRow, formatValue):
+    return ['\t' + ', '.join(formatValue % value for value in values[i:i + perRow]) + ',' for i in range(0, len(values), perRow)]
+
+
+def LanguageIndex(language):
+    letters = [ord(c) - ord('a') + 1 for c in language] + [0]
+    return (letters[0] * 27 + letters[1]) * 27 + letters[2]
+
+
+def AlphaTerritoryIndex(territory):
+    return (ord(territory[0]) - ord('A')) * 26 + ord(territory[1]) - ord('A')
+
+
+def PackScript(script):
+    packed = 0
+    for c in script.lower():
+        packed = packed << 5 | (ord(c) - ord('a') + 1)
+    return packed
+
+
+def PackVariant(variant):
+    packed = 0
+    for c in variant:
+        packed = packed * 37 + (ord(c) - ord('0') + 1 if c.isdigit() else ord(c) - ord('A') + 11)
+    return packed
+
+
+def main():
+    en = Locale('en')
+    # ISO 639, with the deprecated codes (the keys of the language aliases) and the ISO 639-3 languages that have likely subtags
+    languages = set(language for language in en.languages if re.fullmatch('[a-z]{2,3}', language))
+    languages |= set(language for language in get_global('language_aliases') if re.fullmatch('[a-z]{2,3}', language))
+    languages |= set(locale.split('_')[0] for locale in get_global('likely_subtags') if re.fullmatch('[a-z]{2,3}', locale.split('_')[0]))
+    languages.discard('root')
+    # Private use languages of BCP 47 ("qaa" to "qtz")
+    languages |= set('q' + chr(b) + chr(c) for b in range(ord('a'), ord('t') + 1) for c in range(ord('a'), ord('z') + 1))
+    scripts = set(script for script in en.scripts if re.fullmatch('[A-Z][a-z]{3}', script))
+    # Private use scripts of BCP 47 ("Qaaa" to "Qabx")
+    scripts |= set('Qa' + chr(c) + chr(d) for c in (ord('a'), ord('b')) for d in range(ord('a'), ord('z' if c == ord('a') else 'x') + 1))
+    # ISO 3166 and UN M.49, with the deprecated codes (the keys of the territory aliases)
+    territories = set(territory for territory in en.territories if re.fullmatch('[A-Z]{2}|[0-9]{3}', territory))
+    territories |= set(territory for territory in get_global('territory_aliases') if re.fullmatch('[A-Z]{2}|[0-9]{3}', territory))
+    # "UK" is only exceptionally reserved by ISO 3166 (for "GB") and it's not in the IANA registry
+    territories.discard('UK')
+    # Private use territories of BCP 47 ("AA", "QM" to "QZ", "XA" to "XZ" and "ZZ")
+    territories |= set(['AA', 'ZZ']) | set('Q' + chr(c) for c in range(ord('M'), ord('Z') + 1)) | set('X' + chr(c) for c in range(ord('A'), ord('Z') + 1))
+    variants = set(variant.upper() for variant in en.variants) | set(IANA_VARIANTS)
+
+    languageWords = Bitmap(27 * 27 * 27, [LanguageIndex(language) for language in languages])
+    alphaTerritoryWords = Bitmap(26 * 26, [AlphaTerritoryIndex(territory) for territory in territories if territory.isalpha()])
+    numericTerritoryWords = Bitmap(1000, [int(territory) for territory in territories if territory.isdigit()])
+    packedScripts = sorted(PackScript(script) for script in scripts)
+    packedVariants = sorted(PackVariant(variant) for variant in variants)
+
+    out = []
+    out.append('/*')
+    out.append(' * Bitmap of the valid languages, indexed by (a * 27 + b) * 27 + c, where a, b and c are the letters of the code (1 for "a", 0 for a missing third letter).')
+    out.append(' */')
+    out.append('#define LOCALE_REGISTRY_LANGUAGE_BITS (27 * 27 * 27)')
+    out.append('static const uint64_t LocaleRegistryLanguages[(LOCALE_REGISTRY_LANGUAGE_BITS + 63) / 64] = {')
+    out += FormatRows(languageWords, 4, '0x%016xULL')
+    out.append('};')
+    out.append('')
+    out.append('/*')
+    out.append(' * Bitmap of the valid two-letter territories (ISO 3166), indexed by a * 26 + b, where a and b are the letters of the code (0 for "A").')
+    out.append(' */')
+    out.append('static const uint64_t LocaleRegistryAlphaTerritories[(26 * 26 + 63) / 64] = {')
+    out += FormatRows(alphaTerritoryWords, 4, '0x%016xULL')
+    out.append('};')
+    out.append('')
+    out.append('/*')
+    out.append(' * Bitmap of the valid numeric territories (UN M.49 and ISO 3166 numeric codes), indexed by their value.')
+    out.append(' */')
+    out.append('static const uint64_t LocaleRegistryNumericTerritories[(1000 + 63) / 64] = {')
+    out += FormatRows(numericTerritoryWords, 4, '0x%016xULL')
+    out.append('};')
+    out.append('')
+    out.append('/*')
+    out.append(' * Sorted list of the valid scripts (ISO 15924), packed in 5 bits per letter (1 for "a").')
+    out.append(' * 26^4 possible codes for about 250 scripts are too sparse for a bitmap.')
+    out.append(' */')
+    out.append('#define LOCALE_REGISTRY_SCRIPT_COUNT %d' % len(packedScripts))
+    out.append('static const uint32_t LocaleRegistryScripts[LOCALE_REGISTRY_SCRIPT_COUNT] = {')
+    out += FormatRows(packedScripts, 8, '0x%05x')
+    out.append('};')
+    out.append('')
+    out.append('/*')
+    out.append(' * Sorted list of the valid variants, packed in base 37 (1 to 10 for the digits, 11 to 36 for the letters).')
+    out.append(' * "POSIX" is not in the IANA registry, but it\'s used by CLDR and by Gettext.')
+    out.append(' */')
+    out.append('#define LOCALE_REGISTRY_VARIANT_COUNT %d' % len(packedVariants))
+    out.append('static const uint64_t LocaleRegistryVariants[LOCALE_REGISTRY_VARIANT_COUNT] = {')
+    out += FormatRows(packedVariants, 4, '0x%011xULL')
+    out.append('};')
+    Output('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,129 @@
+"""
+Generates the tables of the CLDR cardinal plural rules of parse-locale-identifiers.c
+(LocalePluralCode, LocalePluralRuleOffsets, LocalePluralKeys and LocalePluralKeyRules) from the CLDR data of Babel.
+
+Usage: python3 generate-plural-rules.py [--check]
+
+The tables in parse-locale-identifiers.c have been generated with Babel 2.18 (CLDR 47).
+See check-plural-rules.py to compare the results of SelectLocalePluralCategory with the ones of Babel.
+"""
+from babel.localedata import locale_identifiers, load
+
+from localekey import LocaleKey, Output
+
+# The operands, as encoded in the bytecode (see LOCALE_PLURAL_RELATION_OPERAND)
+OPERANDS = {'n': 1, 'i': 2, 'v': 3, 'w': 4, 'f': 5, 't': 6, 'e': 7}
+# The categories, as encoded in the bytecode (see LOCALE_PLURAL_...): "other" is the fallback
+CATEGORIES = {'zero': 0, 'one': 1, 'two': 2, 'few': 3, 'many': 4}
+
+
+def Disjunction(node):
+    """Converts a Babel plural rule AST to a list of conjunctions of relations."""
+    if node[0] == 'or':
+        return Disjunction(node[1][0]) + Disjunction(node[1][1])
+    return [Conjunction(node)]
+
+
+def Conjunction(node):
+    if node[0] == 'and':
+        return Conjunction(node[1][0]) + Conjunction(node[1][1])
+    return [Relation(node)]
+
+
+def Relation(node):
+    """Converts a relation to (operand, negated, modulo, ranges)."""
+    negated = 0
+    if node[0] == 'not':
+        negated = 1
+        node = node[1][0]
+    assert node[0] == 'relation', node
+    operator, expression, ranges = node[1]
+    assert operator == 'in' and ranges[0] == 'range_list', node
+    modulo = 0
+    if expression[0] == 'mod':
+        modulo = expression[1][1][1][0]
+        expression = expression[1][0]
+    return (OPERANDS[expression[0]], negated, modulo, [(a[1][0], b[1][0]) for a, b in ranges[1]])
+
+
+def CompileRules(abstract):
+    """
+    Compiles the rules of a locale: for every category, a header word (category | condition length << 8) followed by the condition,
+    made of relations: a header word (see LOCALE_PLURAL_RELATION_...), the modulus (if any) and the pairs of bounds of the ranges.
+    """
+    words = []
+    for category, condition in sorted(abstract, key=lambda rule: CATEGORIES[rule[0]]):
+        body = []
+        for conjunction in Disjunction(condition):
+            for i, (operand, negated, modulo, ranges) in enumerate(conjunction):
+                body.append('0x%x' % (operand | negated << 3 | (1 if modulo else 0) << 4 | (1 if i == len(conjunction) - 1 else 0) << 5 | len(ranges) << 8))
+                if modulo:
+                    body.append(str(modulo))
+                for a, b in ranges:
+                    body += [str(a), str(b)]
+        words.append(tuple(['0x%x' % (CATEGORIES[category] | len(body) << 8)] + body))
+    return words
+
+
+def main():
+    identifiers = locale_identifiers()
+    rules = [[]]
+    descriptions = ['(everything is "other")']
+    entries = []
+
+    def RuleIndex(pluralForm):
+        words = CompileRules(pluralForm.abstract)
+        if words not in rules:
+            rules.append(words)
+            descriptions.append('; '.join('%s: %s' % (category, rule) for category, rule in sorted(pluralForm.rules.items(), key=lambda item: CATEGORIES[item[0]])))
+        return rules.index(words)
+
+    for locale in sorted(identifiers):
+        if locale == 'root':
+            continue
+        index = RuleIndex(load(locale)['plural_form'])
+        parts = locale.split('_')
+        if len(parts) == 1:
+            # The languages with the root rules are not listed
+            if index:
+                entries.append((LocaleKey(locale), index))
+        elif parts[0] in identifiers and RuleIndex(load(parts[0])['plural_form']) != index:
+            # The territories with rules that are different from the ones of their language (like pt_PT)
+            assert len(parts) == 2, locale
+            entries.append((LocaleKey(locale), index))
+    entries.sort()
+    out = []
+    out.append('/*\n * Bytecode of the CLDR cardinal plural rules (see SelectLocalePluralCategory), indexed by LocalePluralRuleOffsets.\n */')
+    out.append('static const uint32_t LocalePluralCode[] = {')
+    offsets = [0]
+    for i, words in enumerate(rules):
+        if words:
+            out.append('\t/* %d: %s */' % (i, descriptions[i].replace('*/', '* /')))
+            for category in words:
+                out.append('\t' + ', '.join(category) + ',')
+        offsets.append(offsets[-1] + sum(len(category) for category in words))
+    out[-1] = out[-1].rstrip(',')
+    out.append('};\n')
+    out.append('/*\n * Offsets of the plural rules in LocalePluralCode (rules 0 are the ones of the root locale: everything is "other").\n */')
+    out.append('static const uint16_t LocalePluralRuleOffsets[%d] = {' % len(offsets))
+    for i in range(0, len(offsets), 16):
+        out.append('\t' + ', '.join(str(offset) for offset in offsets[i:i + 16]) + ',')
+    out[-1] = out[-1].rstrip(',')
+    out.append('};\n')
+    out.append('/*\n * Sorted LocaleKeys of the languages (and of the language-territory pairs) with plural rules other than the root ones.\n */')
+    out.append('static const LocaleKey LocalePluralKeys[%d] = {' % len(entries))
+    for i in range(0, len(entries), 4):
+        out.append('\t' + ', '.join('0x%016xULL' % key for key, _ in entries[i:i + 4]) + ',')
+    out[-1] = out[-1].rstrip(',')
+    out.append('};\n')
+    out.append('/*\n * The plural rules of the LocalePluralKeys.\n */')
+    out.append('static const unsigned char LocalePluralKeyRules[%d] = {' % len(entries))
+    for i in range(0, len(entries), 24):
+        out.append('\t' + ', '.join(str(index) for _, index in entries[i:i + 24]) + ',')
+    out[-1] = out[-1].rstrip(',')
+    out.append('};')
+    Output('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
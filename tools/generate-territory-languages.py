@@ -0,0 +1,48 @@
+"""
+Generates the tables of the languages spoken in the territories of parse-locale-identifiers.c
+(LocaleTerritoryLanguageOffsets and LocaleTerritoryLanguages) from the CLDR territory data of Babel.
+
+Usage: python3 generate-territory-languages.py [--check]
+
+The tables in parse-locale-identifiers.c have been generated with Babel 2.18 (CLDR 47).
+"""
+from babel.core import get_global
+
+from localekey import FormatLocaleKey, LocaleKey, Output
+
+
+def main():
+    territoryLanguages = get_global('territory_languages')
+    offsets = []
+    keys = []
+    # Dense territory IDs (see GetLocaleTerritoryID): "AA" is 0, "AB" is 1, ... "ZZ" is 675
+    for territoryID in range(26 * 26):
+        territory = chr(ord('A') + territoryID // 26) + chr(ord('A') + territoryID % 26)
+        offsets.append(len(keys))
+        if territory in territoryLanguages:
+            # Sorted by the percentage of the population that speaks them (then by language, for stable results)
+            languages = sorted(territoryLanguages[territory].items(), key=lambda item: (-item[1]['population_percent'], item[0]))
+            for language, _ in languages:
+                keys.append((LocaleKey(language + '_' + territory), language + '_' + territory))
+    offsets.append(len(keys))
+    out = []
+    out.append('#define LOCALE_TERRITORY_ID_COUNT (26 * 26)')
+    out.append('#define LOCALE_TERRITORY_LANGUAGE_COUNT %d' % len(keys))
+    out.append('')
+    out.append('/*')
+    out.append(' * Where the languages of every territory start in LocaleTerritoryLanguages (the last item is the end of the last territory).')
+    out.append(' */')
+    out.append('static const uint16_t LocaleTerritoryLanguageOffsets[LOCALE_TERRITORY_ID_COUNT + 1] = {')
+    for i in range(0, len(offsets), 16):
+        out.append('\t' + ', '.join(str(offset) for offset in offsets[i:i + 16]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('static const LocaleKey LocaleTerritoryLanguages[LOCALE_TERRITORY_LANGUAGE_COUNT] = {')
+    for i in range(0, len(keys), 4):
+        out.append('\t' + ' '.join(FormatLocaleKey(key) + ',' for key, _ in keys[i:i + 4]) + ' /* ' + ' '.join(locale for _, locale in keys[i:i + 4]) + ' */')
+    out.append('};')
+    Output('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,151 @@
+"""
+Helpers shared by the scripts that generate the tables of parse-locale-identifiers.c.
+
+LocaleKey() replicates the LocaleKey encoding of the C code (see LocaleKeyPositionCharacters and LocaleKeyPositionBits),
+so that the generated tables can be sorted and hashed like the C code does.
+
+Every generator prints the C code of its tables: with --check it verifies instead that the code
+is the same as the one in parse-locale-identifiers.c (exiting with status 1 if it's not).
+"""
+import os
+import sys
+
+SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'parse-locale-identifiers.c')
+
+DIGIT, UPPER, LOWER = 1, 2, 4
+POSITION_CHARACTERS = [
+    UPPER | LOWER, LOWER, LOWER, LOWER,
+    DIGIT | UPPER, DIGIT | UPPER | LOWER, DIGIT | LOWER, LOWER,
+    DIGIT | UPPER, DIGIT | UPPER, DIGIT,
+]
+POSITION_BITS = [
+    6, 5, 5, 5,
+    6, 6, 6, 5,
+    6, 6, 4,
+]
+MASK64 = (1 << 64) - 1
+
+
+def EncodeCharacter(c, characters):
+    code = 1
+    if characters & DIGIT:
+        if '0' <= c <= '9':
+            return code + ord(c) - ord('0')
+        code += 10
+    if characters & UPPER:
+        if 'A' <= c <= 'Z':
+            return code + ord(c) - ord('A')
+        code += 26
+    if characters & LOWER and 'a' <= c <= 'z':
+        return code + ord(c) - ord('a')
+    raise ValueError('%r can not be stored in a LocaleKey' % c)
+
+
+def SplitLocaleID(locale):
+    """Splits a canonical Unicode ID (like "sr_Latn_RS", "Latn_IT" or "es_419") in language, script and territory."""
+    parts = locale.replace('-', '_').split('_')
+    language, script, territory = parts[0], None, None
+    rest = parts[1:]
+    if len(language) == 4 and language != 'root':
+        language, script = None, parts[0]
+    elif rest and len(rest[0]) == 4:
+        script = rest.pop(0)
+    if rest:
+        territory = rest.pop(0)
+    if rest:
+        raise ValueError('%s can not be stored in a LocaleKey' % locale)
+    return language, script, territory
+
+
+def LocaleKey(locale):
+    """The LocaleKey of a Unicode ID (raises ValueError if it can't be represented)."""
+    language, script, territory = SplitLocaleID(locale)
+    characters = [''] * 11
+    position = 0
+    if language:
+        characters[0:len(language)] = language.lower()
+        position = 4
+    if script:
+        characters[position:position + 4] = script.title()
+        position += 4
+    if territory:
+        characters[position:position + len(territory)] = territory.upper()
+    key = 0
+    for i in range(11):
+        code = EncodeCharacter(characters[i], POSITION_CHARACTERS[i]) if characters[i] else 0
+        if code >= 1 << POSITION_BITS[i]:
+            raise ValueError('%s can not be stored in a LocaleKey' % locale)
+        key = (key << POSITION_BITS[i]) | code
+    return key
+
+
+def LocaleKeyToLocaleID(key):
+    """The canonical Unicode ID of a LocaleKey (the inverse of LocaleKey)."""
+    characters = [''] * 11
+    shift = 0
+    for i in reversed(range(11)):
+        code = (key >> shift) & ((1 << POSITION_BITS[i]) - 1)
+        shift += POSITION_BITS[i]
+        if not code:
+            continue
+        code -= 1
+        if POSITION_CHARACTERS[i] & DIGIT:
+            if code < 10:
+                characters[i] = chr(ord('0') + code)
+                continue
+            code -= 10
+        if POSITION_CHARACTERS[i] & UPPER:
+            if code < 26:
+                characters[i] = chr(ord('A') + code)
+                continue
+            code -= 26
+        characters[i] = chr(ord('a') + code)
+    result = ''
+    for i in range(11):
+        if characters[i]:
+            if i in (4, 8):
+                result += '_'
+            result += characters[i]
+    return result
+
+
+def IsLocaleKeyID(locale):
+    """Checks if a Unicode ID is canonical and can be represented as a LocaleKey."""
+    try:
+        return LocaleKeyToLocaleID(LocaleKey(locale)) == locale
+    except ValueError:
+        return False
+
+
+def HashLocaleKey(key):
+    """Replica of HashLocaleKey (the MurmurHash3 finalizer)."""
+    key ^= key >> 33
+    key = (key * 0xff51afd7ed558ccd) & MASK64
+    key ^= key >> 33
+    key = (key * 0xc4ceb9fe1a85ec53) & MASK64
+    key ^= key >> 33
+    return key
+
+
+def FormatLocaleKey(key):
+    return '0x%016xULL' % key
+
+
+def Output(code):
+    """Prints the generated code, or checks that it's in parse-locale-identifiers.c if --check has been specified."""
+    if '--check' not in sys.argv[1:]:
+        sys.stdout.write(code)
+        return
+    with open(SOURCE) as f:
+        source = f.read()
+    if code in source:
+        print('%s: the tables are up to date' % os.path.basename(sys.argv[0]))
+        return
+    lines = source.split('\n')
+    for line in code.split('\n'):
+        if line not in lines:
+            print('%s: the tables are different, for example at:\n%s' % (os.path.basename(sys.argv[0]), line))
+            break
+    else:
+        print('%s: the tables are different' % os.path.basename(sys.argv[0]))
+    sys.exit(1)